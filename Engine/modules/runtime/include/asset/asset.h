@@ -2,11 +2,17 @@
 
 #include "asset/asset_guid.h"
 #include "asset/asset_hash.h"
+#include "asset/asset_cook_scheduler.h"
 #include "asset/asset_database.h"
 #include "asset/asset_importer.h"
+#include "asset/asset_manager.h"
+#include "asset/asset_package.h"
 #include "asset/mesh_importer.h"
+#include "asset/mesh_optimizer.h"
 #include "asset/asset_registry.h"
+#include "asset/asset_registry_binary.h"
 #include "asset/asset_reference.h"
+#include "asset/texture_compression.h"
 #include "asset/texture_importer.h"
 #include "asset/asset_types.h"
 
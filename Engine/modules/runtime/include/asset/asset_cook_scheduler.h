@@ -0,0 +1,114 @@
+#pragma once
+
+#include "asset/asset_importer.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Cyber
+{
+    inline constexpr uint32_t kSourceHashCacheMagic = MakeAssetFourCC('C', 'S', 'H', 'C');
+    inline constexpr uint32_t kSourceHashCacheVersion = 2;
+
+    // Remembers the content hash of source files keyed by path, size and write time so an
+    // incremental cook does not have to reread unchanged sources.
+    class CYBER_RUNTIME_API SourceHashCache
+    {
+    public:
+        [[nodiscard]] bool Load(const std::filesystem::path& path);
+        [[nodiscard]] bool Save(const std::filesystem::path& path) const;
+        void Clear();
+
+        // Thread-safe. Returns false when the file cannot be read.
+        [[nodiscard]] bool HashFile(const std::filesystem::path& path, AssetHashAlgorithm algorithm,
+                                    uint64_t& outHash);
+        // Records a hash computed elsewhere, e.g. by an importer that already read the file.
+        void Remember(const std::filesystem::path& path, AssetHashAlgorithm algorithm, uint64_t hash);
+
+        [[nodiscard]] size_t Size() const;
+
+    private:
+        struct Entry
+        {
+            uint64_t size = 0;
+            int64_t writeTime = 0;
+            uint64_t hash = 0;
+            AssetHashAlgorithm algorithm = AssetHashAlgorithm::Fnv1a64;
+            uint32_t reserved = 0;
+        };
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, Entry> m_entries;
+    };
+
+    enum class AssetCookStatus : uint32_t
+    {
+        Cooked,
+        UpToDate,
+        Failed,
+    };
+
+    struct AssetCookRequest
+    {
+        AssetType importerType = AssetType::Unknown;
+        AssetImportRequest import {};
+    };
+
+    struct AssetCookResult
+    {
+        AssetCookStatus status = AssetCookStatus::Failed;
+        AssetImportResult importResult {};
+    };
+
+    struct AssetCookSettings
+    {
+        // 0 means hardware concurrency.
+        uint32_t workerCount = 0;
+        // Cook every request even when the registry says it is up to date.
+        bool force = false;
+        // Optional persistent SourceHashCache; empty keeps the cache in memory only.
+        std::filesystem::path sourceHashCachePath;
+        // Optional DDC for requests that do not name their own.
+        DerivedDataCache* derivedDataCache = nullptr;
+    };
+
+    struct AssetCookStats
+    {
+        uint32_t cooked = 0;
+        uint32_t upToDate = 0;
+        uint32_t failed = 0;
+    };
+
+    // Cooks a batch of import requests on a worker pool. A request is skipped when the registry
+    // record for its destination matches the importer version, dependency hash and the source
+    // hash, computed with the algorithm named in the existing asset's header. Results come back in request order and the registry
+    // is updated in that order once all jobs finished, so the outcome does not depend on timing.
+    class CYBER_RUNTIME_API AssetCookScheduler
+    {
+    public:
+        // maxConcurrency limits how many jobs of this importer run at once; 0 means no limit.
+        void RegisterImporter(const IAssetImporter& importer, uint32_t maxConcurrency = 0);
+
+        [[nodiscard]] std::vector<AssetCookResult> Cook(const std::vector<AssetCookRequest>& requests,
+                                                        AssetRegistry& registry,
+                                                        const AssetCookSettings& settings = {},
+                                                        AssetCookStats* outStats = nullptr);
+
+        [[nodiscard]] SourceHashCache& HashCache() { return m_hashCache; }
+
+    private:
+        struct ImporterSlot
+        {
+            const IAssetImporter* importer = nullptr;
+            uint32_t maxConcurrency = 0;
+        };
+
+        std::unordered_map<AssetType, ImporterSlot> m_importers;
+        SourceHashCache m_hashCache;
+        std::filesystem::path m_loadedCachePath;
+    };
+}
@@ -14,9 +14,18 @@ namespace Cyber
 
         [[nodiscard]] const std::filesystem::path& ContentRoot() const { return m_contentRoot; }
         [[nodiscard]] std::filesystem::path RegistryPath() const;
+        [[nodiscard]] std::filesystem::path BinaryRegistryPath() const;
 
+        // Load prefers AssetRegistry.bin and falls back to AssetRegistry.json when the binary
+        // file is missing, unreadable or older than the JSON (e.g. after a merge), rewriting it.
         [[nodiscard]] bool Load();
+        // Save always writes the binary registry; the JSON export is kept for diffs and merges
+        // unless disabled.
         [[nodiscard]] bool Save() const;
+        [[nodiscard]] bool ExportJson() const;
+
+        void SetJsonExportEnabled(bool enabled) { m_jsonExportEnabled = enabled; }
+        [[nodiscard]] bool IsJsonExportEnabled() const { return m_jsonExportEnabled; }
 
         [[nodiscard]] AssetRegistry& Registry() { return m_registry; }
         [[nodiscard]] const AssetRegistry& Registry() const { return m_registry; }
@@ -26,5 +35,6 @@ namespace Cyber
     private:
         std::filesystem::path m_contentRoot;
         AssetRegistry m_registry;
+        bool m_jsonExportEnabled = true;
     };
 }
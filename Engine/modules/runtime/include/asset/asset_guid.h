@@ -3,6 +3,7 @@
 #include "cyber_runtime.config.h"
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <string_view>
 
@@ -44,3 +45,13 @@ namespace Cyber
     inline constexpr AssetGuid kInvalidAssetGuid {};
 }
 
+template <>
+struct std::hash<Cyber::AssetGuid>
+{
+    [[nodiscard]] size_t operator()(const Cyber::AssetGuid& guid) const noexcept
+    {
+        // GUIDs are random, so folding the halves is already well distributed
+        return static_cast<size_t>(guid.high ^ (guid.low * 0x9e3779b97f4a7c15ull));
+    }
+};
+
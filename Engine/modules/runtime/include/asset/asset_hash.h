@@ -1,14 +1,68 @@
 #pragma once
 
+#include "cyber_runtime.config.h"
+
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <string_view>
 
+namespace Cyber
+{
+    // Stored in AssetFileHeader::contentHashAlgorithm; never renumber.
+    enum class AssetHashAlgorithm : uint32_t
+    {
+        Fnv1a64 = 0,
+        XXH3_64 = 1,
+    };
+
+    inline constexpr AssetHashAlgorithm kDefaultContentHashAlgorithm = AssetHashAlgorithm::XXH3_64;
+
+    struct AssetHash128
+    {
+        uint64_t low = 0;
+        uint64_t high = 0;
+
+        [[nodiscard]] friend bool operator==(const AssetHash128& lhs, const AssetHash128& rhs)
+        {
+            return lhs.low == rhs.low && lhs.high == rhs.high;
+        }
+        [[nodiscard]] friend bool operator!=(const AssetHash128& lhs, const AssetHash128& rhs)
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    // Incremental content hash over chunks of a file or buffer. Feeding the same bytes in any
+    // chunking gives the same digest as the one-shot AssetHash::HashContent.
+    class CYBER_RUNTIME_API AssetHasher
+    {
+    public:
+        explicit AssetHasher(AssetHashAlgorithm algorithm = kDefaultContentHashAlgorithm);
+
+        void Reset();
+        void Update(const void* data, size_t size);
+
+        [[nodiscard]] uint64_t Digest64() const;
+        // XXH3 only; FNV-1a returns its 64-bit digest in the low half.
+        [[nodiscard]] AssetHash128 Digest128() const;
+
+        [[nodiscard]] AssetHashAlgorithm Algorithm() const { return m_algorithm; }
+
+    private:
+        AssetHashAlgorithm m_algorithm;
+        uint64_t m_fnvState = 0;
+        alignas(64) unsigned char m_xxh3State[640];
+    };
+}
+
 namespace Cyber::AssetHash
 {
     inline constexpr uint64_t kFnv1a64Offset = 14695981039346656037ull;
     inline constexpr uint64_t kFnv1a64Prime = 1099511628211ull;
 
+    // FNV-1a: kept for short keys (paths, dependency keys) and for assets whose header still
+    // names it. File contents go through HashContent/AssetHasher.
     [[nodiscard]] inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = kFnv1a64Offset)
     {
         const auto* bytes = static_cast<const uint8_t*>(data);
@@ -32,5 +86,12 @@ namespace Cyber::AssetHash
         value ^= rhs + 0x9e3779b97f4a7c15ull + (value << 6) + (value >> 2);
         return value;
     }
-}
 
+    [[nodiscard]] CYBER_RUNTIME_API uint64_t HashContent(const void* data, size_t size,
+                                                         AssetHashAlgorithm algorithm = kDefaultContentHashAlgorithm);
+    [[nodiscard]] CYBER_RUNTIME_API AssetHash128 HashContent128(const void* data, size_t size);
+
+    // Streams the file through AssetHasher in fixed-size chunks.
+    [[nodiscard]] CYBER_RUNTIME_API bool HashFile(const std::filesystem::path& path, uint64_t& outHash,
+                                                  AssetHashAlgorithm algorithm = kDefaultContentHashAlgorithm);
+}
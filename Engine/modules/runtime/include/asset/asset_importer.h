@@ -1,12 +1,16 @@
 #pragma once
 
+#include "asset/asset_hash.h"
 #include "asset/asset_registry.h"
+#include "asset/mesh_optimizer.h"
 
 #include <filesystem>
 #include <string>
 
 namespace Cyber
 {
+    class DerivedDataCache;
+
     struct AssetImportRequest
     {
         std::filesystem::path sourcePath;
@@ -15,12 +19,26 @@ namespace Cyber
         AssetGuid existingGuid {};
         uint32_t width = 0;
         uint32_t height = 0;
+        TextureUsage textureUsage = TextureUsage::Auto;
+        AssetSourceStorage sourceStorage = AssetSourceStorage::None;
+        // Threads an importer may use internally; 0 means hardware concurrency.
+        uint32_t threadCount = 0;
+        // Meshes only: weld and reorder for the vertex cache, overdraw and vertex fetch.
+        bool optimizeMesh = true;
+        // Meshes only: vertex buffer layout of the cooked asset.
+        CookedVertexEncoding vertexEncoding {};
+        // Meshes only: simplified levels cooked for each primitive.
+        MeshLodSettings meshLods {};
+        // Optional; cooked mip chains and optimized meshes are looked up here before deriving them.
+        DerivedDataCache* derivedDataCache = nullptr;
     };
 
     struct AssetImportResult
     {
         AssetRegistryRecord registryRecord {};
         std::string error;
+        // Filled by mesh imports that ran the optimizer.
+        MeshOptimizationStats meshOptimization {};
 
         [[nodiscard]] bool Succeeded() const
         {
@@ -37,5 +55,12 @@ namespace Cyber
         [[nodiscard]] virtual uint32_t Version() const = 0;
         [[nodiscard]] virtual bool Import(const AssetImportRequest& request,
                                           AssetImportResult& outResult) const = 0;
+
+        // Everything besides the source bytes and importer version that changes the cooked
+        // output. Written to AssetFileHeader::dependencyHash and used to skip up-to-date cooks.
+        [[nodiscard]] virtual uint64_t DependencyHash(const AssetImportRequest& request) const
+        {
+            return AssetHash::HashString(request.sourcePath.generic_string());
+        }
     };
 }
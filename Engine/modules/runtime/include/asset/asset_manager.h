@@ -0,0 +1,214 @@
+#pragma once
+
+#include "asset/asset_reference.h"
+#include "asset/asset_registry.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Cyber
+{
+    class AssetManager;
+    class AssetPackage;
+    struct AssetLoadEntry;
+
+    enum class AssetLoadState : uint32_t
+    {
+        // Waiting for dependencies or a worker
+        Queued,
+        Loading,
+        Loaded,
+        Failed,
+    };
+
+    enum class AssetLoadPriority : uint32_t
+    {
+        Low,
+        Normal,
+        High,
+        Critical,
+    };
+
+    // Shared ownership of a requested asset. The load keeps running while any handle to it exists;
+    // releasing the last one drops queued work and, once loaded, the runtime object.
+    class CYBER_RUNTIME_API AssetHandle
+    {
+    public:
+        AssetHandle() = default;
+
+        [[nodiscard]] bool IsValid() const { return m_entry != nullptr; }
+        [[nodiscard]] AssetId Id() const;
+        // Acquire load; after Loaded or Failed, Object() and Error() are safe to read.
+        [[nodiscard]] AssetLoadState State() const;
+        [[nodiscard]] bool IsLoaded() const { return State() == AssetLoadState::Loaded; }
+        [[nodiscard]] bool IsDone() const;
+        [[nodiscard]] const std::string& Error() const;
+
+        // The object the type's loader produced; null until loaded.
+        [[nodiscard]] std::shared_ptr<void> Object() const;
+        template <typename T>
+        [[nodiscard]] std::shared_ptr<T> Get() const
+        {
+            return std::static_pointer_cast<T>(Object());
+        }
+
+        void Reset() { m_entry.reset(); }
+
+        [[nodiscard]] bool operator==(const AssetHandle& rhs) const { return m_entry == rhs.m_entry; }
+        [[nodiscard]] bool operator!=(const AssetHandle& rhs) const { return m_entry != rhs.m_entry; }
+
+    private:
+        friend class AssetManager;
+
+        explicit AssetHandle(std::shared_ptr<AssetLoadEntry> entry)
+            : m_entry(std::move(entry))
+        {
+        }
+
+        std::shared_ptr<AssetLoadEntry> m_entry;
+    };
+
+    // What a loader gets on the worker thread. Every dependency has loaded by the time it runs.
+    class CYBER_RUNTIME_API AssetLoadContext
+    {
+    public:
+        AssetLoadContext(AssetManager& manager, const AssetRegistryRecord& record)
+            : m_manager(manager), m_record(record)
+        {
+        }
+
+        [[nodiscard]] const AssetRegistryRecord& Record() const { return m_record; }
+        [[nodiscard]] AssetManager& Manager() const { return m_manager; }
+
+        // The cooked bytes, from the record's package when it names one, else from the loose file.
+        [[nodiscard]] bool ReadBytes(std::vector<uint8_t>& outBytes, std::string* outError = nullptr) const;
+        [[nodiscard]] std::filesystem::path LoosePath() const;
+
+    private:
+        AssetManager& m_manager;
+        const AssetRegistryRecord& m_record;
+    };
+
+    class CYBER_RUNTIME_API IAssetLoader
+    {
+    public:
+        virtual ~IAssetLoader() = default;
+
+        [[nodiscard]] virtual AssetType Type() const = 0;
+        // Runs on a worker thread, possibly on several at once for different assets.
+        [[nodiscard]] virtual bool Load(const AssetLoadContext& context, std::shared_ptr<void>& outObject,
+                                        std::string* outError) const = 0;
+    };
+
+    struct AssetManagerSettings
+    {
+        // Loose cooked files are read from contentRoot / assetPath.
+        std::filesystem::path contentRoot;
+        // Packages named by AssetRegistryRecord::packageName are opened from here on first use.
+        std::filesystem::path packageDirectory;
+        // 0 means hardware concurrency.
+        uint32_t workerCount = 0;
+    };
+
+    struct AssetManagerStats
+    {
+        uint64_t requests = 0;
+        // Requests answered with an entry that was already loading or loaded
+        uint64_t deduplicated = 0;
+        uint64_t loaded = 0;
+        uint64_t failed = 0;
+        // Scheduled loads dropped because every handle was released first
+        uint64_t cancelled = 0;
+        uint64_t bytesRead = 0;
+    };
+
+    // Loads cooked assets by GUID on a fixed worker pool. A request pulls in the record's
+    // dependencies first, and an asset is handed to its loader only once they all loaded, so
+    // loaders may look them up with Find(). Workers take the highest priority ready asset;
+    // requesting an asset again at a higher priority raises it and its dependencies. Concurrent
+    // requests for one GUID share a single load. The registry must outlive the manager and not
+    // change while it is in use.
+    class CYBER_RUNTIME_API AssetManager
+    {
+    public:
+        explicit AssetManager(const AssetRegistry& registry, AssetManagerSettings settings = {});
+        ~AssetManager();
+
+        AssetManager(const AssetManager&) = delete;
+        AssetManager& operator=(const AssetManager&) = delete;
+
+        // Register every loader before the first request.
+        void RegisterLoader(const IAssetLoader& loader);
+
+        [[nodiscard]] AssetHandle Load(AssetId id, AssetLoadPriority priority = AssetLoadPriority::Normal);
+        // Fails the handle when the record's type is not the expected one.
+        [[nodiscard]] AssetHandle Load(const SoftAssetRef& ref, AssetLoadPriority priority = AssetLoadPriority::Normal);
+
+        // A handle to an asset that is already requested; invalid otherwise.
+        [[nodiscard]] AssetHandle Find(AssetId id) const;
+
+        // Blocks until the handle's asset loaded or failed. Must not be called from a loader.
+        void Wait(const AssetHandle& handle) const;
+        // Blocks until no load is queued or running.
+        void WaitIdle() const;
+
+        [[nodiscard]] AssetManagerStats Stats() const;
+        [[nodiscard]] const AssetManagerSettings& Settings() const { return m_settings; }
+
+    private:
+        friend class AssetLoadContext;
+
+        struct QueueKey
+        {
+            AssetLoadPriority priority = AssetLoadPriority::Normal;
+            uint64_t sequence = 0;
+            std::weak_ptr<AssetLoadEntry> entry;
+
+            [[nodiscard]] bool operator<(const QueueKey& rhs) const
+            {
+                return priority != rhs.priority ? priority > rhs.priority : sequence < rhs.sequence;
+            }
+        };
+
+        // Null when guid is already on path, i.e. the dependencies form a cycle.
+        std::shared_ptr<AssetLoadEntry> RequestLocked(AssetGuid guid, AssetLoadPriority priority,
+                                                      std::vector<AssetGuid>& path);
+        void ScheduleLocked(const std::shared_ptr<AssetLoadEntry>& entry);
+        void RaisePriorityLocked(AssetLoadEntry& entry, AssetLoadPriority priority);
+        void CompleteLocked(AssetLoadEntry& entry);
+        void FailLocked(AssetLoadEntry& entry, std::string error);
+        void WorkerMain();
+        [[nodiscard]] const AssetPackage* OpenPackage(const std::string& packageName, std::string* outError);
+
+        const AssetRegistry& m_registry;
+        AssetManagerSettings m_settings;
+        std::unordered_map<AssetType, const IAssetLoader*> m_loaders;
+
+        mutable std::mutex m_mutex;
+        mutable std::condition_variable m_workAvailable;
+        mutable std::condition_variable m_progress;
+        std::unordered_map<AssetGuid, std::weak_ptr<AssetLoadEntry>> m_entries;
+        size_t m_sweepThreshold = 64;
+        std::set<QueueKey> m_queue;
+        uint64_t m_nextSequence = 0;
+        // Scheduled loads that are queued or running
+        uint32_t m_inFlight = 0;
+        bool m_stopping = false;
+        AssetManagerStats m_stats;
+        std::atomic<uint64_t> m_bytesRead { 0 };
+
+        std::mutex m_packageMutex;
+        std::unordered_map<std::string, std::unique_ptr<AssetPackage>> m_packages;
+
+        std::vector<std::thread> m_workers;
+    };
+}
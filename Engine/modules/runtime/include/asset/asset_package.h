@@ -0,0 +1,151 @@
+#pragma once
+
+#include "asset/asset_registry.h"
+#include "asset/asset_types.h"
+#include "asset/mapped_file.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Cyber
+{
+    inline constexpr uint32_t kAssetPackageMagic = MakeAssetFourCC('C', 'P', 'A', 'K');
+    inline constexpr uint32_t kAssetPackageVersion = 1;
+    inline constexpr uint32_t kAssetPackageFanoutSize = 256;
+    inline constexpr uint32_t kMinAssetPackageBlockSize = 64u << 10;
+    inline constexpr uint32_t kMaxAssetPackageBlockSize = 256u << 10;
+
+    // Stored in AssetPackageHeader::compression; never renumber.
+    enum class AssetPackageCompression : uint32_t
+    {
+        None = 0,
+        // Raw DEFLATE, one stream per block; written by zlib and read by libdeflate
+        Deflate = 1,
+    };
+
+    // Cooked assets are concatenated, each on a 16-byte boundary, into one data stream that is cut
+    // into fixed-size blocks and compressed block by block. The index follows the blocks:
+    //   entries sorted by GUID, a fanout table over the first GUID byte, the block table and the
+    //   dependency table, each 16-byte aligned and covered by indexHash.
+    struct AssetPackageHeader
+    {
+        uint32_t magic = kAssetPackageMagic;
+        uint32_t version = kAssetPackageVersion;
+        uint32_t headerSize = sizeof(AssetPackageHeader);
+        uint32_t platformTag = kAnyAssetPlatform;
+        uint32_t chunkId = 0;
+        AssetPackageCompression compression = AssetPackageCompression::Deflate;
+        uint32_t blockSize = 0;
+        uint32_t reserved = 0;
+        uint64_t dataSize = 0;
+        uint64_t entryCount = 0;
+        uint64_t entriesOffset = 0;
+        uint64_t fanoutOffset = 0;
+        uint64_t blockCount = 0;
+        uint64_t blocksOffset = 0;
+        uint64_t dependencyCount = 0;
+        uint64_t dependenciesOffset = 0;
+        uint64_t indexSize = 0;
+        uint64_t indexHash = 0;
+    };
+
+    // offset and size locate the asset in the uncompressed data stream.
+    struct AssetPackageEntry
+    {
+        AssetGuid guid {};
+        AssetType type = AssetType::Unknown;
+        uint32_t dependencyCount = 0;
+        uint64_t firstDependency = 0;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    // A block whose compressed size equals its uncompressed size is stored as is.
+    struct AssetPackageBlock
+    {
+        uint64_t fileOffset = 0;
+        uint32_t compressedSize = 0;
+        uint32_t uncompressedSize = 0;
+    };
+
+    struct AssetPackageInput
+    {
+        AssetGuid guid {};
+        AssetType type = AssetType::Unknown;
+        std::filesystem::path path;
+        std::vector<AssetGuid> dependencies;
+    };
+
+    struct AssetPackageSettings
+    {
+        // Clamped to [kMinAssetPackageBlockSize, kMaxAssetPackageBlockSize].
+        uint32_t blockSize = 128u << 10;
+        AssetPackageCompression compression = AssetPackageCompression::Deflate;
+        // zlib level, 1 to 9.
+        int compressionLevel = 6;
+        uint32_t platformTag = kAnyAssetPlatform;
+        // Threads compressing blocks; 0 means hardware concurrency.
+        uint32_t threadCount = 0;
+    };
+
+    struct AssetPackageReadRequest
+    {
+        AssetGuid guid {};
+        // Must hold exactly the entry's size.
+        std::span<uint8_t> destination;
+    };
+
+    // Read-only view of a mapped .assetpack. Lookups binary search the fanout bucket of a GUID.
+    class CYBER_RUNTIME_API AssetPackage
+    {
+    public:
+        [[nodiscard]] bool Open(const std::filesystem::path& path, std::string* outError = nullptr);
+        void Close();
+
+        [[nodiscard]] bool IsOpen() const { return m_file.IsOpen(); }
+        [[nodiscard]] const AssetPackageHeader& Header() const { return m_header; }
+        [[nodiscard]] std::span<const AssetPackageEntry> Entries() const { return m_entries; }
+        [[nodiscard]] const AssetPackageEntry* Find(AssetGuid guid) const;
+        [[nodiscard]] std::span<const AssetGuid> Dependencies(const AssetPackageEntry& entry) const;
+
+        // Decompresses every requested asset into its destination on up to threadCount threads
+        // (0 means hardware concurrency). Blocks that lie inside one destination are decompressed
+        // in place; blocks shared by several requested assets are decompressed once. Safe to call
+        // from several threads at once.
+        [[nodiscard]] bool Read(std::span<const AssetPackageReadRequest> requests, uint32_t threadCount = 0,
+                                std::string* outError = nullptr) const;
+        [[nodiscard]] bool Read(AssetGuid guid, std::vector<uint8_t>& outBytes, std::string* outError = nullptr) const;
+
+    private:
+        MappedFile m_file;
+        AssetPackageHeader m_header {};
+        std::span<const AssetPackageEntry> m_entries;
+        std::span<const uint32_t> m_fanout;
+        std::span<const AssetPackageBlock> m_blocks;
+        std::span<const AssetGuid> m_dependencies;
+    };
+
+    namespace AssetPackager
+    {
+        // Writes inputs, in the given order, to a package through a temporary file that replaces
+        // packagePath only once complete.
+        [[nodiscard]] CYBER_RUNTIME_API bool WritePackage(const std::filesystem::path& packagePath, uint32_t chunkId,
+                                                          std::span<const AssetPackageInput> inputs,
+                                                          const AssetPackageSettings& settings = {},
+                                                          std::string* outError = nullptr);
+
+        // Packs the cooked asset of every registry record into chunk_<chunkId>.assetpack under
+        // outputDirectory, in asset path order, and records the package name on each record.
+        [[nodiscard]] CYBER_RUNTIME_API bool PackRegistry(AssetRegistry& registry,
+                                                          const std::filesystem::path& contentRoot,
+                                                          const std::filesystem::path& outputDirectory,
+                                                          const AssetPackageSettings& settings = {},
+                                                          std::vector<std::filesystem::path>* outPackages = nullptr,
+                                                          std::string* outError = nullptr);
+
+        [[nodiscard]] CYBER_RUNTIME_API std::string PackageName(uint32_t chunkId);
+    }
+}
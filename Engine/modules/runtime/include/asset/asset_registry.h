@@ -6,6 +6,8 @@
 
 #include <filesystem>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace Cyber
@@ -33,15 +35,26 @@ namespace Cyber
         }
     };
 
+    // Records live in a flat vector in no particular order; GUID, asset path and source path
+    // lookups go through hash indices over normalized paths. Upsert and Remove may move records,
+    // so pointers returned by Find* are only valid until the next modification, and the
+    // mutable Find() must not be used to change a record's guid or paths.
     class CYBER_RUNTIME_API AssetRegistry
     {
     public:
         void Clear();
+        void Reserve(size_t recordCount);
 
         [[nodiscard]] bool Load(const std::filesystem::path& path);
         [[nodiscard]] bool Save(const std::filesystem::path& path) const;
 
+        // Compact binary form of the same data; see asset_registry_binary.h for the layout.
+        [[nodiscard]] bool LoadBinary(const std::filesystem::path& path);
+        [[nodiscard]] bool SaveBinary(const std::filesystem::path& path) const;
+
         void Upsert(const AssetRegistryRecord& record);
+        void Upsert(AssetRegistryRecord&& record);
+        void UpsertBatch(std::vector<AssetRegistryRecord> records);
         [[nodiscard]] bool Remove(AssetGuid guid);
 
         [[nodiscard]] const AssetRegistryRecord* Find(AssetGuid guid) const;
@@ -56,6 +69,25 @@ namespace Cyber
                                                         const std::filesystem::path& root = {});
 
     private:
+        struct PathHash
+        {
+            using is_transparent = void;
+            [[nodiscard]] size_t operator()(std::string_view path) const noexcept
+            {
+                return std::hash<std::string_view> {}(path);
+            }
+        };
+
+        using PathIndex = std::unordered_map<std::string, size_t, PathHash, std::equal_to<>>;
+        using SourcePathIndex = std::unordered_multimap<std::string, size_t, PathHash, std::equal_to<>>;
+
+        void IndexRecord(size_t slot);
+        void UnindexRecord(size_t slot);
+        void RemoveSlot(size_t slot);
+
         std::vector<AssetRegistryRecord> m_records;
+        std::unordered_map<AssetGuid, size_t> m_guidIndex;
+        PathIndex m_assetPathIndex;
+        SourcePathIndex m_sourcePathIndex;
     };
 }
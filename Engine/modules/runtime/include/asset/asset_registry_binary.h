@@ -0,0 +1,92 @@
+#pragma once
+
+#include "asset/asset_registry.h"
+#include "asset/mapped_file.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace Cyber
+{
+    inline constexpr uint32_t kAssetRegistryBinaryMagic = MakeAssetFourCC('C', 'R', 'E', 'G');
+    inline constexpr uint32_t kAssetRegistryBinaryVersion = 1;
+
+    // Layout: header | records sorted by GUID | asset path index sorted by hash |
+    // dependency GUID pool | string table. All offsets are absolute file offsets.
+    struct AssetRegistryBinaryHeader
+    {
+        uint32_t magic = kAssetRegistryBinaryMagic;
+        uint32_t version = kAssetRegistryBinaryVersion;
+        uint32_t recordCount = 0;
+        uint32_t recordSize = 0;
+        uint64_t recordsOffset = 0;
+        uint64_t pathIndexOffset = 0;
+        uint64_t dependenciesOffset = 0;
+        uint64_t dependencyCount = 0;
+        uint64_t stringsOffset = 0;
+        uint64_t stringsSize = 0;
+    };
+
+    // Offset is relative to the string table
+    struct AssetRegistryBinaryString
+    {
+        uint32_t offset = 0;
+        uint32_t size = 0;
+    };
+
+    struct AssetRegistryBinaryRecord
+    {
+        AssetGuid guid {};
+        AssetType type = AssetType::Unknown;
+        uint32_t importerVersion = 0;
+        uint32_t assetFormatVersion = 0;
+        uint32_t chunkId = 0;
+        uint64_t sourceHash = 0;
+        uint64_t editorAssetHash = 0;
+        uint64_t cookedAssetHash = 0;
+        AssetRegistryBinaryString assetPath {};
+        AssetRegistryBinaryString displayName {};
+        AssetRegistryBinaryString sourcePath {};
+        AssetRegistryBinaryString thumbnailPath {};
+        AssetRegistryBinaryString packageName {};
+        uint32_t firstDependency = 0;
+        uint32_t dependencyCount = 0;
+    };
+
+    struct AssetRegistryBinaryPathEntry
+    {
+        uint64_t pathHash = 0;
+        uint32_t recordIndex = 0;
+        uint32_t reserved = 0;
+    };
+
+    // Read-only registry queried straight out of a mapped AssetRegistry.bin, without building
+    // any in-memory records. Everything returned points into the mapping.
+    class CYBER_RUNTIME_API AssetRegistryBinaryView
+    {
+    public:
+        [[nodiscard]] bool Open(const std::filesystem::path& path);
+        void Close();
+
+        [[nodiscard]] bool IsOpen() const { return m_file.IsOpen(); }
+        [[nodiscard]] std::span<const AssetRegistryBinaryRecord> Records() const { return m_records; }
+
+        [[nodiscard]] const AssetRegistryBinaryRecord* Find(AssetGuid guid) const;
+        [[nodiscard]] const AssetRegistryBinaryRecord* FindByAssetPath(std::string_view assetPath) const;
+
+        [[nodiscard]] std::string_view String(const AssetRegistryBinaryString& value) const;
+        [[nodiscard]] std::span<const AssetGuid> Dependencies(const AssetRegistryBinaryRecord& record) const;
+        [[nodiscard]] AssetRegistryRecord ToRecord(const AssetRegistryBinaryRecord& record) const;
+
+        [[nodiscard]] static uint64_t HashPath(std::string_view normalizedPath);
+
+    private:
+        MappedFile m_file;
+        std::span<const AssetRegistryBinaryRecord> m_records;
+        std::span<const AssetRegistryBinaryPathEntry> m_pathIndex;
+        std::span<const AssetGuid> m_dependencies;
+        std::string_view m_strings;
+    };
+}
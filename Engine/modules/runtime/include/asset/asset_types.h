@@ -1,8 +1,10 @@
 #pragma once
 
 #include "asset/asset_guid.h"
+#include "asset/asset_hash.h"
 #include "cyber_runtime.config.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 
@@ -33,11 +35,32 @@ namespace Cyber
         PhysicsCollision,
     };
 
+    // Selects the cooked texture format; Auto infers it from the source file name suffix.
+    enum class TextureUsage : uint32_t
+    {
+        Auto = 0,
+        Albedo,
+        Normal,
+        Mask,
+        Grayscale,
+        Uncompressed,
+    };
+
+    // Where an importer keeps the original source bytes besides the cooked output.
+    enum class AssetSourceStorage : uint32_t
+    {
+        None,
+        Embedded,
+        SideCar,
+    };
+
     inline constexpr uint32_t kAnyAssetPlatform = 0;
     inline constexpr uint32_t kWindowsD3D12AssetPlatform = MakeAssetFourCC('W', 'D', '1', '2');
 
     inline constexpr uint32_t kAssetFileMagic = MakeAssetFourCC('C', 'A', 'S', 'T');
-    inline constexpr uint32_t kAssetFileFormatVersion = 1;
+    // v2 appends contentHashAlgorithm; v1 headers are 72 bytes and hash contents with FNV-1a.
+    inline constexpr uint32_t kAssetFileFormatVersion = 2;
+    inline constexpr uint32_t kAssetFileHeaderV1Size = 72;
 
     struct AssetFileHeader
     {
@@ -52,11 +75,19 @@ namespace Cyber
         uint32_t platformTag = kAnyAssetPlatform;
         uint64_t payloadOffset = 0;
         uint64_t payloadSize = 0;
+        AssetHashAlgorithm contentHashAlgorithm = kDefaultContentHashAlgorithm;
+        uint32_t reserved = 0;
+
+        // A v1 header is followed directly by payload, so the v2 fields read from it are garbage.
+        [[nodiscard]] AssetHashAlgorithm ContentHashAlgorithm() const
+        {
+            return formatVersion >= 2 ? contentHashAlgorithm : AssetHashAlgorithm::Fnv1a64;
+        }
 
         [[nodiscard]] bool IsValid() const
         {
             return magic == kAssetFileMagic &&
-                   headerSize >= sizeof(AssetFileHeader) &&
+                   headerSize >= (formatVersion >= 2 ? sizeof(AssetFileHeader) : kAssetFileHeaderV1Size) &&
                    formatVersion > 0 &&
                    assetType != AssetType::Unknown &&
                    assetGuid.IsValid();
@@ -77,6 +108,8 @@ namespace Cyber
     };
 
     static_assert(sizeof(AssetGuid) == 16, "AssetGuid must stay binary stable.");
+    static_assert(offsetof(AssetFileHeader, contentHashAlgorithm) == kAssetFileHeaderV1Size,
+                  "AssetFileHeader v2 must extend the v1 layout.");
 
     [[nodiscard]] CYBER_RUNTIME_API const char* ToString(AssetType type);
     [[nodiscard]] CYBER_RUNTIME_API bool TryParseAssetType(std::string_view text, AssetType& outType);
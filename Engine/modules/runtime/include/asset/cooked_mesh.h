@@ -1,7 +1,10 @@
 #pragma once
 
+#include "asset/mapped_file.h"
+
 #include <cstdint>
 #include <filesystem>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -25,6 +28,91 @@ namespace Cyber
         float tangent[3] {};
     };
 
+    // How one vertex attribute is stored. Written to MeshAssetPayloadHeader; never renumber.
+    enum class CookedVertexFormat : uint16_t
+    {
+        Float32x2 = 0,
+        Float32x3 = 1,
+        Float16x2 = 2,
+        // Normalized to the owning primitive's CookedMeshPrimitiveDecode range
+        Unorm16x2 = 3,
+        // xyz normalized to the primitive's position range, w = 1
+        Unorm16x4 = 4,
+        // Unit vector folded onto the octahedron
+        OctahedralSnorm16x2 = 5,
+    };
+
+    struct CookedVertexAttribute
+    {
+        CookedVertexFormat format = CookedVertexFormat::Float32x3;
+        uint16_t offset = 0;
+    };
+
+    // Byte layout of the cooked vertex buffer. The default is CookedMeshVertex itself.
+    struct CookedVertexLayout
+    {
+        CookedVertexAttribute position { CookedVertexFormat::Float32x3, 0 };
+        CookedVertexAttribute normal { CookedVertexFormat::Float32x3, 12 };
+        CookedVertexAttribute uv0 { CookedVertexFormat::Float32x2, 24 };
+        CookedVertexAttribute tangent { CookedVertexFormat::Float32x3, 32 };
+        uint32_t stride = 44;
+
+        [[nodiscard]] bool IsFloat() const
+        {
+            return position.format == CookedVertexFormat::Float32x3 && position.offset == 0 &&
+                   normal.format == CookedVertexFormat::Float32x3 && normal.offset == 12 &&
+                   uv0.format == CookedVertexFormat::Float32x2 && uv0.offset == 24 &&
+                   tangent.format == CookedVertexFormat::Float32x3 && tangent.offset == 32 && stride == 44;
+        }
+        // True when decoding needs the primitive's CookedMeshPrimitiveDecode
+        [[nodiscard]] bool IsPrimitiveRelative() const
+        {
+            return position.format == CookedVertexFormat::Unorm16x4 || uv0.format == CookedVertexFormat::Unorm16x2;
+        }
+        // Equal layouts give equal keys; pipelines built from a layout are cached by it
+        [[nodiscard]] uint64_t Key() const
+        {
+            const auto pack = [](const CookedVertexAttribute& attribute)
+            {
+                return uint64_t(attribute.format) << 8 | uint64_t(attribute.offset & 0xff);
+            };
+            return pack(position) | pack(normal) << 12 | pack(uv0) << 24 | pack(tangent) << 36 | uint64_t(stride) << 48;
+        }
+    };
+
+    enum class CookedVertexUvEncoding : uint8_t
+    {
+        Float32,
+        Float16,
+        Unorm16,
+    };
+
+    // Cook-time choice of vertex layout; Compact() packs the 44-byte vertex into 20 bytes.
+    struct CookedVertexEncoding
+    {
+        bool quantizePositions = false;
+        bool octahedralDirections = false;
+        CookedVertexUvEncoding uv0 = CookedVertexUvEncoding::Float32;
+
+        [[nodiscard]] static CookedVertexEncoding Compact()
+        {
+            return CookedVertexEncoding { true, true, CookedVertexUvEncoding::Float16 };
+        }
+        [[nodiscard]] bool IsFloat() const
+        {
+            return !quantizePositions && !octahedralDirections && uv0 == CookedVertexUvEncoding::Float32;
+        }
+    };
+
+    // Per-primitive constants for the normalized formats: value = offset + normalized * scale.
+    struct CookedMeshPrimitiveDecode
+    {
+        float positionOffset[3] {};
+        float positionScale[3] { 1.0f, 1.0f, 1.0f };
+        float uvOffset[2] {};
+        float uvScale[2] { 1.0f, 1.0f };
+    };
+
     struct CookedMeshPrimitive
     {
         uint32_t firstIndex = 0;
@@ -35,6 +123,25 @@ namespace Cyber
         float boundsMax[3] {};
     };
 
+    // A simplified index range of one primitive. It indexes the primitive's own vertices, so
+    // every level draws from the same vertex buffer.
+    struct CookedMeshLod
+    {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        // RMS distance, in mesh units, between this level's surface and the source surface it
+        // replaces; never decreases along a primitive's chain
+        float error = 0.0f;
+        uint32_t reserved = 0;
+    };
+
+    // Levels 1.. of a primitive, coarser with each entry; level 0 is the primitive's own range.
+    struct CookedMeshPrimitiveLods
+    {
+        uint32_t firstLod = 0;
+        uint32_t lodCount = 0;
+    };
+
     struct CookedMeshRecord
     {
         uint32_t firstPrimitive = 0;
@@ -74,12 +181,80 @@ namespace Cyber
         std::vector<uint32_t> indices;
         std::vector<CookedMeshRecord> meshes;
         std::vector<CookedMeshPrimitive> primitives;
+        // Empty, or one entry per primitive; LOD index ranges follow every primitive's own range
+        std::vector<CookedMeshPrimitiveLods> primitiveLods;
+        std::vector<CookedMeshLod> lods;
         std::vector<CookedMeshMaterial> materials;
         std::vector<CookedMeshTexture> textures;
     };
 
+    static_assert(sizeof(CookedMeshVertex) == 44, "CookedVertexLayout defaults describe CookedMeshVertex.");
+
+    [[nodiscard]] CYBER_COOKED_MESH_API CookedVertexLayout MakeCookedVertexLayout(const CookedVertexEncoding& encoding);
+    // Known formats for each attribute, 4-byte aligned and inside the stride
+    [[nodiscard]] CYBER_COOKED_MESH_API bool IsValidCookedVertexLayout(const CookedVertexLayout& layout);
+
+    // Packs data.vertices into layout. With a primitive-relative layout every vertex must belong
+    // to one primitive, so vertices shared between primitives are duplicated and data.indices
+    // rewritten, LOD ranges included; outDecode then holds one entry per primitive.
+    CYBER_COOKED_MESH_API void EncodeCookedVertices(CookedMeshData& data, const CookedVertexLayout& layout,
+                                                    std::vector<uint8_t>& outBytes,
+                                                    std::vector<CookedMeshPrimitiveDecode>& outDecode);
+
+    // Inverse of EncodeCookedVertices. decode may be empty when the layout is not primitive-relative.
+    [[nodiscard]] CYBER_COOKED_MESH_API bool DecodeCookedVertices(
+        const CookedVertexLayout& layout, std::span<const uint8_t> bytes,
+        std::span<const uint32_t> indices, std::span<const CookedMeshPrimitive> primitives,
+        std::span<const CookedMeshPrimitiveDecode> decode, std::vector<CookedMeshVertex>& outVertices);
+
     [[nodiscard]] CYBER_COOKED_MESH_API bool ReadCookedMeshAsset(
         const std::filesystem::path& path, CookedMeshData& outData,
         std::string* outError = nullptr);
+
+    // Zero-copy access to a cooked .meshasset: the file is mapped and every span points into
+    // the mapping, so it stays valid until Close() or destruction. Assets written before the
+    // writer aligned its sections fail to open and must go through ReadCookedMeshAsset instead.
+    // Open(bytes) views an asset already in memory, e.g. read from a package; the bytes must
+    // outlive the view and be 16-byte aligned.
+    // Vertices() is only set for the float layout; VertexBytes() always covers the vertex buffer.
+    class CYBER_COOKED_MESH_API CookedMeshView
+    {
+    public:
+        [[nodiscard]] bool Open(const std::filesystem::path& path, std::string* outError = nullptr);
+        [[nodiscard]] bool Open(std::span<const uint8_t> bytes, std::string* outError = nullptr);
+        void Close();
+
+        [[nodiscard]] bool IsOpen() const { return m_payload != nullptr; }
+        [[nodiscard]] std::span<const CookedMeshVertex> Vertices() const { return m_vertices; }
+        [[nodiscard]] std::span<const uint8_t> VertexBytes() const { return m_vertexBytes; }
+        [[nodiscard]] const CookedVertexLayout& VertexLayout() const { return m_vertexLayout; }
+        [[nodiscard]] std::span<const CookedMeshPrimitiveDecode> PrimitiveDecode() const { return m_primitiveDecode; }
+        [[nodiscard]] std::span<const uint32_t> Indices() const { return m_indices; }
+        [[nodiscard]] std::span<const CookedMeshRecord> Meshes() const { return m_meshes; }
+        [[nodiscard]] std::span<const CookedMeshPrimitive> Primitives() const { return m_primitives; }
+        // Empty for assets cooked without LODs
+        [[nodiscard]] std::span<const CookedMeshPrimitiveLods> PrimitiveLods() const { return m_primitiveLods; }
+        [[nodiscard]] std::span<const CookedMeshLod> Lods() const { return m_lods; }
+        [[nodiscard]] std::span<const CookedMeshMaterial> Materials() const { return m_materials; }
+        [[nodiscard]] std::span<const CookedMeshTextureRecord> TextureRecords() const { return m_textureRecords; }
+        [[nodiscard]] std::span<const uint8_t> TextureBytes(size_t textureIndex) const;
+
+    private:
+        [[nodiscard]] bool Parse(std::span<const uint8_t> bytes, std::string* outError);
+
+        MappedFile m_file;
+        const uint8_t* m_payload = nullptr;
+        std::span<const CookedMeshVertex> m_vertices;
+        std::span<const uint8_t> m_vertexBytes;
+        CookedVertexLayout m_vertexLayout {};
+        std::span<const CookedMeshPrimitiveDecode> m_primitiveDecode;
+        std::span<const uint32_t> m_indices;
+        std::span<const CookedMeshRecord> m_meshes;
+        std::span<const CookedMeshPrimitive> m_primitives;
+        std::span<const CookedMeshPrimitiveLods> m_primitiveLods;
+        std::span<const CookedMeshLod> m_lods;
+        std::span<const CookedMeshMaterial> m_materials;
+        std::span<const CookedMeshTextureRecord> m_textureRecords;
+    };
 }
 
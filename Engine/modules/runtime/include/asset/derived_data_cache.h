@@ -0,0 +1,170 @@
+#pragma once
+
+#include "asset/asset_types.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Cyber
+{
+    inline constexpr uint32_t kDerivedDataEntryMagic = MakeAssetFourCC('C', 'D', 'D', 'C');
+    inline constexpr uint32_t kDerivedDataEntryVersion = 1;
+
+    // DerivedDataKey::kind values; part of the key so two derivations of one asset never collide.
+    inline constexpr uint32_t kDerivedTextureMipChain = MakeAssetFourCC('T', 'M', 'I', 'P');
+    inline constexpr uint32_t kDerivedOptimizedMesh = MakeAssetFourCC('O', 'M', 'S', 'H');
+
+    // Everything a derived result depends on, following the DDC key in docs/asset-system-design.md.
+    // The importer version stands in for the cooker version.
+    struct DerivedDataKey
+    {
+        uint32_t kind = 0;
+        uint32_t platformTag = kAnyAssetPlatform;
+        AssetGuid assetGuid {};
+        uint64_t contentHash = 0;
+        uint64_t settingsHash = 0;
+        uint64_t dependencyHash = 0;
+        uint32_t cookerVersion = 0;
+
+        // XXH3-128 over the fields; names the entry in the store.
+        [[nodiscard]] CYBER_RUNTIME_API AssetHash128 Digest() const;
+    };
+
+    struct DerivedDataCacheSettings
+    {
+        std::filesystem::path localPath;
+        // Least recently used entries are evicted once the local store grows past this; 0 disables the cap.
+        uint64_t maxLocalBytes = uint64_t(4) << 30;
+        // Optional directory other machines also use, e.g. on a network share. Local misses are looked
+        // up there and copied into the local store; puts go to both unless writeShared is off.
+        std::filesystem::path sharedPath;
+        bool writeShared = true;
+    };
+
+    struct DerivedDataCacheStats
+    {
+        uint64_t localHits = 0;
+        uint64_t sharedHits = 0;
+        uint64_t misses = 0;
+        uint64_t puts = 0;
+        // Entries that failed the integrity check and were dropped
+        uint64_t corrupt = 0;
+        uint64_t evicted = 0;
+        uint64_t evictedBytes = 0;
+    };
+
+    // Content-addressed store of derived data. Entries live at <root>/<2 hex>/<32 hex>.ddc, are
+    // written to a temporary file and renamed into place, and carry the key digest and a payload
+    // hash that every read checks. A cache is safe to use from several threads, and several
+    // processes may share one directory.
+    class CYBER_RUNTIME_API DerivedDataCache
+    {
+    public:
+        // Creates the local store if needed and indexes its entries for eviction.
+        [[nodiscard]] bool Open(const DerivedDataCacheSettings& settings);
+
+        [[nodiscard]] bool Get(const DerivedDataKey& key, std::vector<uint8_t>& outData);
+        bool Put(const DerivedDataKey& key, std::span<const uint8_t> data);
+
+        // Evicts least recently used local entries until the store fits maxLocalBytes.
+        void Trim();
+
+        [[nodiscard]] uint64_t LocalSize() const;
+        [[nodiscard]] DerivedDataCacheStats Stats() const;
+        [[nodiscard]] const DerivedDataCacheSettings& Settings() const { return m_settings; }
+
+        [[nodiscard]] static std::filesystem::path EntryPath(const std::filesystem::path& root,
+                                                             const AssetHash128& digest);
+
+    private:
+        struct Entry
+        {
+            uint64_t size = 0;
+            int64_t lastUse = 0;
+        };
+
+        void Touch(const std::string& name, const std::filesystem::path& path, uint64_t size);
+        // Caller holds m_mutex
+        void TrimLocked();
+
+        DerivedDataCacheSettings m_settings;
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, Entry> m_entries;
+        uint64_t m_localSize = 0;
+        DerivedDataCacheStats m_stats;
+    };
+
+    // Flat serialization of trivially copyable values and arrays into a derived data payload.
+    class DerivedDataWriter
+    {
+    public:
+        template <typename T>
+        void Write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+            m_bytes.insert(m_bytes.end(), bytes, bytes + sizeof(T));
+        }
+
+        template <typename T>
+        void WriteArray(std::span<const T> values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            Write(static_cast<uint64_t>(values.size()));
+            const auto* bytes = reinterpret_cast<const uint8_t*>(values.data());
+            m_bytes.insert(m_bytes.end(), bytes, bytes + values.size_bytes());
+        }
+
+        [[nodiscard]] std::span<const uint8_t> Bytes() const { return m_bytes; }
+
+    private:
+        std::vector<uint8_t> m_bytes;
+    };
+
+    class DerivedDataReader
+    {
+    public:
+        explicit DerivedDataReader(std::span<const uint8_t> bytes)
+            : m_bytes(bytes)
+        {
+        }
+
+        template <typename T>
+        [[nodiscard]] bool Read(T& outValue)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            if (m_bytes.size() - m_offset < sizeof(T))
+                return false;
+            std::memcpy(&outValue, m_bytes.data() + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+            return true;
+        }
+
+        template <typename T>
+        [[nodiscard]] bool ReadArray(std::vector<T>& outValues)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            uint64_t count = 0;
+            if (!Read(count) || count > (m_bytes.size() - m_offset) / sizeof(T))
+                return false;
+            outValues.resize(static_cast<size_t>(count));
+            if (count != 0)
+                std::memcpy(outValues.data(), m_bytes.data() + m_offset, static_cast<size_t>(count) * sizeof(T));
+            m_offset += static_cast<size_t>(count) * sizeof(T);
+            return true;
+        }
+
+        [[nodiscard]] bool AtEnd() const { return m_offset == m_bytes.size(); }
+
+    private:
+        std::span<const uint8_t> m_bytes;
+        size_t m_offset = 0;
+    };
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+#if defined(_MSC_VER)
+    #if defined(CYBER_MAPPED_FILE_EXPORTS)
+        #define CYBER_MAPPED_FILE_API __declspec(dllexport)
+    #else
+        #define CYBER_MAPPED_FILE_API __declspec(dllimport)
+    #endif
+#else
+    #define CYBER_MAPPED_FILE_API
+#endif
+
+namespace Cyber
+{
+    // Read-only mapping of a whole file. The base address is page aligned, so data written at
+    // aligned file offsets can be read in place.
+    class CYBER_MAPPED_FILE_API MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        [[nodiscard]] bool Open(const std::filesystem::path& path);
+        void Close();
+
+        [[nodiscard]] bool IsOpen() const { return m_data != nullptr; }
+        [[nodiscard]] const uint8_t* Data() const { return m_data; }
+        [[nodiscard]] uint64_t Size() const { return m_size; }
+
+    private:
+        const uint8_t* m_data = nullptr;
+        uint64_t m_size = 0;
+#if defined(_WIN32)
+        void* m_fileHandle = nullptr;
+        void* m_mappingHandle = nullptr;
+#endif
+    };
+}
@@ -3,6 +3,7 @@
 #include "asset/asset_importer.h"
 #include "asset/cooked_mesh.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -11,9 +12,13 @@
 namespace Cyber
 {
     inline constexpr uint32_t kMeshAssetPayloadMagic = MakeAssetFourCC('C', 'M', 'E', 'S');
-    inline constexpr uint32_t kMeshAssetPayloadVersion = 2;
-    inline constexpr uint32_t kMeshImporterVersion = 2;
+    inline constexpr uint32_t kMeshAssetPayloadVersion = 5;
+    inline constexpr uint32_t kMeshImporterVersion = 5;
+    inline constexpr uint64_t kCookedMeshSectionAlignment = 16;
 
+    // v3 appends the optional embedded source section to the v2 header, v4 the vertex layout
+    // with its per-primitive decode section and v5 the LOD sections. Older payloads are read into
+    // their prefix and keep the float CookedMeshVertex layout, no embedded source and no LODs.
     struct MeshAssetPayloadHeader
     {
         uint32_t magic = kMeshAssetPayloadMagic;
@@ -34,8 +39,28 @@ namespace Cyber
         uint64_t textureCount = 0;
         uint64_t textureDataOffset = 0;
         uint64_t textureDataSize = 0;
+        uint64_t sourceDataOffset = 0;
+        uint64_t sourceDataSize = 0;
+        CookedVertexLayout vertexLayout {};
+        uint32_t reserved = 0;
+        uint64_t primitiveDecodeOffset = 0;
+        uint64_t primitiveDecodeCount = 0;
+        uint64_t primitiveLodsOffset = 0;
+        uint64_t primitiveLodsCount = 0;
+        uint64_t lodsOffset = 0;
+        uint64_t lodCount = 0;
     };
 
+    inline constexpr size_t kMeshAssetPayloadV2Size = 128;
+    inline constexpr size_t kMeshAssetPayloadV3Size = 144;
+    inline constexpr size_t kMeshAssetPayloadV4Size = 184;
+    static_assert(offsetof(MeshAssetPayloadHeader, sourceDataOffset) == kMeshAssetPayloadV2Size,
+                  "MeshAssetPayloadHeader v3 must extend the v2 layout.");
+    static_assert(offsetof(MeshAssetPayloadHeader, vertexLayout) == kMeshAssetPayloadV3Size,
+                  "MeshAssetPayloadHeader v4 must extend the v3 layout.");
+    static_assert(offsetof(MeshAssetPayloadHeader, primitiveLodsOffset) == kMeshAssetPayloadV4Size,
+                  "MeshAssetPayloadHeader v5 must extend the v4 layout.");
+
     struct MeshEditorAssetInfo
     {
         AssetFileHeader fileHeader {};
@@ -51,6 +76,7 @@ namespace Cyber
         [[nodiscard]] uint32_t Version() const override { return kMeshImporterVersion; }
         [[nodiscard]] bool Import(const AssetImportRequest& request,
                                   AssetImportResult& outResult) const override;
+        [[nodiscard]] uint64_t DependencyHash(const AssetImportRequest& request) const override;
 
         [[nodiscard]] static bool IsSupportedSourceExtension(std::string_view extension);
         [[nodiscard]] static bool ReadInfo(const std::filesystem::path& path,
@@ -58,15 +84,15 @@ namespace Cyber
         [[nodiscard]] static bool ReadCookedData(const std::filesystem::path& path,
                                                  CookedMeshData& outData,
                                                  std::string* outError = nullptr);
+        // Returns the source kept with the asset: the legacy v1 payload, the embedded section or
+        // the side-car file.
         [[nodiscard]] static bool ReadEmbeddedSource(const std::filesystem::path& path,
                                                      MeshEditorAssetInfo& outInfo,
                                                      std::vector<uint8_t>& outBytes);
         [[nodiscard]] static bool WriteEmbeddedSourceToCache(const std::filesystem::path& path,
                                                              const std::filesystem::path& cacheRoot,
                                                              std::filesystem::path& outPath);
-
-    private:
-        [[nodiscard]] static bool ReadFileBytes(const std::filesystem::path& path,
-                                                std::vector<uint8_t>& outBytes);
+        [[nodiscard]] static std::filesystem::path SideCarSourcePath(const std::filesystem::path& assetPath,
+                                                                     std::string_view sourceExtension);
     };
 }
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "asset/cooked_mesh.h"
+#include "cyber_runtime.config.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Cyber
+{
+    // ACMR is post-transform cache misses per triangle (0.5 is ideal for a regular grid, 3 is
+    // no reuse at all); ATVR is misses per unique vertex (1 is ideal). Both are measured with a
+    // FIFO cache of MeshOptimizationSettings::cacheSize entries, per primitive.
+    struct MeshOptimizationStats
+    {
+        uint32_t sourceVertexCount = 0;
+        uint32_t vertexCount = 0;
+        uint32_t triangleCount = 0;
+        float acmrBefore = 0.0f;
+        float acmrAfter = 0.0f;
+        float atvrBefore = 0.0f;
+        float atvrAfter = 0.0f;
+    };
+
+    struct MeshOptimizationSettings
+    {
+        uint32_t cacheSize = 16;
+        // Overdraw ordering may raise a cluster's ACMR by at most this factor.
+        float overdrawThreshold = 1.05f;
+    };
+
+    struct MeshLodSettings
+    {
+        // Levels generated per primitive beyond the source; 0 disables LODs. A chain ends early
+        // once simplification stalls or hits one of the limits below.
+        uint32_t lodCount = 3;
+        // Each level aims for this fraction of the previous level's triangles
+        float reductionRatio = 0.5f;
+        // Primitives smaller than this get no LODs, and no level goes below it
+        uint32_t minTriangleCount = 64;
+        // A level whose error exceeds this fraction of the primitive's bounds diagonal is dropped
+        float maxRelativeError = 0.1f;
+
+        [[nodiscard]] bool operator==(const MeshLodSettings&) const = default;
+    };
+
+    namespace MeshOptimizer
+    {
+        // Merges bitwise-identical vertices and rewrites the indices; returns the vertex count.
+        CYBER_RUNTIME_API uint32_t WeldVertices(CookedMeshData& data);
+
+        // Tipsify (Sander et al. 2007) over one primitive's triangle list. Indices may reference
+        // any vertex below vertexCount.
+        CYBER_RUNTIME_API void OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertexCount,
+                                                   uint32_t cacheSize = 16);
+
+        // Reorders cache-optimized triangles in clusters so outward-facing clusters draw first.
+        CYBER_RUNTIME_API void OptimizeOverdraw(std::span<uint32_t> indices,
+                                                std::span<const CookedMeshVertex> vertices,
+                                                uint32_t cacheSize = 16, float threshold = 1.05f);
+
+        // Renumbers vertices in first-use order of the index buffer and drops unreferenced ones.
+        CYBER_RUNTIME_API uint32_t OptimizeVertexFetch(CookedMeshData& data);
+
+        [[nodiscard]] CYBER_RUNTIME_API float AnalyzeACMR(std::span<const uint32_t> indices, uint32_t cacheSize = 16);
+        [[nodiscard]] CYBER_RUNTIME_API float AnalyzeATVR(std::span<const uint32_t> indices, uint32_t cacheSize = 16);
+
+        // Quadric error metric edge collapse (Garland and Heckbert 1997) of one triangle list.
+        // Collapses move a vertex onto a neighbour, so outIndices references the input vertices
+        // and no new ones. Vertices on open borders or UV and normal seams stay in place. Stops at
+        // targetIndexCount or when no collapse remains that keeps the surface from folding, and
+        // returns the RMS distance of the result from the source surface.
+        CYBER_RUNTIME_API float Simplify(std::span<const uint32_t> indices, std::span<const CookedMeshVertex> vertices,
+                                         size_t targetIndexCount, std::vector<uint32_t>& outIndices);
+
+        // Appends a chain of simplified index ranges for every triangle list primitive and fills
+        // data.primitiveLods and data.lods; each level continues simplifying the previous one
+        // and is ordered for the vertex cache. Returns the number of levels added.
+        CYBER_RUNTIME_API uint32_t GenerateLods(CookedMeshData& data, const MeshLodSettings& settings = {},
+                                                uint32_t cacheSize = 16);
+
+        // Weld, then vertex cache and overdraw order per primitive, then vertex fetch order.
+        // Primitive vertexCount becomes the number of distinct vertices the primitive references.
+        CYBER_RUNTIME_API MeshOptimizationStats Optimize(CookedMeshData& data,
+                                                         const MeshOptimizationSettings& settings = {});
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "cyber_runtime.config.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Cyber
+{
+    enum class TextureCookFormat : uint32_t
+    {
+        Unknown = 0,
+        RGBA8,
+        RGBA8_SRGB,
+        BC1,
+        BC1_SRGB,
+        BC3,
+        BC3_SRGB,
+        BC4,
+        BC5,
+        BC7,
+        BC7_SRGB,
+    };
+
+    namespace TextureCompression
+    {
+        // Bytes per 4x4 block for block-compressed formats, bytes per texel otherwise.
+        [[nodiscard]] CYBER_RUNTIME_API uint32_t BytesPerBlock(TextureCookFormat format);
+        [[nodiscard]] CYBER_RUNTIME_API bool IsBlockCompressed(TextureCookFormat format);
+        [[nodiscard]] CYBER_RUNTIME_API bool IsSRGB(TextureCookFormat format);
+        [[nodiscard]] CYBER_RUNTIME_API const char* ToString(TextureCookFormat format);
+
+        [[nodiscard]] CYBER_RUNTIME_API uint32_t RowPitch(TextureCookFormat format, uint32_t width);
+        [[nodiscard]] CYBER_RUNTIME_API uint32_t RowCount(TextureCookFormat format, uint32_t height);
+        [[nodiscard]] CYBER_RUNTIME_API uint64_t MipDataSize(TextureCookFormat format, uint32_t width, uint32_t height);
+
+        // Encodes a tightly packed RGBA8 image. Partial edge blocks replicate the last row/column.
+        // threadCount == 0 splits block rows across all hardware threads.
+        [[nodiscard]] CYBER_RUNTIME_API bool Encode(TextureCookFormat format,
+                                                    const uint8_t* rgba, uint32_t width, uint32_t height,
+                                                    std::vector<uint8_t>& outData,
+                                                    uint32_t threadCount = 0);
+
+        // Decodes back to tightly packed RGBA8. BC4 fills G/B from R, BC5 leaves B at 0.
+        [[nodiscard]] CYBER_RUNTIME_API bool Decode(TextureCookFormat format,
+                                                    const uint8_t* data, uint32_t width, uint32_t height,
+                                                    std::vector<uint8_t>& outRgba);
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "asset/asset_importer.h"
+#include "asset/texture_compression.h"
 
 #include <cstdint>
 #include <string>
@@ -10,9 +11,12 @@
 namespace Cyber
 {
     inline constexpr uint32_t kTextureAssetPayloadMagic = MakeAssetFourCC('C', 'T', 'E', 'X');
-    inline constexpr uint32_t kTextureAssetPayloadVersion = 1;
-    inline constexpr uint32_t kTextureImporterVersion = 1;
+    inline constexpr uint32_t kTextureAssetPayloadVersion = 2;
+    inline constexpr uint32_t kTextureImporterVersion = 3;
 
+    // v1 stored only the source bytes; v2 keeps that prefix (the old reserved field is the
+    // cooked format) and appends a mip table plus the encoded subresources. Importer v3 writes
+    // the subresources smallest mip first; readers go by the offsets and accept either order.
     struct TextureAssetPayloadHeader
     {
         uint32_t magic = kTextureAssetPayloadMagic;
@@ -20,9 +24,25 @@ namespace Cyber
         uint32_t width = 0;
         uint32_t height = 0;
         uint32_t sourceExtensionSize = 0;
-        uint32_t reserved = 0;
+        TextureCookFormat cookedFormat = TextureCookFormat::Unknown;
         uint64_t sourceDataOffset = 0;
         uint64_t sourceDataSize = 0;
+        TextureUsage usage = TextureUsage::Auto;
+        uint32_t mipCount = 0;
+        uint64_t mipsOffset = 0;
+        uint64_t cookedDataOffset = 0;
+        uint64_t cookedDataSize = 0;
+    };
+
+    // Offsets are relative to the payload; mip 0 is the full resolution image.
+    struct TextureAssetMipRecord
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t rowPitch = 0;
+        uint32_t rowCount = 0;
+        uint64_t dataOffset = 0;
+        uint64_t dataSize = 0;
     };
 
     struct TextureEditorAssetInfo
@@ -30,6 +50,23 @@ namespace Cyber
         AssetFileHeader fileHeader {};
         TextureAssetPayloadHeader payloadHeader {};
         std::string sourceExtension;
+        bool isCooked = false;
+    };
+
+    struct CookedTextureMip
+    {
+        TextureAssetMipRecord record {};
+        std::vector<uint8_t> bytes;
+    };
+
+    struct CookedTextureData
+    {
+        TextureCookFormat format = TextureCookFormat::Unknown;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        // Chain index of mips[0]; width and height are still those of mip 0
+        uint32_t firstMip = 0;
+        std::vector<CookedTextureMip> mips;
     };
 
     class CYBER_RUNTIME_API TextureImporter final : public IAssetImporter
@@ -39,10 +76,23 @@ namespace Cyber
         [[nodiscard]] uint32_t Version() const override { return kTextureImporterVersion; }
         [[nodiscard]] bool Import(const AssetImportRequest& request,
                                   AssetImportResult& outResult) const override;
+        [[nodiscard]] uint64_t DependencyHash(const AssetImportRequest& request) const override;
 
         [[nodiscard]] static bool IsSupportedSourceExtension(std::string_view extension);
         [[nodiscard]] static bool ReadInfo(const std::filesystem::path& path,
                                            TextureEditorAssetInfo& outInfo);
+        [[nodiscard]] static bool ReadCookedData(const std::filesystem::path& path,
+                                                 CookedTextureData& outData,
+                                                 std::string* outError = nullptr);
+        // Reads only mips [firstMip, mipCount), the part of the chain a streamer keeps resident.
+        [[nodiscard]] static bool ReadCookedMips(const std::filesystem::path& path,
+                                                 uint32_t firstMip,
+                                                 CookedTextureData& outData,
+                                                 std::string* outError = nullptr);
+
+        [[nodiscard]] static TextureUsage ResolveUsage(TextureUsage requested,
+                                                       const std::filesystem::path& sourcePath);
+        [[nodiscard]] static TextureCookFormat SelectCookFormat(TextureUsage usage, bool hasAlpha);
 
     private:
         [[nodiscard]] static bool ReadSourceBytes(const std::filesystem::path& path,
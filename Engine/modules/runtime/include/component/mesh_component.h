@@ -1,4 +1,5 @@
 #pragma once
+#include "asset/cooked_mesh.h"
 #include "component/primitive.h"
 #include "gameruntime/mesh.h"
 #include "common/smart_ptr.h"
@@ -17,11 +18,24 @@ namespace RenderObject
 
 CYBER_BEGIN_NAMESPACE(Component)
 
+    // A simplified index range of a draw primitive, sharing its vertices
+    struct MeshDrawLod
+    {
+        uint32_t first_index = 0;
+        uint32_t index_count = 0;
+        // Cooked deviation from full detail, in mesh units
+        float error = 0.0f;
+    };
+
     struct MeshDrawPrimitive
     {
         uint32_t first_index = 0;
         uint32_t index_count = 0;
         RefCntAutoPtr<RenderObject::ITexture_View> base_color_view = nullptr;
+        // TextureStreamer handle of base_color_view's texture; ~0u when it does not stream
+        uint32_t streamed_texture = ~0u;
+        // Coarser levels, finest first; empty draws full detail at every distance
+        eastl::vector<MeshDrawLod> lods;
     };
 
     class CYBER_RUNTIME_API MeshComponent : public Primitive
@@ -58,7 +72,12 @@ CYBER_BEGIN_NAMESPACE(Component)
         RefCntAutoPtr<RenderObject::IBuffer> vertex_buffer = nullptr;
         RefCntAutoPtr<RenderObject::IBuffer> index_buffer = nullptr;
         uint32_t                    vertex_stride = 0;
+        // Byte layout of vertex_buffer as cooked; the forward passes pick their pipelines by it
+        CookedVertexLayout          vertex_layout;
         eastl::vector<MeshDrawPrimitive> draw_primitives;
+        // One Renderer::ForwardPrimitiveDecode slot per draw_primitives entry, in the same order;
+        // null for float layouts, which draw with the identity decode
+        RefCntAutoPtr<RenderObject::IBuffer> primitive_decode = nullptr;
         uint32_t                    runtime_vertex_count = 0;
         uint32_t                    runtime_index_count = 0;
         float3                      runtime_bounds_min{0.0f, 0.0f, 0.0f};
@@ -341,6 +341,8 @@ namespace Cyber
             std::string m_texture_info_guid;
             uint64_t    m_texture_info_content_hash = 0;
             uint64_t    m_texture_info_payload_size = 0;
+            std::string m_texture_info_cooked_format;
+            uint32_t    m_texture_info_mip_count = 0;
 
             // Panel draw helpers
             std::filesystem::path resolve_content_browser_root() const;
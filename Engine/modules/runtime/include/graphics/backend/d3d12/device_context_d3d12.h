@@ -68,7 +68,7 @@ public:
     virtual void set_shader_resource_view(SHADER_STAGE stage, uint32_t binding, ITexture_View* textureView) override;
     virtual void set_constant_buffer_view(SHADER_STAGE stage, uint32_t binding, IBuffer* buffer) override;
     virtual void set_unordered_access_view(SHADER_STAGE stage, uint32_t binding, IBuffer* buffer) override;
-    virtual void set_root_constant_buffer_view(SHADER_STAGE stage, uint32_t binding, IBuffer* buffer) override;
+    virtual void set_root_constant_buffer_view(SHADER_STAGE stage, uint32_t binding, IBuffer* buffer, uint64_t offset = 0) override;
 
     void set_srv_table(SHADER_STAGE stage, RootSignature_D3D12_Impl* rs, ShaderResourceViewCache& srv_cache, uint32_t slots_need, const D3D12_GPU_DESCRIPTOR_HANDLE& bind_descriptor);
     void set_cbv_table(SHADER_STAGE stage, RootSignature_D3D12_Impl* rs, ConstantBufferViewCache& cbv_cache, uint32_t slots_need, const D3D12_GPU_DESCRIPTOR_HANDLE& bind_descriptor);
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "EASTL/map.h"
+#include "EASTL/utility.h"
+#include "EASTL/vector.h"
+#include "asset/cooked_mesh.h"
 #include "common/smart_ptr.h"
 #include "cyber_runtime.config.h"
+#include "graphics/features/frustum_culling.h"
 #include "graphics/rendergraph/render_graph_resource.h"
 #include "math/basic_math.hpp"
 
@@ -10,6 +14,12 @@ namespace Cyber
 {
     class World;
 
+    namespace Component
+    {
+        class MeshComponent;
+        struct MeshDrawPrimitive;
+    }
+
     namespace RenderObject
     {
         struct IBuffer;
@@ -20,6 +30,7 @@ namespace Cyber
         struct IRenderPipeline;
         struct ISampler;
         struct ITexture;
+        struct VertexAttribute;
     }
 
     namespace Renderer
@@ -30,11 +41,12 @@ namespace Cyber
         {
         public:
             void initialize(RenderObject::IRenderDevice* device);
-            RenderObject::IRenderPipeline* get_depth_only(TEXTURE_FORMAT depth_format);
+            // One pipeline per depth format and cooked vertex layout, built on first use
+            RenderObject::IRenderPipeline* get_depth_only(TEXTURE_FORMAT depth_format, const CookedVertexLayout& layout);
 
         private:
             RenderObject::IRenderDevice* device = nullptr;
-            eastl::map<TEXTURE_FORMAT, RefCntAutoPtr<RenderObject::IRenderPipeline>> depth_pipelines;
+            eastl::map<eastl::pair<TEXTURE_FORMAT, uint64_t>, RefCntAutoPtr<RenderObject::IRenderPipeline>> depth_pipelines;
         };
 
         struct CYBER_RUNTIME_API ForwardFrameContext
@@ -51,21 +63,82 @@ namespace Cyber
             Renderer* renderer = nullptr;
             RenderObject::IRenderDevice* device = nullptr;
             RenderObject::IDeviceContext* command_context = nullptr;
-            RenderObject::IBuffer* scene_constants = nullptr;
+            RenderObject::IBuffer* pass_constants = nullptr;
+            // Drawable meshes gathered once per frame. Object constant slot i (uploaded with a single
+            // map, bound per draw by offset) and world-space culling box i belong to draw_list[i].
+            RenderObject::IBuffer* object_constants = nullptr;
+            // b2 for meshes without per-primitive decode constants: a single ForwardPrimitiveDecode{}
+            RenderObject::IBuffer* identity_decode = nullptr;
+            eastl::vector<Component::MeshComponent*> draw_list;
+            CullingBoxes draw_bounds;
+            // Indices into draw_list that survive the current pass's frustum; passes record serially
+            eastl::vector<uint32_t> visible_objects;
+            // Per draw_list entry: screen pixels one mesh unit of LOD error covers as seen from the
+            // camera. Every pass draws the same level, so depth prepass and color stay in step.
+            eastl::vector<float> lod_pixels_per_unit;
+            // Each primitive draws its coarsest level whose error stays within this many pixels;
+            // 0 or less always draws full detail
+            float lod_max_pixel_error = 1.0f;
             ForwardPassPipelineCache* pipeline_cache = nullptr;
             uint32_t shadow_resolution = 2048;
             ForwardFrameContext frame;
         };
 
-        struct ForwardSceneConstants
+        // b0: written once per pass
+        struct ForwardPassConstants
         {
             float4x4 view_proj_matrix;
-            float4x4 model_matrix;
             float4 camera_pos;
             float4 light_direction;
             float4 light_color;
         };
 
+        // b1: one slot per drawable mesh; slots are root constant buffer aligned
+        struct ForwardObjectConstants
+        {
+            float4x4 model_matrix;
+        };
+
+        constexpr uint32_t kForwardObjectConstantsStride = 256;
+        static_assert(sizeof(ForwardObjectConstants) <= kForwardObjectConstantsStride, "Object constants overflow their slot");
+
+        // b2: one slot per draw primitive, dequantizing compact cooked vertices in the vertex shader
+        // (shaders/DX12/cooked_vertex.hlsli). The defaults leave float vertices unchanged.
+        struct ForwardPrimitiveDecode
+        {
+            float4 position_offset = float4(0.0f, 0.0f, 0.0f, 0.0f);
+            float4 position_scale = float4(1.0f, 1.0f, 1.0f, 1.0f);
+            // xy offset, zw scale
+            float4 uv_offset_scale = float4(0.0f, 0.0f, 1.0f, 1.0f);
+            uint32_t octahedral_normal = 0;
+            uint32_t padding[3] = {};
+        };
+
+        constexpr uint32_t kForwardPrimitiveDecodeStride = 256;
+        static_assert(sizeof(ForwardPrimitiveDecode) <= kForwardPrimitiveDecodeStride, "Primitive decode overflows its slot");
+
+        // Input layout of a cooked vertex buffer: ATTRIB0 position, ATTRIB1 normal, ATTRIB2 uv0.
+        // The forward shaders do not read the tangent.
+        CYBER_RUNTIME_API void make_cooked_input_layout(const CookedVertexLayout& layout,
+                                                        RenderObject::VertexAttribute (&out_attributes)[3]);
+        // Shader constants for one primitive; only the attributes the layout stores relative to the
+        // primitive take their range from decode
+        CYBER_RUNTIME_API ForwardPrimitiveDecode make_forward_primitive_decode(const CookedVertexLayout& layout,
+                                                                               const CookedMeshPrimitiveDecode& decode);
+
+        // Meshes the forward passes draw; the object constant upload and every pass visit the same set
+        CYBER_RUNTIME_API bool is_forward_drawable(const Component::MeshComponent& mesh);
+
+        // Screen pixels one mesh unit covers at the near side of a world box's bounding sphere under
+        // a perspective projection with the given y scale; world_scale is the model matrix's largest
+        // axis scale. Infinite when the eye is inside the sphere.
+        CYBER_RUNTIME_API float lod_pixels_per_unit(const float3& center, const float3& extent, const float3& eye,
+                                                    float proj_y_scale, float viewport_height, float world_scale);
+        // 0 for full detail, otherwise 1 + the index of the coarsest level in primitive.lods whose
+        // projected error is within max_pixel_error
+        CYBER_RUNTIME_API uint32_t select_mesh_lod(const Component::MeshDrawPrimitive& primitive,
+                                                   float pixels_per_unit, float max_pixel_error);
+
         class CYBER_RUNTIME_API ForwardRenderPass : public render_graph::RGRenderPass
         {
         public:
@@ -73,11 +146,19 @@ namespace Cyber
 
         protected:
             void set_default_viewport(uint32_t width, uint32_t height) const;
-            void update_scene_constants(const ForwardSceneConstants& constants) const;
-            void draw_depth_only(const float4x4& view_proj, RenderObject::IRenderPipeline* pipeline) const;
+            void update_pass_constants(const ForwardPassConstants& constants) const;
+            void bind_object_constants(uint32_t object_index) const;
+            void bind_mesh_decode(const Component::MeshComponent& mesh) const;
+            // Pipeline drawing meshes with the given vertex layout; null skips them
+            virtual RenderObject::IRenderPipeline* get_pipeline(const CookedVertexLayout& layout) = 0;
+            // Binds the primitive's decode constants and draws its level chosen for this frame
+            void draw_primitive(uint32_t object_index, const Component::MeshComponent& mesh, uint32_t primitive_index) const;
+            // Shadow casters are culled by the side planes only; they cast from outside the depth range
+            uint32_t cull_draw_list(const float4x4& view_proj, bool shadow_casters) const;
+            void draw_depth_only(const float4x4& view_proj, bool shadow_casters = false);
             void draw_color(const float4x4& view_proj, const float3& eye,
                 const float3& light_dir, const float3& light_color, float light_intensity,
-                RenderObject::IRenderPipeline* pipeline, RenderObject::ITexture* fallback_texture) const;
+                RenderObject::ITexture* fallback_texture);
 
             bool find_scene_view(float4x4& view_proj, float3& eye) const;
             bool find_main_light(float3& light_dir, float3& light_color, float& intensity) const;
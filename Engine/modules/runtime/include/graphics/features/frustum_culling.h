@@ -0,0 +1,55 @@
+#pragma once
+
+#include "EASTL/vector.h"
+#include "cyber_runtime.config.h"
+#include "math/basic_math.hpp"
+
+namespace Cyber::Renderer
+{
+    // Inward-facing planes (xyz normal, w distance) of a row-vector view-projection with D3D clip
+    // depth; a point p is inside when dot(p, plane.xyz) + plane.w >= 0 for every plane. Planes are
+    // not normalized, which does not change the sign of the box tests.
+    struct CYBER_RUNTIME_API CullingFrustum
+    {
+        // Left, right, bottom, top, then near and far when the depth range is tested
+        float4 planes[6];
+        uint32_t plane_count = 0;
+
+        // Shadow casters must skip the depth planes: geometry in front of the light's near plane
+        // still casts into the map.
+        static CullingFrustum from_view_projection(const float4x4& view_proj, bool test_depth_range = true);
+    };
+
+    // World-space boxes as centers and half extents, in structure-of-arrays form padded to the widest
+    // SIMD batch so the tests never need a scalar tail.
+    class CYBER_RUNTIME_API CullingBoxes
+    {
+    public:
+        static constexpr uint32_t kBatchWidth = 8;
+
+        void clear();
+        void reserve(uint32_t count);
+        // Transforms a local AABB by an affine row-vector matrix and returns the box index
+        uint32_t add_local_box(const float3& local_min, const float3& local_max, const float4x4& world);
+        uint32_t add_world_box(const float3& center, const float3& extent);
+        // A box no plane rejects, for objects without bounds
+        uint32_t add_unbounded();
+
+        uint32_t size() const { return count; }
+        // Entries a visible-index buffer must hold
+        uint32_t padded_size() const { return static_cast<uint32_t>(center_x.size()); }
+
+        eastl::vector<float> center_x, center_y, center_z;
+        eastl::vector<float> extent_x, extent_y, extent_z;
+
+    private:
+        uint32_t count = 0;
+    };
+
+    // Writes the ascending indices of the boxes that intersect the frustum into visible, which must
+    // hold boxes.padded_size() entries, and returns how many there are. Tests eight boxes at a time
+    // with AVX when the build enables it, four with SSE2 otherwise, and one at a time off x86.
+    CYBER_RUNTIME_API uint32_t cull_boxes(const CullingFrustum& frustum, const CullingBoxes& boxes, uint32_t* visible);
+    // One box at a time; the reference the SIMD paths must match
+    CYBER_RUNTIME_API uint32_t cull_boxes_scalar(const CullingFrustum& frustum, const CullingBoxes& boxes, uint32_t* visible);
+}
@@ -18,12 +18,13 @@ namespace Cyber::Renderer
         void setup(render_graph::RenderGraphBuilder& builder) override;
         void execute(render_graph::RenderGraph& graph, render_graph::RenderPassContext& context) override;
 
+    protected:
+        RenderObject::IRenderPipeline* get_pipeline(const CookedVertexLayout& layout) override;
+
     private:
-        void create_pipeline();
         void create_render_pass();
 
         Resources resources;
-        RefCntAutoPtr<RenderObject::IRenderPipeline> pipeline;
         RefCntAutoPtr<RenderObject::IRenderPass> render_pass;
     };
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "EASTL/map.h"
 #include "common/smart_ptr.h"
 #include "graphics/features/forward_pass.h"
 
@@ -20,13 +21,16 @@ namespace Cyber::Renderer
         void setup(render_graph::RenderGraphBuilder& builder) override;
         void execute(render_graph::RenderGraph& graph, render_graph::RenderPassContext& context) override;
 
+    protected:
+        RenderObject::IRenderPipeline* get_pipeline(const CookedVertexLayout& layout) override;
+
     private:
         void create_resources();
-        void create_pipeline();
         void create_render_pass();
 
         Resources resources;
-        RefCntAutoPtr<RenderObject::IRenderPipeline> pipeline;
+        // Keyed by CookedVertexLayout::Key()
+        eastl::map<uint64_t, RefCntAutoPtr<RenderObject::IRenderPipeline>> pipelines;
         RefCntAutoPtr<RenderObject::IRenderPass> render_pass;
         RefCntAutoPtr<RenderObject::ISampler> sampler;
         RefCntAutoPtr<RenderObject::ITexture> white_texture;
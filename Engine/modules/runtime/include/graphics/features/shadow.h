@@ -18,13 +18,14 @@ namespace Cyber::Renderer
         void setup(render_graph::RenderGraphBuilder& builder) override;
         void execute(render_graph::RenderGraph& graph, render_graph::RenderPassContext& context) override;
 
+    protected:
+        RenderObject::IRenderPipeline* get_pipeline(const CookedVertexLayout& layout) override;
+
     private:
-        void create_pipeline();
         void create_render_pass();
         void create_frame_buffer();
 
         Resources resources;
-        RefCntAutoPtr<RenderObject::IRenderPipeline> pipeline;
         RefCntAutoPtr<RenderObject::IRenderPass> render_pass;
         RefCntAutoPtr<RenderObject::IFrameBuffer> frame_buffer;
     };
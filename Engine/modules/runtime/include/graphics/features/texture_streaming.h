@@ -0,0 +1,132 @@
+#pragma once
+
+#include "EASTL/vector.h"
+#include "cyber_runtime.config.h"
+#include "math/basic_math.hpp"
+
+namespace Cyber::Renderer
+{
+    using StreamedTextureHandle = uint32_t;
+    constexpr StreamedTextureHandle kInvalidStreamedTexture = ~0u;
+
+    // Moves mip data in and out of memory for the streamer. A texture with first resident mip m
+    // holds mips [m, mip_count); mip_count means nothing is resident.
+    class CYBER_RUNTIME_API ITextureStreamingBackend
+    {
+    public:
+        virtual ~ITextureStreamingBackend() = default;
+
+        // Makes exactly mips [first_mip, mip_count) of the texture resident. Dropping mips must
+        // always succeed; a load may fail (data not read yet, allocation failure) and is retried
+        // on a later update.
+        virtual bool set_resident_mips(StreamedTextureHandle texture, uint32_t first_mip) = 0;
+        // The texture was unregistered; free everything it holds
+        virtual void release(StreamedTextureHandle texture) = 0;
+    };
+
+    struct StreamedTextureDesc
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        // Resident size of each mip, mip 0 first; its length is the mip count
+        eastl::vector<uint64_t> mip_bytes;
+    };
+
+    struct TextureStreamingSettings
+    {
+        uint64_t budget_bytes = 256ull << 20;
+        // Mips no larger than this on either side form the tail, which is loaded on registration
+        // and never evicted. Tails count against the budget but are not limited by it.
+        uint32_t tail_size = 64;
+        // Loads per update stop once this many bytes went in, except that one mip always may;
+        // 0 means no limit
+        uint64_t max_upload_bytes_per_update = 32ull << 20;
+        // Added to every desired mip; positive values trade sharpness for memory
+        float mip_bias = 0.0f;
+    };
+
+    struct TextureStreamingStats
+    {
+        uint32_t textures = 0;
+        // Textures requested since the previous update
+        uint32_t requested = 0;
+        uint64_t resident_bytes = 0;
+        // What residency would cost if every request were met
+        uint64_t wanted_bytes = 0;
+        uint64_t uploaded_bytes = 0;
+        uint64_t evicted_bytes = 0;
+        // Requested textures left coarser than wanted because the budget ran out
+        uint32_t over_budget = 0;
+        // Mips that fit the budget but wait for a later update's upload allowance
+        uint32_t deferred_uploads = 0;
+    };
+
+    // Decides which mips of every registered texture stay in memory. Each frame the renderer
+    // reports how large each texture appears on screen; update() then works out the mip each
+    // one wants and fits the wanted mips into the budget coarsest-relative-to-want first, so no
+    // texture sharpens while another is blurrier than it should be. Budget left over keeps mips
+    // that are no longer wanted, most recently used first, and the rest are evicted. Only the
+    // bookkeeping lives here; the backend owns the data, which keeps the policy testable
+    // without a GPU. Not thread safe.
+    class CYBER_RUNTIME_API TextureStreamer
+    {
+    public:
+        explicit TextureStreamer(ITextureStreamingBackend& in_backend, TextureStreamingSettings in_settings = {});
+
+        StreamedTextureHandle register_texture(const StreamedTextureDesc& desc);
+        void unregister_texture(StreamedTextureHandle texture);
+
+        // screen_pixels is the largest on-screen extent the texture covers; several requests for
+        // one texture in a frame keep the largest
+        void request(StreamedTextureHandle texture, float screen_pixels);
+        // Ends the frame: rebalances residency for this frame's requests and clears them
+        void update();
+
+        void set_budget(uint64_t budget_bytes) { settings.budget_bytes = budget_bytes; }
+        const TextureStreamingSettings& get_settings() const { return settings; }
+
+        uint32_t get_resident_mip(StreamedTextureHandle texture) const;
+        // The mip the last update wanted, before the budget was applied
+        uint32_t get_wanted_mip(StreamedTextureHandle texture) const;
+        uint32_t get_tail_mip(StreamedTextureHandle texture) const;
+        uint64_t get_resident_bytes() const { return resident_bytes; }
+        const TextureStreamingStats& get_stats() const { return stats; }
+
+    private:
+        struct StreamedTexture
+        {
+            StreamedTextureDesc desc;
+            uint32_t mip_count = 0;
+            uint32_t tail_mip = 0;
+            uint32_t resident_mip = 0;
+            uint32_t wanted_mip = 0;
+            float screen_pixels = 0.0f;
+            uint64_t last_used_frame = 0;
+            bool requested = false;
+            bool live = false;
+        };
+
+        // Bytes of mips [first_mip, mip_count)
+        static uint64_t bytes_from(const StreamedTexture& texture, uint32_t first_mip);
+        void load_tail(StreamedTextureHandle handle);
+
+        ITextureStreamingBackend& backend;
+        TextureStreamingSettings settings;
+        eastl::vector<StreamedTexture> textures;
+        eastl::vector<StreamedTextureHandle> free_handles;
+        uint64_t resident_bytes = 0;
+        uint64_t frame_index = 1;
+        TextureStreamingStats stats;
+    };
+
+    // Mip whose resolution best matches screen_pixels texels across the texture's larger side,
+    // plus the bias, clamped to the chain. Textures not visible (0 pixels) want the last mip.
+    CYBER_RUNTIME_API uint32_t compute_wanted_mip(uint32_t width, uint32_t height, uint32_t mip_count,
+                                                  float screen_pixels, float mip_bias = 0.0f);
+
+    // Approximate on-screen diameter in pixels of a world box's bounding sphere under a perspective
+    // projection with the given y scale (1 / tan(fov_y / 2)). A camera inside the sphere gets the
+    // whole viewport height.
+    CYBER_RUNTIME_API float projected_screen_pixels(const float3& center, const float3& extent, const float3& eye,
+                                                    float proj_y_scale, float viewport_height);
+}
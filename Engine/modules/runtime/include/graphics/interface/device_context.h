@@ -126,7 +126,8 @@ namespace Cyber
             virtual void set_shader_resource_view(SHADER_STAGE stage, uint32_t binding, ITexture_View* textureView) = 0;
             virtual void set_constant_buffer_view(SHADER_STAGE stage, uint32_t binding, IBuffer* buffer) = 0;
             virtual void set_unordered_access_view(SHADER_STAGE stage, uint32_t binding, IBuffer* buffer) = 0;
-            virtual void set_root_constant_buffer_view(SHADER_STAGE stage, uint32_t binding, IBuffer* buffer) = 0;
+            // offset selects a 256-byte aligned slot within the buffer's current contents
+            virtual void set_root_constant_buffer_view(SHADER_STAGE stage, uint32_t binding, IBuffer* buffer, uint64_t offset = 0) = 0;
             
             virtual void prepare_for_rendering() = 0;
 
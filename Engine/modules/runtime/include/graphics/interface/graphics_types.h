@@ -1494,13 +1494,13 @@ namespace Cyber
     {
         TextureBarrier()
             : texture(nullptr), src_state(GRAPHICS_RESOURCE_STATE_UNKNOWN), dst_state(GRAPHICS_RESOURCE_STATE_UNKNOWN), queue_acquire(0), queue_release(0), subresource_barrier(0)
-            , mip_level(0), array_layer(0), d3d12{0, 0}
+            , mip_level(0), array_layer(0), record_only(0), d3d12{0, 0}
         {
         }
 
         TextureBarrier(RenderObject::ITexture* in_texture, GRAPHICS_RESOURCE_STATE from, GRAPHICS_RESOURCE_STATE to)
             : texture(in_texture), src_state(from), dst_state(to), queue_acquire(0), queue_release(0), subresource_barrier(0)
-            , mip_level(0), array_layer(0), d3d12{0, 0}
+            , mip_level(0), array_layer(0), record_only(0), d3d12{0, 0}
         {
         }
 
@@ -1515,6 +1515,9 @@ namespace Cyber
         /// Following values are ignored if subresource_barrier is false
         uint8_t mip_level : 7;
         uint16_t array_layer;
+        /// Record the barrier without reading or updating the texture's tracked state; src_state must be explicit.
+        /// Set when recording on a worker thread, whose owner writes the tracked state back after submission
+        uint8_t record_only : 1;
         struct {
             uint8_t begin_only : 1;
             uint8_t end_only : 1;
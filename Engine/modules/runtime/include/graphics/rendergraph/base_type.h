@@ -4,6 +4,13 @@
 
 namespace Cyber
 {
+    namespace RenderObject
+    {
+        struct IDeviceContext;
+        struct ICommandQueue;
+        struct IFence;
+    }
+
     namespace render_graph
     {
         class RenderGraph;
@@ -28,6 +35,13 @@ namespace Cyber
 
         } ERGObjectType;
 
+        enum class ERGQueue : uint8_t
+        {
+            Graphics = 0,
+            AsyncCompute = 1,
+            Count
+        };
+
         enum class ERGResourceAccess : uint8_t
         {
             Read = 1,
@@ -39,26 +53,37 @@ namespace Cyber
         {
             RGRenderResource* resource = nullptr;
             ERGResourceAccess access = ERGResourceAccess::Read;
+            // State the resource must be in while the pass runs; barriers are derived from it.
+            GRAPHICS_RESOURCE_STATE state = GRAPHICS_RESOURCE_STATE_UNKNOWN;
         };
 
-        struct Utf8StringLess
+        // Interned resource name: a 64-bit FNV-1a hash of the UTF-8 string, computed at compile time when
+        // the handle is a constexpr constant. Lookups compare hashes only; the graph asserts on collisions
+        // when resources are created. The string must outlive the graph, as with plain names.
+        struct RGResourceName
         {
-            bool operator()(const char8_t* lhs, const char8_t* rhs) const CYBER_NOEXCEPT
+            static constexpr uint64_t kOffsetBasis = 14695981039346656037ull;
+            static constexpr uint64_t kPrime = 1099511628211ull;
+
+            constexpr RGResourceName() = default;
+            constexpr RGResourceName(const char8_t* str) CYBER_NOEXCEPT : name(str), hash(hash_string(str)) {}
+
+            static constexpr uint64_t hash_string(const char8_t* str) CYBER_NOEXCEPT
             {
-                if (lhs == rhs)
-                    return false;
-                if (!lhs)
-                    return rhs != nullptr;
-                if (!rhs)
-                    return false;
-
-                while (*lhs != 0 && *rhs != 0 && *lhs == *rhs)
+                uint64_t value = kOffsetBasis;
+                for (; str && *str; ++str)
                 {
-                    ++lhs;
-                    ++rhs;
+                    value ^= static_cast<uint8_t>(*str);
+                    value *= kPrime;
                 }
-                return *lhs < *rhs;
+                return value;
             }
+
+            constexpr bool operator==(const RGResourceName& other) const CYBER_NOEXCEPT { return hash == other.hash; }
+            constexpr bool operator!=(const RGResourceName& other) const CYBER_NOEXCEPT { return hash != other.hash; }
+
+            const char8_t* name = nullptr;
+            uint64_t hash = 0;
         };
 
         struct RenderGraphNode
@@ -89,7 +114,33 @@ namespace Cyber
             RGPass* pass_handle;
             PassDestroyFunction destroy_pass;
             eastl::vector<PassResourceAccess> resource_accesses;
+            // Hazard edges to earlier passes (RAW, WAW, WAR) and their reverse. Only a full compile
+            // builds them; they stay empty when compile reuses a cached plan.
             eastl::vector<PassNode*> dependencies;
+            eastl::vector<PassNode*> dependents;
+            // Passes whose writes this pass reads; the data edges culling walks backwards.
+            eastl::vector<PassNode*> producers;
+            // Live consumers of this pass's output: reading passes plus one per graph output it
+            // writes last. A pass that reaches zero is culled.
+            uint32_t ref_count = 0;
+            bool culled = false;
+            // Slot in RenderGraph::passes, refreshed by compile.
+            uint32_t pass_index = UINT32_MAX;
+            // Index of the last pass that linked to this one, so repeated accesses add one edge.
+            uint32_t link_stamp = UINT32_MAX;
+            uint32_t pending_dependencies = 0;
+            // Queue the pass is submitted on, assigned by compile
+            ERGQueue queue = ERGQueue::Graphics;
+        };
+
+        struct RenderGraphAsyncComputeDesc
+        {
+            RenderObject::IDeviceContext* compute_context = nullptr;
+            RenderObject::ICommandQueue* graphics_queue = nullptr;
+            RenderObject::ICommandQueue* compute_queue = nullptr;
+            // One fence per queue, each signaled only by its own queue so its values stay monotonic
+            RenderObject::IFence* graphics_fence = nullptr;
+            RenderObject::IFence* compute_fence = nullptr;
         };
 
         struct RenderPassContext
@@ -97,6 +148,9 @@ namespace Cyber
             RenderGraph* graph = nullptr;
             RGPass* pass = nullptr;
             RenderPassEncoder* encoder = nullptr;
+            // Context the pass records into: the graph's context, or a deferred context when its
+            // record group runs on a worker thread.
+            RenderObject::IDeviceContext* device_context = nullptr;
             uint32_t frame_index = 0;
         };
     }
@@ -3,12 +3,16 @@
 #include "render_graph_flag.h"
 #include "base_type.h"
 #include "render_graph_phase.h"
+#include "render_graph_allocator.h"
 #include "platform/configure.h"
 #include "cyber_runtime.config.h"
 #include "eastl/functional.h"
 #include "eastl/map.h"
 #include "eastl/vector.h"
 #include "graphics/interface/graphics_types.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #ifndef RG_MAX_FRAME_IN_FLIGHT
 #define RG_MAX_FRAME_IN_FLIGHT 3
@@ -22,6 +26,7 @@ namespace Cyber
         struct ICommandPool;
         class IQueue;
         struct IRenderDevice;
+        struct IDeviceContext;
     }
     namespace render_graph
     {
@@ -36,6 +41,78 @@ namespace Cyber
             RenderObject::ICommandBuffer* gfx_cmd_buffer = nullptr;
         };
 
+        struct RenderGraphBarrier
+        {
+            class RGRenderResource* resource = nullptr;
+            GRAPHICS_RESOURCE_STATE src_state = GRAPHICS_RESOURCE_STATE_UNKNOWN;
+            GRAPHICS_RESOURCE_STATE dst_state = GRAPHICS_RESOURCE_STATE_UNKNOWN;
+            // Split barrier halves; a transition with neither flag set is a full barrier.
+            bool begin_only = false;
+            bool end_only = false;
+            // Execution index of the access the transition leaves; UINT32_MAX for a first use
+            uint32_t previous_pass = UINT32_MAX;
+        };
+
+        // A contiguous range of the execution order recorded into one deferred context. Barriers are
+        // planned at compile time, so ranges record independently; submission restores their order.
+        struct RenderGraphRecordGroup
+        {
+            uint32_t first_pass = 0;
+            uint32_t pass_count = 0;
+        };
+
+        // Transitions issued together, in one cmd_resource_barrier call, before a pass runs
+        struct RenderGraphBarrierBatch
+        {
+            eastl::vector<RenderGraphBarrier> barriers;
+        };
+
+        // Cross-queue work before a pass, in order: the graphics queue catches up with async compute,
+        // records the transitions a compute queue cannot, then the pass's queue waits on the other one.
+        struct RenderGraphQueueSync
+        {
+            bool graphics_waits_compute = false;
+            RenderGraphBarrierBatch graphics_barriers;
+            bool waits_other_queue = false;
+        };
+
+        struct RenderGraphResourceLifetime
+        {
+            const char8_t* name = nullptr;
+            class ResourceNode* node = nullptr;
+            // Inclusive execution order indices; UINT32_MAX when no surviving pass touches it.
+            uint32_t first_pass = UINT32_MAX;
+            uint32_t last_pass = UINT32_MAX;
+            uint32_t reader_count = 0;
+            uint32_t heap_index = UINT32_MAX;
+            uint64_t heap_offset = 0;
+            uint64_t size = 0;
+            bool imported = false;
+            bool output = false;
+            bool culled = false;
+        };
+
+        struct RenderGraphCompileReport
+        {
+            eastl::vector<const char8_t*> executed_passes;
+            eastl::vector<const char8_t*> culled_passes;
+            eastl::vector<RenderGraphResourceLifetime> resources;
+            eastl::vector<RenderGraphTransientHeap> transient_heaps;
+            // Bytes the transient heaps need after aliasing, against one allocation per resource
+            uint64_t aliased_transient_size = 0;
+            uint64_t unaliased_transient_size = 0;
+            uint32_t barrier_count = 0;
+            uint32_t barrier_batch_count = 0;
+            // Accesses that found the resource already in a compatible read state
+            uint32_t elided_transition_count = 0;
+            // The structure matched the previous compile, so its schedule, barriers and placement were kept
+            bool reused_cached_plan = false;
+            uint32_t record_group_count = 0;
+            // Cross-queue waits planned for one frame, including the end-of-frame join
+            uint32_t queue_wait_count = 0;
+            uint32_t async_compute_pass_count = 0;
+        };
+
         class CYBER_RUNTIME_API RenderGraph
         {
         public:
@@ -51,22 +128,106 @@ namespace Cyber
             void reset_passes();
             void compile();
             void execute();
-            void execute_pass(class RGPass* pass, uint32_t frame_index = 0);
+            void execute_pass(class RGPass* pass, uint32_t frame_index = 0, RenderObject::IDeviceContext* context = nullptr);
             template<typename Phase>
             void add_custom_phase();
             void invalidate() CYBER_NOEXCEPT { compiled = false; }
+            CYBER_FORCE_INLINE const RenderGraphCompileReport& get_compile_report() const CYBER_NOEXCEPT { return compile_report; }
+            CYBER_FORCE_INLINE const eastl::vector<class PassNode*>& get_execution_order() const CYBER_NOEXCEPT { return execution_order; }
+            // Parallel to the execution order: the batch recorded before each pass
+            CYBER_FORCE_INLINE const eastl::vector<RenderGraphBarrierBatch>& get_barrier_batches() const CYBER_NOEXCEPT { return barrier_batches; }
+            // Begin transitions right after a resource's last access and end them just before its next
+            // one. Only valid when passes leave graph resources in the states they declared.
+            void set_split_barriers(bool enable) CYBER_NOEXCEPT { if (split_barriers != enable) { split_barriers = enable; compiled = false; } }
+            CYBER_FORCE_INLINE const eastl::vector<RenderGraphRecordGroup>& get_record_groups() const CYBER_NOEXCEPT { return record_groups; }
+            // Parallel to the execution order; empty unless async compute passes were scheduled
+            CYBER_FORCE_INLINE const eastl::vector<RenderGraphQueueSync>& get_queue_syncs() const CYBER_NOEXCEPT { return queue_syncs; }
+            // Parallel recording splits the execution order into at most one group per deferred context,
+            // each at least this many passes long. Passes must record through RenderPassContext::device_context
+            // and leave graph resources in their declared states, as with split barriers.
+            void set_min_passes_per_record_group(uint32_t count) CYBER_NOEXCEPT { if (min_passes_per_record_group != count) { min_passes_per_record_group = count; compiled = false; } }
+            // Hash of everything compile depends on; equal hashes across frames mean the cached plan is reused.
+            CYBER_FORCE_INLINE uint64_t get_structure_hash() const CYBER_NOEXCEPT { return structure_hash; }
+            // Forces the next compile to rebuild from scratch.
+            void discard_cached_plan() CYBER_NOEXCEPT { has_cached_plan = false; compiled = false; }
+            // Hash lookup in a flat open-addressed table; no string compares on the hot path
+            class RGRenderResource* find_resource(RGResourceName name) const CYBER_NOEXCEPT;
+            // Appends a node created by the builder and indexes it by its resource's name hash
+            void add_resource(class ResourceNode* resource_node) CYBER_NOEXCEPT;
         private:
+            void cull_passes();
+            void build_dependencies();
+            void schedule_passes();
+            void compute_lifetimes();
+            void compute_barriers();
+            void compute_record_groups();
+            void record_barriers(const RenderGraphBarrierBatch& batch, RenderObject::IDeviceContext* context,
+                ResourceBarrierDesc& desc, bool deferred);
+            void record_group(uint32_t group_index);
+            void execute_parallel();
+            void store_final_states();
+            void start_record_workers();
+            void stop_record_workers();
+            void record_worker_main(uint32_t group_index);
+            void compute_queue_syncs();
+            void execute_async();
+            void wait_for_queue(ERGQueue waiting_queue);
+            RenderObject::IDeviceContext* get_queue_context(ERGQueue queue) const CYBER_NOEXCEPT;
+            void build_structure_key();
+            bool reuse_cached_plan();
+            void store_cached_plan();
+            void insert_resource_slot(class ResourceNode* resource_node) CYBER_NOEXCEPT;
+
             eastl::vector<class RenderGraphPhase*> phases;
+            // Indices into resources, UINT32_MAX for empty slots; the size is a power of two
+            eastl::vector<uint32_t> resource_table;
             eastl::vector<class PassNode*> execution_order;
             class RenderGraphBuilder* graphBuilder = nullptr;
+            RenderGraphTransientAllocator transient_allocator;
+            RenderGraphCompileReport compile_report;
+            eastl::vector<RenderGraphBarrierBatch> barrier_batches;
+            ResourceBarrierDesc barrier_desc;
+            eastl::vector<RenderGraphRecordGroup> record_groups;
+            // One scratch description per group, since groups record concurrently
+            eastl::vector<ResourceBarrierDesc> group_barrier_descs;
+            uint32_t min_passes_per_record_group = 16;
+            // Started with the deferred contexts and kept for the graph's lifetime, so frames do not pay
+            // for thread creation. Worker i records group i + 1; the calling thread records group 0.
+            eastl::vector<std::thread> record_workers;
+            std::mutex record_mutex;
+            std::condition_variable record_start;
+            std::condition_variable record_done;
+            uint64_t record_generation = 0;
+            uint32_t record_group_count = 0;
+            uint32_t record_pending = 0;
+            bool record_shutdown = false;
+            eastl::vector<RenderGraphQueueSync> queue_syncs;
+            // Reads that reuse a transition made by an earlier reader: (reader, transitioning pass)
+            eastl::vector<eastl::pair<uint32_t, uint32_t>> shared_read_sources;
+            bool async_compute_active = false;
+            bool final_graphics_wait = false;
+            uint64_t queue_fence_values[static_cast<uint32_t>(ERGQueue::Count)] = {};
+            bool split_barriers = false;
             bool compiled = false;
+
+            // Pass types, accesses and transient descriptors flattened by build_structure_key. The plan
+            // is stored by pass index because pass nodes are recreated by reset_passes every frame.
+            eastl::vector<uint64_t> structure_key;
+            eastl::vector<uint64_t> cached_structure_key;
+            uint64_t structure_hash = 0;
+            uint64_t cached_structure_hash = 0;
+            eastl::vector<uint32_t> cached_execution_order;
+            eastl::vector<uint32_t> cached_culled_passes;
+            bool has_cached_plan = false;
         public:
-            eastl::map<const char8_t*, class RGRenderResource*, Utf8StringLess> resource_map;
             eastl::vector<class ResourceNode*> resources;
             eastl::vector<class PassNode*> passes;
             eastl::vector<class ResourceNode*> culled_resources;
             eastl::vector<class PassNode*> culled_passes;
             RenderObject::IQueue* gfx_queue = nullptr;
+            RenderObject::IDeviceContext* device_context = nullptr;
+            eastl::vector<RenderObject::IDeviceContext*> deferred_contexts;
+            RenderGraphAsyncComputeDesc async_compute;
             RenderGraphFrameExecutor frame_executors[RG_MAX_FRAME_IN_FLIGHT];
         };
     }
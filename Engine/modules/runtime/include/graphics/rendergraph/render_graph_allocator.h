@@ -0,0 +1,51 @@
+#pragma once
+#include "EASTL/vector.h"
+#include "platform/configure.h"
+#include "cyber_runtime.config.h"
+#include "interface/pool_allocator.h"
+#include "render_graph_resource.h"
+
+namespace Cyber
+{
+    namespace render_graph
+    {
+        struct RenderGraphTransientHeap
+        {
+            RenderObject::PoolResourceType resource_type = RenderObject::PoolResourceType::Buffers;
+            // High-water mark of the packed allocations, i.e. the heap size this frame needs.
+            uint64_t size = 0;
+            uint32_t alignment = 0;
+            uint32_t resource_count = 0;
+        };
+
+        // Places transient graph resources (neither imported nor outputs) into shared heaps.
+        // Resources whose [first_use, last_use] intervals do not overlap may share bytes. Allocation walks the
+        // execution order through a MemoryPool per heap: resources are placed at their first pass
+        // and released after their last, so a block freed by one pass is reused by the next.
+        class CYBER_RUNTIME_API RenderGraphTransientAllocator
+        {
+        public:
+            static constexpr uint32_t kPlacementAlignment = 64 * 1024;
+            static constexpr uint32_t kMSAAPlacementAlignment = 4 * 1024 * 1024;
+
+            // Sizes follow the D3D12 placement rules: 64KB granularity, 4MB for MSAA targets.
+            static uint64_t estimate_size(const RGTextureCreateDesc& desc, uint32_t& out_alignment);
+            static uint64_t estimate_size(const RGBufferCreateDesc& desc, uint32_t& out_alignment);
+            static RenderObject::PoolResourceType get_heap_type(const ResourceNode* resource_node);
+
+            // Lifetimes must already be computed; writes heap_index/heap_offset/allocation_size
+            // on every transient node that survived culling.
+            void plan(const eastl::vector<ResourceNode*>& resources, uint32_t pass_count);
+            void reset();
+
+            CYBER_FORCE_INLINE const eastl::vector<RenderGraphTransientHeap>& get_heaps() const CYBER_NOEXCEPT { return heaps; }
+            CYBER_FORCE_INLINE uint64_t get_aliased_size() const CYBER_NOEXCEPT { return aliased_size; }
+            CYBER_FORCE_INLINE uint64_t get_unaliased_size() const CYBER_NOEXCEPT { return unaliased_size; }
+
+        private:
+            eastl::vector<RenderGraphTransientHeap> heaps;
+            uint64_t aliased_size = 0;
+            uint64_t unaliased_size = 0;
+        };
+    }
+}
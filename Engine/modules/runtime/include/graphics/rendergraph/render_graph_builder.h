@@ -12,6 +12,7 @@ namespace Cyber
     {
         struct IRenderDevice;
         struct IQueue;
+        struct IDeviceContext;
     }
     
     namespace render_graph
@@ -24,17 +25,28 @@ namespace Cyber
             RenderGraphBuilder& backend_api(GRAPHICS_BACKEND backend) CYBER_NOEXCEPT;
             RenderGraphBuilder& with_device(class RenderObject::IRenderDevice* device) CYBER_NOEXCEPT;
             RenderGraphBuilder& with_queue(class RenderObject::IQueue* queue) CYBER_NOEXCEPT;
+            // Context the graph records its batched barriers into
+            RenderGraphBuilder& with_context(RenderObject::IDeviceContext* context) CYBER_NOEXCEPT;
+            // Deferred contexts that independent record groups are recorded into in parallel
+            RenderGraphBuilder& with_deferred_contexts(RenderObject::IDeviceContext* const* contexts, uint32_t count) CYBER_NOEXCEPT;
+            // Queue, context and fences that async compute passes are submitted through
+            RenderGraphBuilder& with_async_compute(const RenderGraphAsyncComputeDesc& desc) CYBER_NOEXCEPT;
             
         public:
-            RGTextureRef create_texture(RGTextureCreateDesc desc, const char8_t* name);
-            RGTextureRef import_texture(RenderObject::ITexture* texture, const char8_t* name);
+            // Names are interned handles; plain strings convert implicitly and are hashed on the call.
+            // Declare hot names as constexpr RGResourceName constants to hash them at compile time.
+            RGTextureRef create_texture(RGTextureCreateDesc desc, RGResourceName name);
+            RGTextureRef import_texture(RenderObject::ITexture* texture, RGResourceName name);
             void update_imported_texture(RGTextureRef texture, RenderObject::ITexture* imported_texture);
-            RGTextureRef get_texture(const char8_t* name);
+            RGTextureRef get_texture(RGResourceName name);
+            // Outputs keep the passes that produce them alive during culling. Imported textures
+            // start as outputs; clear it for imports that only carry data within the frame.
+            void set_output(RGRenderResource* resource, bool output = true);
 
-            RenderObject::ITexture* GetRHITexture(const char8_t* name);
+            RenderObject::ITexture* GetRHITexture(RGResourceName name);
             
-            RGBufferRef create_buffer(RGBufferCreateDesc desc, const char8_t* name);
-            RGBufferRef get_buffer(const char8_t* name);
+            RGBufferRef create_buffer(RGBufferCreateDesc desc, RGResourceName name);
+            RGBufferRef get_buffer(RGResourceName name);
 
             RGTextureViewRef CreateTextureView(RGTextureViewCreateDesc desc);
 
@@ -60,6 +72,7 @@ namespace Cyber
 
         private:
             bool register_pass(const char8_t* name, RGPass* pass, PassNode::PassDestroyFunction destroy_pass);
+            bool check_unique_name(RGResourceName name) const;
 
             template<typename PassType>
             static void destroy_typed_pass(RGPass* pass)
@@ -70,6 +83,9 @@ namespace Cyber
         public:
             class RenderObject::IRenderDevice* device = nullptr;
             class RenderObject::IQueue* gfx_queue = nullptr;
+            RenderObject::IDeviceContext* device_context = nullptr;
+            eastl::vector<RenderObject::IDeviceContext*> deferred_contexts;
+            RenderGraphAsyncComputeDesc async_compute;
             class RenderGraph* graph = nullptr;
         };
     }
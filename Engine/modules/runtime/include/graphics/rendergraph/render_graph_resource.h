@@ -44,6 +44,13 @@ namespace Cyber
         class RGRenderPass;
         class RGComputePass;
 
+        template<typename ResourceRef>
+        struct RGPassInput
+        {
+            RGResourceName name;
+            ResourceRef resource = nullptr;
+        };
+
         using RGTextureCreateDesc = RenderObject::TextureCreateDesc;
         using RGBufferCreateDesc = RenderObject::BufferCreateDesc;
         using RGTextureViewCreateDesc = RenderObject::TextureViewCreateDesc;
@@ -69,6 +76,7 @@ namespace Cyber
             virtual ~RGRenderResource() = default;
 
             const char8_t* resource_name = nullptr;
+            uint64_t name_hash = 0;
             ERGResourceType resource_type = ERGResourceType::Buffer;
             RenderObject::IRenderDevice* device = nullptr;
         };
@@ -85,6 +93,10 @@ namespace Cyber
             RGBufferCreateDesc create_desc;
             RenderObject::IBuffer* buffer = nullptr;
             struct BufferNode* buffer_node = nullptr;
+            // The backend tracks no buffer state, so the graph carries it between frames: the first
+            // transition of a frame starts here and the last one is written back. D3D12 creates
+            // buffers in COMMON; set this when importing a buffer left in another state.
+            GRAPHICS_RESOURCE_STATE state = GRAPHICS_RESOURCE_STATE_COMMON;
         };
 
         class RGTexture : public RGRenderResource
@@ -119,19 +131,20 @@ namespace Cyber
             virtual void setup(RenderGraphBuilder& builder);
             virtual void execute(RenderGraph& graph, RenderPassContext& context);
 
-            RGPass& read(RGTextureRef texture) CYBER_NOEXCEPT;
-            RGPass& read(RGBufferRef buffer) CYBER_NOEXCEPT;
-            RGPass& write(RGTextureRef texture) CYBER_NOEXCEPT;
-            RGPass& write(RGBufferRef buffer) CYBER_NOEXCEPT;
-            RGPass& read_write(RGTextureRef texture) CYBER_NOEXCEPT;
-            RGPass& read_write(RGBufferRef buffer) CYBER_NOEXCEPT;
+            RGPass& read(RGTextureRef texture, GRAPHICS_RESOURCE_STATE state = GRAPHICS_RESOURCE_STATE_SHADER_RESOURCE) CYBER_NOEXCEPT;
+            RGPass& read(RGBufferRef buffer, GRAPHICS_RESOURCE_STATE state = GRAPHICS_RESOURCE_STATE_SHADER_RESOURCE) CYBER_NOEXCEPT;
+            RGPass& write(RGTextureRef texture, GRAPHICS_RESOURCE_STATE state = GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS) CYBER_NOEXCEPT;
+            RGPass& write(RGBufferRef buffer, GRAPHICS_RESOURCE_STATE state = GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS) CYBER_NOEXCEPT;
+            RGPass& read_write(RGTextureRef texture, GRAPHICS_RESOURCE_STATE state = GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS) CYBER_NOEXCEPT;
+            RGPass& read_write(RGBufferRef buffer, GRAPHICS_RESOURCE_STATE state = GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS) CYBER_NOEXCEPT;
 
             ERGPassType pass_type;
             const char8_t* pass_name = nullptr;
             struct PassNode* pass_node = nullptr;
 
         protected:
-            void register_resource_access(RGRenderResource* resource, ERGResourceAccess access) CYBER_NOEXCEPT;
+            void register_resource_access(RGRenderResource* resource, ERGResourceAccess access,
+                GRAPHICS_RESOURCE_STATE state) CYBER_NOEXCEPT;
         };
 
 
@@ -170,13 +183,16 @@ namespace Cyber
             STORE_ACTION stencil_store_action = STORE_ACTION_STORE) CYBER_NOEXCEPT;
 
             RGRenderPass& set_pipeline(RenderObject::IRenderPipeline* pipeline) CYBER_NOEXCEPT;
-            RGRenderPass& add_input(const char8_t* name, RGTextureRef texture) CYBER_NOEXCEPT;
-            RGRenderPass& add_input(const char8_t* name, RGBufferRef buffer) CYBER_NOEXCEPT;
+            RGRenderPass& add_input(RGResourceName name, RGTextureRef texture) CYBER_NOEXCEPT;
+            RGRenderPass& add_input(RGResourceName name, RGBufferRef buffer) CYBER_NOEXCEPT;
+            // Passes bind a handful of inputs, so a scan over their hashes is cheaper than a map
+            RGTextureRef get_input_texture(RGResourceName name) const CYBER_NOEXCEPT;
+            RGBufferRef get_input_buffer(RGResourceName name) const CYBER_NOEXCEPT;
 
             RenderObject::IRenderPipeline* pipeline;
             eastl::map<uint32_t, RGTextureRef> render_targets;
-            eastl::map<const char8_t*, RGTextureRef, Utf8StringLess> input_textures;
-            eastl::map<const char8_t*, RGBufferRef, Utf8StringLess> input_buffers;
+            eastl::vector<RGPassInput<RGTextureRef>> input_textures;
+            eastl::vector<RGPassInput<RGBufferRef>> input_buffers;
             RGRenderResource* depth_stencil = nullptr;
 
             LOAD_ACTION dload_action;
@@ -197,6 +213,12 @@ namespace Cyber
         public:
             RGComputePass();
             virtual ~RGComputePass() = default;
+
+            // Runs the pass on the graph's async compute queue when one is configured. Set it before
+            // the pass is added; the graph synchronizes with the graphics queue only where needed.
+            RGComputePass& set_async_compute(bool enable = true) CYBER_NOEXCEPT { async_compute = enable; return *this; }
+
+            bool async_compute = false;
         };
 
         class CYBER_RUNTIME_API RGPresentPass : public RGPass
@@ -227,6 +249,31 @@ namespace Cyber
         {
             ResourceNode(ERGObjectType type) : RenderGraphNode(type) {}
 
+            RGRenderResource* resource = nullptr;
+            // Slot in RenderGraph::resources
+            uint32_t resource_index = UINT32_MAX;
+            // Imported resources outlive the graph; outputs are sinks whose final contents must be
+            // produced even when no pass reads them. Imports are outputs unless cleared.
+            bool imported = false;
+            bool output = false;
+
+            // Filled by RenderGraph::compile: surviving passes that read the resource, and the
+            // inclusive range of execution order indices that access it (UINT32_MAX when unused).
+            uint32_t ref_count = 0;
+            uint32_t first_use = UINT32_MAX;
+            uint32_t last_use = UINT32_MAX;
+            PassNode* last_writer = nullptr;
+            // Passes that read the current contents since last_writer; the next writer waits on them.
+            eastl::vector<PassNode*> readers;
+
+            // Transient placement from RenderGraphTransientAllocator; heap_index is UINT32_MAX for
+            // imported, output or culled resources.
+            uint32_t heap_index = UINT32_MAX;
+            uint64_t heap_offset = 0;
+            uint64_t allocation_size = 0;
+
+            // State the frame's last barrier leaves the resource in; UNKNOWN when no pass transitions it
+            GRAPHICS_RESOURCE_STATE final_state = GRAPHICS_RESOURCE_STATE_UNKNOWN;
         };
 
         struct BufferNode : public ResourceNode
@@ -244,5 +291,15 @@ namespace Cyber
             RenderObject::ITexture* texture = nullptr;
         };
 
+        inline ResourceNode* get_resource_node(RGRenderResource* resource) CYBER_NOEXCEPT
+        {
+            if (!resource)
+                return nullptr;
+            if (resource->resource_type == ERGResourceType::Texture)
+                return static_cast<RGTexture*>(resource)->texture_node;
+            if (resource->resource_type == ERGResourceType::Buffer)
+                return static_cast<RGBuffer*>(resource)->buffer_node;
+            return nullptr;
+        }
     }
 }
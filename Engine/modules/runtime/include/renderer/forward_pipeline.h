@@ -30,6 +30,7 @@ namespace Cyber
         class Renderer;
         class SceneColorPass;
         class ShadowPass;
+        class TextureStreamer;
 
         class CYBER_RUNTIME_API ForwardPipeline
         {
@@ -40,6 +41,12 @@ namespace Cyber
             void initialize();
             void resize(uint32_t width, uint32_t height);
             void render(World* world, float delta_time);
+            // Reports every drawn primitive's on-screen size to the streamer and updates it each
+            // frame; the streamer must outlive the pipeline or be reset to null
+            void set_texture_streamer(TextureStreamer* streamer) { m_texture_streamer = streamer; }
+            // Screen-space error, in pixels, a mesh LOD may show before a finer level is drawn;
+            // 0 disables LOD selection
+            void set_lod_max_pixel_error(float pixels) { m_pass_context.lod_max_pixel_error = pixels; }
 
         private:
             void create_resources();
@@ -47,6 +54,10 @@ namespace Cyber
             void destroy_render_graph();
             void update_render_graph_resources(const ForwardFrameContext& frame_context);
             void update_pass_context(const ForwardFrameContext& frame_context);
+            // Gathers drawable meshes with their world bounds and uploads their object constants
+            void build_draw_list(World* world);
+            void select_mesh_lods(World* world);
+            void request_texture_mips(World* world);
 
             ForwardFrameContext begin_frame();
 
@@ -54,7 +65,10 @@ namespace Cyber
             RenderObject::IRenderDevice* m_device = nullptr;
             RenderObject::IDeviceContext* m_context = nullptr;
 
-            RefCntAutoPtr<RenderObject::IBuffer> m_scene_constants;
+            RefCntAutoPtr<RenderObject::IBuffer> m_pass_constants;
+            RefCntAutoPtr<RenderObject::IBuffer> m_object_constants;
+            RefCntAutoPtr<RenderObject::IBuffer> m_identity_decode;
+            uint32_t m_object_capacity = 0;
             RefCntAutoPtr<RenderObject::ITexture> m_shadow_map;
 
             render_graph::RenderGraph* m_render_graph = nullptr;
@@ -66,6 +80,7 @@ namespace Cyber
             SceneColorPass* m_scene_color_pass = nullptr;
             ForwardPassPipelineCache m_pipeline_cache;
             ForwardPassContext m_pass_context;
+            TextureStreamer* m_texture_streamer = nullptr;
 
             uint32_t m_shadow_resolution = 2048;
         };
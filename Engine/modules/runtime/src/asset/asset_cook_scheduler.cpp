@@ -0,0 +1,340 @@
+#include "asset/asset_cook_scheduler.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <thread>
+
+namespace Cyber
+{
+    namespace
+    {
+        struct SourceHashCacheHeader
+        {
+            uint32_t magic = kSourceHashCacheMagic;
+            uint32_t version = kSourceHashCacheVersion;
+            uint64_t entryCount = 0;
+        };
+
+        bool stat_source(const std::filesystem::path& path, std::string& outKey,
+                         uint64_t& outSize, int64_t& outWriteTicks)
+        {
+            std::error_code ec;
+            outSize = std::filesystem::file_size(path, ec);
+            if (ec)
+                return false;
+            const auto writeTime = std::filesystem::last_write_time(path, ec);
+            if (ec)
+                return false;
+            outKey = AssetRegistry::NormalizePath(path.lexically_normal().generic_string());
+            outWriteTicks = static_cast<int64_t>(writeTime.time_since_epoch().count());
+            return true;
+        }
+
+        bool read_file_header(const std::filesystem::path& path, AssetFileHeader& outHeader)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+                return false;
+            file.read(reinterpret_cast<char*>(&outHeader), sizeof(outHeader));
+            return static_cast<bool>(file) && outHeader.IsValid();
+        }
+
+        bool is_up_to_date(const IAssetImporter& importer, const AssetImportRequest& request,
+                           const AssetRegistryRecord& record, SourceHashCache& hashCache)
+        {
+            if (record.importerVersion != importer.Version())
+                return false;
+
+            // Hash the source with whatever the existing asset was written with, so assets from
+            // before a hash algorithm change are not recooked just for that
+            AssetFileHeader header;
+            if (!read_file_header(request.destinationPath, header) || header.contentHash != record.sourceHash)
+                return false;
+            uint64_t sourceHash = 0;
+            if (!hashCache.HashFile(request.sourcePath, header.ContentHashAlgorithm(), sourceHash))
+                return false;
+            return sourceHash == record.sourceHash &&
+                   record.editorAssetHash == AssetHash::Combine(sourceHash, importer.DependencyHash(request));
+        }
+    }
+
+    bool SourceHashCache::Load(const std::filesystem::path& path)
+    {
+        Clear();
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        SourceHashCacheHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || header.magic != kSourceHashCacheMagic || header.version != kSourceHashCacheVersion)
+            return false;
+
+        std::unordered_map<std::string, Entry> entries;
+        entries.reserve(static_cast<size_t>(std::min<uint64_t>(header.entryCount, 1u << 20)));
+        for (uint64_t i = 0; i < header.entryCount; ++i)
+        {
+            uint32_t pathSize = 0;
+            file.read(reinterpret_cast<char*>(&pathSize), sizeof(pathSize));
+            if (!file || pathSize > 4096)
+                return false;
+            std::string key(pathSize, '\0');
+            file.read(key.data(), static_cast<std::streamsize>(pathSize));
+            Entry entry;
+            file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+            if (!file)
+                return false;
+            entries[std::move(key)] = entry;
+        }
+
+        std::lock_guard lock(m_mutex);
+        m_entries = std::move(entries);
+        return true;
+    }
+
+    bool SourceHashCache::Save(const std::filesystem::path& path) const
+    {
+        std::error_code ec;
+        const std::filesystem::path parent = path.parent_path();
+        if (!parent.empty())
+            std::filesystem::create_directories(parent, ec);
+        if (ec)
+            return false;
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        std::lock_guard lock(m_mutex);
+        SourceHashCacheHeader header;
+        header.entryCount = m_entries.size();
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& [key, entry] : m_entries)
+        {
+            const uint32_t pathSize = static_cast<uint32_t>(key.size());
+            file.write(reinterpret_cast<const char*>(&pathSize), sizeof(pathSize));
+            file.write(key.data(), static_cast<std::streamsize>(key.size()));
+            file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        }
+        return file.good();
+    }
+
+    void SourceHashCache::Clear()
+    {
+        std::lock_guard lock(m_mutex);
+        m_entries.clear();
+    }
+
+    size_t SourceHashCache::Size() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_entries.size();
+    }
+
+    bool SourceHashCache::HashFile(const std::filesystem::path& path, AssetHashAlgorithm algorithm,
+                                   uint64_t& outHash)
+    {
+        std::string key;
+        uint64_t size = 0;
+        int64_t writeTicks = 0;
+        if (!stat_source(path, key, size, writeTicks))
+            return false;
+        {
+            std::lock_guard lock(m_mutex);
+            const auto it = m_entries.find(key);
+            if (it != m_entries.end() && it->second.size == size && it->second.writeTime == writeTicks &&
+                it->second.algorithm == algorithm)
+            {
+                outHash = it->second.hash;
+                return true;
+            }
+        }
+
+        uint64_t hash = 0;
+        if (!AssetHash::HashFile(path, hash, algorithm))
+            return false;
+
+        std::lock_guard lock(m_mutex);
+        m_entries[key] = Entry { size, writeTicks, hash, algorithm };
+        outHash = hash;
+        return true;
+    }
+
+    void SourceHashCache::Remember(const std::filesystem::path& path, AssetHashAlgorithm algorithm, uint64_t hash)
+    {
+        std::string key;
+        uint64_t size = 0;
+        int64_t writeTicks = 0;
+        if (!stat_source(path, key, size, writeTicks))
+            return;
+        std::lock_guard lock(m_mutex);
+        m_entries[key] = Entry { size, writeTicks, hash, algorithm };
+    }
+
+    void AssetCookScheduler::RegisterImporter(const IAssetImporter& importer, uint32_t maxConcurrency)
+    {
+        m_importers[importer.Type()] = ImporterSlot { &importer, maxConcurrency };
+    }
+
+    std::vector<AssetCookResult> AssetCookScheduler::Cook(const std::vector<AssetCookRequest>& requests,
+                                                          AssetRegistry& registry,
+                                                          const AssetCookSettings& settings,
+                                                          AssetCookStats* outStats)
+    {
+        std::vector<AssetCookResult> results(requests.size());
+        if (outStats)
+            *outStats = {};
+        if (!settings.sourceHashCachePath.empty() && settings.sourceHashCachePath != m_loadedCachePath)
+        {
+            // A missing or stale cache file only costs rehashing
+            (void)m_hashCache.Load(settings.sourceHashCachePath);
+            m_loadedCachePath = settings.sourceHashCachePath;
+        }
+
+        const uint32_t workerCount = std::max(1u, settings.workerCount != 0
+            ? settings.workerCount
+            : std::thread::hardware_concurrency());
+
+        // Resolve everything that reads the registry up front, on this thread. The registry is
+        // not modified again until every job has finished.
+        struct Job
+        {
+            const ImporterSlot* slot = nullptr;
+            const AssetRegistryRecord* record = nullptr;
+            AssetImportRequest request {};
+        };
+        std::vector<Job> jobs(requests.size());
+        std::deque<size_t> pending;
+        std::unordered_map<std::string, size_t> destinations;
+        destinations.reserve(requests.size());
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            const AssetCookRequest& cookRequest = requests[i];
+            const auto slotIt = m_importers.find(cookRequest.importerType);
+            if (slotIt == m_importers.end())
+            {
+                results[i].importResult.error = "No importer registered for asset type.";
+                continue;
+            }
+
+            const AssetImportRequest& request = cookRequest.import;
+            const std::string assetPath = AssetRegistry::MakeStoredPath(request.destinationPath, request.contentRoot);
+            if (!destinations.emplace(assetPath, i).second)
+            {
+                results[i].importResult.error = "Another request in the batch writes the same destination.";
+                continue;
+            }
+
+            Job& job = jobs[i];
+            job.slot = &slotIt->second;
+            job.record = registry.FindByAssetPath(assetPath);
+            job.request = request;
+            if (!job.request.existingGuid.IsValid() && job.record)
+                job.request.existingGuid = job.record->guid;
+            if (!job.request.derivedDataCache)
+                job.request.derivedDataCache = settings.derivedDataCache;
+            // Assets already run in parallel; split the remaining threads between them
+            if (job.request.threadCount == 0)
+                job.request.threadCount = std::max(1u, workerCount / static_cast<uint32_t>(
+                    std::min<size_t>(requests.size(), workerCount)));
+            pending.push_back(i);
+        }
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::unordered_map<const ImporterSlot*, uint32_t> running;
+
+        const auto run_job = [&](size_t index)
+        {
+            const Job& job = jobs[index];
+            AssetCookResult& result = results[index];
+            const IAssetImporter& importer = *job.slot->importer;
+
+            if (!settings.force && job.record && is_up_to_date(importer, job.request, *job.record, m_hashCache))
+            {
+                result.status = AssetCookStatus::UpToDate;
+                result.importResult.registryRecord = *job.record;
+                return;
+            }
+
+            result.status = importer.Import(job.request, result.importResult)
+                ? AssetCookStatus::Cooked
+                : AssetCookStatus::Failed;
+            if (result.status == AssetCookStatus::Cooked)
+                m_hashCache.Remember(job.request.sourcePath, kDefaultContentHashAlgorithm,
+                                     result.importResult.registryRecord.sourceHash);
+            else if (result.importResult.error.empty())
+                result.importResult.error = "Importer failed.";
+        };
+
+        // Workers take the oldest pending job whose importer is below its concurrency limit
+        const auto worker = [&]()
+        {
+            std::unique_lock lock(mutex);
+            for (;;)
+            {
+                auto next = pending.end();
+                wake.wait(lock, [&]
+                {
+                    if (pending.empty())
+                        return true;
+                    next = std::find_if(pending.begin(), pending.end(), [&](size_t index)
+                    {
+                        const ImporterSlot* slot = jobs[index].slot;
+                        return slot->maxConcurrency == 0 || running[slot] < slot->maxConcurrency;
+                    });
+                    return next != pending.end();
+                });
+                if (pending.empty())
+                    return;
+
+                const size_t index = *next;
+                pending.erase(next);
+                const ImporterSlot* slot = jobs[index].slot;
+                ++running[slot];
+                lock.unlock();
+                run_job(index);
+                lock.lock();
+                --running[slot];
+                wake.notify_all();
+            }
+        };
+
+        const size_t threadCount = std::min<size_t>(workerCount, pending.size());
+        if (threadCount <= 1)
+        {
+            worker();
+        }
+        else
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(threadCount);
+            for (size_t i = 0; i < threadCount; ++i)
+                threads.emplace_back(worker);
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+
+        std::vector<AssetRegistryRecord> cookedRecords;
+        for (AssetCookResult& result : results)
+        {
+            if (result.status == AssetCookStatus::Cooked)
+            {
+                cookedRecords.push_back(result.importResult.registryRecord);
+                if (outStats)
+                    ++outStats->cooked;
+            }
+            else if (outStats)
+            {
+                ++(result.status == AssetCookStatus::UpToDate ? outStats->upToDate : outStats->failed);
+            }
+        }
+        registry.UpsertBatch(std::move(cookedRecords));
+
+        if (!settings.sourceHashCachePath.empty())
+            (void)m_hashCache.Save(settings.sourceHashCachePath);
+        return results;
+    }
+}
@@ -19,21 +19,57 @@ namespace Cyber
         return m_contentRoot / "Registry" / "AssetRegistry.json";
     }
 
+    std::filesystem::path AssetDatabase::BinaryRegistryPath() const
+    {
+        if (m_contentRoot.empty())
+            return {};
+        return m_contentRoot / "Registry" / "AssetRegistry.bin";
+    }
+
     bool AssetDatabase::Load()
     {
         m_registry.Clear();
-        const std::filesystem::path path = RegistryPath();
-        if (path.empty())
+        const std::filesystem::path jsonPath = RegistryPath();
+        const std::filesystem::path binaryPath = BinaryRegistryPath();
+        if (jsonPath.empty())
             return false;
 
         std::error_code ec;
-        if (!std::filesystem::exists(path, ec))
+        const bool hasJson = std::filesystem::exists(jsonPath, ec);
+        const bool hasBinary = std::filesystem::exists(binaryPath, ec);
+        bool binaryIsCurrent = hasBinary;
+        if (hasBinary && hasJson)
+        {
+            std::error_code jsonTimeError;
+            std::error_code binaryTimeError;
+            const auto jsonTime = std::filesystem::last_write_time(jsonPath, jsonTimeError);
+            const auto binaryTime = std::filesystem::last_write_time(binaryPath, binaryTimeError);
+            binaryIsCurrent = !jsonTimeError && !binaryTimeError && binaryTime >= jsonTime;
+        }
+
+        if (binaryIsCurrent && m_registry.LoadBinary(binaryPath))
             return true;
+        if (!hasJson)
+            return !hasBinary;
 
-        return m_registry.Load(path);
+        if (!m_registry.Load(jsonPath))
+            return false;
+        // Migrate; a failed write only costs the fast path on the next load
+        (void)m_registry.SaveBinary(binaryPath);
+        return true;
     }
 
     bool AssetDatabase::Save() const
+    {
+        // JSON first: the binary file must not end up older than the export, or Load would
+        // take it for stale and reparse the JSON.
+        const std::filesystem::path binaryPath = BinaryRegistryPath();
+        if (binaryPath.empty() || (m_jsonExportEnabled && !ExportJson()))
+            return false;
+        return m_registry.SaveBinary(binaryPath);
+    }
+
+    bool AssetDatabase::ExportJson() const
     {
         const std::filesystem::path path = RegistryPath();
         if (path.empty())
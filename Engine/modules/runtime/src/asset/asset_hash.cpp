@@ -0,0 +1,105 @@
+#include "asset/asset_hash.h"
+
+#define XXH_INLINE_ALL
+#include "xxhash3/xxhash.h"
+
+#include <fstream>
+#include <new>
+#include <vector>
+
+namespace Cyber
+{
+    namespace
+    {
+        constexpr size_t kHashFileChunkSize = 1u << 20;
+
+        XXH3_state_t* xxh3_state(unsigned char* storage)
+        {
+            return std::launder(reinterpret_cast<XXH3_state_t*>(storage));
+        }
+
+        const XXH3_state_t* xxh3_state(const unsigned char* storage)
+        {
+            return std::launder(reinterpret_cast<const XXH3_state_t*>(storage));
+        }
+    }
+
+    AssetHasher::AssetHasher(AssetHashAlgorithm algorithm)
+        : m_algorithm(algorithm)
+    {
+        static_assert(sizeof(XXH3_state_t) <= sizeof(m_xxh3State), "XXH3 state storage is too small.");
+        static_assert(alignof(XXH3_state_t) <= 64, "XXH3 state storage is under-aligned.");
+        new (m_xxh3State) XXH3_state_t;
+        Reset();
+    }
+
+    void AssetHasher::Reset()
+    {
+        m_fnvState = AssetHash::kFnv1a64Offset;
+        if (m_algorithm == AssetHashAlgorithm::XXH3_64)
+            (void)XXH3_64bits_reset(xxh3_state(m_xxh3State));
+    }
+
+    void AssetHasher::Update(const void* data, size_t size)
+    {
+        if (size == 0)
+            return;
+        if (m_algorithm == AssetHashAlgorithm::XXH3_64)
+            (void)XXH3_64bits_update(xxh3_state(m_xxh3State), data, size);
+        else
+            m_fnvState = AssetHash::HashBytes(data, size, m_fnvState);
+    }
+
+    uint64_t AssetHasher::Digest64() const
+    {
+        if (m_algorithm == AssetHashAlgorithm::XXH3_64)
+            return XXH3_64bits_digest(xxh3_state(m_xxh3State));
+        return m_fnvState;
+    }
+
+    AssetHash128 AssetHasher::Digest128() const
+    {
+        if (m_algorithm != AssetHashAlgorithm::XXH3_64)
+            return AssetHash128 { m_fnvState, 0 };
+        // The 64- and 128-bit variants share their reset and update steps; only the digest differs.
+        const XXH128_hash_t hash = XXH3_128bits_digest(xxh3_state(m_xxh3State));
+        return AssetHash128 { hash.low64, hash.high64 };
+    }
+}
+
+namespace Cyber::AssetHash
+{
+    uint64_t HashContent(const void* data, size_t size, AssetHashAlgorithm algorithm)
+    {
+        if (algorithm == AssetHashAlgorithm::XXH3_64)
+            return XXH3_64bits(data, size);
+        return HashBytes(data, size);
+    }
+
+    AssetHash128 HashContent128(const void* data, size_t size)
+    {
+        const XXH128_hash_t hash = XXH3_128bits(data, size);
+        return AssetHash128 { hash.low64, hash.high64 };
+    }
+
+    bool HashFile(const std::filesystem::path& path, uint64_t& outHash, AssetHashAlgorithm algorithm)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        AssetHasher hasher(algorithm);
+        std::vector<char> chunk(kHashFileChunkSize);
+        while (file)
+        {
+            file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            const std::streamsize count = file.gcount();
+            if (count > 0)
+                hasher.Update(chunk.data(), static_cast<size_t>(count));
+        }
+        if (file.bad())
+            return false;
+        outHash = hasher.Digest64();
+        return true;
+    }
+}
@@ -0,0 +1,400 @@
+#include "asset/asset_manager.h"
+
+#include "asset/asset_package.h"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+
+namespace Cyber
+{
+    struct AssetLoadEntry
+    {
+        AssetGuid guid {};
+        AssetRegistryRecord record {};
+        std::atomic<AssetLoadState> state { AssetLoadState::Queued };
+        // Everything below is guarded by the manager's mutex; error and object are written once
+        // before state becomes Failed or Loaded and only read after that.
+        AssetLoadPriority priority = AssetLoadPriority::Normal;
+        std::string error;
+        std::shared_ptr<void> object;
+        // Keeps dependencies alive for as long as this asset is
+        std::vector<AssetHandle> dependencies;
+        std::vector<std::weak_ptr<AssetLoadEntry>> dependents;
+        uint32_t pendingDependencies = 0;
+        bool scheduled = false;
+        uint64_t sequence = 0;
+    };
+
+    namespace
+    {
+        void set_error(std::string* outError, std::string message)
+        {
+            if (outError)
+                *outError = std::move(message);
+        }
+
+        std::shared_ptr<AssetLoadEntry> make_failed_entry(AssetGuid guid, std::string error)
+        {
+            auto entry = std::make_shared<AssetLoadEntry>();
+            entry->guid = guid;
+            entry->error = std::move(error);
+            entry->state.store(AssetLoadState::Failed, std::memory_order_release);
+            return entry;
+        }
+    }
+
+    AssetId AssetHandle::Id() const
+    {
+        return m_entry ? AssetId(m_entry->guid) : AssetId();
+    }
+
+    AssetLoadState AssetHandle::State() const
+    {
+        return m_entry ? m_entry->state.load(std::memory_order_acquire) : AssetLoadState::Failed;
+    }
+
+    bool AssetHandle::IsDone() const
+    {
+        const AssetLoadState state = State();
+        return state == AssetLoadState::Loaded || state == AssetLoadState::Failed;
+    }
+
+    const std::string& AssetHandle::Error() const
+    {
+        static const std::string kInvalidHandle = "Invalid asset handle.";
+        return m_entry ? m_entry->error : kInvalidHandle;
+    }
+
+    std::shared_ptr<void> AssetHandle::Object() const
+    {
+        return IsLoaded() ? m_entry->object : nullptr;
+    }
+
+    std::filesystem::path AssetLoadContext::LoosePath() const
+    {
+        return m_manager.m_settings.contentRoot / m_record.assetPath;
+    }
+
+    bool AssetLoadContext::ReadBytes(std::vector<uint8_t>& outBytes, std::string* outError) const
+    {
+        if (!m_record.packageName.empty() && !m_manager.m_settings.packageDirectory.empty())
+        {
+            const AssetPackage* package = m_manager.OpenPackage(m_record.packageName, outError);
+            if (!package || !package->Read(m_record.guid, outBytes, outError))
+                return false;
+        }
+        else
+        {
+            const std::filesystem::path path = LoosePath();
+            std::error_code ec;
+            const uint64_t size = std::filesystem::file_size(path, ec);
+            std::ifstream file(path, std::ios::binary);
+            if (ec || !file)
+            {
+                set_error(outError, "Failed to open " + path.generic_string() + ".");
+                return false;
+            }
+            outBytes.resize(static_cast<size_t>(size));
+            file.read(reinterpret_cast<char*>(outBytes.data()), static_cast<std::streamsize>(outBytes.size()));
+            if (static_cast<size_t>(file.gcount()) != outBytes.size())
+            {
+                set_error(outError, "Failed to read " + path.generic_string() + ".");
+                return false;
+            }
+        }
+        m_manager.m_bytesRead.fetch_add(outBytes.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    AssetManager::AssetManager(const AssetRegistry& registry, AssetManagerSettings settings)
+        : m_registry(registry), m_settings(std::move(settings))
+    {
+        const uint32_t workerCount =
+            m_settings.workerCount != 0 ? m_settings.workerCount : std::max(1u, std::thread::hardware_concurrency());
+        m_workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+            m_workers.emplace_back([this] { WorkerMain(); });
+    }
+
+    AssetManager::~AssetManager()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+            m_queue.clear();
+        }
+        m_workAvailable.notify_all();
+        for (std::thread& worker : m_workers)
+            worker.join();
+    }
+
+    void AssetManager::RegisterLoader(const IAssetLoader& loader)
+    {
+        std::lock_guard lock(m_mutex);
+        m_loaders[loader.Type()] = &loader;
+    }
+
+    AssetHandle AssetManager::Load(AssetId id, AssetLoadPriority priority)
+    {
+        std::vector<AssetGuid> path;
+        std::lock_guard lock(m_mutex);
+        return AssetHandle(RequestLocked(id.guid, priority, path));
+    }
+
+    AssetHandle AssetManager::Load(const SoftAssetRef& ref, AssetLoadPriority priority)
+    {
+        AssetHandle handle = Load(ref.id, priority);
+        const AssetType type = handle.m_entry->record.type;
+        if (ref.expectedType != AssetType::Unknown && type != AssetType::Unknown && type != ref.expectedType)
+        {
+            // The asset itself is fine; only this reference is wrong, so the shared entry stays untouched
+            return AssetHandle(make_failed_entry(ref.id.guid, "Asset " + ref.id.ToString() + " is a " +
+                                                 ToString(type) + ", not a " + ToString(ref.expectedType) + "."));
+        }
+        return handle;
+    }
+
+    AssetHandle AssetManager::Find(AssetId id) const
+    {
+        std::lock_guard lock(m_mutex);
+        const auto it = m_entries.find(id.guid);
+        return it != m_entries.end() ? AssetHandle(it->second.lock()) : AssetHandle();
+    }
+
+    void AssetManager::Wait(const AssetHandle& handle) const
+    {
+        if (!handle.IsValid())
+            return;
+        std::unique_lock lock(m_mutex);
+        m_progress.wait(lock, [&] { return handle.IsDone(); });
+    }
+
+    void AssetManager::WaitIdle() const
+    {
+        std::unique_lock lock(m_mutex);
+        m_progress.wait(lock, [&] { return m_inFlight == 0; });
+    }
+
+    AssetManagerStats AssetManager::Stats() const
+    {
+        std::lock_guard lock(m_mutex);
+        AssetManagerStats stats = m_stats;
+        stats.bytesRead = m_bytesRead.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    std::shared_ptr<AssetLoadEntry> AssetManager::RequestLocked(AssetGuid guid, AssetLoadPriority priority,
+                                                                std::vector<AssetGuid>& path)
+    {
+        if (std::find(path.begin(), path.end(), guid) != path.end())
+            return nullptr;
+
+        ++m_stats.requests;
+        const auto it = m_entries.find(guid);
+        if (it != m_entries.end())
+        {
+            if (std::shared_ptr<AssetLoadEntry> existing = it->second.lock())
+            {
+                ++m_stats.deduplicated;
+                RaisePriorityLocked(*existing, priority);
+                return existing;
+            }
+        }
+
+        // Released entries leave expired slots behind; sweep them once the map doubles
+        if (m_entries.size() >= m_sweepThreshold)
+        {
+            std::erase_if(m_entries, [](const auto& slot) { return slot.second.expired(); });
+            m_sweepThreshold = std::max<size_t>(64, m_entries.size() * 2);
+        }
+
+        auto entry = std::make_shared<AssetLoadEntry>();
+        entry->guid = guid;
+        entry->priority = priority;
+        m_entries[guid] = entry;
+
+        const AssetRegistryRecord* record = m_registry.Find(guid);
+        if (!record)
+        {
+            FailLocked(*entry, "Asset " + guid.ToString() + " is not in the registry.");
+            return entry;
+        }
+        entry->record = *record;
+        if (m_loaders.find(record->type) == m_loaders.end())
+        {
+            FailLocked(*entry, std::string("No loader is registered for ") + ToString(record->type) + " assets.");
+            return entry;
+        }
+
+        path.push_back(guid);
+        for (const AssetGuid& dependencyGuid : record->dependencies)
+        {
+            std::shared_ptr<AssetLoadEntry> dependency = RequestLocked(dependencyGuid, priority, path);
+            if (!dependency)
+            {
+                FailLocked(*entry, "Dependency cycle through " + dependencyGuid.ToString() + ".");
+                break;
+            }
+            const AssetLoadState state = dependency->state.load(std::memory_order_relaxed);
+            if (state == AssetLoadState::Failed)
+            {
+                FailLocked(*entry, "Dependency " + dependencyGuid.ToString() + " failed: " + dependency->error);
+                break;
+            }
+            if (state != AssetLoadState::Loaded)
+            {
+                ++entry->pendingDependencies;
+                dependency->dependents.push_back(entry);
+            }
+            entry->dependencies.push_back(AssetHandle(std::move(dependency)));
+        }
+        path.pop_back();
+
+        if (entry->state.load(std::memory_order_relaxed) == AssetLoadState::Queued && entry->pendingDependencies == 0)
+            ScheduleLocked(entry);
+        return entry;
+    }
+
+    void AssetManager::ScheduleLocked(const std::shared_ptr<AssetLoadEntry>& entry)
+    {
+        entry->scheduled = true;
+        entry->sequence = m_nextSequence++;
+        m_queue.insert(QueueKey { entry->priority, entry->sequence, entry });
+        ++m_inFlight;
+        m_workAvailable.notify_one();
+    }
+
+    void AssetManager::RaisePriorityLocked(AssetLoadEntry& entry, AssetLoadPriority priority)
+    {
+        if (priority <= entry.priority)
+            return;
+        if (entry.scheduled && entry.state.load(std::memory_order_relaxed) == AssetLoadState::Queued)
+        {
+            // Keys compare by priority and sequence only, so the old key finds the queued slot
+            const auto it = m_queue.find(QueueKey { entry.priority, entry.sequence, {} });
+            if (it != m_queue.end())
+            {
+                QueueKey key = *it;
+                m_queue.erase(it);
+                key.priority = priority;
+                m_queue.insert(std::move(key));
+            }
+        }
+        entry.priority = priority;
+        for (const AssetHandle& dependency : entry.dependencies)
+            RaisePriorityLocked(*dependency.m_entry, priority);
+    }
+
+    void AssetManager::CompleteLocked(AssetLoadEntry& entry)
+    {
+        entry.state.store(AssetLoadState::Loaded, std::memory_order_release);
+        ++m_stats.loaded;
+        for (const std::weak_ptr<AssetLoadEntry>& weakDependent : entry.dependents)
+        {
+            const std::shared_ptr<AssetLoadEntry> dependent = weakDependent.lock();
+            if (dependent && dependent->state.load(std::memory_order_relaxed) == AssetLoadState::Queued &&
+                --dependent->pendingDependencies == 0)
+                ScheduleLocked(dependent);
+        }
+        entry.dependents.clear();
+    }
+
+    void AssetManager::FailLocked(AssetLoadEntry& entry, std::string error)
+    {
+        const AssetLoadState state = entry.state.load(std::memory_order_relaxed);
+        if (state == AssetLoadState::Loaded || state == AssetLoadState::Failed)
+            return;
+        entry.error = std::move(error);
+        entry.state.store(AssetLoadState::Failed, std::memory_order_release);
+        ++m_stats.failed;
+
+        // Dependents never reached the queue, since this asset had not loaded
+        std::vector<std::weak_ptr<AssetLoadEntry>> dependents = std::move(entry.dependents);
+        for (const std::weak_ptr<AssetLoadEntry>& weakDependent : dependents)
+        {
+            if (const std::shared_ptr<AssetLoadEntry> dependent = weakDependent.lock())
+                FailLocked(*dependent, "Dependency " + entry.guid.ToString() + " failed: " + entry.error);
+        }
+    }
+
+    void AssetManager::WorkerMain()
+    {
+        std::unique_lock lock(m_mutex);
+        for (;;)
+        {
+            m_workAvailable.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping)
+                return;
+
+            std::shared_ptr<AssetLoadEntry> entry = m_queue.begin()->entry.lock();
+            m_queue.erase(m_queue.begin());
+            if (!entry)
+            {
+                ++m_stats.cancelled;
+                --m_inFlight;
+                m_progress.notify_all();
+                continue;
+            }
+            entry->state.store(AssetLoadState::Loading, std::memory_order_relaxed);
+            const IAssetLoader* loader = m_loaders.at(entry->record.type);
+            lock.unlock();
+
+            std::shared_ptr<void> object;
+            std::string error;
+            bool loaded = false;
+            try
+            {
+                loaded = loader->Load(AssetLoadContext(*this, entry->record), object, &error);
+            }
+            catch (const std::exception& e)
+            {
+                error = e.what();
+            }
+            catch (...)
+            {
+                error = "Unknown exception while loading.";
+            }
+            if (loaded && !object)
+            {
+                loaded = false;
+                error = "Loader returned no object.";
+            }
+
+            lock.lock();
+            if (loaded)
+            {
+                entry->object = std::move(object);
+                CompleteLocked(*entry);
+            }
+            else
+            {
+                FailLocked(*entry, error.empty() ? "Failed to load " + entry->guid.ToString() + "." : std::move(error));
+            }
+            --m_inFlight;
+            m_progress.notify_all();
+
+            // The last handle may have gone while loading; release the asset outside the lock
+            lock.unlock();
+            entry.reset();
+            lock.lock();
+        }
+    }
+
+    const AssetPackage* AssetManager::OpenPackage(const std::string& packageName, std::string* outError)
+    {
+        std::lock_guard lock(m_packageMutex);
+        std::unique_ptr<AssetPackage>& package = m_packages[packageName];
+        if (!package)
+        {
+            auto opened = std::make_unique<AssetPackage>();
+            if (!opened->Open(m_settings.packageDirectory / packageName, outError))
+            {
+                m_packages.erase(packageName);
+                return nullptr;
+            }
+            package = std::move(opened);
+        }
+        return package.get();
+    }
+}
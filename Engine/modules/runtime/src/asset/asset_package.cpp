@@ -0,0 +1,638 @@
+#include "asset/asset_package.h"
+
+#include "libdeflate.h"
+#include "zlib.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <thread>
+
+namespace Cyber
+{
+    namespace
+    {
+        constexpr uint64_t kAssetPackageAlignment = 16;
+
+        // The bundled libdeflate only decompresses, so blocks are written with zlib's raw DEFLATE
+        class BlockCompressor
+        {
+        public:
+            BlockCompressor() = default;
+            BlockCompressor(const BlockCompressor&) = delete;
+            BlockCompressor& operator=(const BlockCompressor&) = delete;
+            ~BlockCompressor()
+            {
+                if (m_initialized)
+                    deflateEnd(&m_stream);
+            }
+
+            bool Init(int level)
+            {
+                m_initialized = deflateInit2(&m_stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+                return m_initialized;
+            }
+
+            // Leaves out empty when the block does not fit in size bytes
+            void Compress(const uint8_t* in, size_t size, std::vector<uint8_t>& out)
+            {
+                out.resize(size);
+                deflateReset(&m_stream);
+                m_stream.next_in = const_cast<Bytef*>(in);
+                m_stream.avail_in = static_cast<uInt>(size);
+                m_stream.next_out = out.data();
+                m_stream.avail_out = static_cast<uInt>(size);
+                if (deflate(&m_stream, Z_FINISH) != Z_STREAM_END)
+                    out.clear();
+                else
+                    out.resize(size - m_stream.avail_out);
+            }
+
+        private:
+            z_stream m_stream {};
+            bool m_initialized = false;
+        };
+
+        struct DecompressorDeleter
+        {
+            void operator()(libdeflate_decompressor* decompressor) const { libdeflate_free_decompressor(decompressor); }
+        };
+
+        void set_error(std::string* outError, std::string message)
+        {
+            if (outError)
+                *outError = std::move(message);
+        }
+
+        uint64_t align_up(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        bool section_inside(uint64_t offset, uint64_t count, uint64_t stride, uint64_t fileSize)
+        {
+            if (stride != 0 && count > std::numeric_limits<uint64_t>::max() / stride)
+                return false;
+            return offset <= fileSize && count * stride <= fileSize - offset;
+        }
+
+        uint32_t resolve_thread_count(uint32_t requested, size_t jobCount)
+        {
+            const uint32_t threads = requested != 0 ? requested : std::max(1u, std::thread::hardware_concurrency());
+            return static_cast<uint32_t>(std::min<size_t>(threads, jobCount));
+        }
+
+        // Runs job(index, worker) for every index below count; each worker index stays on one thread.
+        template <typename Job>
+        void parallel_for(size_t count, uint32_t threadCount, Job&& job)
+        {
+            if (threadCount <= 1)
+            {
+                for (size_t i = 0; i < count; ++i)
+                    job(i, 0u);
+                return;
+            }
+
+            std::atomic<size_t> next { 0 };
+            const auto worker = [&](uint32_t workerIndex)
+            {
+                for (size_t i = next++; i < count; i = next++)
+                    job(i, workerIndex);
+            };
+            std::vector<std::thread> threads;
+            threads.reserve(threadCount - 1);
+            for (uint32_t i = 1; i < threadCount; ++i)
+                threads.emplace_back(worker, i);
+            worker(0);
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+
+        libdeflate_decompressor* thread_decompressor()
+        {
+            thread_local std::unique_ptr<libdeflate_decompressor, DecompressorDeleter> decompressor(
+                libdeflate_alloc_decompressor());
+            return decompressor.get();
+        }
+
+        // Reads the concatenated inputs, zero-padded to their stream offsets, one range at a time.
+        class PackageStreamReader
+        {
+        public:
+            PackageStreamReader(std::span<const AssetPackageInput> inputs, std::span<const AssetPackageEntry> layout)
+                : m_inputs(inputs), m_layout(layout)
+            {
+            }
+
+            bool Read(uint64_t position, std::span<uint8_t> out)
+            {
+                size_t written = 0;
+                while (written < out.size())
+                {
+                    const uint64_t cursor = position + written;
+                    while (m_index < m_layout.size() && cursor >= m_layout[m_index].offset + m_layout[m_index].size)
+                        ++m_index;
+                    const uint64_t end = position + out.size();
+                    if (m_index == m_layout.size() || cursor < m_layout[m_index].offset)
+                    {
+                        const uint64_t padEnd = m_index == m_layout.size() ? end : std::min(end, m_layout[m_index].offset);
+                        std::memset(out.data() + written, 0, static_cast<size_t>(padEnd - cursor));
+                        written += static_cast<size_t>(padEnd - cursor);
+                        continue;
+                    }
+
+                    const AssetPackageEntry& entry = m_layout[m_index];
+                    if (m_openIndex != m_index)
+                    {
+                        m_file = std::ifstream(m_inputs[m_index].path, std::ios::binary);
+                        m_openIndex = m_index;
+                        if (!m_file)
+                            return false;
+                    }
+                    const size_t count = static_cast<size_t>(std::min(end, entry.offset + entry.size) - cursor);
+                    m_file.read(reinterpret_cast<char*>(out.data() + written), static_cast<std::streamsize>(count));
+                    if (static_cast<size_t>(m_file.gcount()) != count)
+                        return false;
+                    written += count;
+                }
+                return true;
+            }
+
+        private:
+            std::span<const AssetPackageInput> m_inputs;
+            std::span<const AssetPackageEntry> m_layout;
+            size_t m_index = 0;
+            size_t m_openIndex = std::numeric_limits<size_t>::max();
+            std::ifstream m_file;
+        };
+
+        void write_padding(std::ofstream& file, uint64_t size)
+        {
+            static constexpr char kZeros[kAssetPackageAlignment] {};
+            file.write(kZeros, static_cast<std::streamsize>(size));
+        }
+
+        template <typename T>
+        void write_section(std::ofstream& file, uint64_t& written, uint64_t& outOffset, const std::vector<T>& values)
+        {
+            outOffset = align_up(written, kAssetPackageAlignment);
+            write_padding(file, outOffset - written);
+            if (!values.empty())
+                file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+            written = outOffset + values.size() * sizeof(T);
+        }
+    }
+
+    bool AssetPackage::Open(const std::filesystem::path& path, std::string* outError)
+    {
+        Close();
+        if (!m_file.Open(path))
+        {
+            set_error(outError, "Failed to map asset package.");
+            return false;
+        }
+
+        const uint8_t* data = m_file.Data();
+        const uint64_t fileSize = m_file.Size();
+        AssetPackageHeader& h = m_header;
+        if (fileSize < sizeof(h))
+        {
+            set_error(outError, "Invalid asset package.");
+            Close();
+            return false;
+        }
+        std::memcpy(&h, data, sizeof(h));
+        const uint64_t indexOffset = h.entriesOffset;
+        if (h.magic != kAssetPackageMagic || h.version != kAssetPackageVersion || h.headerSize != sizeof(h) ||
+            h.blockSize < kMinAssetPackageBlockSize || h.blockSize > kMaxAssetPackageBlockSize ||
+            h.blockCount != (h.dataSize + h.blockSize - 1) / h.blockSize ||
+            !section_inside(indexOffset, h.indexSize, 1, fileSize) ||
+            !section_inside(h.entriesOffset, h.entryCount, sizeof(AssetPackageEntry), fileSize) ||
+            !section_inside(h.fanoutOffset, kAssetPackageFanoutSize + 1, sizeof(uint32_t), fileSize) ||
+            !section_inside(h.blocksOffset, h.blockCount, sizeof(AssetPackageBlock), fileSize) ||
+            !section_inside(h.dependenciesOffset, h.dependencyCount, sizeof(AssetGuid), fileSize) ||
+            h.entriesOffset % kAssetPackageAlignment != 0 || h.fanoutOffset % kAssetPackageAlignment != 0 ||
+            h.blocksOffset % kAssetPackageAlignment != 0 || h.dependenciesOffset % kAssetPackageAlignment != 0)
+        {
+            set_error(outError, "Asset package header is invalid.");
+            Close();
+            return false;
+        }
+        if (AssetHash::HashContent(data + indexOffset, static_cast<size_t>(h.indexSize), AssetHashAlgorithm::XXH3_64) != h.indexHash)
+        {
+            set_error(outError, "Asset package index is corrupt.");
+            Close();
+            return false;
+        }
+
+        m_entries = { reinterpret_cast<const AssetPackageEntry*>(data + h.entriesOffset), static_cast<size_t>(h.entryCount) };
+        m_fanout = { reinterpret_cast<const uint32_t*>(data + h.fanoutOffset), kAssetPackageFanoutSize + 1 };
+        m_blocks = { reinterpret_cast<const AssetPackageBlock*>(data + h.blocksOffset), static_cast<size_t>(h.blockCount) };
+        m_dependencies = { reinterpret_cast<const AssetGuid*>(data + h.dependenciesOffset), static_cast<size_t>(h.dependencyCount) };
+
+        // Everything Read and Find trust is checked once here
+        bool valid = m_fanout.front() == 0 && m_fanout.back() == h.entryCount;
+        for (uint32_t i = 0; valid && i < kAssetPackageFanoutSize; ++i)
+            valid = m_fanout[i] <= m_fanout[i + 1];
+        for (size_t i = 0; valid && i < m_entries.size(); ++i)
+        {
+            const AssetPackageEntry& entry = m_entries[i];
+            valid = entry.size <= h.dataSize && entry.offset <= h.dataSize - entry.size &&
+                    entry.firstDependency <= h.dependencyCount &&
+                    entry.dependencyCount <= h.dependencyCount - entry.firstDependency &&
+                    (i == 0 || m_entries[i - 1].guid < entry.guid);
+        }
+        for (size_t i = 0; valid && i < m_blocks.size(); ++i)
+        {
+            const AssetPackageBlock& block = m_blocks[i];
+            const uint64_t expected = std::min<uint64_t>(h.blockSize, h.dataSize - i * h.blockSize);
+            valid = block.uncompressedSize == expected && block.compressedSize <= block.uncompressedSize &&
+                    section_inside(block.fileOffset, block.compressedSize, 1, indexOffset) &&
+                    (h.compression != AssetPackageCompression::None || block.compressedSize == block.uncompressedSize);
+        }
+        if (!valid)
+        {
+            set_error(outError, "Asset package index is invalid.");
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void AssetPackage::Close()
+    {
+        m_header = {};
+        m_entries = {};
+        m_fanout = {};
+        m_blocks = {};
+        m_dependencies = {};
+        m_file.Close();
+    }
+
+    const AssetPackageEntry* AssetPackage::Find(AssetGuid guid) const
+    {
+        if (m_entries.empty())
+            return nullptr;
+        const uint32_t bucket = static_cast<uint32_t>(guid.high >> 56);
+        const auto begin = m_entries.begin() + m_fanout[bucket];
+        const auto end = m_entries.begin() + m_fanout[bucket + 1];
+        const auto it = std::lower_bound(begin, end, guid,
+            [](const AssetPackageEntry& entry, const AssetGuid& value) { return entry.guid < value; });
+        return it != end && it->guid == guid ? &*it : nullptr;
+    }
+
+    std::span<const AssetGuid> AssetPackage::Dependencies(const AssetPackageEntry& entry) const
+    {
+        return m_dependencies.subspan(static_cast<size_t>(entry.firstDependency), entry.dependencyCount);
+    }
+
+    bool AssetPackage::Read(std::span<const AssetPackageReadRequest> requests, uint32_t threadCount,
+                            std::string* outError) const
+    {
+        if (!IsOpen())
+        {
+            set_error(outError, "Asset package is not open.");
+            return false;
+        }
+
+        // One piece per block an asset touches; pieces are grouped by block so shared blocks
+        // are decompressed once
+        struct Piece
+        {
+            uint64_t block = 0;
+            uint32_t blockOffset = 0;
+            uint32_t size = 0;
+            uint8_t* destination = nullptr;
+        };
+        std::vector<Piece> pieces;
+        const uint64_t blockSize = m_header.blockSize;
+        for (const AssetPackageReadRequest& request : requests)
+        {
+            const AssetPackageEntry* entry = Find(request.guid);
+            if (!entry || request.destination.size() != entry->size)
+            {
+                set_error(outError, entry ? "Read destination does not match the asset size."
+                                          : "Asset is not in the package.");
+                return false;
+            }
+            for (uint64_t position = entry->offset; position < entry->offset + entry->size;)
+            {
+                const uint64_t block = position / blockSize;
+                const uint64_t blockEnd = std::min((block + 1) * blockSize, entry->offset + entry->size);
+                pieces.push_back(Piece { block, static_cast<uint32_t>(position - block * blockSize),
+                                         static_cast<uint32_t>(blockEnd - position),
+                                         request.destination.data() + (position - entry->offset) });
+                position = blockEnd;
+            }
+        }
+        std::sort(pieces.begin(), pieces.end(), [](const Piece& lhs, const Piece& rhs) { return lhs.block < rhs.block; });
+
+        std::vector<size_t> groups;
+        for (size_t i = 0; i < pieces.size(); ++i)
+        {
+            if (i == 0 || pieces[i].block != pieces[i - 1].block)
+                groups.push_back(i);
+        }
+        groups.push_back(pieces.size());
+
+        const size_t groupCount = groups.size() - 1;
+        const uint32_t workers = resolve_thread_count(threadCount, groupCount);
+        std::vector<std::vector<uint8_t>> scratch(std::max(1u, workers));
+        std::atomic<bool> failed { false };
+        parallel_for(groupCount, workers, [&](size_t groupIndex, uint32_t worker)
+        {
+            const Piece* first = pieces.data() + groups[groupIndex];
+            const Piece* last = pieces.data() + groups[groupIndex + 1];
+            const AssetPackageBlock& block = m_blocks[static_cast<size_t>(first->block)];
+            const uint8_t* compressed = m_file.Data() + block.fileOffset;
+
+            // A block wholly inside one destination is decompressed straight into it
+            const bool direct = last - first == 1 && first->size == block.uncompressedSize;
+            uint8_t* out = first->destination;
+            if (!direct)
+            {
+                scratch[worker].resize(block.uncompressedSize);
+                out = scratch[worker].data();
+            }
+            if (block.compressedSize == block.uncompressedSize)
+            {
+                std::memcpy(out, compressed, block.uncompressedSize);
+            }
+            else
+            {
+                libdeflate_decompressor* decompressor = thread_decompressor();
+                if (!decompressor || libdeflate_deflate_decompress(decompressor, compressed, block.compressedSize, out,
+                                                                   block.uncompressedSize, nullptr) != LIBDEFLATE_SUCCESS)
+                {
+                    failed = true;
+                    return;
+                }
+            }
+            if (!direct)
+            {
+                for (const Piece* piece = first; piece != last; ++piece)
+                    std::memcpy(piece->destination, out + piece->blockOffset, piece->size);
+            }
+        });
+        if (failed)
+        {
+            set_error(outError, "Asset package block failed to decompress.");
+            return false;
+        }
+        return true;
+    }
+
+    bool AssetPackage::Read(AssetGuid guid, std::vector<uint8_t>& outBytes, std::string* outError) const
+    {
+        const AssetPackageEntry* entry = Find(guid);
+        if (!entry)
+        {
+            set_error(outError, "Asset is not in the package.");
+            return false;
+        }
+        outBytes.resize(static_cast<size_t>(entry->size));
+        const AssetPackageReadRequest request { guid, outBytes };
+        return Read(std::span<const AssetPackageReadRequest>(&request, 1), 1, outError);
+    }
+}
+
+namespace Cyber::AssetPackager
+{
+    bool WritePackage(const std::filesystem::path& packagePath, uint32_t chunkId,
+                      std::span<const AssetPackageInput> inputs, const AssetPackageSettings& settings,
+                      std::string* outError)
+    {
+        if (settings.compression != AssetPackageCompression::None &&
+            settings.compression != AssetPackageCompression::Deflate)
+        {
+            set_error(outError, "Unknown asset package compression.");
+            return false;
+        }
+
+        AssetPackageHeader header;
+        header.platformTag = settings.platformTag;
+        header.chunkId = chunkId;
+        header.compression = settings.compression;
+        header.blockSize = std::clamp(settings.blockSize, kMinAssetPackageBlockSize, kMaxAssetPackageBlockSize);
+
+        // Lay the assets out in input order; the index is sorted separately
+        std::vector<AssetPackageEntry> layout(inputs.size());
+        std::vector<AssetGuid> dependencies;
+        uint64_t dataSize = 0;
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            const AssetPackageInput& input = inputs[i];
+            std::error_code ec;
+            const uint64_t size = std::filesystem::file_size(input.path, ec);
+            if (ec || !input.guid.IsValid())
+            {
+                set_error(outError, "Cannot package " + input.path.generic_string() + ".");
+                return false;
+            }
+            AssetPackageEntry& entry = layout[i];
+            entry.guid = input.guid;
+            entry.type = input.type;
+            entry.offset = align_up(dataSize, kAssetPackageAlignment);
+            entry.size = size;
+            entry.firstDependency = dependencies.size();
+            entry.dependencyCount = static_cast<uint32_t>(input.dependencies.size());
+            dependencies.insert(dependencies.end(), input.dependencies.begin(), input.dependencies.end());
+            dataSize = entry.offset + size;
+        }
+        header.dataSize = dataSize;
+        header.blockCount = (dataSize + header.blockSize - 1) / header.blockSize;
+
+        std::vector<AssetPackageEntry> entries = layout;
+        std::sort(entries.begin(), entries.end(),
+                  [](const AssetPackageEntry& lhs, const AssetPackageEntry& rhs) { return lhs.guid < rhs.guid; });
+        for (size_t i = 1; i < entries.size(); ++i)
+        {
+            if (entries[i - 1].guid == entries[i].guid)
+            {
+                set_error(outError, "Asset " + entries[i].guid.ToString() + " is packaged twice.");
+                return false;
+            }
+        }
+        std::vector<uint32_t> fanout(kAssetPackageFanoutSize + 1, 0);
+        for (const AssetPackageEntry& entry : entries)
+            ++fanout[static_cast<size_t>(entry.guid.high >> 56) + 1];
+        for (uint32_t i = 0; i < kAssetPackageFanoutSize; ++i)
+            fanout[i + 1] += fanout[i];
+
+        std::error_code ec;
+        if (!packagePath.parent_path().empty())
+            std::filesystem::create_directories(packagePath.parent_path(), ec);
+        if (ec)
+        {
+            set_error(outError, "Failed to create the package directory.");
+            return false;
+        }
+        std::filesystem::path tempPath = packagePath;
+        tempPath += ".tmp";
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            set_error(outError, "Failed to create " + tempPath.generic_string() + ".");
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        uint64_t written = sizeof(header);
+
+        // Blocks are read and compressed a batch at a time so memory stays bounded by the batch
+        const uint32_t threadCount = resolve_thread_count(settings.threadCount, static_cast<size_t>(header.blockCount));
+        const size_t batchSize = std::max<size_t>(16, size_t(threadCount) * 4);
+        std::vector<BlockCompressor> compressors(std::max(1u, threadCount));
+        if (settings.compression == AssetPackageCompression::Deflate)
+        {
+            for (BlockCompressor& compressor : compressors)
+            {
+                if (!compressor.Init(std::clamp(settings.compressionLevel, 1, 9)))
+                {
+                    set_error(outError, "Failed to create a block compressor.");
+                    return false;
+                }
+            }
+        }
+
+        PackageStreamReader stream(inputs, layout);
+        std::vector<AssetPackageBlock> blocks(static_cast<size_t>(header.blockCount));
+        std::vector<uint8_t> raw(batchSize * header.blockSize);
+        std::vector<std::vector<uint8_t>> compressed(batchSize);
+        bool ok = true;
+        for (uint64_t batchStart = 0; ok && batchStart < header.blockCount; batchStart += batchSize)
+        {
+            const size_t count = static_cast<size_t>(std::min<uint64_t>(batchSize, header.blockCount - batchStart));
+            const uint64_t position = batchStart * header.blockSize;
+            const uint64_t batchBytes = std::min<uint64_t>(count * uint64_t(header.blockSize), dataSize - position);
+            if (!stream.Read(position, std::span<uint8_t>(raw.data(), static_cast<size_t>(batchBytes))))
+            {
+                set_error(outError, "Failed to read an asset while packaging.");
+                ok = false;
+                break;
+            }
+
+            parallel_for(count, threadCount, [&](size_t i, uint32_t worker)
+            {
+                const uint64_t blockIndex = batchStart + i;
+                const size_t size = static_cast<size_t>(std::min<uint64_t>(header.blockSize, dataSize - blockIndex * header.blockSize));
+                const uint8_t* in = raw.data() + i * header.blockSize;
+                std::vector<uint8_t>& out = compressed[i];
+                out.clear();
+                if (settings.compression == AssetPackageCompression::Deflate)
+                    compressors[worker].Compress(in, size, out);
+                // Incompressible blocks are stored
+                if (out.empty() || out.size() >= size)
+                    out.assign(in, in + size);
+                blocks[static_cast<size_t>(blockIndex)].uncompressedSize = static_cast<uint32_t>(size);
+                blocks[static_cast<size_t>(blockIndex)].compressedSize = static_cast<uint32_t>(out.size());
+            });
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                blocks[static_cast<size_t>(batchStart + i)].fileOffset = written;
+                file.write(reinterpret_cast<const char*>(compressed[i].data()), static_cast<std::streamsize>(compressed[i].size()));
+                written += compressed[i].size();
+            }
+        }
+
+        if (ok)
+        {
+            write_section(file, written, header.entriesOffset, entries);
+            write_section(file, written, header.fanoutOffset, fanout);
+            write_section(file, written, header.blocksOffset, blocks);
+            write_section(file, written, header.dependenciesOffset, dependencies);
+            header.entryCount = entries.size();
+            header.dependencyCount = dependencies.size();
+            header.indexSize = written - header.entriesOffset;
+            file.close();
+
+            // Hash the index as written, padding included, then patch the header
+            ok = static_cast<bool>(file);
+            if (ok)
+            {
+                MappedFile mapped;
+                ok = mapped.Open(tempPath);
+                if (ok)
+                    header.indexHash = AssetHash::HashContent(mapped.Data() + header.entriesOffset,
+                                                              static_cast<size_t>(header.indexSize),
+                                                              AssetHashAlgorithm::XXH3_64);
+            }
+            if (ok)
+            {
+                std::fstream patch(tempPath, std::ios::binary | std::ios::in | std::ios::out);
+                patch.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                ok = static_cast<bool>(patch);
+            }
+            if (!ok)
+                set_error(outError, "Failed to write " + tempPath.generic_string() + ".");
+        }
+        else
+        {
+            file.close();
+        }
+
+        if (ok)
+        {
+            std::filesystem::rename(tempPath, packagePath, ec);
+            ok = !ec;
+            if (!ok)
+                set_error(outError, "Failed to replace " + packagePath.generic_string() + ".");
+        }
+        if (!ok)
+            std::filesystem::remove(tempPath, ec);
+        return ok;
+    }
+
+    bool PackRegistry(AssetRegistry& registry, const std::filesystem::path& contentRoot,
+                      const std::filesystem::path& outputDirectory, const AssetPackageSettings& settings,
+                      std::vector<std::filesystem::path>* outPackages, std::string* outError)
+    {
+        if (outPackages)
+            outPackages->clear();
+
+        std::map<uint32_t, std::vector<const AssetRegistryRecord*>> chunks;
+        for (const AssetRegistryRecord& record : registry.Records())
+        {
+            if (record.IsValid())
+                chunks[record.chunkId].push_back(&record);
+        }
+
+        std::vector<AssetRegistryRecord> packaged;
+        for (auto& [chunkId, records] : chunks)
+        {
+            std::sort(records.begin(), records.end(), [](const AssetRegistryRecord* lhs, const AssetRegistryRecord* rhs)
+            {
+                return lhs->assetPath < rhs->assetPath;
+            });
+
+            std::vector<AssetPackageInput> inputs;
+            inputs.reserve(records.size());
+            for (const AssetRegistryRecord* record : records)
+                inputs.push_back(AssetPackageInput { record->guid, record->type, contentRoot / record->assetPath,
+                                                     record->dependencies });
+
+            const std::string packageName = PackageName(chunkId);
+            const std::filesystem::path packagePath = outputDirectory / packageName;
+            if (!WritePackage(packagePath, chunkId, inputs, settings, outError))
+                return false;
+            if (outPackages)
+                outPackages->push_back(packagePath);
+            for (const AssetRegistryRecord* record : records)
+            {
+                packaged.push_back(*record);
+                packaged.back().packageName = packageName;
+            }
+        }
+        registry.UpsertBatch(std::move(packaged));
+        return true;
+    }
+
+    std::string PackageName(uint32_t chunkId)
+    {
+        return "chunk_" + std::to_string(chunkId) + ".assetpack";
+    }
+}
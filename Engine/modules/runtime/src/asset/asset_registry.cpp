@@ -10,6 +10,12 @@ namespace Cyber
     {
         constexpr uint32_t kAssetRegistryVersion = 1;
 
+        bool is_normalized_path(std::string_view path)
+        {
+            return path.find('\\') == std::string_view::npos &&
+                   (path.size() <= 1 || path.back() != '/');
+        }
+
         bool path_starts_with_parent_reference(const std::filesystem::path& path)
         {
             for (const auto& part : path)
@@ -65,6 +71,17 @@ namespace Cyber
     void AssetRegistry::Clear()
     {
         m_records.clear();
+        m_guidIndex.clear();
+        m_assetPathIndex.clear();
+        m_sourcePathIndex.clear();
+    }
+
+    void AssetRegistry::Reserve(size_t recordCount)
+    {
+        m_records.reserve(recordCount);
+        m_guidIndex.reserve(recordCount);
+        m_assetPathIndex.reserve(recordCount);
+        m_sourcePathIndex.reserve(recordCount);
     }
 
     bool AssetRegistry::Load(const std::filesystem::path& path)
@@ -95,6 +112,8 @@ namespace Cyber
         if (!assets || !assets->is_array())
             return false;
 
+        std::vector<AssetRegistryRecord> records;
+        records.reserve(assets->size());
         for (const nlohmann::json& item : *assets)
         {
             if (!item.is_object())
@@ -122,9 +141,10 @@ namespace Cyber
             record.chunkId = item.value("chunkId", 0u);
 
             if (record.IsValid())
-                Upsert(record);
+                records.push_back(std::move(record));
         }
 
+        UpsertBatch(std::move(records));
         return true;
     }
 
@@ -141,8 +161,20 @@ namespace Cyber
         root["version"] = kAssetRegistryVersion;
         root["assets"] = nlohmann::json::array();
 
+        // Records are unordered in memory; sort on the way out so registry.json diffs stay stable.
+        std::vector<const AssetRegistryRecord*> sorted;
+        sorted.reserve(m_records.size());
         for (const AssetRegistryRecord& record : m_records)
+            sorted.push_back(&record);
+        std::sort(sorted.begin(), sorted.end(),
+            [](const AssetRegistryRecord* lhs, const AssetRegistryRecord* rhs)
+            {
+                return lhs->assetPath < rhs->assetPath;
+            });
+
+        for (const AssetRegistryRecord* sortedRecord : sorted)
         {
+            const AssetRegistryRecord& record = *sortedRecord;
             if (!record.IsValid())
                 continue;
 
@@ -173,77 +205,135 @@ namespace Cyber
     }
 
     void AssetRegistry::Upsert(const AssetRegistryRecord& record)
+    {
+        Upsert(AssetRegistryRecord(record));
+    }
+
+    void AssetRegistry::Upsert(AssetRegistryRecord&& record)
     {
         if (!record.IsValid())
             return;
 
-        AssetRegistryRecord normalized = record;
-        normalized.assetPath = NormalizePath(normalized.assetPath);
-        normalized.sourcePath = NormalizePath(normalized.sourcePath);
-        normalized.thumbnailPath = NormalizePath(normalized.thumbnailPath);
+        for (std::string* path : { &record.assetPath, &record.sourcePath, &record.thumbnailPath })
+        {
+            if (!is_normalized_path(*path))
+                *path = NormalizePath(*path);
+        }
 
-        auto it = std::find_if(m_records.begin(), m_records.end(),
-            [&](const AssetRegistryRecord& existing)
-            {
-                return existing.guid == normalized.guid ||
-                       NormalizePath(existing.assetPath) == normalized.assetPath;
-            });
+        // A record is replaced when either its GUID or its asset path is already registered.
+        // Asset paths stay unique, so a different record holding the path is dropped.
+        auto guidIt = m_guidIndex.find(record.guid);
+        auto pathIt = m_assetPathIndex.find(record.assetPath);
+        if (guidIt != m_guidIndex.end() && pathIt != m_assetPathIndex.end() && guidIt->second != pathIt->second)
+        {
+            RemoveSlot(pathIt->second);
+            guidIt = m_guidIndex.find(record.guid);
+            pathIt = m_assetPathIndex.end();
+        }
+
+        size_t slot = m_records.size();
+        if (guidIt != m_guidIndex.end())
+            slot = guidIt->second;
+        else if (pathIt != m_assetPathIndex.end())
+            slot = pathIt->second;
 
-        if (it != m_records.end())
-            *it = std::move(normalized);
+        if (slot == m_records.size())
+        {
+            m_records.push_back(std::move(record));
+        }
         else
-            m_records.push_back(std::move(normalized));
+        {
+            UnindexRecord(slot);
+            m_records[slot] = std::move(record);
+        }
+        IndexRecord(slot);
+    }
 
-        std::sort(m_records.begin(), m_records.end(),
-            [](const AssetRegistryRecord& lhs, const AssetRegistryRecord& rhs)
-            {
-                return lhs.assetPath < rhs.assetPath;
-            });
+    void AssetRegistry::UpsertBatch(std::vector<AssetRegistryRecord> records)
+    {
+        Reserve(m_records.size() + records.size());
+        for (AssetRegistryRecord& record : records)
+            Upsert(std::move(record));
     }
 
     bool AssetRegistry::Remove(AssetGuid guid)
     {
-        auto it = std::remove_if(m_records.begin(), m_records.end(),
-            [&](const AssetRegistryRecord& record) { return record.guid == guid; });
-        const bool removed = it != m_records.end();
-        m_records.erase(it, m_records.end());
-        return removed;
+        const auto it = m_guidIndex.find(guid);
+        if (it == m_guidIndex.end())
+            return false;
+        RemoveSlot(it->second);
+        return true;
     }
 
     const AssetRegistryRecord* AssetRegistry::Find(AssetGuid guid) const
     {
-        auto it = std::find_if(m_records.begin(), m_records.end(),
-            [&](const AssetRegistryRecord& record) { return record.guid == guid; });
-        return it == m_records.end() ? nullptr : &(*it);
+        const auto it = m_guidIndex.find(guid);
+        return it == m_guidIndex.end() ? nullptr : &m_records[it->second];
     }
 
     AssetRegistryRecord* AssetRegistry::Find(AssetGuid guid)
     {
-        auto it = std::find_if(m_records.begin(), m_records.end(),
-            [&](const AssetRegistryRecord& record) { return record.guid == guid; });
-        return it == m_records.end() ? nullptr : &(*it);
+        const auto it = m_guidIndex.find(guid);
+        return it == m_guidIndex.end() ? nullptr : &m_records[it->second];
     }
 
     const AssetRegistryRecord* AssetRegistry::FindByAssetPath(std::string_view assetPath) const
     {
-        const std::string normalized = NormalizePath(assetPath);
-        auto it = std::find_if(m_records.begin(), m_records.end(),
-            [&](const AssetRegistryRecord& record)
-            {
-                return NormalizePath(record.assetPath) == normalized;
-            });
-        return it == m_records.end() ? nullptr : &(*it);
+        const auto it = is_normalized_path(assetPath)
+            ? m_assetPathIndex.find(assetPath)
+            : m_assetPathIndex.find(NormalizePath(assetPath));
+        return it == m_assetPathIndex.end() ? nullptr : &m_records[it->second];
     }
 
     const AssetRegistryRecord* AssetRegistry::FindBySourcePath(std::string_view sourcePath) const
     {
-        const std::string normalized = NormalizePath(sourcePath);
-        auto it = std::find_if(m_records.begin(), m_records.end(),
-            [&](const AssetRegistryRecord& record)
+        const auto it = is_normalized_path(sourcePath)
+            ? m_sourcePathIndex.find(sourcePath)
+            : m_sourcePathIndex.find(NormalizePath(sourcePath));
+        return it == m_sourcePathIndex.end() ? nullptr : &m_records[it->second];
+    }
+
+    void AssetRegistry::IndexRecord(size_t slot)
+    {
+        const AssetRegistryRecord& record = m_records[slot];
+        m_guidIndex[record.guid] = slot;
+        m_assetPathIndex[record.assetPath] = slot;
+        if (!record.sourcePath.empty())
+            m_sourcePathIndex.emplace(record.sourcePath, slot);
+    }
+
+    void AssetRegistry::UnindexRecord(size_t slot)
+    {
+        const AssetRegistryRecord& record = m_records[slot];
+        m_guidIndex.erase(record.guid);
+        m_assetPathIndex.erase(record.assetPath);
+        auto [begin, end] = m_sourcePathIndex.equal_range(record.sourcePath);
+        for (auto it = begin; it != end; ++it)
+        {
+            if (it->second == slot)
             {
-                return NormalizePath(record.sourcePath) == normalized;
-            });
-        return it == m_records.end() ? nullptr : &(*it);
+                m_sourcePathIndex.erase(it);
+                break;
+            }
+        }
+    }
+
+    void AssetRegistry::RemoveSlot(size_t slot)
+    {
+        UnindexRecord(slot);
+        const size_t last = m_records.size() - 1;
+        if (slot != last)
+        {
+            // Move the last record into the hole and repoint its index entries
+            UnindexRecord(last);
+            m_records[slot] = std::move(m_records[last]);
+            m_records.pop_back();
+            IndexRecord(slot);
+        }
+        else
+        {
+            m_records.pop_back();
+        }
     }
 
     std::string AssetRegistry::NormalizePath(std::string_view path)
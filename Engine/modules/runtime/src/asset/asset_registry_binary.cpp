@@ -0,0 +1,319 @@
+#include "asset/asset_registry_binary.h"
+
+#include "asset/asset_hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Cyber
+{
+    namespace
+    {
+        constexpr uint64_t kSectionAlignment = 16;
+
+        uint64_t align_up(uint64_t value)
+        {
+            return (value + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+        }
+
+        bool section_inside(uint64_t offset, uint64_t count, uint64_t stride, uint64_t fileSize)
+        {
+            if (stride != 0 && count > std::numeric_limits<uint64_t>::max() / stride)
+                return false;
+            const uint64_t size = count * stride;
+            return offset <= fileSize && size <= fileSize - offset;
+        }
+
+        template <typename T>
+        std::span<const T> map_section(const uint8_t* data, uint64_t offset, uint64_t count)
+        {
+            return std::span<const T>(reinterpret_cast<const T*>(data + offset), static_cast<size_t>(count));
+        }
+
+        class StringTableBuilder
+        {
+        public:
+            bool Add(const std::string& value, AssetRegistryBinaryString& outString)
+            {
+                if (value.empty())
+                {
+                    outString = {};
+                    return true;
+                }
+                const auto it = m_offsets.find(value);
+                if (it != m_offsets.end())
+                {
+                    outString = { it->second, static_cast<uint32_t>(value.size()) };
+                    return true;
+                }
+                if (m_data.size() + value.size() > std::numeric_limits<uint32_t>::max())
+                    return false;
+                outString = { static_cast<uint32_t>(m_data.size()), static_cast<uint32_t>(value.size()) };
+                m_offsets.emplace(value, outString.offset);
+                m_data += value;
+                return true;
+            }
+
+            [[nodiscard]] const std::string& Data() const { return m_data; }
+
+        private:
+            std::unordered_map<std::string, uint32_t> m_offsets;
+            std::string m_data;
+        };
+    }
+
+    bool AssetRegistry::SaveBinary(const std::filesystem::path& path) const
+    {
+        std::vector<const AssetRegistryRecord*> sorted;
+        sorted.reserve(m_records.size());
+        for (const AssetRegistryRecord& record : m_records)
+        {
+            if (record.IsValid())
+                sorted.push_back(&record);
+        }
+        if (sorted.size() > std::numeric_limits<uint32_t>::max())
+            return false;
+        std::sort(sorted.begin(), sorted.end(),
+            [](const AssetRegistryRecord* lhs, const AssetRegistryRecord* rhs) { return lhs->guid < rhs->guid; });
+
+        StringTableBuilder strings;
+        std::vector<AssetRegistryBinaryRecord> records(sorted.size());
+        std::vector<AssetRegistryBinaryPathEntry> pathIndex(sorted.size());
+        std::vector<AssetGuid> dependencies;
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            const AssetRegistryRecord& source = *sorted[i];
+            AssetRegistryBinaryRecord& record = records[i];
+            record.guid = source.guid;
+            record.type = source.type;
+            record.importerVersion = source.importerVersion;
+            record.assetFormatVersion = source.assetFormatVersion;
+            record.chunkId = source.chunkId;
+            record.sourceHash = source.sourceHash;
+            record.editorAssetHash = source.editorAssetHash;
+            record.cookedAssetHash = source.cookedAssetHash;
+            if (!strings.Add(source.assetPath, record.assetPath) ||
+                !strings.Add(source.displayName, record.displayName) ||
+                !strings.Add(source.sourcePath, record.sourcePath) ||
+                !strings.Add(source.thumbnailPath, record.thumbnailPath) ||
+                !strings.Add(source.packageName, record.packageName))
+            {
+                return false;
+            }
+
+            record.firstDependency = static_cast<uint32_t>(dependencies.size());
+            for (AssetGuid dependency : source.dependencies)
+            {
+                if (dependency.IsValid())
+                    dependencies.push_back(dependency);
+            }
+            record.dependencyCount = static_cast<uint32_t>(dependencies.size()) - record.firstDependency;
+
+            pathIndex[i].pathHash = AssetRegistryBinaryView::HashPath(source.assetPath);
+            pathIndex[i].recordIndex = static_cast<uint32_t>(i);
+        }
+        std::sort(pathIndex.begin(), pathIndex.end(),
+            [](const AssetRegistryBinaryPathEntry& lhs, const AssetRegistryBinaryPathEntry& rhs)
+            {
+                return lhs.pathHash < rhs.pathHash ||
+                       (lhs.pathHash == rhs.pathHash && lhs.recordIndex < rhs.recordIndex);
+            });
+
+        AssetRegistryBinaryHeader header;
+        header.recordCount = static_cast<uint32_t>(records.size());
+        header.recordSize = sizeof(AssetRegistryBinaryRecord);
+        header.recordsOffset = align_up(sizeof(header));
+        header.pathIndexOffset = align_up(header.recordsOffset + records.size() * sizeof(AssetRegistryBinaryRecord));
+        header.dependenciesOffset = align_up(header.pathIndexOffset + pathIndex.size() * sizeof(AssetRegistryBinaryPathEntry));
+        header.dependencyCount = dependencies.size();
+        header.stringsOffset = align_up(header.dependenciesOffset + dependencies.size() * sizeof(AssetGuid));
+        header.stringsSize = strings.Data().size();
+
+        std::error_code ec;
+        const std::filesystem::path parent = path.parent_path();
+        if (!parent.empty())
+            std::filesystem::create_directories(parent, ec);
+        if (ec)
+            return false;
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        uint64_t written = 0;
+        const auto write_section = [&](uint64_t offset, const void* data, uint64_t size)
+        {
+            static constexpr char kZeros[kSectionAlignment] {};
+            file.write(kZeros, static_cast<std::streamsize>(offset - written));
+            if (size != 0)
+                file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            written = offset + size;
+        };
+        write_section(0, &header, sizeof(header));
+        write_section(header.recordsOffset, records.data(), records.size() * sizeof(AssetRegistryBinaryRecord));
+        write_section(header.pathIndexOffset, pathIndex.data(), pathIndex.size() * sizeof(AssetRegistryBinaryPathEntry));
+        write_section(header.dependenciesOffset, dependencies.data(), dependencies.size() * sizeof(AssetGuid));
+        write_section(header.stringsOffset, strings.Data().data(), strings.Data().size());
+        return file.good();
+    }
+
+    bool AssetRegistry::LoadBinary(const std::filesystem::path& path)
+    {
+        Clear();
+
+        AssetRegistryBinaryView view;
+        if (!view.Open(path))
+            return false;
+
+        std::vector<AssetRegistryRecord> records;
+        records.reserve(view.Records().size());
+        for (const AssetRegistryBinaryRecord& record : view.Records())
+            records.push_back(view.ToRecord(record));
+        UpsertBatch(std::move(records));
+        return true;
+    }
+
+    bool AssetRegistryBinaryView::Open(const std::filesystem::path& path)
+    {
+        Close();
+        if (!m_file.Open(path))
+            return false;
+
+        const uint8_t* data = m_file.Data();
+        const uint64_t fileSize = m_file.Size();
+        AssetRegistryBinaryHeader header;
+        if (fileSize < sizeof(header))
+        {
+            Close();
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(header));
+
+        if (header.magic != kAssetRegistryBinaryMagic ||
+            header.version != kAssetRegistryBinaryVersion ||
+            header.recordSize != sizeof(AssetRegistryBinaryRecord) ||
+            header.stringsSize > std::numeric_limits<uint32_t>::max() ||
+            header.recordsOffset % kSectionAlignment != 0 ||
+            header.pathIndexOffset % kSectionAlignment != 0 ||
+            header.dependenciesOffset % kSectionAlignment != 0 ||
+            !section_inside(header.recordsOffset, header.recordCount, sizeof(AssetRegistryBinaryRecord), fileSize) ||
+            !section_inside(header.pathIndexOffset, header.recordCount, sizeof(AssetRegistryBinaryPathEntry), fileSize) ||
+            !section_inside(header.dependenciesOffset, header.dependencyCount, sizeof(AssetGuid), fileSize) ||
+            !section_inside(header.stringsOffset, header.stringsSize, 1, fileSize))
+        {
+            Close();
+            return false;
+        }
+
+        m_records = map_section<AssetRegistryBinaryRecord>(data, header.recordsOffset, header.recordCount);
+        m_pathIndex = map_section<AssetRegistryBinaryPathEntry>(data, header.pathIndexOffset, header.recordCount);
+        m_dependencies = map_section<AssetGuid>(data, header.dependenciesOffset, header.dependencyCount);
+        m_strings = std::string_view(reinterpret_cast<const char*>(data + header.stringsOffset),
+                                     static_cast<size_t>(header.stringsSize));
+
+        // Validate every reference once so lookups never have to range check
+        const auto string_valid = [this](const AssetRegistryBinaryString& value)
+        {
+            return value.offset <= m_strings.size() && value.size <= m_strings.size() - value.offset;
+        };
+        for (const AssetRegistryBinaryRecord& record : m_records)
+        {
+            if (!string_valid(record.assetPath) || !string_valid(record.displayName) ||
+                !string_valid(record.sourcePath) || !string_valid(record.thumbnailPath) ||
+                !string_valid(record.packageName) ||
+                record.firstDependency > m_dependencies.size() ||
+                record.dependencyCount > m_dependencies.size() - record.firstDependency)
+            {
+                Close();
+                return false;
+            }
+        }
+        for (const AssetRegistryBinaryPathEntry& entry : m_pathIndex)
+        {
+            if (entry.recordIndex >= m_records.size())
+            {
+                Close();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void AssetRegistryBinaryView::Close()
+    {
+        m_records = {};
+        m_pathIndex = {};
+        m_dependencies = {};
+        m_strings = {};
+        m_file.Close();
+    }
+
+    const AssetRegistryBinaryRecord* AssetRegistryBinaryView::Find(AssetGuid guid) const
+    {
+        const auto it = std::lower_bound(m_records.begin(), m_records.end(), guid,
+            [](const AssetRegistryBinaryRecord& record, AssetGuid value) { return record.guid < value; });
+        return it != m_records.end() && it->guid == guid ? &(*it) : nullptr;
+    }
+
+    const AssetRegistryBinaryRecord* AssetRegistryBinaryView::FindByAssetPath(std::string_view assetPath) const
+    {
+        std::string normalizedStorage;
+        if (assetPath.find('\\') != std::string_view::npos || (assetPath.size() > 1 && assetPath.back() == '/'))
+        {
+            normalizedStorage = AssetRegistry::NormalizePath(assetPath);
+            assetPath = normalizedStorage;
+        }
+
+        const uint64_t hash = HashPath(assetPath);
+        auto it = std::lower_bound(m_pathIndex.begin(), m_pathIndex.end(), hash,
+            [](const AssetRegistryBinaryPathEntry& entry, uint64_t value) { return entry.pathHash < value; });
+        for (; it != m_pathIndex.end() && it->pathHash == hash; ++it)
+        {
+            const AssetRegistryBinaryRecord& record = m_records[it->recordIndex];
+            if (String(record.assetPath) == assetPath)
+                return &record;
+        }
+        return nullptr;
+    }
+
+    std::string_view AssetRegistryBinaryView::String(const AssetRegistryBinaryString& value) const
+    {
+        return m_strings.substr(value.offset, value.size);
+    }
+
+    std::span<const AssetGuid> AssetRegistryBinaryView::Dependencies(const AssetRegistryBinaryRecord& record) const
+    {
+        return m_dependencies.subspan(record.firstDependency, record.dependencyCount);
+    }
+
+    AssetRegistryRecord AssetRegistryBinaryView::ToRecord(const AssetRegistryBinaryRecord& record) const
+    {
+        AssetRegistryRecord out;
+        out.guid = record.guid;
+        out.type = record.type;
+        out.assetPath = String(record.assetPath);
+        out.displayName = String(record.displayName);
+        out.sourcePath = String(record.sourcePath);
+        out.sourceHash = record.sourceHash;
+        out.editorAssetHash = record.editorAssetHash;
+        out.cookedAssetHash = record.cookedAssetHash;
+        out.importerVersion = record.importerVersion;
+        out.assetFormatVersion = record.assetFormatVersion;
+        const std::span<const AssetGuid> dependencies = Dependencies(record);
+        out.dependencies.assign(dependencies.begin(), dependencies.end());
+        out.thumbnailPath = String(record.thumbnailPath);
+        out.packageName = String(record.packageName);
+        out.chunkId = record.chunkId;
+        return out;
+    }
+
+    uint64_t AssetRegistryBinaryView::HashPath(std::string_view normalizedPath)
+    {
+        return AssetHash::HashString(normalizedPath);
+    }
+}
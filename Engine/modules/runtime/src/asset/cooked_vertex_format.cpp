@@ -0,0 +1,412 @@
+#include "asset/cooked_mesh.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Cyber
+{
+    namespace
+    {
+        constexpr uint32_t kInvalidVertex = ~0u;
+
+        uint16_t format_size(CookedVertexFormat format)
+        {
+            switch (format)
+            {
+            case CookedVertexFormat::Float32x2: return 8;
+            case CookedVertexFormat::Float32x3: return 12;
+            case CookedVertexFormat::Float16x2: return 4;
+            case CookedVertexFormat::Unorm16x2: return 4;
+            case CookedVertexFormat::Unorm16x4: return 8;
+            case CookedVertexFormat::OctahedralSnorm16x2: return 4;
+            }
+            return 0;
+        }
+
+        bool attribute_fits(const CookedVertexAttribute& attribute, CookedVertexFormat a, CookedVertexFormat b,
+                            uint32_t stride)
+        {
+            if (attribute.format != a && attribute.format != b)
+                return false;
+            return attribute.offset % 4 == 0 && uint32_t(attribute.offset) + format_size(attribute.format) <= stride;
+        }
+
+        // IEEE binary16 with round-to-nearest-even; out-of-range values saturate to infinity.
+        uint16_t float_to_half(float value)
+        {
+            const uint32_t bits = std::bit_cast<uint32_t>(value);
+            const uint32_t sign = (bits >> 16) & 0x8000u;
+            const uint32_t magnitude = bits & 0x7fffffffu;
+            if (magnitude >= 0x7f800000u)
+                return static_cast<uint16_t>(sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x200u : 0u));
+            if (magnitude >= 0x477ff000u)
+                return static_cast<uint16_t>(sign | 0x7c00u);
+            if (magnitude < 0x38800000u)
+            {
+                // Subnormal half: shift the implicit-one mantissa into place and round
+                if (magnitude < 0x33000000u)
+                    return static_cast<uint16_t>(sign);
+                const uint32_t exponent = magnitude >> 23;
+                const uint32_t mantissa = (magnitude & 0x7fffffu) | 0x800000u;
+                const uint32_t shift = 126 - exponent;
+                uint32_t half = mantissa >> shift;
+                const uint32_t remainder = mantissa & ((1u << shift) - 1);
+                const uint32_t halfway = 1u << (shift - 1);
+                if (remainder > halfway || (remainder == halfway && (half & 1u)))
+                    ++half;
+                return static_cast<uint16_t>(sign | half);
+            }
+            uint32_t half = ((magnitude - 0x38000000u) >> 13);
+            const uint32_t remainder = magnitude & 0x1fffu;
+            if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+                ++half;
+            return static_cast<uint16_t>(sign | half);
+        }
+
+        float half_to_float(uint16_t half)
+        {
+            const uint32_t sign = uint32_t(half & 0x8000u) << 16;
+            const uint32_t exponent = (half >> 10) & 0x1fu;
+            uint32_t mantissa = half & 0x3ffu;
+            if (exponent == 0x1f)
+                return std::bit_cast<float>(sign | 0x7f800000u | (mantissa << 13));
+            if (exponent != 0)
+                return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+            if (mantissa == 0)
+                return std::bit_cast<float>(sign);
+            const float value = float(mantissa) * (1.0f / 16777216.0f);
+            return sign ? -value : value;
+        }
+
+        uint16_t to_unorm16(float value, float offset, float scale)
+        {
+            if (scale <= 0.0f)
+                return 0;
+            const float normalized = std::clamp((value - offset) / scale, 0.0f, 1.0f);
+            return static_cast<uint16_t>(std::lround(normalized * 65535.0f));
+        }
+
+        float from_unorm16(uint16_t value, float offset, float scale)
+        {
+            return offset + float(value) * (1.0f / 65535.0f) * scale;
+        }
+
+        float sign_not_zero(float value)
+        {
+            return value < 0.0f ? -1.0f : 1.0f;
+        }
+
+        // Zero vectors (missing tangents) come back as +Z.
+        void encode_octahedral(const float direction[3], int16_t out[2])
+        {
+            const float l1 = std::fabs(direction[0]) + std::fabs(direction[1]) + std::fabs(direction[2]);
+            float u = 0.0f;
+            float v = 0.0f;
+            if (l1 > 0.0f)
+            {
+                u = direction[0] / l1;
+                v = direction[1] / l1;
+                if (direction[2] < 0.0f)
+                {
+                    const float foldedU = (1.0f - std::fabs(v)) * sign_not_zero(u);
+                    const float foldedV = (1.0f - std::fabs(u)) * sign_not_zero(v);
+                    u = foldedU;
+                    v = foldedV;
+                }
+            }
+            out[0] = static_cast<int16_t>(std::lround(std::clamp(u, -1.0f, 1.0f) * 32767.0f));
+            out[1] = static_cast<int16_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * 32767.0f));
+        }
+
+        void decode_octahedral(const int16_t encoded[2], float out[3])
+        {
+            float u = std::max(float(encoded[0]) / 32767.0f, -1.0f);
+            float v = std::max(float(encoded[1]) / 32767.0f, -1.0f);
+            const float z = 1.0f - std::fabs(u) - std::fabs(v);
+            if (z < 0.0f)
+            {
+                const float foldedU = (1.0f - std::fabs(v)) * sign_not_zero(u);
+                const float foldedV = (1.0f - std::fabs(u)) * sign_not_zero(v);
+                u = foldedU;
+                v = foldedV;
+            }
+            const float length = std::sqrt(u * u + v * v + z * z);
+            out[0] = u / length;
+            out[1] = v / length;
+            out[2] = z / length;
+        }
+
+        void encode_direction(const CookedVertexAttribute& attribute, const float direction[3], uint8_t* vertex)
+        {
+            if (attribute.format == CookedVertexFormat::OctahedralSnorm16x2)
+            {
+                int16_t encoded[2];
+                encode_octahedral(direction, encoded);
+                std::memcpy(vertex + attribute.offset, encoded, sizeof(encoded));
+            }
+            else
+            {
+                std::memcpy(vertex + attribute.offset, direction, sizeof(float) * 3);
+            }
+        }
+
+        void decode_direction(const CookedVertexAttribute& attribute, const uint8_t* vertex, float out[3])
+        {
+            if (attribute.format == CookedVertexFormat::OctahedralSnorm16x2)
+            {
+                int16_t encoded[2];
+                std::memcpy(encoded, vertex + attribute.offset, sizeof(encoded));
+                decode_octahedral(encoded, out);
+            }
+            else
+            {
+                std::memcpy(out, vertex + attribute.offset, sizeof(float) * 3);
+            }
+        }
+
+        void encode_vertex(const CookedVertexLayout& layout, const CookedMeshVertex& source,
+                           const CookedMeshPrimitiveDecode& decode, uint8_t* vertex)
+        {
+            if (layout.position.format == CookedVertexFormat::Unorm16x4)
+            {
+                uint16_t position[4] {};
+                for (int i = 0; i < 3; ++i)
+                    position[i] = to_unorm16(source.position[i], decode.positionOffset[i], decode.positionScale[i]);
+                position[3] = 65535;
+                std::memcpy(vertex + layout.position.offset, position, sizeof(position));
+            }
+            else
+            {
+                std::memcpy(vertex + layout.position.offset, source.position, sizeof(source.position));
+            }
+
+            encode_direction(layout.normal, source.normal, vertex);
+            encode_direction(layout.tangent, source.tangent, vertex);
+
+            if (layout.uv0.format == CookedVertexFormat::Float16x2)
+            {
+                const uint16_t uv[2] { float_to_half(source.uv0[0]), float_to_half(source.uv0[1]) };
+                std::memcpy(vertex + layout.uv0.offset, uv, sizeof(uv));
+            }
+            else if (layout.uv0.format == CookedVertexFormat::Unorm16x2)
+            {
+                const uint16_t uv[2] { to_unorm16(source.uv0[0], decode.uvOffset[0], decode.uvScale[0]),
+                                       to_unorm16(source.uv0[1], decode.uvOffset[1], decode.uvScale[1]) };
+                std::memcpy(vertex + layout.uv0.offset, uv, sizeof(uv));
+            }
+            else
+            {
+                std::memcpy(vertex + layout.uv0.offset, source.uv0, sizeof(source.uv0));
+            }
+        }
+
+        void decode_vertex(const CookedVertexLayout& layout, const uint8_t* vertex,
+                           const CookedMeshPrimitiveDecode& decode, CookedMeshVertex& out)
+        {
+            if (layout.position.format == CookedVertexFormat::Unorm16x4)
+            {
+                uint16_t position[4];
+                std::memcpy(position, vertex + layout.position.offset, sizeof(position));
+                for (int i = 0; i < 3; ++i)
+                    out.position[i] = from_unorm16(position[i], decode.positionOffset[i], decode.positionScale[i]);
+            }
+            else
+            {
+                std::memcpy(out.position, vertex + layout.position.offset, sizeof(out.position));
+            }
+
+            decode_direction(layout.normal, vertex, out.normal);
+            decode_direction(layout.tangent, vertex, out.tangent);
+
+            if (layout.uv0.format == CookedVertexFormat::Float16x2)
+            {
+                uint16_t uv[2];
+                std::memcpy(uv, vertex + layout.uv0.offset, sizeof(uv));
+                out.uv0[0] = half_to_float(uv[0]);
+                out.uv0[1] = half_to_float(uv[1]);
+            }
+            else if (layout.uv0.format == CookedVertexFormat::Unorm16x2)
+            {
+                uint16_t uv[2];
+                std::memcpy(uv, vertex + layout.uv0.offset, sizeof(uv));
+                out.uv0[0] = from_unorm16(uv[0], decode.uvOffset[0], decode.uvScale[0]);
+                out.uv0[1] = from_unorm16(uv[1], decode.uvOffset[1], decode.uvScale[1]);
+            }
+            else
+            {
+                std::memcpy(out.uv0, vertex + layout.uv0.offset, sizeof(out.uv0));
+            }
+        }
+
+        CookedMeshPrimitiveDecode primitive_decode(const CookedMeshData& data, const CookedMeshPrimitive& primitive)
+        {
+            CookedMeshPrimitiveDecode decode;
+            if (primitive.indexCount == 0)
+                return decode;
+            float positionMin[3], positionMax[3], uvMin[2], uvMax[2];
+            const CookedMeshVertex& first = data.vertices[data.indices[primitive.firstIndex]];
+            std::copy(first.position, first.position + 3, positionMin);
+            std::copy(first.position, first.position + 3, positionMax);
+            std::copy(first.uv0, first.uv0 + 2, uvMin);
+            std::copy(first.uv0, first.uv0 + 2, uvMax);
+            for (uint32_t i = primitive.firstIndex; i < primitive.firstIndex + primitive.indexCount; ++i)
+            {
+                const CookedMeshVertex& vertex = data.vertices[data.indices[i]];
+                for (int c = 0; c < 3; ++c)
+                {
+                    positionMin[c] = std::min(positionMin[c], vertex.position[c]);
+                    positionMax[c] = std::max(positionMax[c], vertex.position[c]);
+                }
+                for (int c = 0; c < 2; ++c)
+                {
+                    uvMin[c] = std::min(uvMin[c], vertex.uv0[c]);
+                    uvMax[c] = std::max(uvMax[c], vertex.uv0[c]);
+                }
+            }
+            for (int c = 0; c < 3; ++c)
+            {
+                decode.positionOffset[c] = positionMin[c];
+                decode.positionScale[c] = positionMax[c] - positionMin[c];
+            }
+            for (int c = 0; c < 2; ++c)
+            {
+                decode.uvOffset[c] = uvMin[c];
+                decode.uvScale[c] = uvMax[c] - uvMin[c];
+            }
+            return decode;
+        }
+    }
+
+    bool IsValidCookedVertexLayout(const CookedVertexLayout& layout)
+    {
+        using F = CookedVertexFormat;
+        const bool uvValid = attribute_fits(layout.uv0, F::Float32x2, F::Float16x2, layout.stride) ||
+                             attribute_fits(layout.uv0, F::Unorm16x2, F::Unorm16x2, layout.stride);
+        return layout.stride != 0 && layout.stride % 4 == 0 && uvValid &&
+               attribute_fits(layout.position, F::Float32x3, F::Unorm16x4, layout.stride) &&
+               attribute_fits(layout.normal, F::Float32x3, F::OctahedralSnorm16x2, layout.stride) &&
+               attribute_fits(layout.tangent, F::Float32x3, F::OctahedralSnorm16x2, layout.stride);
+    }
+
+    CookedVertexLayout MakeCookedVertexLayout(const CookedVertexEncoding& encoding)
+    {
+        CookedVertexLayout layout;
+        uint16_t offset = 0;
+        const auto place = [&offset](CookedVertexAttribute& attribute, CookedVertexFormat format)
+        {
+            attribute.format = format;
+            attribute.offset = offset;
+            offset = static_cast<uint16_t>(offset + format_size(format));
+        };
+        const CookedVertexFormat direction = encoding.octahedralDirections ? CookedVertexFormat::OctahedralSnorm16x2
+                                                                           : CookedVertexFormat::Float32x3;
+        place(layout.position, encoding.quantizePositions ? CookedVertexFormat::Unorm16x4 : CookedVertexFormat::Float32x3);
+        place(layout.normal, direction);
+        switch (encoding.uv0)
+        {
+        case CookedVertexUvEncoding::Float16: place(layout.uv0, CookedVertexFormat::Float16x2); break;
+        case CookedVertexUvEncoding::Unorm16: place(layout.uv0, CookedVertexFormat::Unorm16x2); break;
+        default: place(layout.uv0, CookedVertexFormat::Float32x2); break;
+        }
+        place(layout.tangent, direction);
+        layout.stride = offset;
+        return layout;
+    }
+
+    void EncodeCookedVertices(CookedMeshData& data, const CookedVertexLayout& layout,
+                              std::vector<uint8_t>& outBytes, std::vector<CookedMeshPrimitiveDecode>& outDecode)
+    {
+        outBytes.clear();
+        outDecode.clear();
+        const CookedMeshPrimitiveDecode identity {};
+        if (!layout.IsPrimitiveRelative())
+        {
+            outBytes.resize(data.vertices.size() * layout.stride);
+            for (size_t i = 0; i < data.vertices.size(); ++i)
+                encode_vertex(layout, data.vertices[i], identity, outBytes.data() + i * layout.stride);
+            return;
+        }
+
+        // Give every primitive its own copy of the vertices it shares with an earlier one, in
+        // first-use order so the optimizer's fetch order survives.
+        outDecode.reserve(data.primitives.size());
+        std::vector<uint32_t> owner(data.vertices.size(), kInvalidVertex);
+        std::vector<uint32_t> remap(data.vertices.size(), kInvalidVertex);
+        std::vector<CookedMeshVertex> vertices;
+        vertices.reserve(data.vertices.size());
+        for (uint32_t p = 0; p < data.primitives.size(); ++p)
+        {
+            const CookedMeshPrimitive& primitive = data.primitives[p];
+            const CookedMeshPrimitiveDecode decode = primitive_decode(data, primitive);
+            outDecode.push_back(decode);
+            const auto encode_range = [&](uint32_t firstIndex, uint32_t indexCount)
+            {
+                for (uint32_t i = firstIndex; i < firstIndex + indexCount; ++i)
+                {
+                    const uint32_t source = data.indices[i];
+                    if (owner[source] != p)
+                    {
+                        owner[source] = p;
+                        remap[source] = static_cast<uint32_t>(vertices.size());
+                        vertices.push_back(data.vertices[source]);
+                        outBytes.resize(vertices.size() * layout.stride);
+                        encode_vertex(layout, vertices.back(), decode, outBytes.data() + remap[source] * layout.stride);
+                    }
+                    data.indices[i] = remap[source];
+                }
+            };
+            encode_range(primitive.firstIndex, primitive.indexCount);
+            // LOD levels only reference the primitive's own vertices
+            if (p < data.primitiveLods.size())
+            {
+                const CookedMeshPrimitiveLods& range = data.primitiveLods[p];
+                for (uint32_t l = range.firstLod; l < range.firstLod + range.lodCount; ++l)
+                    encode_range(data.lods[l].firstIndex, data.lods[l].indexCount);
+            }
+        }
+        data.vertices = std::move(vertices);
+    }
+
+    bool DecodeCookedVertices(const CookedVertexLayout& layout, std::span<const uint8_t> bytes,
+                              std::span<const uint32_t> indices, std::span<const CookedMeshPrimitive> primitives,
+                              std::span<const CookedMeshPrimitiveDecode> decode, std::vector<CookedMeshVertex>& outVertices)
+    {
+        outVertices.clear();
+        if (!IsValidCookedVertexLayout(layout) || bytes.size() % layout.stride != 0)
+            return false;
+        const size_t vertexCount = bytes.size() / layout.stride;
+        outVertices.resize(vertexCount);
+
+        const CookedMeshPrimitiveDecode identity {};
+        if (!layout.IsPrimitiveRelative())
+        {
+            for (size_t i = 0; i < vertexCount; ++i)
+                decode_vertex(layout, bytes.data() + i * layout.stride, identity, outVertices[i]);
+            return true;
+        }
+
+        if (decode.size() != primitives.size())
+            return false;
+        std::vector<uint8_t> decoded(vertexCount, 0);
+        for (size_t p = 0; p < primitives.size(); ++p)
+        {
+            const CookedMeshPrimitive& primitive = primitives[p];
+            if (primitive.firstIndex > indices.size() || primitive.indexCount > indices.size() - primitive.firstIndex)
+                return false;
+            for (uint32_t i = primitive.firstIndex; i < primitive.firstIndex + primitive.indexCount; ++i)
+            {
+                const uint32_t vertex = indices[i];
+                if (vertex >= vertexCount)
+                    return false;
+                if (decoded[vertex])
+                    continue;
+                decoded[vertex] = 1;
+                decode_vertex(layout, bytes.data() + size_t(vertex) * layout.stride, decode[p], outVertices[vertex]);
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,331 @@
+#include "asset/derived_data_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+
+namespace Cyber
+{
+    namespace
+    {
+        struct DerivedDataEntryHeader
+        {
+            uint32_t magic = kDerivedDataEntryMagic;
+            uint32_t version = kDerivedDataEntryVersion;
+            AssetHash128 key {};
+            uint64_t payloadSize = 0;
+            uint64_t payloadHash = 0;
+        };
+
+        enum class EntryReadResult
+        {
+            Missing,
+            Corrupt,
+            Valid,
+        };
+
+        // Temporary files this old were left by a writer that died before renaming them
+        constexpr auto kStaleTemporaryAge = std::chrono::hours(24);
+
+        std::string entry_name(const AssetHash128& digest)
+        {
+            static constexpr char kHex[] = "0123456789abcdef";
+            std::string name(32, '0');
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                name[i] = kHex[(digest.high >> (60 - i * 4)) & 0xf];
+                name[16 + i] = kHex[(digest.low >> (60 - i * 4)) & 0xf];
+            }
+            return name;
+        }
+
+        int64_t now_ticks()
+        {
+            return static_cast<int64_t>(std::filesystem::file_time_type::clock::now().time_since_epoch().count());
+        }
+
+        EntryReadResult read_entry(const std::filesystem::path& path, const AssetHash128& digest,
+                                   std::vector<uint8_t>& outData)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+                return EntryReadResult::Missing;
+
+            std::error_code ec;
+            const uint64_t fileSize = std::filesystem::file_size(path, ec);
+            DerivedDataEntryHeader header;
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+            if (ec || !file || header.magic != kDerivedDataEntryMagic || header.version != kDerivedDataEntryVersion ||
+                header.key != digest || header.payloadSize != fileSize - sizeof(header))
+                return EntryReadResult::Corrupt;
+
+            outData.resize(static_cast<size_t>(header.payloadSize));
+            if (!outData.empty())
+                file.read(reinterpret_cast<char*>(outData.data()), static_cast<std::streamsize>(outData.size()));
+            if (!file || AssetHash::HashContent(outData.data(), outData.size(), AssetHashAlgorithm::XXH3_64) != header.payloadHash)
+            {
+                outData.clear();
+                return EntryReadResult::Corrupt;
+            }
+            return EntryReadResult::Valid;
+        }
+
+        // Readers either see no entry or a complete one: the bytes go to a uniquely named temporary
+        // file first, which is then renamed over the entry.
+        bool write_entry(const std::filesystem::path& path, const AssetHash128& digest, std::span<const uint8_t> data)
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(path.parent_path(), ec);
+            if (ec)
+                return false;
+
+            std::filesystem::path tempPath = path;
+            tempPath += "." + AssetGuid::Create().ToString() + ".tmp";
+            {
+                std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+                if (!file)
+                    return false;
+                DerivedDataEntryHeader header;
+                header.key = digest;
+                header.payloadSize = data.size();
+                header.payloadHash = AssetHash::HashContent(data.data(), data.size(), AssetHashAlgorithm::XXH3_64);
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                if (!data.empty())
+                    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+                file.close();
+                if (!file)
+                {
+                    std::filesystem::remove(tempPath, ec);
+                    return false;
+                }
+            }
+
+            std::filesystem::rename(tempPath, path, ec);
+            if (ec)
+            {
+                // Another writer may have renamed the same entry into place first
+                std::filesystem::remove(tempPath, ec);
+                return std::filesystem::exists(path, ec);
+            }
+            return true;
+        }
+    }
+
+    AssetHash128 DerivedDataKey::Digest() const
+    {
+        AssetHasher hasher(AssetHashAlgorithm::XXH3_64);
+        hasher.Update(&kind, sizeof(kind));
+        hasher.Update(&platformTag, sizeof(platformTag));
+        hasher.Update(&assetGuid.high, sizeof(assetGuid.high));
+        hasher.Update(&assetGuid.low, sizeof(assetGuid.low));
+        hasher.Update(&contentHash, sizeof(contentHash));
+        hasher.Update(&settingsHash, sizeof(settingsHash));
+        hasher.Update(&dependencyHash, sizeof(dependencyHash));
+        hasher.Update(&cookerVersion, sizeof(cookerVersion));
+        return hasher.Digest128();
+    }
+
+    std::filesystem::path DerivedDataCache::EntryPath(const std::filesystem::path& root, const AssetHash128& digest)
+    {
+        const std::string name = entry_name(digest);
+        return root / name.substr(0, 2) / (name + ".ddc");
+    }
+
+    bool DerivedDataCache::Open(const DerivedDataCacheSettings& settings)
+    {
+        std::lock_guard lock(m_mutex);
+        m_settings = settings;
+        m_entries.clear();
+        m_localSize = 0;
+        m_stats = {};
+        if (m_settings.localPath.empty())
+            return false;
+
+        std::error_code ec;
+        std::filesystem::create_directories(m_settings.localPath, ec);
+        if (ec)
+            return false;
+
+        // Recency survives restarts as the entries' write times, which every hit refreshes
+        const auto staleBefore = std::filesystem::file_time_type::clock::now() - kStaleTemporaryAge;
+        for (auto it = std::filesystem::recursive_directory_iterator(m_settings.localPath, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+        {
+            if (!it->is_regular_file(ec))
+                continue;
+            const std::filesystem::path& path = it->path();
+            const auto writeTime = it->last_write_time(ec);
+            if (ec)
+                continue;
+            if (path.extension() == ".tmp")
+            {
+                if (writeTime < staleBefore)
+                    std::filesystem::remove(path, ec);
+                continue;
+            }
+            if (path.extension() != ".ddc")
+                continue;
+
+            const uint64_t size = it->file_size(ec);
+            if (ec)
+                continue;
+            m_entries[path.stem().string()] = Entry { size, static_cast<int64_t>(writeTime.time_since_epoch().count()) };
+            m_localSize += size;
+        }
+        if (ec)
+            return false;
+
+        TrimLocked();
+        return true;
+    }
+
+    bool DerivedDataCache::Get(const DerivedDataKey& key, std::vector<uint8_t>& outData)
+    {
+        const AssetHash128 digest = key.Digest();
+        const std::string name = entry_name(digest);
+        const std::filesystem::path localPath = EntryPath(m_settings.localPath, digest);
+        std::error_code ec;
+
+        EntryReadResult result = read_entry(localPath, digest, outData);
+        if (result == EntryReadResult::Valid)
+        {
+            Touch(name, localPath, sizeof(DerivedDataEntryHeader) + outData.size());
+            std::lock_guard lock(m_mutex);
+            ++m_stats.localHits;
+            return true;
+        }
+        {
+            // A missing file can still be indexed when a trim removed it between a Put's rename and
+            // its registration; drop the entry so its size stops counting
+            if (result == EntryReadResult::Corrupt)
+                std::filesystem::remove(localPath, ec);
+            std::lock_guard lock(m_mutex);
+            const auto it = m_entries.find(name);
+            if (it != m_entries.end())
+            {
+                m_localSize -= it->second.size;
+                m_entries.erase(it);
+            }
+            if (result == EntryReadResult::Corrupt)
+                ++m_stats.corrupt;
+        }
+
+        if (!m_settings.sharedPath.empty())
+        {
+            const std::filesystem::path sharedPath = EntryPath(m_settings.sharedPath, digest);
+            result = read_entry(sharedPath, digest, outData);
+            if (result == EntryReadResult::Valid)
+            {
+                if (write_entry(localPath, digest, outData))
+                    Touch(name, localPath, sizeof(DerivedDataEntryHeader) + outData.size());
+                std::lock_guard lock(m_mutex);
+                ++m_stats.sharedHits;
+                TrimLocked();
+                return true;
+            }
+            if (result == EntryReadResult::Corrupt)
+            {
+                // Entries are renamed into place whole, so this one will not heal; let a writer replace it
+                std::filesystem::remove(sharedPath, ec);
+                std::lock_guard lock(m_mutex);
+                ++m_stats.corrupt;
+            }
+        }
+
+        outData.clear();
+        std::lock_guard lock(m_mutex);
+        ++m_stats.misses;
+        return false;
+    }
+
+    bool DerivedDataCache::Put(const DerivedDataKey& key, std::span<const uint8_t> data)
+    {
+        const AssetHash128 digest = key.Digest();
+        const std::filesystem::path localPath = EntryPath(m_settings.localPath, digest);
+        if (!write_entry(localPath, digest, data))
+            return false;
+
+        if (!m_settings.sharedPath.empty() && m_settings.writeShared)
+        {
+            // Entries are immutable for their key, so an existing shared entry is already right
+            std::error_code ec;
+            const std::filesystem::path sharedPath = EntryPath(m_settings.sharedPath, digest);
+            if (!std::filesystem::exists(sharedPath, ec))
+                (void)write_entry(sharedPath, digest, data);
+        }
+
+        const std::string name = entry_name(digest);
+        std::lock_guard lock(m_mutex);
+        Entry& entry = m_entries[name];
+        m_localSize -= entry.size;
+        entry.size = sizeof(DerivedDataEntryHeader) + data.size();
+        entry.lastUse = now_ticks();
+        m_localSize += entry.size;
+        ++m_stats.puts;
+        TrimLocked();
+        return true;
+    }
+
+    void DerivedDataCache::Trim()
+    {
+        std::lock_guard lock(m_mutex);
+        TrimLocked();
+    }
+
+    uint64_t DerivedDataCache::LocalSize() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_localSize;
+    }
+
+    DerivedDataCacheStats DerivedDataCache::Stats() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_stats;
+    }
+
+    void DerivedDataCache::Touch(const std::string& name, const std::filesystem::path& path, uint64_t size)
+    {
+        const int64_t lastUse = now_ticks();
+        {
+            std::lock_guard lock(m_mutex);
+            Entry& entry = m_entries[name];
+            m_localSize += size - entry.size;
+            entry.size = size;
+            entry.lastUse = lastUse;
+        }
+        std::error_code ec;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type(
+            std::filesystem::file_time_type::duration(lastUse)), ec);
+    }
+
+    void DerivedDataCache::TrimLocked()
+    {
+        if (m_settings.maxLocalBytes == 0 || m_localSize <= m_settings.maxLocalBytes)
+            return;
+
+        // Trim a tenth below the cap so a full store does not sort its index on every put
+        const uint64_t target = m_settings.maxLocalBytes - m_settings.maxLocalBytes / 10;
+        std::vector<std::pair<int64_t, std::string>> byAge;
+        byAge.reserve(m_entries.size());
+        for (const auto& [name, entry] : m_entries)
+            byAge.emplace_back(entry.lastUse, name);
+        std::sort(byAge.begin(), byAge.end());
+
+        // Files go while the lock is held: once it is released, a Put of the same key can rename a
+        // fresh entry into place and register it, and a late delete would remove that file instead
+        std::error_code ec;
+        for (const auto& [lastUse, name] : byAge)
+        {
+            if (m_localSize <= target)
+                break;
+            const auto it = m_entries.find(name);
+            m_localSize -= it->second.size;
+            ++m_stats.evicted;
+            m_stats.evictedBytes += it->second.size;
+            m_entries.erase(it);
+            std::filesystem::remove(m_settings.localPath / name.substr(0, 2) / (name + ".ddc"), ec);
+        }
+    }
+}
@@ -1,6 +1,9 @@
 #include "asset/mesh_importer.h"
 
 #include "asset/asset_hash.h"
+#include "asset/derived_data_cache.h"
+#include "asset/mapped_file.h"
+#include "asset/mesh_optimizer.h"
 #include "ofbx.h"
 
 #define TINYGLTF_NOEXCEPTION
@@ -17,6 +20,7 @@
 #include <cstring>
 #include <fstream>
 #include <limits>
+#include <span>
 #include <unordered_map>
 
 namespace Cyber
@@ -195,7 +199,9 @@ namespace Cyber
             return result;
         }
 
-        bool cook_fbx(const std::vector<uint8_t>& sourceBytes, CookedMeshData& outData,
+        // OpenFBX copies the whole input into its own buffer, so the mapping is closed as soon as
+        // the scene is parsed when nothing later in the import reads it.
+        bool cook_fbx(std::span<const uint8_t> source, MappedFile* releaseSource, CookedMeshData& outData,
                       std::string& outError)
         {
             ofbx::LoadFlags flags = ofbx::LoadFlags::IGNORE_BLEND_SHAPES |
@@ -211,8 +217,10 @@ namespace Cyber
                                     ofbx::LoadFlags::IGNORE_LIMBS;
 
             std::unique_ptr<ofbx::IScene, void(*)(ofbx::IScene*)> scene(
-                ofbx::load(sourceBytes.data(), sourceBytes.size(), static_cast<ofbx::u16>(flags)),
+                ofbx::load(source.data(), source.size(), static_cast<ofbx::u16>(flags)),
                 [](ofbx::IScene* value) { if (value) value->destroy(); });
+            if (releaseSource)
+                releaseSource->Close();
             if (!scene)
             {
                 outError = std::string("OpenFBX failed: ") + ofbx::getError();
@@ -587,8 +595,8 @@ namespace Cyber
                 append_gltf_node(model, child, world, outData);
         }
 
-        bool cook_gltf(const std::filesystem::path& sourcePath, CookedMeshData& outData,
-                       std::string& outError)
+        bool cook_gltf(const std::filesystem::path& sourcePath, std::span<const uint8_t> source,
+                       CookedMeshData& outData, std::string& outError)
         {
             tinygltf::TinyGLTF loader;
             loader.SetImageLoader(
@@ -597,11 +605,19 @@ namespace Cyber
                 nullptr);
             tinygltf::Model model;
             std::string warning;
+            // Parse straight from the mapped source rather than letting tinygltf read its own copy
+            const bool isBinary = lowercase(sourcePath.extension().string()) == ".glb";
+            const std::string baseDir = sourcePath.parent_path().string();
             bool loaded = false;
-            if (lowercase(sourcePath.extension().string()) == ".glb")
-                loaded = loader.LoadBinaryFromFile(&model, &outError, &warning, sourcePath.string());
+            if (source.size() > std::numeric_limits<unsigned int>::max())
+                outError = "glTF source exceeds 4 GB.";
+            else if (isBinary)
+                loaded = loader.LoadBinaryFromMemory(&model, &outError, &warning, source.data(),
+                                                     static_cast<unsigned int>(source.size()), baseDir);
             else
-                loaded = loader.LoadASCIIFromFile(&model, &outError, &warning, sourcePath.string());
+                loaded = loader.LoadASCIIFromString(&model, &outError, &warning,
+                                                    reinterpret_cast<const char*>(source.data()),
+                                                    static_cast<unsigned int>(source.size()), baseDir);
             if (!loaded)
             {
                 if (outError.empty())
@@ -631,16 +647,15 @@ namespace Cyber
             return true;
         }
 
-        bool cook_source(const std::filesystem::path& sourcePath,
-                         const std::vector<uint8_t>& sourceBytes,
-                         CookedMeshData& outData, std::string& outError)
+        bool cook_source(const std::filesystem::path& sourcePath, std::span<const uint8_t> source,
+                         MappedFile* releaseSource, CookedMeshData& outData, std::string& outError)
         {
             outData = {};
             const std::string extension = lowercase(sourcePath.extension().string());
             if (extension == ".fbx")
-                return cook_fbx(sourceBytes, outData, outError);
+                return cook_fbx(source, releaseSource, outData, outError);
             if (extension == ".gltf" || extension == ".glb")
-                return cook_gltf(sourcePath, outData, outError);
+                return cook_gltf(sourcePath, source, outData, outError);
             outError = "Unsupported mesh source extension.";
             return false;
         }
@@ -652,8 +667,10 @@ namespace Cyber
         }
 
         bool write_cooked_asset(const AssetImportRequest& request,
-                                const std::vector<uint8_t>& sourceBytes,
+                                std::span<const uint8_t> source,
                                 CookedMeshData& cookedData,
+                                uint64_t contentHash,
+                                uint64_t dependencyHash,
                                 AssetGuid assetGuid,
                                 AssetFileHeader& outHeader)
         {
@@ -661,45 +678,80 @@ namespace Cyber
             if (sourceExtension.size() > 64)
                 return false;
 
+            // Sections start on 16-byte file offsets so CookedMeshView can read them in place.
+            const auto align_section = [](uint64_t payloadCursor)
+            {
+                constexpr uint64_t payloadOffset = sizeof(AssetFileHeader);
+                return (payloadOffset + payloadCursor + kCookedMeshSectionAlignment - 1) /
+                       kCookedMeshSectionAlignment * kCookedMeshSectionAlignment - payloadOffset;
+            };
+
+            // Compact layouts may duplicate vertices shared between primitives, so encode first
+            const CookedVertexLayout vertexLayout = MakeCookedVertexLayout(request.vertexEncoding);
+            std::vector<uint8_t> vertexBytes;
+            std::vector<CookedMeshPrimitiveDecode> primitiveDecode;
+            if (!vertexLayout.IsFloat())
+                EncodeCookedVertices(cookedData, vertexLayout, vertexBytes, primitiveDecode);
+
             MeshAssetPayloadHeader payload;
             payload.sourceExtensionSize = static_cast<uint32_t>(sourceExtension.size());
-            uint64_t cursor = sizeof(payload) + sourceExtension.size();
+            payload.vertexStride = vertexLayout.stride;
+            payload.vertexLayout = vertexLayout;
+            uint64_t cursor = align_section(sizeof(payload) + sourceExtension.size());
             payload.verticesOffset = cursor;
             payload.vertexCount = cookedData.vertices.size();
-            cursor += section_size(cookedData.vertices);
+            cursor = align_section(cursor + payload.vertexCount * vertexLayout.stride);
             payload.indicesOffset = cursor;
             payload.indexCount = cookedData.indices.size();
-            cursor += section_size(cookedData.indices);
+            cursor = align_section(cursor + section_size(cookedData.indices));
             payload.meshesOffset = cursor;
             payload.meshCount = cookedData.meshes.size();
-            cursor += section_size(cookedData.meshes);
+            cursor = align_section(cursor + section_size(cookedData.meshes));
             payload.primitivesOffset = cursor;
             payload.primitiveCount = cookedData.primitives.size();
-            cursor += section_size(cookedData.primitives);
+            cursor = align_section(cursor + section_size(cookedData.primitives));
+            payload.primitiveDecodeOffset = cursor;
+            payload.primitiveDecodeCount = primitiveDecode.size();
+            cursor = align_section(cursor + section_size(primitiveDecode));
+            payload.primitiveLodsOffset = cursor;
+            payload.primitiveLodsCount = cookedData.primitiveLods.size();
+            cursor = align_section(cursor + section_size(cookedData.primitiveLods));
+            payload.lodsOffset = cursor;
+            payload.lodCount = cookedData.lods.size();
+            cursor = align_section(cursor + section_size(cookedData.lods));
             payload.materialsOffset = cursor;
             payload.materialCount = cookedData.materials.size();
-            cursor += section_size(cookedData.materials);
+            cursor = align_section(cursor + section_size(cookedData.materials));
             payload.texturesOffset = cursor;
             payload.textureCount = cookedData.textures.size();
-            cursor += static_cast<uint64_t>(cookedData.textures.size()) * sizeof(CookedMeshTextureRecord);
+            cursor = align_section(cursor + static_cast<uint64_t>(cookedData.textures.size()) * sizeof(CookedMeshTextureRecord));
             payload.textureDataOffset = cursor;
 
             std::vector<CookedMeshTextureRecord> textureRecords;
             textureRecords.reserve(cookedData.textures.size());
             for (auto& texture : cookedData.textures)
             {
+                cursor = align_section(cursor);
                 texture.record.dataOffset = cursor;
                 texture.record.dataSize = texture.bytes.size();
                 textureRecords.push_back(texture.record);
                 cursor += texture.bytes.size();
             }
             payload.textureDataSize = cursor - payload.textureDataOffset;
+            if (request.sourceStorage == AssetSourceStorage::Embedded)
+            {
+                cursor = align_section(cursor);
+                payload.sourceDataOffset = cursor;
+                payload.sourceDataSize = source.size();
+                cursor += source.size();
+            }
 
             AssetFileHeader fileHeader;
             fileHeader.assetType = AssetType::Mesh;
             fileHeader.assetGuid = assetGuid.IsValid() ? assetGuid : AssetGuid::Create();
-            fileHeader.contentHash = AssetHash::HashBytes(sourceBytes.data(), sourceBytes.size());
-            fileHeader.dependencyHash = AssetHash::HashString(request.sourcePath.generic_string());
+            fileHeader.contentHash = contentHash;
+            fileHeader.contentHashAlgorithm = kDefaultContentHashAlgorithm;
+            fileHeader.dependencyHash = dependencyHash;
             fileHeader.cookerVersion = kMeshImporterVersion;
             fileHeader.platformTag = kAnyAssetPlatform;
             fileHeader.payloadOffset = sizeof(AssetFileHeader);
@@ -711,29 +763,79 @@ namespace Cyber
             if (ec)
                 return false;
 
-            std::ofstream file(request.destinationPath, std::ios::binary | std::ios::trunc);
+            // Sections go straight from the cooked vectors and the mapped source to a temporary file
+            // that replaces the asset only once complete.
+            std::filesystem::path tempPath = request.destinationPath;
+            tempPath += ".tmp";
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
             if (!file)
                 return false;
-            auto write_vector = [&](const auto& values)
+            uint64_t written = 0;
+            auto write_vector = [&](uint64_t offset, const auto& values)
             {
+                static constexpr char kZeros[kCookedMeshSectionAlignment] {};
+                file.write(kZeros, static_cast<std::streamsize>(offset - written));
                 if (!values.empty())
                     file.write(reinterpret_cast<const char*>(values.data()),
                                static_cast<std::streamsize>(values.size() * sizeof(values[0])));
+                written = offset + values.size() * sizeof(values[0]);
             };
 
             file.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
             file.write(reinterpret_cast<const char*>(&payload), sizeof(payload));
             file.write(sourceExtension.data(), static_cast<std::streamsize>(sourceExtension.size()));
-            write_vector(cookedData.vertices);
-            write_vector(cookedData.indices);
-            write_vector(cookedData.meshes);
-            write_vector(cookedData.primitives);
-            write_vector(cookedData.materials);
-            write_vector(textureRecords);
+            written = sizeof(payload) + sourceExtension.size();
+            if (vertexLayout.IsFloat())
+                write_vector(payload.verticesOffset, cookedData.vertices);
+            else
+                write_vector(payload.verticesOffset, vertexBytes);
+            write_vector(payload.indicesOffset, cookedData.indices);
+            write_vector(payload.meshesOffset, cookedData.meshes);
+            write_vector(payload.primitivesOffset, cookedData.primitives);
+            write_vector(payload.primitiveDecodeOffset, primitiveDecode);
+            write_vector(payload.primitiveLodsOffset, cookedData.primitiveLods);
+            write_vector(payload.lodsOffset, cookedData.lods);
+            write_vector(payload.materialsOffset, cookedData.materials);
+            write_vector(payload.texturesOffset, textureRecords);
             for (const auto& texture : cookedData.textures)
-                write_vector(texture.bytes);
-            if (!file.good())
+                write_vector(texture.record.dataOffset, texture.bytes);
+            if (payload.sourceDataSize != 0)
+            {
+                constexpr size_t kSourceChunkSize = size_t(64) << 20;
+                write_vector(payload.sourceDataOffset, std::span<const uint8_t> {});
+                for (size_t offset = 0; offset < source.size() && file; offset += kSourceChunkSize)
+                {
+                    const size_t count = std::min(kSourceChunkSize, source.size() - offset);
+                    file.write(reinterpret_cast<const char*>(source.data() + offset), static_cast<std::streamsize>(count));
+                }
+            }
+            file.close();
+            if (!file)
+            {
+                std::filesystem::remove(tempPath, ec);
                 return false;
+            }
+            std::filesystem::rename(tempPath, request.destinationPath, ec);
+            if (ec)
+            {
+                std::filesystem::remove(tempPath, ec);
+                return false;
+            }
+
+            const std::filesystem::path sideCarPath =
+                MeshImporter::SideCarSourcePath(request.destinationPath, sourceExtension);
+            if (request.sourceStorage == AssetSourceStorage::SideCar)
+            {
+                std::filesystem::copy_file(request.sourcePath, sideCarPath,
+                                           std::filesystem::copy_options::overwrite_existing, ec);
+                if (ec)
+                    return false;
+            }
+            else
+            {
+                // A side-car left from an earlier import would no longer match the asset
+                std::filesystem::remove(sideCarPath, ec);
+            }
             outHeader = fileHeader;
             return true;
         }
@@ -761,6 +863,179 @@ namespace Cyber
             return static_cast<bool>(file);
         }
 
+        template <typename T>
+        std::span<const T> map_section(const uint8_t* payload, uint64_t offset, uint64_t count)
+        {
+            return std::span<const T>(reinterpret_cast<const T*>(payload + offset), static_cast<size_t>(count));
+        }
+
+        bool validate_cooked_ranges(size_t vertexCount, std::span<const uint32_t> indices,
+                                    std::span<const CookedMeshRecord> meshes,
+                                    std::span<const CookedMeshPrimitive> primitives,
+                                    std::span<const CookedMeshPrimitiveLods> primitiveLods,
+                                    std::span<const CookedMeshLod> lods,
+                                    size_t materialCount, std::string* outError)
+        {
+            for (uint32_t index : indices)
+            {
+                if (index >= vertexCount)
+                {
+                    set_error(outError, "Cooked mesh contains an invalid vertex index.");
+                    return false;
+                }
+            }
+            for (const auto& mesh : meshes)
+            {
+                if (mesh.firstPrimitive > primitives.size() ||
+                    mesh.primitiveCount > primitives.size() - mesh.firstPrimitive)
+                {
+                    set_error(outError, "Cooked mesh contains an invalid primitive range.");
+                    return false;
+                }
+            }
+            for (const auto& primitive : primitives)
+            {
+                if (primitive.firstIndex > indices.size() ||
+                    primitive.indexCount > indices.size() - primitive.firstIndex ||
+                    primitive.materialIndex >= materialCount)
+                {
+                    set_error(outError, "Cooked mesh primitive references invalid data.");
+                    return false;
+                }
+            }
+            if (!primitiveLods.empty() && primitiveLods.size() != primitives.size())
+            {
+                set_error(outError, "Cooked mesh LOD table does not match its primitives.");
+                return false;
+            }
+            for (const auto& range : primitiveLods)
+            {
+                if (range.firstLod > lods.size() || range.lodCount > lods.size() - range.firstLod)
+                {
+                    set_error(outError, "Cooked mesh contains an invalid LOD range.");
+                    return false;
+                }
+            }
+            for (const auto& lod : lods)
+            {
+                if (lod.firstIndex > indices.size() || lod.indexCount > indices.size() - lod.firstIndex ||
+                    lod.indexCount % 3 != 0)
+                {
+                    set_error(outError, "Cooked mesh LOD references invalid indices.");
+                    return false;
+                }
+            }
+            return vertexCount != 0 && !indices.empty() && !meshes.empty();
+        }
+
+        // 0 for payload versions this build cannot read as cooked data
+        size_t payload_header_size(uint32_t version)
+        {
+            if (version == 2)
+                return kMeshAssetPayloadV2Size;
+            if (version == 3)
+                return kMeshAssetPayloadV3Size;
+            if (version == 4)
+                return kMeshAssetPayloadV4Size;
+            if (version == kMeshAssetPayloadVersion)
+                return sizeof(MeshAssetPayloadHeader);
+            return 0;
+        }
+
+        // External buffers of a glTF feed the cooked mesh, so their contents are part of its DDC key.
+        // Images are not cooked from glTF and do not count. Returns false when a buffer cannot be
+        // read, which leaves the error to the cook itself.
+        bool gltf_dependency_hash(const std::filesystem::path& sourcePath, std::span<const uint8_t> source,
+                                  uint64_t& outHash)
+        {
+            outHash = 0;
+            const char* json = reinterpret_cast<const char*>(source.data());
+            size_t jsonSize = source.size();
+            if (lowercase(sourcePath.extension().string()) == ".glb")
+            {
+                // 12-byte header, then the JSON chunk's length and type
+                uint32_t chunk[2] {};
+                if (source.size() < 20)
+                    return false;
+                std::memcpy(chunk, source.data() + 12, sizeof(chunk));
+                if (chunk[1] != MakeAssetFourCC('J', 'S', 'O', 'N') || chunk[0] > source.size() - 20)
+                    return false;
+                json += 20;
+                jsonSize = chunk[0];
+            }
+
+            const nlohmann::json document = nlohmann::json::parse(json, json + jsonSize, nullptr, false);
+            if (document.is_discarded())
+                return false;
+            const auto buffers = document.find("buffers");
+            if (buffers == document.end() || !buffers->is_array())
+                return true;
+            for (const auto& buffer : *buffers)
+            {
+                const auto uri = buffer.find("uri");
+                if (uri == buffer.end() || !uri->is_string())
+                    continue;
+                const std::string& text = uri->get_ref<const std::string&>();
+                if (text.rfind("data:", 0) == 0)
+                    continue;
+                uint64_t bufferHash = 0;
+                if (!AssetHash::HashFile(sourcePath.parent_path() / text, bufferHash))
+                    return false;
+                outHash = AssetHash::Combine(outHash, AssetHash::Combine(AssetHash::HashString(text), bufferHash));
+            }
+            return true;
+        }
+
+        uint64_t hash_lod_settings(const MeshLodSettings& settings)
+        {
+            uint64_t hash = AssetHash::HashBytes(&settings.lodCount, sizeof(settings.lodCount));
+            hash = AssetHash::Combine(hash, AssetHash::HashBytes(&settings.reductionRatio, sizeof(settings.reductionRatio)));
+            hash = AssetHash::Combine(hash, AssetHash::HashBytes(&settings.minTriangleCount, sizeof(settings.minTriangleCount)));
+            return AssetHash::Combine(hash, AssetHash::HashBytes(&settings.maxRelativeError, sizeof(settings.maxRelativeError)));
+        }
+
+        void serialize_cooked_mesh(const CookedMeshData& data, const MeshOptimizationStats& stats,
+                                   DerivedDataWriter& writer)
+        {
+            writer.WriteArray(std::span<const CookedMeshVertex>(data.vertices));
+            writer.WriteArray(std::span<const uint32_t>(data.indices));
+            writer.WriteArray(std::span<const CookedMeshRecord>(data.meshes));
+            writer.WriteArray(std::span<const CookedMeshPrimitive>(data.primitives));
+            writer.WriteArray(std::span<const CookedMeshPrimitiveLods>(data.primitiveLods));
+            writer.WriteArray(std::span<const CookedMeshLod>(data.lods));
+            writer.WriteArray(std::span<const CookedMeshMaterial>(data.materials));
+            writer.Write(static_cast<uint64_t>(data.textures.size()));
+            for (const auto& texture : data.textures)
+            {
+                writer.Write(texture.record);
+                writer.WriteArray(std::span<const uint8_t>(texture.bytes));
+            }
+            writer.Write(stats);
+        }
+
+        bool deserialize_cooked_mesh(std::span<const uint8_t> bytes, CookedMeshData& outData,
+                                     MeshOptimizationStats& outStats)
+        {
+            outData = {};
+            DerivedDataReader reader(bytes);
+            uint64_t textureCount = 0;
+            if (!reader.ReadArray(outData.vertices) || !reader.ReadArray(outData.indices) ||
+                !reader.ReadArray(outData.meshes) || !reader.ReadArray(outData.primitives) ||
+                !reader.ReadArray(outData.primitiveLods) || !reader.ReadArray(outData.lods) ||
+                !reader.ReadArray(outData.materials) || !reader.Read(textureCount) || textureCount > bytes.size())
+                return false;
+            outData.textures.resize(static_cast<size_t>(textureCount));
+            for (auto& texture : outData.textures)
+            {
+                if (!reader.Read(texture.record) || !reader.ReadArray(texture.bytes))
+                    return false;
+            }
+            return reader.Read(outStats) && reader.AtEnd() &&
+                   validate_cooked_ranges(outData.vertices.size(), outData.indices, outData.meshes,
+                                          outData.primitives, outData.primitiveLods, outData.lods,
+                                          outData.materials.size(), nullptr);
+        }
+
         bool read_legacy_header(const std::filesystem::path& path, AssetFileHeader& fileHeader,
                                 LegacyMeshAssetPayloadHeader& payload, std::string& extension)
         {
@@ -799,19 +1074,69 @@ namespace Cyber
             return false;
         }
 
-        std::vector<uint8_t> sourceBytes;
-        if (!ReadFileBytes(request.sourcePath, sourceBytes))
+        MappedFile sourceFile;
+        if (!sourceFile.Open(request.sourcePath) || sourceFile.Size() > std::numeric_limits<size_t>::max())
         {
             outResult.error = "Failed to read mesh source file.";
             return false;
         }
+        std::span<const uint8_t> source(sourceFile.Data(), static_cast<size_t>(sourceFile.Size()));
+
+        // The GUID is settled before cooking because it keys the derived data
+        const AssetGuid assetGuid = request.existingGuid.IsValid() ? request.existingGuid : AssetGuid::Create();
+        const uint64_t contentHash = AssetHash::HashContent(source.data(), source.size());
+
+        // The cooked and optimized mesh comes from the DDC when it holds one for this key; the
+        // vertex encoding and source storage are applied on write, so they stay out of the key
+        DerivedDataKey key;
+        key.kind = kDerivedOptimizedMesh;
+        key.platformTag = kAnyAssetPlatform;
+        key.assetGuid = assetGuid;
+        key.contentHash = contentHash;
+        key.cookerVersion = kMeshImporterVersion;
+        if (request.optimizeMesh)
+        {
+            const MeshOptimizationSettings settings;
+            key.settingsHash = AssetHash::Combine(AssetHash::HashBytes(&settings.cacheSize, sizeof(settings.cacheSize)),
+                                                  AssetHash::HashBytes(&settings.overdrawThreshold, sizeof(settings.overdrawThreshold)));
+        }
+        if (request.meshLods.lodCount != 0)
+            key.settingsHash = AssetHash::Combine(key.settingsHash, hash_lod_settings(request.meshLods));
+        const bool isGltf = lowercase(request.sourcePath.extension().string()) != ".fbx";
+        DerivedDataCache* derivedDataCache =
+            !isGltf || gltf_dependency_hash(request.sourcePath, source, key.dependencyHash)
+                ? request.derivedDataCache
+                : nullptr;
 
         CookedMeshData cookedData;
-        if (!cook_source(request.sourcePath, sourceBytes, cookedData, outResult.error))
-            return false;
+        std::vector<uint8_t> derived;
+        if (!derivedDataCache || !derivedDataCache->Get(key, derived) ||
+            !deserialize_cooked_mesh(derived, cookedData, outResult.meshOptimization))
+        {
+            outResult.meshOptimization = {};
+            // Only an embedded source is read again after cooking
+            MappedFile* releaseSource = request.sourceStorage == AssetSourceStorage::Embedded ? nullptr : &sourceFile;
+            const bool cooked = cook_source(request.sourcePath, source, releaseSource, cookedData, outResult.error);
+            if (!sourceFile.IsOpen())
+                source = {};
+            if (!cooked)
+                return false;
+            if (request.optimizeMesh)
+                outResult.meshOptimization = MeshOptimizer::Optimize(cookedData);
+            // After optimizing, so the levels index the final vertex order
+            if (request.meshLods.lodCount != 0)
+                MeshOptimizer::GenerateLods(cookedData, request.meshLods);
+            if (derivedDataCache)
+            {
+                DerivedDataWriter writer;
+                serialize_cooked_mesh(cookedData, outResult.meshOptimization, writer);
+                (void)derivedDataCache->Put(key, writer.Bytes());
+            }
+        }
 
         AssetFileHeader fileHeader;
-        if (!write_cooked_asset(request, sourceBytes, cookedData, request.existingGuid, fileHeader))
+        if (!write_cooked_asset(request, source, cookedData, contentHash, DependencyHash(request),
+                                assetGuid, fileHeader))
         {
             outResult.error = "Failed to write cooked mesh asset.";
             return false;
@@ -831,6 +1156,23 @@ namespace Cyber
         return true;
     }
 
+    uint64_t MeshImporter::DependencyHash(const AssetImportRequest& request) const
+    {
+        uint64_t hash = IAssetImporter::DependencyHash(request);
+        if (request.sourceStorage != AssetSourceStorage::None)
+            hash = AssetHash::Combine(hash, static_cast<uint64_t>(request.sourceStorage));
+        if (!request.optimizeMesh)
+            hash = AssetHash::Combine(hash, AssetHash::HashString("unoptimized"));
+        if (!request.vertexEncoding.IsFloat())
+        {
+            const CookedVertexLayout layout = MakeCookedVertexLayout(request.vertexEncoding);
+            hash = AssetHash::Combine(hash, AssetHash::HashBytes(&layout, sizeof(layout)));
+        }
+        if (request.meshLods != MeshLodSettings {})
+            hash = AssetHash::Combine(hash, hash_lod_settings(request.meshLods));
+        return hash;
+    }
+
     bool MeshImporter::IsSupportedSourceExtension(std::string_view extension)
     {
         const std::string ext = lowercase(extension);
@@ -847,7 +1189,7 @@ namespace Cyber
         AssetFileHeader fileHeader;
         file.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader));
         if (!file || !fileHeader.IsCompatible(AssetType::Mesh, kAssetFileFormatVersion) ||
-            fileHeader.payloadOffset < sizeof(AssetFileHeader))
+            fileHeader.payloadOffset < fileHeader.headerSize)
             return false;
 
         file.seekg(static_cast<std::streamoff>(fileHeader.payloadOffset), std::ios::beg);
@@ -869,15 +1211,17 @@ namespace Cyber
             outInfo.isCooked = false;
             return true;
         }
-        if (prefix[1] != kMeshAssetPayloadVersion || fileHeader.payloadSize < sizeof(MeshAssetPayloadHeader))
+        const size_t payloadHeaderSize = payload_header_size(prefix[1]);
+        if (payloadHeaderSize == 0 || fileHeader.payloadSize < payloadHeaderSize)
             return false;
 
         file.seekg(static_cast<std::streamoff>(fileHeader.payloadOffset), std::ios::beg);
         MeshAssetPayloadHeader payload;
-        file.read(reinterpret_cast<char*>(&payload), sizeof(payload));
-        if (!file || payload.magic != kMeshAssetPayloadMagic ||
-            payload.version != kMeshAssetPayloadVersion || payload.sourceExtensionSize > 64 ||
-            payload.vertexStride != sizeof(CookedMeshVertex))
+        file.read(reinterpret_cast<char*>(&payload), static_cast<std::streamsize>(payloadHeaderSize));
+        if (!file || payload.magic != kMeshAssetPayloadMagic || payload.sourceExtensionSize > 64 ||
+            payload.vertexStride != payload.vertexLayout.stride ||
+            !IsValidCookedVertexLayout(payload.vertexLayout) ||
+            !section_inside(payload.sourceDataOffset, payload.sourceDataSize, 1, fileHeader.payloadSize))
             return false;
         std::string extension(payload.sourceExtensionSize, '\0');
         if (!extension.empty())
@@ -911,10 +1255,14 @@ namespace Cyber
 
         const auto& p = info.payloadHeader;
         const uint64_t size = info.fileHeader.payloadSize;
-        if (!section_inside(p.verticesOffset, p.vertexCount, sizeof(CookedMeshVertex), size) ||
+        const bool floatVertices = p.vertexLayout.IsFloat();
+        if (!section_inside(p.verticesOffset, p.vertexCount, p.vertexStride, size) ||
             !section_inside(p.indicesOffset, p.indexCount, sizeof(uint32_t), size) ||
             !section_inside(p.meshesOffset, p.meshCount, sizeof(CookedMeshRecord), size) ||
             !section_inside(p.primitivesOffset, p.primitiveCount, sizeof(CookedMeshPrimitive), size) ||
+            !section_inside(p.primitiveDecodeOffset, p.primitiveDecodeCount, sizeof(CookedMeshPrimitiveDecode), size) ||
+            !section_inside(p.primitiveLodsOffset, p.primitiveLodsCount, sizeof(CookedMeshPrimitiveLods), size) ||
+            !section_inside(p.lodsOffset, p.lodCount, sizeof(CookedMeshLod), size) ||
             !section_inside(p.materialsOffset, p.materialCount, sizeof(CookedMeshMaterial), size) ||
             !section_inside(p.texturesOffset, p.textureCount, sizeof(CookedMeshTextureRecord), size) ||
             !section_inside(p.textureDataOffset, p.textureDataSize, 1, size))
@@ -925,17 +1273,31 @@ namespace Cyber
 
         std::ifstream file(path, std::ios::binary);
         std::vector<CookedMeshTextureRecord> textureRecords;
-        if (!file ||
-            !read_section(file, info.fileHeader, p.verticesOffset, p.vertexCount, outData.vertices) ||
+        std::vector<uint8_t> vertexBytes;
+        std::vector<CookedMeshPrimitiveDecode> primitiveDecode;
+        const bool verticesRead = floatVertices
+            ? read_section(file, info.fileHeader, p.verticesOffset, p.vertexCount, outData.vertices)
+            : read_section(file, info.fileHeader, p.verticesOffset, p.vertexCount * p.vertexStride, vertexBytes);
+        if (!file || !verticesRead ||
             !read_section(file, info.fileHeader, p.indicesOffset, p.indexCount, outData.indices) ||
             !read_section(file, info.fileHeader, p.meshesOffset, p.meshCount, outData.meshes) ||
             !read_section(file, info.fileHeader, p.primitivesOffset, p.primitiveCount, outData.primitives) ||
+            !read_section(file, info.fileHeader, p.primitiveDecodeOffset, p.primitiveDecodeCount, primitiveDecode) ||
+            !read_section(file, info.fileHeader, p.primitiveLodsOffset, p.primitiveLodsCount, outData.primitiveLods) ||
+            !read_section(file, info.fileHeader, p.lodsOffset, p.lodCount, outData.lods) ||
             !read_section(file, info.fileHeader, p.materialsOffset, p.materialCount, outData.materials) ||
             !read_section(file, info.fileHeader, p.texturesOffset, p.textureCount, textureRecords))
         {
             set_error(outError, "Failed to read cooked mesh sections.");
             return false;
         }
+        if (!floatVertices &&
+            !DecodeCookedVertices(p.vertexLayout, vertexBytes, outData.indices, outData.primitives,
+                                  primitiveDecode, outData.vertices))
+        {
+            set_error(outError, "Cooked mesh vertex data does not match its layout.");
+            return false;
+        }
 
         for (const auto& record : textureRecords)
         {
@@ -963,40 +1325,179 @@ namespace Cyber
             outData.textures.push_back(std::move(texture));
         }
 
-        for (uint32_t index : outData.indices)
+        return validate_cooked_ranges(outData.vertices.size(), outData.indices, outData.meshes,
+                                      outData.primitives, outData.primitiveLods, outData.lods,
+                                      outData.materials.size(), outError);
+    }
+
+    bool ReadCookedMeshAsset(const std::filesystem::path& path,
+                             CookedMeshData& outData, std::string* outError)
+    {
+        return MeshImporter::ReadCookedData(path, outData, outError);
+    }
+
+    bool CookedMeshView::Open(const std::filesystem::path& path, std::string* outError)
+    {
+        Close();
+        if (outError)
+            outError->clear();
+        if (!m_file.Open(path))
+        {
+            set_error(outError, "Failed to map mesh asset.");
+            return false;
+        }
+        if (!Parse(std::span<const uint8_t>(m_file.Data(), static_cast<size_t>(m_file.Size())), outError))
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    bool CookedMeshView::Open(std::span<const uint8_t> bytes, std::string* outError)
+    {
+        Close();
+        if (outError)
+            outError->clear();
+        if (!Parse(bytes, outError))
         {
-            if (index >= outData.vertices.size())
-            {
-                set_error(outError, "Cooked mesh contains an invalid vertex index.");
-                return false;
-            }
+            Close();
+            return false;
         }
-        for (const auto& mesh : outData.meshes)
+        return true;
+    }
+
+    bool CookedMeshView::Parse(std::span<const uint8_t> bytes, std::string* outError)
+    {
+        const uint8_t* data = bytes.data();
+        const uint64_t fileSize = bytes.size();
+        AssetFileHeader fileHeader;
+        MeshAssetPayloadHeader p;
+        if (fileSize < sizeof(fileHeader))
         {
-            if (mesh.firstPrimitive > outData.primitives.size() ||
-                mesh.primitiveCount > outData.primitives.size() - mesh.firstPrimitive)
-            {
-                set_error(outError, "Cooked mesh contains an invalid primitive range.");
-                return false;
-            }
+            set_error(outError, "Invalid mesh asset.");
+            return false;
+        }
+        std::memcpy(&fileHeader, data, sizeof(fileHeader));
+        if (!fileHeader.IsCompatible(AssetType::Mesh, kAssetFileFormatVersion) ||
+            fileHeader.payloadOffset < fileHeader.headerSize || fileHeader.payloadOffset > fileSize ||
+            fileHeader.payloadSize > fileSize - fileHeader.payloadOffset ||
+            fileHeader.payloadSize < sizeof(uint32_t) * 2)
+        {
+            set_error(outError, "Invalid mesh asset.");
+            return false;
+        }
+
+        m_payload = data + fileHeader.payloadOffset;
+        uint32_t prefix[2] {};
+        std::memcpy(prefix, m_payload, sizeof(prefix));
+        if (prefix[0] == kMeshAssetPayloadMagic && prefix[1] == 1)
+        {
+            set_error(outError, "Legacy mesh asset payload v1 must be reimported.");
+            return false;
+        }
+        const size_t payloadHeaderSize = payload_header_size(prefix[1]);
+        if (prefix[0] != kMeshAssetPayloadMagic || payloadHeaderSize == 0 ||
+            fileHeader.payloadSize < payloadHeaderSize)
+        {
+            set_error(outError, "Invalid mesh asset.");
+            return false;
+        }
+        std::memcpy(&p, m_payload, payloadHeaderSize);
+
+        const uint64_t size = fileHeader.payloadSize;
+        if (p.vertexStride != p.vertexLayout.stride || !IsValidCookedVertexLayout(p.vertexLayout) ||
+            (p.vertexLayout.IsPrimitiveRelative() && p.primitiveDecodeCount != p.primitiveCount) ||
+            !section_inside(p.verticesOffset, p.vertexCount, p.vertexStride, size) ||
+            !section_inside(p.indicesOffset, p.indexCount, sizeof(uint32_t), size) ||
+            !section_inside(p.meshesOffset, p.meshCount, sizeof(CookedMeshRecord), size) ||
+            !section_inside(p.primitivesOffset, p.primitiveCount, sizeof(CookedMeshPrimitive), size) ||
+            !section_inside(p.primitiveDecodeOffset, p.primitiveDecodeCount, sizeof(CookedMeshPrimitiveDecode), size) ||
+            !section_inside(p.primitiveLodsOffset, p.primitiveLodsCount, sizeof(CookedMeshPrimitiveLods), size) ||
+            !section_inside(p.lodsOffset, p.lodCount, sizeof(CookedMeshLod), size) ||
+            !section_inside(p.materialsOffset, p.materialCount, sizeof(CookedMeshMaterial), size) ||
+            !section_inside(p.texturesOffset, p.textureCount, sizeof(CookedMeshTextureRecord), size) ||
+            !section_inside(p.textureDataOffset, p.textureDataSize, 1, size) ||
+            !section_inside(p.sourceDataOffset, p.sourceDataSize, 1, size))
+        {
+            set_error(outError, "Cooked mesh asset contains an invalid section range.");
+            return false;
         }
-        for (const auto& primitive : outData.primitives)
+
+        const uint8_t* payload = m_payload;
+        const auto aligned = [payload](uint64_t offset, size_t alignment)
         {
-            if (primitive.firstIndex > outData.indices.size() ||
-                primitive.indexCount > outData.indices.size() - primitive.firstIndex ||
-                primitive.materialIndex >= outData.materials.size())
+            return reinterpret_cast<uintptr_t>(payload + offset) % alignment == 0;
+        };
+        if (!aligned(p.verticesOffset, alignof(CookedMeshVertex)) ||
+            !aligned(p.indicesOffset, alignof(uint32_t)) ||
+            !aligned(p.meshesOffset, alignof(CookedMeshRecord)) ||
+            !aligned(p.primitivesOffset, alignof(CookedMeshPrimitive)) ||
+            !aligned(p.primitiveDecodeOffset, alignof(CookedMeshPrimitiveDecode)) ||
+            !aligned(p.primitiveLodsOffset, alignof(CookedMeshPrimitiveLods)) ||
+            !aligned(p.lodsOffset, alignof(CookedMeshLod)) ||
+            !aligned(p.materialsOffset, alignof(CookedMeshMaterial)) ||
+            !aligned(p.texturesOffset, alignof(CookedMeshTextureRecord)))
+        {
+            set_error(outError, "Cooked mesh asset sections are unaligned and must be reimported to be mapped.");
+            return false;
+        }
+
+        m_vertexLayout = p.vertexLayout;
+        m_vertexBytes = map_section<uint8_t>(m_payload, p.verticesOffset, p.vertexCount * p.vertexStride);
+        if (m_vertexLayout.IsFloat())
+            m_vertices = map_section<CookedMeshVertex>(m_payload, p.verticesOffset, p.vertexCount);
+        m_primitiveDecode = map_section<CookedMeshPrimitiveDecode>(m_payload, p.primitiveDecodeOffset, p.primitiveDecodeCount);
+        m_indices = map_section<uint32_t>(m_payload, p.indicesOffset, p.indexCount);
+        m_meshes = map_section<CookedMeshRecord>(m_payload, p.meshesOffset, p.meshCount);
+        m_primitives = map_section<CookedMeshPrimitive>(m_payload, p.primitivesOffset, p.primitiveCount);
+        m_primitiveLods = map_section<CookedMeshPrimitiveLods>(m_payload, p.primitiveLodsOffset, p.primitiveLodsCount);
+        m_lods = map_section<CookedMeshLod>(m_payload, p.lodsOffset, p.lodCount);
+        m_materials = map_section<CookedMeshMaterial>(m_payload, p.materialsOffset, p.materialCount);
+        m_textureRecords = map_section<CookedMeshTextureRecord>(m_payload, p.texturesOffset, p.textureCount);
+
+        for (const auto& record : m_textureRecords)
+        {
+            if (!section_inside(record.dataOffset, record.dataSize, 1, size) ||
+                record.dataOffset < p.textureDataOffset ||
+                record.dataOffset + record.dataSize > p.textureDataOffset + p.textureDataSize)
             {
-                set_error(outError, "Cooked mesh primitive references invalid data.");
+                set_error(outError, "Cooked mesh texture range is invalid.");
                 return false;
             }
         }
-        return !outData.vertices.empty() && !outData.indices.empty() && !outData.meshes.empty();
+
+        if (!validate_cooked_ranges(static_cast<size_t>(p.vertexCount), m_indices, m_meshes, m_primitives,
+                                    m_primitiveLods, m_lods, m_materials.size(), outError))
+        {
+            return false;
+        }
+        return true;
     }
 
-    bool ReadCookedMeshAsset(const std::filesystem::path& path,
-                             CookedMeshData& outData, std::string* outError)
+    void CookedMeshView::Close()
     {
-        return MeshImporter::ReadCookedData(path, outData, outError);
+        m_vertices = {};
+        m_vertexBytes = {};
+        m_vertexLayout = {};
+        m_primitiveDecode = {};
+        m_indices = {};
+        m_meshes = {};
+        m_primitives = {};
+        m_primitiveLods = {};
+        m_lods = {};
+        m_materials = {};
+        m_textureRecords = {};
+        m_payload = nullptr;
+        m_file.Close();
+    }
+
+    std::span<const uint8_t> CookedMeshView::TextureBytes(size_t textureIndex) const
+    {
+        if (textureIndex >= m_textureRecords.size())
+            return {};
+        const CookedMeshTextureRecord& record = m_textureRecords[textureIndex];
+        return std::span<const uint8_t>(m_payload + record.dataOffset, static_cast<size_t>(record.dataSize));
     }
 
     bool MeshImporter::ReadEmbeddedSource(const std::filesystem::path& path,
@@ -1004,23 +1505,47 @@ namespace Cyber
                                           std::vector<uint8_t>& outBytes)
     {
         outBytes.clear();
-        AssetFileHeader fileHeader;
-        LegacyMeshAssetPayloadHeader legacy;
-        std::string extension;
-        if (!read_legacy_header(path, fileHeader, legacy, extension))
+        MeshEditorAssetInfo info;
+        if (!ReadInfo(path, info))
             return false;
-        std::ifstream file(path, std::ios::binary);
-        file.seekg(static_cast<std::streamoff>(fileHeader.payloadOffset + legacy.sourceDataOffset), std::ios::beg);
-        outBytes.resize(static_cast<size_t>(legacy.sourceDataSize));
+
+        std::filesystem::path sourcePath = path;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        if (!info.isCooked)
+        {
+            LegacyMeshAssetPayloadHeader legacy;
+            std::string extension;
+            if (!read_legacy_header(path, info.fileHeader, legacy, extension))
+                return false;
+            offset = info.fileHeader.payloadOffset + legacy.sourceDataOffset;
+            size = legacy.sourceDataSize;
+        }
+        else if (info.payloadHeader.sourceDataSize != 0)
+        {
+            offset = info.fileHeader.payloadOffset + info.payloadHeader.sourceDataOffset;
+            size = info.payloadHeader.sourceDataSize;
+        }
+        else
+        {
+            sourcePath = SideCarSourcePath(path, info.sourceExtension);
+            std::error_code ec;
+            size = std::filesystem::file_size(sourcePath, ec);
+            if (ec)
+                return false;
+        }
+
+        std::ifstream file(sourcePath, std::ios::binary);
+        file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+        outBytes.resize(static_cast<size_t>(size));
         if (!outBytes.empty())
             file.read(reinterpret_cast<char*>(outBytes.data()), static_cast<std::streamsize>(outBytes.size()));
         if (!file)
+        {
+            outBytes.clear();
             return false;
-        outInfo = {};
-        outInfo.fileHeader = fileHeader;
-        outInfo.payloadHeader.version = 1;
-        outInfo.sourceExtension = std::move(extension);
-        outInfo.isCooked = false;
+        }
+        outInfo = std::move(info);
         return true;
     }
 
@@ -1046,20 +1571,11 @@ namespace Cyber
         return file.good();
     }
 
-    bool MeshImporter::ReadFileBytes(const std::filesystem::path& path,
-                                     std::vector<uint8_t>& outBytes)
+    std::filesystem::path MeshImporter::SideCarSourcePath(const std::filesystem::path& assetPath,
+                                                          std::string_view sourceExtension)
     {
-        outBytes.clear();
-        std::ifstream file(path, std::ios::binary | std::ios::ate);
-        if (!file)
-            return false;
-        const std::streamoff size = file.tellg();
-        if (size < 0)
-            return false;
-        outBytes.resize(static_cast<size_t>(size));
-        file.seekg(0, std::ios::beg);
-        if (!outBytes.empty())
-            file.read(reinterpret_cast<char*>(outBytes.data()), static_cast<std::streamsize>(outBytes.size()));
-        return file.good() || file.eof();
+        std::filesystem::path path = assetPath;
+        path += lowercase(sourceExtension);
+        return path;
     }
 }
@@ -0,0 +1,887 @@
+#include "asset/mesh_optimizer.h"
+
+#include "asset/asset_hash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace Cyber
+{
+    namespace
+    {
+        constexpr uint32_t kInvalidIndex = ~0u;
+
+        // FIFO post-transform cache. A vertex is resident while fewer than cacheSize misses have
+        // happened since it was loaded; Reset() evicts everything without touching the array.
+        class FifoCacheSimulator
+        {
+        public:
+            FifoCacheSimulator(uint32_t vertexCount, uint32_t cacheSize)
+                : m_timestamps(vertexCount, 0), m_cacheSize(cacheSize), m_time(cacheSize + 1)
+            {
+            }
+
+            uint32_t Triangle(const uint32_t* triangle)
+            {
+                uint32_t misses = 0;
+                for (uint32_t k = 0; k < 3; ++k)
+                {
+                    uint32_t& stamp = m_timestamps[triangle[k]];
+                    if (m_time - stamp > m_cacheSize)
+                    {
+                        stamp = m_time++;
+                        ++misses;
+                    }
+                }
+                return misses;
+            }
+
+            void Reset() { m_time += m_cacheSize + 1; }
+
+        private:
+            std::vector<uint32_t> m_timestamps;
+            uint32_t m_cacheSize;
+            uint32_t m_time;
+        };
+
+        uint32_t max_index_plus_one(std::span<const uint32_t> indices)
+        {
+            uint32_t count = 0;
+            for (uint32_t index : indices)
+                count = std::max(count, index + 1);
+            return count;
+        }
+
+        // Compacts a primitive's global indices to 0..N-1 so per-primitive passes scale with the
+        // primitive, not the whole vertex buffer. globalToLocal must be all kInvalidIndex on entry
+        // and is restored on exit.
+        struct LocalPrimitive
+        {
+            std::vector<uint32_t> indices;
+            std::vector<uint32_t> localToGlobal;
+
+            LocalPrimitive(std::span<const uint32_t> globalIndices, std::vector<uint32_t>& globalToLocal)
+            {
+                indices.resize(globalIndices.size());
+                for (size_t i = 0; i < globalIndices.size(); ++i)
+                {
+                    uint32_t& local = globalToLocal[globalIndices[i]];
+                    if (local == kInvalidIndex)
+                    {
+                        local = static_cast<uint32_t>(localToGlobal.size());
+                        localToGlobal.push_back(globalIndices[i]);
+                    }
+                    indices[i] = local;
+                }
+                for (uint32_t global : localToGlobal)
+                    globalToLocal[global] = kInvalidIndex;
+            }
+
+            void Store(std::span<uint32_t> globalIndices) const
+            {
+                for (size_t i = 0; i < indices.size(); ++i)
+                    globalIndices[i] = localToGlobal[indices[i]];
+            }
+        };
+
+        void tipsify(std::span<uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize)
+        {
+            const size_t triangleCount = indices.size() / 3;
+            if (triangleCount == 0)
+                return;
+
+            std::vector<uint32_t> live(vertexCount, 0);
+            for (uint32_t index : indices)
+                ++live[index];
+            std::vector<uint32_t> offsets(vertexCount + 1, 0);
+            for (uint32_t v = 0; v < vertexCount; ++v)
+                offsets[v + 1] = offsets[v] + live[v];
+            std::vector<uint32_t> adjacency(indices.size());
+            {
+                std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < indices.size(); ++i)
+                    adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+
+            std::vector<uint32_t> cacheTime(vertexCount, 0);
+            uint32_t time = cacheSize + 1;
+            std::vector<uint8_t> emitted(triangleCount, 0);
+            std::vector<uint32_t> deadEnd;
+            deadEnd.reserve(indices.size());
+            std::vector<uint32_t> candidates;
+            std::vector<uint32_t> output;
+            output.reserve(indices.size());
+
+            uint32_t fan = indices[0];
+            uint32_t scan = 0;
+            while (fan != kInvalidIndex)
+            {
+                // Emit every remaining triangle around the fanning vertex
+                candidates.clear();
+                for (uint32_t a = offsets[fan]; a < offsets[fan + 1]; ++a)
+                {
+                    const uint32_t triangle = adjacency[a];
+                    if (emitted[triangle])
+                        continue;
+                    emitted[triangle] = 1;
+                    for (uint32_t k = 0; k < 3; ++k)
+                    {
+                        const uint32_t v = indices[triangle * 3 + k];
+                        output.push_back(v);
+                        deadEnd.push_back(v);
+                        candidates.push_back(v);
+                        --live[v];
+                        if (time - cacheTime[v] > cacheSize)
+                            cacheTime[v] = time++;
+                    }
+                }
+
+                // Prefer the oldest candidate that will still be cached after its own fan
+                fan = kInvalidIndex;
+                int64_t bestPriority = -1;
+                for (uint32_t v : candidates)
+                {
+                    if (live[v] == 0)
+                        continue;
+                    int64_t priority = 0;
+                    if (time - cacheTime[v] + 2 * live[v] <= cacheSize)
+                        priority = time - cacheTime[v];
+                    if (priority > bestPriority)
+                    {
+                        bestPriority = priority;
+                        fan = v;
+                    }
+                }
+                while (fan == kInvalidIndex && !deadEnd.empty())
+                {
+                    const uint32_t v = deadEnd.back();
+                    deadEnd.pop_back();
+                    if (live[v] > 0)
+                        fan = v;
+                }
+                while (fan == kInvalidIndex && scan < vertexCount)
+                {
+                    if (live[scan] > 0)
+                        fan = scan;
+                    ++scan;
+                }
+            }
+            std::copy(output.begin(), output.end(), indices.begin());
+        }
+
+        struct Float3
+        {
+            float x = 0.0f;
+            float y = 0.0f;
+            float z = 0.0f;
+        };
+
+        Float3 position_of(const CookedMeshVertex& vertex)
+        {
+            return { vertex.position[0], vertex.position[1], vertex.position[2] };
+        }
+
+        // Sander et al.: split the cache-ordered stream into clusters (at full cache restarts,
+        // then wherever the running ACMR is already within threshold of the cluster's), and draw
+        // clusters facing away from the primitive's centre first.
+        void optimize_overdraw(std::span<uint32_t> indices, uint32_t vertexCount,
+                               std::span<const uint32_t> localToGlobal,
+                               std::span<const CookedMeshVertex> vertices,
+                               uint32_t cacheSize, float threshold)
+        {
+            const size_t triangleCount = indices.size() / 3;
+            if (triangleCount < 2)
+                return;
+
+            FifoCacheSimulator cache(vertexCount, cacheSize);
+            std::vector<size_t> hardBoundaries;
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                if (cache.Triangle(&indices[t * 3]) == 3)
+                    hardBoundaries.push_back(t);
+            }
+            if (hardBoundaries.empty() || hardBoundaries.front() != 0)
+                hardBoundaries.insert(hardBoundaries.begin(), 0);
+            hardBoundaries.push_back(triangleCount);
+
+            std::vector<size_t> boundaries;
+            for (size_t h = 0; h + 1 < hardBoundaries.size(); ++h)
+            {
+                const size_t begin = hardBoundaries[h];
+                const size_t end = hardBoundaries[h + 1];
+                cache.Reset();
+                uint32_t clusterMisses = 0;
+                for (size_t t = begin; t < end; ++t)
+                    clusterMisses += cache.Triangle(&indices[t * 3]);
+                const float clusterThreshold = threshold * float(clusterMisses) / float(end - begin);
+
+                cache.Reset();
+                boundaries.push_back(begin);
+                uint32_t runningMisses = 0;
+                size_t runningTriangles = 0;
+                for (size_t t = begin; t < end; ++t)
+                {
+                    runningMisses += cache.Triangle(&indices[t * 3]);
+                    ++runningTriangles;
+                    if (t + 1 < end && float(runningMisses) / float(runningTriangles) <= clusterThreshold)
+                    {
+                        boundaries.push_back(t + 1);
+                        cache.Reset();
+                        runningMisses = 0;
+                        runningTriangles = 0;
+                    }
+                }
+            }
+            boundaries.push_back(triangleCount);
+            const size_t clusterCount = boundaries.size() - 1;
+            if (clusterCount < 2)
+                return;
+
+            const auto position = [&](uint32_t local) { return position_of(vertices[localToGlobal[local]]); };
+            struct ClusterInfo
+            {
+                Float3 centroid;
+                Float3 normal;
+                float area = 0.0f;
+            };
+            std::vector<ClusterInfo> clusters(clusterCount);
+            Float3 meshCentroid;
+            float meshArea = 0.0f;
+            for (size_t c = 0; c < clusterCount; ++c)
+            {
+                ClusterInfo& info = clusters[c];
+                for (size_t t = boundaries[c]; t < boundaries[c + 1]; ++t)
+                {
+                    const Float3 a = position(indices[t * 3 + 0]);
+                    const Float3 b = position(indices[t * 3 + 1]);
+                    const Float3 p = position(indices[t * 3 + 2]);
+                    const Float3 ab { b.x - a.x, b.y - a.y, b.z - a.z };
+                    const Float3 ap { p.x - a.x, p.y - a.y, p.z - a.z };
+                    const Float3 n { ab.y * ap.z - ab.z * ap.y, ab.z * ap.x - ab.x * ap.z, ab.x * ap.y - ab.y * ap.x };
+                    const float area = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+                    info.centroid.x += (a.x + b.x + p.x) * area;
+                    info.centroid.y += (a.y + b.y + p.y) * area;
+                    info.centroid.z += (a.z + b.z + p.z) * area;
+                    info.normal.x += n.x;
+                    info.normal.y += n.y;
+                    info.normal.z += n.z;
+                    info.area += area;
+                }
+                meshCentroid.x += info.centroid.x;
+                meshCentroid.y += info.centroid.y;
+                meshCentroid.z += info.centroid.z;
+                meshArea += info.area;
+            }
+            if (meshArea <= 0.0f)
+                return;
+            const float meshScale = 1.0f / (3.0f * meshArea);
+            meshCentroid = { meshCentroid.x * meshScale, meshCentroid.y * meshScale, meshCentroid.z * meshScale };
+
+            std::vector<float> sortKeys(clusterCount, 0.0f);
+            for (size_t c = 0; c < clusterCount; ++c)
+            {
+                const ClusterInfo& info = clusters[c];
+                const float length = std::sqrt(info.normal.x * info.normal.x + info.normal.y * info.normal.y +
+                                               info.normal.z * info.normal.z);
+                if (info.area <= 0.0f || length <= 0.0f)
+                    continue;
+                const float scale = 1.0f / (3.0f * info.area);
+                const Float3 offset { info.centroid.x * scale - meshCentroid.x,
+                                      info.centroid.y * scale - meshCentroid.y,
+                                      info.centroid.z * scale - meshCentroid.z };
+                sortKeys[c] = (offset.x * info.normal.x + offset.y * info.normal.y + offset.z * info.normal.z) / length;
+            }
+
+            std::vector<uint32_t> order(clusterCount);
+            std::iota(order.begin(), order.end(), 0u);
+            std::stable_sort(order.begin(), order.end(),
+                [&](uint32_t lhs, uint32_t rhs) { return sortKeys[lhs] > sortKeys[rhs]; });
+
+            std::vector<uint32_t> reordered;
+            reordered.reserve(indices.size());
+            for (uint32_t c : order)
+                reordered.insert(reordered.end(), indices.begin() + boundaries[c] * 3,
+                                 indices.begin() + boundaries[c + 1] * 3);
+            std::copy(reordered.begin(), reordered.end(), indices.begin());
+        }
+
+        bool is_triangle_list(const CookedMeshPrimitive& primitive)
+        {
+            return primitive.indexCount >= 3 && primitive.indexCount % 3 == 0;
+        }
+
+        // Sum of area weighted squared distances to a set of planes, as the symmetric 4x4 form
+        // p^T A p + 2 b.p + c; dividing by the summed weight gives the mean squared distance.
+        struct Quadric
+        {
+            double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+            double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+            double c = 0.0;
+            double weight = 0.0;
+
+            void AddPlane(double nx, double ny, double nz, double d, double w)
+            {
+                a00 += w * nx * nx;
+                a01 += w * nx * ny;
+                a02 += w * nx * nz;
+                a11 += w * ny * ny;
+                a12 += w * ny * nz;
+                a22 += w * nz * nz;
+                b0 += w * nx * d;
+                b1 += w * ny * d;
+                b2 += w * nz * d;
+                c += w * d * d;
+                weight += w;
+            }
+
+            void Add(const Quadric& q)
+            {
+                a00 += q.a00;
+                a01 += q.a01;
+                a02 += q.a02;
+                a11 += q.a11;
+                a12 += q.a12;
+                a22 += q.a22;
+                b0 += q.b0;
+                b1 += q.b1;
+                b2 += q.b2;
+                c += q.c;
+                weight += q.weight;
+            }
+
+            [[nodiscard]] double Error(const Float3& p) const
+            {
+                if (weight <= 0.0)
+                    return 0.0;
+                const double x = p.x;
+                const double y = p.y;
+                const double z = p.z;
+                const double error = a00 * x * x + a11 * y * y + a22 * z * z +
+                                     2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                                     2.0 * (b0 * x + b1 * y + b2 * z) + c;
+                return std::max(error, 0.0) / weight;
+            }
+        };
+
+        Float3 triangle_normal(const Float3& a, const Float3& b, const Float3& c)
+        {
+            const Float3 e0 { b.x - a.x, b.y - a.y, b.z - a.z };
+            const Float3 e1 { c.x - a.x, c.y - a.y, c.z - a.z };
+            return { e0.y * e1.z - e0.z * e1.y, e0.z * e1.x - e0.x * e1.z, e0.x * e1.y - e0.y * e1.x };
+        }
+
+        // Half-edge collapse over one primitive's triangle list in local vertex numbering. Every
+        // pass ranks all legal collapses by the quadric error at the surviving vertex and applies
+        // the cheapest ones that do not touch each other's one-ring, so the fold-over checks made
+        // against the current surface stay valid for the whole pass.
+        class QuadricSimplifier
+        {
+        public:
+            QuadricSimplifier(std::span<const uint32_t> indices, std::span<const CookedMeshVertex> vertices,
+                              std::vector<uint32_t>& globalToLocal)
+                : m_local(indices, globalToLocal)
+            {
+                const uint32_t vertexCount = static_cast<uint32_t>(m_local.localToGlobal.size());
+                m_positions.resize(vertexCount);
+                for (uint32_t i = 0; i < vertexCount; ++i)
+                    m_positions[i] = position_of(vertices[m_local.localToGlobal[i]]);
+                m_locked.assign(vertexCount, 0);
+                m_quadrics.resize(vertexCount);
+                m_marks.assign(vertexCount, 0);
+
+                // Welded vertices that still share a position differ in normal or UV; moving one
+                // of them would tear the seam open
+                std::vector<uint32_t> order(vertexCount);
+                std::iota(order.begin(), order.end(), 0u);
+                const auto position_less = [this](uint32_t lhs, uint32_t rhs)
+                {
+                    const Float3& a = m_positions[lhs];
+                    const Float3& b = m_positions[rhs];
+                    return a.x != b.x ? a.x < b.x : a.y != b.y ? a.y < b.y : a.z < b.z;
+                };
+                std::sort(order.begin(), order.end(), position_less);
+                for (uint32_t i = 1; i < vertexCount; ++i)
+                {
+                    if (!position_less(order[i - 1], order[i]))
+                        m_locked[order[i - 1]] = m_locked[order[i]] = 1;
+                }
+
+                // Edges without exactly two triangles are open borders or non-manifold
+                std::vector<uint64_t> edges;
+                edges.reserve(m_local.indices.size());
+                for (size_t t = 0; t + 2 < m_local.indices.size(); t += 3)
+                {
+                    for (uint32_t k = 0; k < 3; ++k)
+                    {
+                        const uint32_t a = m_local.indices[t + k];
+                        const uint32_t b = m_local.indices[t + (k + 1) % 3];
+                        edges.push_back((uint64_t(std::min(a, b)) << 32) | std::max(a, b));
+                    }
+                }
+                std::sort(edges.begin(), edges.end());
+                for (size_t begin = 0; begin < edges.size();)
+                {
+                    size_t end = begin + 1;
+                    while (end < edges.size() && edges[end] == edges[begin])
+                        ++end;
+                    if (end - begin != 2)
+                        m_locked[uint32_t(edges[begin] >> 32)] = m_locked[uint32_t(edges[begin])] = 1;
+                    begin = end;
+                }
+
+                for (size_t t = 0; t + 2 < m_local.indices.size(); t += 3)
+                {
+                    const Float3& p0 = m_positions[m_local.indices[t]];
+                    const Float3 n = triangle_normal(p0, m_positions[m_local.indices[t + 1]], m_positions[m_local.indices[t + 2]]);
+                    const double length = std::sqrt(double(n.x) * n.x + double(n.y) * n.y + double(n.z) * n.z);
+                    if (length <= 0.0)
+                        continue;
+                    const double nx = n.x / length;
+                    const double ny = n.y / length;
+                    const double nz = n.z / length;
+                    const double d = -(nx * p0.x + ny * p0.y + nz * p0.z);
+                    for (uint32_t k = 0; k < 3; ++k)
+                        m_quadrics[m_local.indices[t + k]].AddPlane(nx, ny, nz, d, length * 0.5);
+                }
+            }
+
+            void Simplify(size_t targetIndexCount)
+            {
+                std::vector<uint32_t>& indices = m_local.indices;
+                const uint32_t vertexCount = static_cast<uint32_t>(m_positions.size());
+                std::vector<uint32_t> remap(vertexCount);
+                std::vector<uint8_t> touched(vertexCount);
+                while (indices.size() > targetIndexCount)
+                {
+                    // Triangles around each vertex
+                    m_offsets.assign(vertexCount + 1, 0);
+                    for (uint32_t index : indices)
+                        ++m_offsets[index + 1];
+                    for (uint32_t v = 0; v < vertexCount; ++v)
+                        m_offsets[v + 1] += m_offsets[v];
+                    m_triangles.resize(indices.size());
+                    std::vector<uint32_t> cursor(m_offsets.begin(), m_offsets.end() - 1);
+                    for (size_t i = 0; i < indices.size(); ++i)
+                        m_triangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+
+                    // Every half-edge u->v proposes moving u onto v
+                    struct Collapse
+                    {
+                        uint32_t from = 0;
+                        uint32_t to = 0;
+                        double cost = 0.0;
+                    };
+                    std::vector<Collapse> collapses;
+                    collapses.reserve(indices.size());
+                    for (size_t t = 0; t < indices.size(); t += 3)
+                    {
+                        for (uint32_t k = 0; k < 3; ++k)
+                        {
+                            const uint32_t from = indices[t + k];
+                            const uint32_t to = indices[t + (k + 1) % 3];
+                            if (m_locked[from])
+                                continue;
+                            Quadric merged = m_quadrics[from];
+                            merged.Add(m_quadrics[to]);
+                            collapses.push_back({ from, to, merged.Error(m_positions[to]) });
+                        }
+                    }
+                    if (collapses.empty())
+                        break;
+                    std::sort(collapses.begin(), collapses.end(),
+                        [](const Collapse& lhs, const Collapse& rhs) { return lhs.cost < rhs.cost; });
+
+                    // A collapse removes about two triangles; cheaper ones than half again the
+                    // cost of the last one needed may all go in this pass
+                    const size_t triangleGoal = (indices.size() - targetIndexCount + 2) / 3;
+                    const size_t collapseGoal = std::min(std::max<size_t>(triangleGoal / 2, 1), collapses.size()) - 1;
+                    const double costLimit = collapses[collapseGoal].cost * 1.5;
+
+                    std::iota(remap.begin(), remap.end(), 0u);
+                    std::fill(touched.begin(), touched.end(), uint8_t(0));
+                    size_t removed = 0;
+                    bool collapsed = false;
+                    for (const Collapse& collapse : collapses)
+                    {
+                        if (collapse.cost > costLimit || removed >= triangleGoal)
+                            break;
+                        if (touched[collapse.from] || touched[collapse.to] || !CanCollapse(collapse.from, collapse.to))
+                            continue;
+
+                        for (uint32_t i = m_offsets[collapse.from]; i < m_offsets[collapse.from + 1]; ++i)
+                        {
+                            const uint32_t* triangle = indices.data() + size_t(m_triangles[i]) * 3;
+                            if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+                                ++removed;
+                            touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = 1;
+                        }
+                        remap[collapse.from] = collapse.to;
+                        m_quadrics[collapse.to].Add(m_quadrics[collapse.from]);
+                        m_error = std::max(m_error, collapse.cost);
+                        collapsed = true;
+                    }
+                    if (!collapsed)
+                        break;
+
+                    size_t write = 0;
+                    for (size_t t = 0; t < indices.size(); t += 3)
+                    {
+                        const uint32_t a = remap[indices[t]];
+                        const uint32_t b = remap[indices[t + 1]];
+                        const uint32_t c = remap[indices[t + 2]];
+                        if (a == b || b == c || a == c)
+                            continue;
+                        indices[write++] = a;
+                        indices[write++] = b;
+                        indices[write++] = c;
+                    }
+                    indices.resize(write);
+                }
+            }
+
+            [[nodiscard]] size_t IndexCount() const { return m_local.indices.size(); }
+            [[nodiscard]] float Error() const { return static_cast<float>(std::sqrt(m_error)); }
+            void Store(std::span<uint32_t> globalIndices) const { m_local.Store(globalIndices); }
+
+        private:
+            // Rejects collapses that would flip a triangle or, by breaking the link condition
+            // (the only vertices next to both ends are the corners opposite the edge), fold the
+            // surface onto itself
+            bool CanCollapse(uint32_t from, uint32_t to)
+            {
+                const std::vector<uint32_t>& indices = m_local.indices;
+                const uint32_t ringStamp = ++m_stamp;
+                uint32_t shared = 0;
+                for (uint32_t i = m_offsets[from]; i < m_offsets[from + 1]; ++i)
+                {
+                    const uint32_t* triangle = indices.data() + size_t(m_triangles[i]) * 3;
+                    for (uint32_t k = 0; k < 3; ++k)
+                        m_marks[triangle[k]] = ringStamp;
+                    if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+                    {
+                        ++shared;
+                        continue;
+                    }
+
+                    Float3 corners[3];
+                    for (uint32_t k = 0; k < 3; ++k)
+                        corners[k] = m_positions[triangle[k]];
+                    const Float3 before = triangle_normal(corners[0], corners[1], corners[2]);
+                    for (uint32_t k = 0; k < 3; ++k)
+                    {
+                        if (triangle[k] == from)
+                            corners[k] = m_positions[to];
+                    }
+                    const Float3 after = triangle_normal(corners[0], corners[1], corners[2]);
+                    if (before.x * after.x + before.y * after.y + before.z * after.z <= 0.0f)
+                        return false;
+                }
+
+                const uint32_t countedStamp = ++m_stamp;
+                uint32_t common = 0;
+                for (uint32_t i = m_offsets[to]; i < m_offsets[to + 1]; ++i)
+                {
+                    const uint32_t* triangle = indices.data() + size_t(m_triangles[i]) * 3;
+                    for (uint32_t k = 0; k < 3; ++k)
+                    {
+                        const uint32_t corner = triangle[k];
+                        if (corner != from && corner != to && m_marks[corner] == ringStamp)
+                        {
+                            m_marks[corner] = countedStamp;
+                            ++common;
+                        }
+                    }
+                }
+                return common == shared;
+            }
+
+            LocalPrimitive m_local;
+            std::vector<Float3> m_positions;
+            std::vector<uint8_t> m_locked;
+            std::vector<Quadric> m_quadrics;
+            std::vector<uint32_t> m_offsets;
+            std::vector<uint32_t> m_triangles;
+            std::vector<uint32_t> m_marks;
+            uint32_t m_stamp = 0;
+            // Largest mean squared error of any collapse so far
+            double m_error = 0.0;
+        };
+
+        // Per-primitive cache misses, distinct vertices and triangles, each primitive starting
+        // with a cold cache as its own draw would.
+        void analyze_primitives(const CookedMeshData& data, uint32_t cacheSize,
+                                uint64_t& outMisses, uint64_t& outUnique, uint64_t& outTriangles)
+        {
+            outMisses = outUnique = outTriangles = 0;
+            FifoCacheSimulator cache(static_cast<uint32_t>(data.vertices.size()), cacheSize);
+            std::vector<uint32_t> seen(data.vertices.size(), kInvalidIndex);
+            for (uint32_t p = 0; p < data.primitives.size(); ++p)
+            {
+                const CookedMeshPrimitive& primitive = data.primitives[p];
+                if (!is_triangle_list(primitive))
+                    continue;
+                const uint32_t* indices = data.indices.data() + primitive.firstIndex;
+                for (uint32_t i = 0; i < primitive.indexCount; ++i)
+                {
+                    if (seen[indices[i]] != p)
+                    {
+                        seen[indices[i]] = p;
+                        ++outUnique;
+                    }
+                }
+                cache.Reset();
+                for (uint32_t t = 0; t < primitive.indexCount / 3; ++t)
+                    outMisses += cache.Triangle(indices + t * 3);
+                outTriangles += primitive.indexCount / 3;
+            }
+        }
+    }
+
+    namespace MeshOptimizer
+    {
+        uint32_t WeldVertices(CookedMeshData& data)
+        {
+            const size_t vertexCount = data.vertices.size();
+            size_t tableSize = 1;
+            while (tableSize < vertexCount * 2)
+                tableSize <<= 1;
+            std::vector<uint32_t> table(tableSize, kInvalidIndex);
+            std::vector<uint32_t> remap(vertexCount);
+
+            // Open addressing over the compacted output, comparing whole vertices bitwise
+            uint32_t uniqueCount = 0;
+            for (size_t i = 0; i < vertexCount; ++i)
+            {
+                const CookedMeshVertex& vertex = data.vertices[i];
+                size_t slot = AssetHash::HashContent(&vertex, sizeof(vertex)) & (tableSize - 1);
+                for (;;)
+                {
+                    const uint32_t existing = table[slot];
+                    if (existing == kInvalidIndex)
+                    {
+                        table[slot] = uniqueCount;
+                        data.vertices[uniqueCount] = vertex;
+                        remap[i] = uniqueCount++;
+                        break;
+                    }
+                    if (std::memcmp(&data.vertices[existing], &vertex, sizeof(vertex)) == 0)
+                    {
+                        remap[i] = existing;
+                        break;
+                    }
+                    slot = (slot + 1) & (tableSize - 1);
+                }
+            }
+            data.vertices.resize(uniqueCount);
+            for (uint32_t& index : data.indices)
+                index = remap[index];
+            return uniqueCount;
+        }
+
+        void OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize)
+        {
+            if (indices.size() < 3)
+                return;
+            std::vector<uint32_t> globalToLocal(vertexCount, kInvalidIndex);
+            LocalPrimitive local(indices, globalToLocal);
+            tipsify(local.indices, static_cast<uint32_t>(local.localToGlobal.size()), cacheSize);
+            local.Store(indices);
+        }
+
+        void OptimizeOverdraw(std::span<uint32_t> indices, std::span<const CookedMeshVertex> vertices,
+                              uint32_t cacheSize, float threshold)
+        {
+            if (indices.size() < 6)
+                return;
+            std::vector<uint32_t> globalToLocal(vertices.size(), kInvalidIndex);
+            LocalPrimitive local(indices, globalToLocal);
+            optimize_overdraw(local.indices, static_cast<uint32_t>(local.localToGlobal.size()),
+                              local.localToGlobal, vertices, cacheSize, threshold);
+            local.Store(indices);
+        }
+
+        uint32_t OptimizeVertexFetch(CookedMeshData& data)
+        {
+            std::vector<uint32_t> remap(data.vertices.size(), kInvalidIndex);
+            std::vector<CookedMeshVertex> vertices;
+            vertices.reserve(data.vertices.size());
+            for (uint32_t& index : data.indices)
+            {
+                if (remap[index] == kInvalidIndex)
+                {
+                    remap[index] = static_cast<uint32_t>(vertices.size());
+                    vertices.push_back(data.vertices[index]);
+                }
+                index = remap[index];
+            }
+            data.vertices = std::move(vertices);
+            return static_cast<uint32_t>(data.vertices.size());
+        }
+
+        float AnalyzeACMR(std::span<const uint32_t> indices, uint32_t cacheSize)
+        {
+            const size_t triangleCount = indices.size() / 3;
+            if (triangleCount == 0)
+                return 0.0f;
+            FifoCacheSimulator cache(max_index_plus_one(indices), cacheSize);
+            uint64_t misses = 0;
+            for (size_t t = 0; t < triangleCount; ++t)
+                misses += cache.Triangle(&indices[t * 3]);
+            return float(misses) / float(triangleCount);
+        }
+
+        float AnalyzeATVR(std::span<const uint32_t> indices, uint32_t cacheSize)
+        {
+            const size_t triangleCount = indices.size() / 3;
+            if (triangleCount == 0)
+                return 0.0f;
+            std::vector<uint8_t> seen(max_index_plus_one(indices), 0);
+            uint64_t unique = 0;
+            for (uint32_t index : indices)
+            {
+                unique += seen[index] == 0;
+                seen[index] = 1;
+            }
+            return AnalyzeACMR(indices, cacheSize) * float(triangleCount) / float(unique);
+        }
+
+        float Simplify(std::span<const uint32_t> indices, std::span<const CookedMeshVertex> vertices,
+                       size_t targetIndexCount, std::vector<uint32_t>& outIndices)
+        {
+            outIndices.assign(indices.begin(), indices.end());
+            if (indices.size() < 3 || indices.size() % 3 != 0 || targetIndexCount >= indices.size())
+                return 0.0f;
+
+            std::vector<uint32_t> globalToLocal(vertices.size(), kInvalidIndex);
+            QuadricSimplifier simplifier(indices, vertices, globalToLocal);
+            simplifier.Simplify(targetIndexCount);
+            outIndices.resize(simplifier.IndexCount());
+            simplifier.Store(outIndices);
+            return simplifier.Error();
+        }
+
+        uint32_t GenerateLods(CookedMeshData& data, const MeshLodSettings& settings, uint32_t cacheSize)
+        {
+            // Ranges from an earlier run sit after every primitive's own range
+            size_t baseIndexCount = 0;
+            for (const CookedMeshPrimitive& primitive : data.primitives)
+                baseIndexCount = std::max<size_t>(baseIndexCount, size_t(primitive.firstIndex) + primitive.indexCount);
+            data.indices.resize(std::min(data.indices.size(), baseIndexCount));
+            data.primitiveLods.clear();
+            data.lods.clear();
+            if (settings.lodCount == 0 || data.vertices.empty())
+                return 0;
+
+            data.primitiveLods.resize(data.primitives.size());
+            std::vector<uint32_t> globalToLocal(data.vertices.size(), kInvalidIndex);
+            for (uint32_t p = 0; p < data.primitives.size(); ++p)
+            {
+                const CookedMeshPrimitive primitive = data.primitives[p];
+                CookedMeshPrimitiveLods& range = data.primitiveLods[p];
+                range.firstLod = static_cast<uint32_t>(data.lods.size());
+                if (!is_triangle_list(primitive) || primitive.indexCount / 3 <= settings.minTriangleCount)
+                    continue;
+
+                const float extent[3] {
+                    primitive.boundsMax[0] - primitive.boundsMin[0],
+                    primitive.boundsMax[1] - primitive.boundsMin[1],
+                    primitive.boundsMax[2] - primitive.boundsMin[2],
+                };
+                const float errorLimit = settings.maxRelativeError *
+                    std::sqrt(extent[0] * extent[0] + extent[1] * extent[1] + extent[2] * extent[2]);
+
+                QuadricSimplifier simplifier(std::span<const uint32_t>(data.indices.data() + primitive.firstIndex, primitive.indexCount),
+                                             data.vertices, globalToLocal);
+                size_t current = primitive.indexCount;
+                for (uint32_t level = 0; level < settings.lodCount; ++level)
+                {
+                    const size_t target = std::max<size_t>(size_t(settings.minTriangleCount) * 3,
+                                                           size_t(double(current / 3) * settings.reductionRatio) * 3);
+                    if (target >= current)
+                        break;
+                    simplifier.Simplify(target);
+
+                    // Reaching less than half the requested reduction means legal collapses ran out
+                    const size_t count = simplifier.IndexCount();
+                    if ((current - count) * 2 < current - target || simplifier.Error() > errorLimit)
+                        break;
+
+                    CookedMeshLod lod;
+                    lod.firstIndex = static_cast<uint32_t>(data.indices.size());
+                    lod.indexCount = static_cast<uint32_t>(count);
+                    lod.error = simplifier.Error();
+                    data.indices.resize(data.indices.size() + count);
+                    const std::span<uint32_t> lodIndices(data.indices.data() + lod.firstIndex, count);
+                    simplifier.Store(lodIndices);
+
+                    LocalPrimitive local(lodIndices, globalToLocal);
+                    tipsify(local.indices, static_cast<uint32_t>(local.localToGlobal.size()), cacheSize);
+                    local.Store(lodIndices);
+
+                    data.lods.push_back(lod);
+                    ++range.lodCount;
+                    current = count;
+                }
+            }
+            return static_cast<uint32_t>(data.lods.size());
+        }
+
+        MeshOptimizationStats Optimize(CookedMeshData& data, const MeshOptimizationSettings& settings)
+        {
+            MeshOptimizationStats stats;
+            stats.sourceVertexCount = static_cast<uint32_t>(data.vertices.size());
+            if (data.vertices.empty() || data.indices.empty())
+                return stats;
+
+            uint64_t misses = 0;
+            uint64_t unique = 0;
+            uint64_t triangles = 0;
+            analyze_primitives(data, settings.cacheSize, misses, unique, triangles);
+            stats.triangleCount = static_cast<uint32_t>(triangles);
+            stats.acmrBefore = triangles ? float(misses) / float(triangles) : 0.0f;
+            stats.atvrBefore = unique ? float(misses) / float(unique) : 0.0f;
+
+            WeldVertices(data);
+
+            std::vector<uint32_t> globalToLocal(data.vertices.size(), kInvalidIndex);
+            for (const CookedMeshPrimitive& primitive : data.primitives)
+            {
+                if (!is_triangle_list(primitive))
+                    continue;
+                const std::span<uint32_t> indices(data.indices.data() + primitive.firstIndex, primitive.indexCount);
+                LocalPrimitive local(indices, globalToLocal);
+                const uint32_t localCount = static_cast<uint32_t>(local.localToGlobal.size());
+                tipsify(local.indices, localCount, settings.cacheSize);
+                optimize_overdraw(local.indices, localCount, local.localToGlobal, data.vertices,
+                                  settings.cacheSize, settings.overdrawThreshold);
+                local.Store(indices);
+            }
+
+            OptimizeVertexFetch(data);
+
+            std::vector<uint32_t> seen(data.vertices.size(), kInvalidIndex);
+            for (uint32_t p = 0; p < data.primitives.size(); ++p)
+            {
+                CookedMeshPrimitive& primitive = data.primitives[p];
+                primitive.vertexCount = 0;
+                for (uint32_t i = primitive.firstIndex; i < primitive.firstIndex + primitive.indexCount; ++i)
+                {
+                    if (seen[data.indices[i]] != p)
+                    {
+                        seen[data.indices[i]] = p;
+                        ++primitive.vertexCount;
+                    }
+                }
+            }
+
+            analyze_primitives(data, settings.cacheSize, misses, unique, triangles);
+            stats.vertexCount = static_cast<uint32_t>(data.vertices.size());
+            stats.acmrAfter = triangles ? float(misses) / float(triangles) : 0.0f;
+            stats.atvrAfter = unique ? float(misses) / float(unique) : 0.0f;
+            return stats;
+        }
+    }
+}
@@ -0,0 +1,840 @@
+#include "asset/texture_compression.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+namespace Cyber
+{
+    namespace
+    {
+        constexpr uint32_t kMinBlockRowsPerThread = 4;
+
+        // BC7 4-bit index interpolation weights, out of 64
+        constexpr std::array<uint32_t, 16> kBc7Weights4 {{
+            0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64
+        }};
+
+        struct Rgba8Block
+        {
+            uint8_t texels[16][4] {};
+        };
+
+        void load_block(const uint8_t* rgba, uint32_t width, uint32_t height,
+                        uint32_t blockX, uint32_t blockY, Rgba8Block& outBlock)
+        {
+            for (uint32_t y = 0; y < 4; ++y)
+            {
+                const uint32_t sy = std::min(blockY * 4 + y, height - 1);
+                for (uint32_t x = 0; x < 4; ++x)
+                {
+                    const uint32_t sx = std::min(blockX * 4 + x, width - 1);
+                    std::memcpy(outBlock.texels[y * 4 + x], rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+                }
+            }
+        }
+
+        void store_block(const Rgba8Block& block, uint32_t width, uint32_t height,
+                         uint32_t blockX, uint32_t blockY, uint8_t* rgba)
+        {
+            for (uint32_t y = 0; y < 4 && blockY * 4 + y < height; ++y)
+            {
+                for (uint32_t x = 0; x < 4 && blockX * 4 + x < width; ++x)
+                {
+                    const size_t offset = (static_cast<size_t>(blockY * 4 + y) * width + blockX * 4 + x) * 4;
+                    std::memcpy(rgba + offset, block.texels[y * 4 + x], 4);
+                }
+            }
+        }
+
+        uint8_t clamp_byte(float value)
+        {
+            return static_cast<uint8_t>(std::clamp(value + 0.5f, 0.0f, 255.0f));
+        }
+
+        // Dominant direction of the texel cloud, found by power iteration on the covariance matrix.
+        template <uint32_t Channels>
+        void principal_axis(const Rgba8Block& block, float outMean[Channels], float outAxis[Channels])
+        {
+            for (uint32_t c = 0; c < Channels; ++c)
+            {
+                float sum = 0.0f;
+                for (const auto& texel : block.texels)
+                    sum += texel[c];
+                outMean[c] = sum / 16.0f;
+            }
+
+            float covariance[Channels][Channels] {};
+            for (const auto& texel : block.texels)
+            {
+                for (uint32_t i = 0; i < Channels; ++i)
+                {
+                    for (uint32_t j = 0; j < Channels; ++j)
+                        covariance[i][j] += (texel[i] - outMean[i]) * (texel[j] - outMean[j]);
+                }
+            }
+
+            for (uint32_t c = 0; c < Channels; ++c)
+                outAxis[c] = 1.0f;
+            for (uint32_t iteration = 0; iteration < 8; ++iteration)
+            {
+                float next[Channels] {};
+                float length = 0.0f;
+                for (uint32_t i = 0; i < Channels; ++i)
+                {
+                    for (uint32_t j = 0; j < Channels; ++j)
+                        next[i] += covariance[i][j] * outAxis[j];
+                    length += next[i] * next[i];
+                }
+                if (length <= std::numeric_limits<float>::epsilon())
+                    break;
+                length = std::sqrt(length);
+                for (uint32_t c = 0; c < Channels; ++c)
+                    outAxis[c] = next[c] / length;
+            }
+        }
+
+        template <uint32_t Channels>
+        void axis_endpoints(const Rgba8Block& block, const float mean[Channels], const float axis[Channels],
+                            float outLow[Channels], float outHigh[Channels])
+        {
+            float minT = std::numeric_limits<float>::max();
+            float maxT = -std::numeric_limits<float>::max();
+            for (const auto& texel : block.texels)
+            {
+                float t = 0.0f;
+                for (uint32_t c = 0; c < Channels; ++c)
+                    t += (texel[c] - mean[c]) * axis[c];
+                minT = std::min(minT, t);
+                maxT = std::max(maxT, t);
+            }
+            for (uint32_t c = 0; c < Channels; ++c)
+            {
+                outLow[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+                outHigh[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+            }
+        }
+
+        // Solves for the endpoints that best reproduce the block given fixed interpolation weights.
+        template <uint32_t Channels>
+        bool least_squares_endpoints(const Rgba8Block& block, const float weights[16],
+                                     float outLow[Channels], float outHigh[Channels])
+        {
+            float aa = 0.0f;
+            float ab = 0.0f;
+            float bb = 0.0f;
+            float ax[Channels] {};
+            float bx[Channels] {};
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                const float b = weights[i];
+                const float a = 1.0f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (uint32_t c = 0; c < Channels; ++c)
+                {
+                    ax[c] += a * block.texels[i][c];
+                    bx[c] += b * block.texels[i][c];
+                }
+            }
+            const float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) < 1e-6f)
+                return false;
+            for (uint32_t c = 0; c < Channels; ++c)
+            {
+                outLow[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+                outHigh[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        uint16_t pack_565(const float color[3])
+        {
+            const auto r = static_cast<uint16_t>(std::clamp(color[0] * 31.0f / 255.0f + 0.5f, 0.0f, 31.0f));
+            const auto g = static_cast<uint16_t>(std::clamp(color[1] * 63.0f / 255.0f + 0.5f, 0.0f, 63.0f));
+            const auto b = static_cast<uint16_t>(std::clamp(color[2] * 31.0f / 255.0f + 0.5f, 0.0f, 31.0f));
+            return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        void unpack_565(uint16_t value, uint8_t outColor[3])
+        {
+            const uint32_t r = (value >> 11) & 31u;
+            const uint32_t g = (value >> 5) & 63u;
+            const uint32_t b = value & 31u;
+            outColor[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+            outColor[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+            outColor[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+        }
+
+        void bc1_palette(uint16_t color0, uint16_t color1, bool fourColor, uint8_t outPalette[4][3])
+        {
+            unpack_565(color0, outPalette[0]);
+            unpack_565(color1, outPalette[1]);
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                const uint32_t a = outPalette[0][c];
+                const uint32_t b = outPalette[1][c];
+                if (fourColor)
+                {
+                    outPalette[2][c] = static_cast<uint8_t>((2 * a + b + 1) / 3);
+                    outPalette[3][c] = static_cast<uint8_t>((a + 2 * b + 1) / 3);
+                }
+                else
+                {
+                    outPalette[2][c] = static_cast<uint8_t>((a + b + 1) / 2);
+                    outPalette[3][c] = 0;
+                }
+            }
+        }
+
+        uint32_t color_distance(const uint8_t* lhs, const uint8_t* rhs, uint32_t channels)
+        {
+            uint32_t error = 0;
+            for (uint32_t c = 0; c < channels; ++c)
+            {
+                const int32_t d = int32_t(lhs[c]) - int32_t(rhs[c]);
+                error += uint32_t(d * d);
+            }
+            return error;
+        }
+
+        uint32_t assign_bc1_indices(const Rgba8Block& block, uint16_t color0, uint16_t color1, uint8_t outIndices[16])
+        {
+            uint8_t palette[4][3];
+            bc1_palette(color0, color1, true, palette);
+            uint32_t total = 0;
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                uint32_t best = std::numeric_limits<uint32_t>::max();
+                for (uint8_t p = 0; p < 4; ++p)
+                {
+                    const uint32_t error = color_distance(block.texels[i], palette[p], 3);
+                    if (error < best)
+                    {
+                        best = error;
+                        outIndices[i] = p;
+                    }
+                }
+                total += best;
+            }
+            return total;
+        }
+
+        // BC1 color block in 4-color mode; also the color half of a BC3 block.
+        void encode_color_block(const Rgba8Block& block, uint8_t out[8])
+        {
+            float mean[3];
+            float axis[3];
+            float low[3];
+            float high[3];
+            principal_axis<3>(block, mean, axis);
+            axis_endpoints<3>(block, mean, axis, low, high);
+
+            uint16_t bestColor0 = pack_565(high);
+            uint16_t bestColor1 = pack_565(low);
+            uint8_t bestIndices[16] {};
+            uint32_t bestError = assign_bc1_indices(block, bestColor0, bestColor1, bestIndices);
+
+            static constexpr float kIndexWeights[4] { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+            for (uint32_t iteration = 0; iteration < 2 && bestError > 0; ++iteration)
+            {
+                float weights[16];
+                for (uint32_t i = 0; i < 16; ++i)
+                    weights[i] = kIndexWeights[bestIndices[i]];
+                if (!least_squares_endpoints<3>(block, weights, high, low))
+                    break;
+                const uint16_t color0 = pack_565(high);
+                const uint16_t color1 = pack_565(low);
+                uint8_t indices[16];
+                const uint32_t error = assign_bc1_indices(block, color0, color1, indices);
+                if (error >= bestError)
+                    break;
+                bestError = error;
+                bestColor0 = color0;
+                bestColor1 = color1;
+                std::memcpy(bestIndices, indices, sizeof(indices));
+            }
+
+            // color0 > color1 selects 4-color mode; swapping the endpoints flips 0<->1 and 2<->3
+            if (bestColor0 < bestColor1)
+            {
+                std::swap(bestColor0, bestColor1);
+                for (uint8_t& index : bestIndices)
+                    index ^= 1u;
+            }
+            else if (bestColor0 == bestColor1)
+            {
+                std::memset(bestIndices, 0, sizeof(bestIndices));
+            }
+
+            uint32_t packedIndices = 0;
+            for (uint32_t i = 0; i < 16; ++i)
+                packedIndices |= uint32_t(bestIndices[i]) << (i * 2);
+            std::memcpy(out + 0, &bestColor0, 2);
+            std::memcpy(out + 2, &bestColor1, 2);
+            std::memcpy(out + 4, &packedIndices, 4);
+        }
+
+        void bc4_palette(uint8_t a0, uint8_t a1, uint8_t outPalette[8])
+        {
+            outPalette[0] = a0;
+            outPalette[1] = a1;
+            if (a0 > a1)
+            {
+                for (uint32_t i = 2; i < 8; ++i)
+                    outPalette[i] = static_cast<uint8_t>(((8 - i) * a0 + (i - 1) * a1 + 3) / 7);
+            }
+            else
+            {
+                for (uint32_t i = 2; i < 6; ++i)
+                    outPalette[i] = static_cast<uint8_t>(((6 - i) * a0 + (i - 1) * a1 + 2) / 5);
+                outPalette[6] = 0;
+                outPalette[7] = 255;
+            }
+        }
+
+        uint32_t assign_bc4_indices(const uint8_t values[16], uint8_t a0, uint8_t a1, uint8_t outIndices[16])
+        {
+            // 8-value mode palette order along the ramp from a0 to a1
+            static constexpr uint8_t kRampToIndex[8] { 0, 2, 3, 4, 5, 6, 7, 1 };
+            uint8_t palette[8];
+            bc4_palette(a0, a1, palette);
+            const float scale = 7.0f / float(a0 - a1);
+            uint32_t total = 0;
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                const float ramp = std::clamp((float(a0) - float(values[i])) * scale + 0.5f, 0.0f, 7.0f);
+                const uint8_t index = kRampToIndex[static_cast<uint32_t>(ramp)];
+                const int32_t d = int32_t(values[i]) - int32_t(palette[index]);
+                outIndices[i] = index;
+                total += uint32_t(d * d);
+            }
+            return total;
+        }
+
+        // Single-channel block in 8-value mode; also the alpha half of BC3 and each half of BC5.
+        void encode_bc4_block(const uint8_t values[16], uint8_t out[8])
+        {
+            uint8_t low = 255;
+            uint8_t high = 0;
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                low = std::min(low, values[i]);
+                high = std::max(high, values[i]);
+            }
+
+            uint8_t bestA0 = high;
+            uint8_t bestA1 = low;
+            uint8_t bestIndices[16] {};
+            if (high == low)
+            {
+                // a0 <= a1 selects 6-value mode, where index 0 is exactly a0
+                out[0] = high;
+                out[1] = low;
+                std::memset(out + 2, 0, 6);
+                return;
+            }
+            uint32_t bestError = assign_bc4_indices(values, bestA0, bestA1, bestIndices);
+
+            // Pulling the endpoints in slightly often lands the interior palette entries on the data
+            for (int32_t insetHigh = 0; insetHigh <= 2 && bestError > 0; ++insetHigh)
+            {
+                for (int32_t insetLow = 0; insetLow <= 2; ++insetLow)
+                {
+                    const int32_t a0 = int32_t(high) - insetHigh;
+                    const int32_t a1 = int32_t(low) + insetLow;
+                    if (a0 <= a1)
+                        continue;
+                    uint8_t indices[16];
+                    const uint32_t error = assign_bc4_indices(values, uint8_t(a0), uint8_t(a1), indices);
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestA0 = uint8_t(a0);
+                        bestA1 = uint8_t(a1);
+                        std::memcpy(bestIndices, indices, sizeof(indices));
+                    }
+                }
+            }
+
+            uint64_t packedIndices = 0;
+            for (uint32_t i = 0; i < 16; ++i)
+                packedIndices |= uint64_t(bestIndices[i]) << (i * 3);
+            out[0] = bestA0;
+            out[1] = bestA1;
+            for (uint32_t i = 0; i < 6; ++i)
+                out[2 + i] = static_cast<uint8_t>(packedIndices >> (i * 8));
+        }
+
+        void decode_bc4_block(const uint8_t* data, uint8_t outValues[16])
+        {
+            uint8_t palette[8];
+            bc4_palette(data[0], data[1], palette);
+            uint64_t packedIndices = 0;
+            for (uint32_t i = 0; i < 6; ++i)
+                packedIndices |= uint64_t(data[2 + i]) << (i * 8);
+            for (uint32_t i = 0; i < 16; ++i)
+                outValues[i] = palette[(packedIndices >> (i * 3)) & 7u];
+        }
+
+        void decode_color_block(const uint8_t* data, bool allowThreeColor, Rgba8Block& outBlock)
+        {
+            uint16_t color0 = 0;
+            uint16_t color1 = 0;
+            uint32_t packedIndices = 0;
+            std::memcpy(&color0, data + 0, 2);
+            std::memcpy(&color1, data + 2, 2);
+            std::memcpy(&packedIndices, data + 4, 4);
+
+            const bool fourColor = !allowThreeColor || color0 > color1;
+            uint8_t palette[4][3];
+            bc1_palette(color0, color1, fourColor, palette);
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                const uint32_t index = (packedIndices >> (i * 2)) & 3u;
+                std::memcpy(outBlock.texels[i], palette[index], 3);
+                outBlock.texels[i][3] = (!fourColor && index == 3) ? 0 : 255;
+            }
+        }
+
+        struct BitWriter
+        {
+            uint8_t* data;
+            uint32_t position = 0;
+
+            void Write(uint32_t value, uint32_t bits)
+            {
+                for (uint32_t i = 0; i < bits; ++i, ++position)
+                {
+                    if ((value >> i) & 1u)
+                        data[position >> 3] |= static_cast<uint8_t>(1u << (position & 7u));
+                }
+            }
+        };
+
+        struct BitReader
+        {
+            const uint8_t* data;
+            uint32_t position = 0;
+
+            uint32_t Read(uint32_t bits)
+            {
+                uint32_t value = 0;
+                for (uint32_t i = 0; i < bits; ++i, ++position)
+                    value |= uint32_t((data[position >> 3] >> (position & 7u)) & 1u) << i;
+                return value;
+            }
+        };
+
+        struct Bc7Mode6Endpoints
+        {
+            uint8_t color[2][4] {};
+            uint32_t pbit[2] {};
+        };
+
+        // Mode 6 stores 7 bits per channel plus a shared low bit per endpoint
+        Bc7Mode6Endpoints quantize_mode6(const float low[4], const float high[4], uint32_t pbit0, uint32_t pbit1)
+        {
+            Bc7Mode6Endpoints endpoints;
+            endpoints.pbit[0] = pbit0;
+            endpoints.pbit[1] = pbit1;
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                const float values[2] { low[c], high[c] };
+                for (uint32_t e = 0; e < 2; ++e)
+                {
+                    const float quantized = std::clamp((values[e] - float(endpoints.pbit[e])) * 0.5f + 0.5f, 0.0f, 127.0f);
+                    endpoints.color[e][c] = static_cast<uint8_t>(quantized);
+                }
+            }
+            return endpoints;
+        }
+
+        void mode6_palette(const Bc7Mode6Endpoints& endpoints, uint8_t outPalette[16][4])
+        {
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                const uint32_t e0 = (uint32_t(endpoints.color[0][c]) << 1) | endpoints.pbit[0];
+                const uint32_t e1 = (uint32_t(endpoints.color[1][c]) << 1) | endpoints.pbit[1];
+                for (uint32_t i = 0; i < 16; ++i)
+                    outPalette[i][c] = static_cast<uint8_t>(((64 - kBc7Weights4[i]) * e0 + kBc7Weights4[i] * e1 + 32) >> 6);
+            }
+        }
+
+        uint32_t assign_mode6_indices(const Rgba8Block& block, const Bc7Mode6Endpoints& endpoints, uint8_t outIndices[16])
+        {
+            uint8_t palette[16][4];
+            mode6_palette(endpoints, palette);
+
+            // Project onto the endpoint segment for a first guess, then settle on the nearest neighbour
+            float direction[4];
+            float lengthSquared = 0.0f;
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                direction[c] = float(palette[15][c]) - float(palette[0][c]);
+                lengthSquared += direction[c] * direction[c];
+            }
+            const float scale = lengthSquared > 0.0f ? 15.0f / lengthSquared : 0.0f;
+
+            uint32_t total = 0;
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                float t = 0.0f;
+                for (uint32_t c = 0; c < 4; ++c)
+                    t += (float(block.texels[i][c]) - float(palette[0][c])) * direction[c];
+                const uint32_t guess = static_cast<uint32_t>(std::clamp(t * scale + 0.5f, 0.0f, 15.0f));
+
+                uint32_t best = std::numeric_limits<uint32_t>::max();
+                for (uint32_t p = guess > 0 ? guess - 1 : 0; p <= std::min(guess + 1, 15u); ++p)
+                {
+                    const uint32_t error = color_distance(block.texels[i], palette[p], 4);
+                    if (error < best)
+                    {
+                        best = error;
+                        outIndices[i] = static_cast<uint8_t>(p);
+                    }
+                }
+                total += best;
+            }
+            return total;
+        }
+
+        void fit_mode6(const Rgba8Block& block, const float low[4], const float high[4],
+                       Bc7Mode6Endpoints& inOutBest, uint8_t inOutIndices[16], uint32_t& inOutError)
+        {
+            for (uint32_t pbits = 0; pbits < 4; ++pbits)
+            {
+                const Bc7Mode6Endpoints endpoints = quantize_mode6(low, high, pbits & 1u, pbits >> 1);
+                uint8_t indices[16];
+                const uint32_t error = assign_mode6_indices(block, endpoints, indices);
+                if (error < inOutError)
+                {
+                    inOutError = error;
+                    inOutBest = endpoints;
+                    std::memcpy(inOutIndices, indices, sizeof(indices));
+                }
+            }
+        }
+
+        // Single-subset RGBA mode 6 only; a fast, robust mode for both opaque and alpha content.
+        void encode_bc7_block(const Rgba8Block& block, uint8_t out[16])
+        {
+            float mean[4];
+            float axis[4];
+            float low[4];
+            float high[4];
+            principal_axis<4>(block, mean, axis);
+            axis_endpoints<4>(block, mean, axis, low, high);
+
+            Bc7Mode6Endpoints best;
+            uint8_t bestIndices[16] {};
+            uint32_t bestError = std::numeric_limits<uint32_t>::max();
+            fit_mode6(block, low, high, best, bestIndices, bestError);
+
+            if (bestError > 0)
+            {
+                float weights[16];
+                for (uint32_t i = 0; i < 16; ++i)
+                    weights[i] = float(kBc7Weights4[bestIndices[i]]) / 64.0f;
+                if (least_squares_endpoints<4>(block, weights, low, high))
+                    fit_mode6(block, low, high, best, bestIndices, bestError);
+            }
+
+            // The anchor index drops its top bit, so texel 0 must use the lower half of the palette
+            if (bestIndices[0] & 8u)
+            {
+                std::swap(best.color[0], best.color[1]);
+                std::swap(best.pbit[0], best.pbit[1]);
+                for (uint8_t& index : bestIndices)
+                    index = static_cast<uint8_t>(15u - index);
+            }
+
+            std::memset(out, 0, 16);
+            BitWriter writer { out };
+            writer.Write(1u << 6, 7);
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                writer.Write(best.color[0][c], 7);
+                writer.Write(best.color[1][c], 7);
+            }
+            writer.Write(best.pbit[0], 1);
+            writer.Write(best.pbit[1], 1);
+            writer.Write(bestIndices[0], 3);
+            for (uint32_t i = 1; i < 16; ++i)
+                writer.Write(bestIndices[i], 4);
+        }
+
+        bool decode_bc7_block(const uint8_t* data, Rgba8Block& outBlock)
+        {
+            BitReader reader { data };
+            if (reader.Read(7) != (1u << 6))
+                return false;
+
+            Bc7Mode6Endpoints endpoints;
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                endpoints.color[0][c] = static_cast<uint8_t>(reader.Read(7));
+                endpoints.color[1][c] = static_cast<uint8_t>(reader.Read(7));
+            }
+            endpoints.pbit[0] = reader.Read(1);
+            endpoints.pbit[1] = reader.Read(1);
+
+            uint8_t palette[16][4];
+            mode6_palette(endpoints, palette);
+            for (uint32_t i = 0; i < 16; ++i)
+                std::memcpy(outBlock.texels[i], palette[reader.Read(i == 0 ? 3 : 4)], 4);
+            return true;
+        }
+
+        void encode_block(TextureCookFormat format, const Rgba8Block& block, uint8_t* out)
+        {
+            uint8_t channel[16];
+            auto extract = [&](uint32_t c)
+            {
+                for (uint32_t i = 0; i < 16; ++i)
+                    channel[i] = block.texels[i][c];
+                return channel;
+            };
+
+            switch (format)
+            {
+            case TextureCookFormat::BC1:
+            case TextureCookFormat::BC1_SRGB:
+                encode_color_block(block, out);
+                break;
+            case TextureCookFormat::BC3:
+            case TextureCookFormat::BC3_SRGB:
+                encode_bc4_block(extract(3), out);
+                encode_color_block(block, out + 8);
+                break;
+            case TextureCookFormat::BC4:
+                encode_bc4_block(extract(0), out);
+                break;
+            case TextureCookFormat::BC5:
+                encode_bc4_block(extract(0), out);
+                encode_bc4_block(extract(1), out + 8);
+                break;
+            case TextureCookFormat::BC7:
+            case TextureCookFormat::BC7_SRGB:
+                encode_bc7_block(block, out);
+                break;
+            default:
+                break;
+            }
+        }
+
+        bool decode_block(TextureCookFormat format, const uint8_t* data, Rgba8Block& outBlock)
+        {
+            uint8_t channel[16];
+            switch (format)
+            {
+            case TextureCookFormat::BC1:
+            case TextureCookFormat::BC1_SRGB:
+                decode_color_block(data, true, outBlock);
+                return true;
+            case TextureCookFormat::BC3:
+            case TextureCookFormat::BC3_SRGB:
+                decode_color_block(data + 8, false, outBlock);
+                decode_bc4_block(data, channel);
+                for (uint32_t i = 0; i < 16; ++i)
+                    outBlock.texels[i][3] = channel[i];
+                return true;
+            case TextureCookFormat::BC4:
+                decode_bc4_block(data, channel);
+                for (uint32_t i = 0; i < 16; ++i)
+                {
+                    outBlock.texels[i][0] = outBlock.texels[i][1] = outBlock.texels[i][2] = channel[i];
+                    outBlock.texels[i][3] = 255;
+                }
+                return true;
+            case TextureCookFormat::BC5:
+                decode_bc4_block(data, channel);
+                for (uint32_t i = 0; i < 16; ++i)
+                {
+                    outBlock.texels[i][0] = channel[i];
+                    outBlock.texels[i][2] = 0;
+                    outBlock.texels[i][3] = 255;
+                }
+                decode_bc4_block(data + 8, channel);
+                for (uint32_t i = 0; i < 16; ++i)
+                    outBlock.texels[i][1] = channel[i];
+                return true;
+            case TextureCookFormat::BC7:
+            case TextureCookFormat::BC7_SRGB:
+                return decode_bc7_block(data, outBlock);
+            default:
+                return false;
+            }
+        }
+
+        template <typename Fn>
+        void for_each_block_row(uint32_t rowCount, uint32_t threadCount, Fn&& fn)
+        {
+            if (threadCount == 0)
+                threadCount = std::max(1u, std::thread::hardware_concurrency());
+            const uint32_t bandCount = std::clamp(
+                (rowCount + kMinBlockRowsPerThread - 1) / kMinBlockRowsPerThread, 1u, threadCount);
+            if (bandCount == 1)
+            {
+                fn(0u, rowCount);
+                return;
+            }
+
+            const uint32_t rowsPerBand = (rowCount + bandCount - 1) / bandCount;
+            std::vector<std::thread> workers;
+            workers.reserve(bandCount - 1);
+            for (uint32_t band = 1; band < bandCount; ++band)
+            {
+                const uint32_t begin = band * rowsPerBand;
+                const uint32_t end = std::min(rowCount, begin + rowsPerBand);
+                if (begin < end)
+                    workers.emplace_back([&fn, begin, end] { fn(begin, end); });
+            }
+            fn(0u, std::min(rowCount, rowsPerBand));
+            for (std::thread& worker : workers)
+                worker.join();
+        }
+    }
+
+    namespace TextureCompression
+    {
+        uint32_t BytesPerBlock(TextureCookFormat format)
+        {
+            switch (format)
+            {
+            case TextureCookFormat::RGBA8:
+            case TextureCookFormat::RGBA8_SRGB:
+                return 4;
+            case TextureCookFormat::BC1:
+            case TextureCookFormat::BC1_SRGB:
+            case TextureCookFormat::BC4:
+                return 8;
+            case TextureCookFormat::BC3:
+            case TextureCookFormat::BC3_SRGB:
+            case TextureCookFormat::BC5:
+            case TextureCookFormat::BC7:
+            case TextureCookFormat::BC7_SRGB:
+                return 16;
+            default:
+                return 0;
+            }
+        }
+
+        bool IsBlockCompressed(TextureCookFormat format)
+        {
+            return BytesPerBlock(format) != 0 &&
+                   format != TextureCookFormat::RGBA8 &&
+                   format != TextureCookFormat::RGBA8_SRGB;
+        }
+
+        bool IsSRGB(TextureCookFormat format)
+        {
+            return format == TextureCookFormat::RGBA8_SRGB ||
+                   format == TextureCookFormat::BC1_SRGB ||
+                   format == TextureCookFormat::BC3_SRGB ||
+                   format == TextureCookFormat::BC7_SRGB;
+        }
+
+        const char* ToString(TextureCookFormat format)
+        {
+            switch (format)
+            {
+            case TextureCookFormat::RGBA8: return "RGBA8";
+            case TextureCookFormat::RGBA8_SRGB: return "RGBA8_SRGB";
+            case TextureCookFormat::BC1: return "BC1";
+            case TextureCookFormat::BC1_SRGB: return "BC1_SRGB";
+            case TextureCookFormat::BC3: return "BC3";
+            case TextureCookFormat::BC3_SRGB: return "BC3_SRGB";
+            case TextureCookFormat::BC4: return "BC4";
+            case TextureCookFormat::BC5: return "BC5";
+            case TextureCookFormat::BC7: return "BC7";
+            case TextureCookFormat::BC7_SRGB: return "BC7_SRGB";
+            default: return "Unknown";
+            }
+        }
+
+        uint32_t RowPitch(TextureCookFormat format, uint32_t width)
+        {
+            if (!IsBlockCompressed(format))
+                return width * BytesPerBlock(format);
+            return std::max(1u, (width + 3) / 4) * BytesPerBlock(format);
+        }
+
+        uint32_t RowCount(TextureCookFormat format, uint32_t height)
+        {
+            return IsBlockCompressed(format) ? std::max(1u, (height + 3) / 4) : height;
+        }
+
+        uint64_t MipDataSize(TextureCookFormat format, uint32_t width, uint32_t height)
+        {
+            return uint64_t(RowPitch(format, width)) * RowCount(format, height);
+        }
+
+        bool Encode(TextureCookFormat format, const uint8_t* rgba, uint32_t width, uint32_t height,
+                    std::vector<uint8_t>& outData, uint32_t threadCount)
+        {
+            outData.clear();
+            if (!rgba || width == 0 || height == 0 || BytesPerBlock(format) == 0)
+                return false;
+
+            outData.resize(static_cast<size_t>(MipDataSize(format, width, height)));
+            if (!IsBlockCompressed(format))
+            {
+                std::memcpy(outData.data(), rgba, outData.size());
+                return true;
+            }
+
+            const uint32_t blocksX = std::max(1u, (width + 3) / 4);
+            const uint32_t blocksY = std::max(1u, (height + 3) / 4);
+            const uint32_t blockSize = BytesPerBlock(format);
+            uint8_t* out = outData.data();
+            for_each_block_row(blocksY, threadCount, [&](uint32_t begin, uint32_t end)
+            {
+                Rgba8Block block;
+                for (uint32_t by = begin; by < end; ++by)
+                {
+                    for (uint32_t bx = 0; bx < blocksX; ++bx)
+                    {
+                        load_block(rgba, width, height, bx, by, block);
+                        encode_block(format, block, out + (static_cast<size_t>(by) * blocksX + bx) * blockSize);
+                    }
+                }
+            });
+            return true;
+        }
+
+        bool Decode(TextureCookFormat format, const uint8_t* data, uint32_t width, uint32_t height,
+                    std::vector<uint8_t>& outRgba)
+        {
+            outRgba.clear();
+            if (!data || width == 0 || height == 0 || BytesPerBlock(format) == 0)
+                return false;
+
+            outRgba.resize(static_cast<size_t>(width) * height * 4);
+            if (!IsBlockCompressed(format))
+            {
+                std::memcpy(outRgba.data(), data, outRgba.size());
+                return true;
+            }
+
+            const uint32_t blocksX = std::max(1u, (width + 3) / 4);
+            const uint32_t blocksY = std::max(1u, (height + 3) / 4);
+            const uint32_t blockSize = BytesPerBlock(format);
+            Rgba8Block block;
+            for (uint32_t by = 0; by < blocksY; ++by)
+            {
+                for (uint32_t bx = 0; bx < blocksX; ++bx)
+                {
+                    if (!decode_block(format, data + (static_cast<size_t>(by) * blocksX + bx) * blockSize, block))
+                        return false;
+                    store_block(block, width, height, bx, by, outRgba.data());
+                }
+            }
+            return true;
+        }
+    }
+}
@@ -1,12 +1,22 @@
 #include "asset/texture_importer.h"
 
 #include "asset/asset_hash.h"
+#include "asset/derived_data_cache.h"
+
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#include "stb_image.h"
 
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include <limits>
+#include <span>
 
 namespace Cyber
 {
@@ -20,8 +30,309 @@ namespace Cyber
             return out;
         }
 
+        // v1 payload header, kept so editor assets written before the cook stage still open.
+        struct LegacyTextureAssetPayloadHeader
+        {
+            uint32_t magic = kTextureAssetPayloadMagic;
+            uint32_t version = 1;
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t sourceExtensionSize = 0;
+            uint32_t reserved = 0;
+            uint64_t sourceDataOffset = 0;
+            uint64_t sourceDataSize = 0;
+        };
+
+        constexpr uint64_t kCookedDataAlignment = 16;
+
+        struct DecodedTexture
+        {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            std::vector<uint8_t> rgba;
+            bool hasAlpha = false;
+        };
+
+        struct CookedTexture
+        {
+            TextureUsage usage = TextureUsage::Auto;
+            TextureCookFormat format = TextureCookFormat::Unknown;
+            std::vector<TextureAssetMipRecord> mips;
+            std::vector<std::vector<uint8_t>> mipData;
+        };
+
+        void set_error(std::string* outError, std::string message)
+        {
+            if (outError)
+                *outError = std::move(message);
+        }
+
+        uint64_t align_up(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        bool section_inside(uint64_t offset, uint64_t count, uint64_t stride, uint64_t payloadSize)
+        {
+            if (stride != 0 && count > std::numeric_limits<uint64_t>::max() / stride)
+                return false;
+            const uint64_t size = count * stride;
+            return offset <= payloadSize && size <= payloadSize - offset;
+        }
+
+        bool ends_with(std::string_view text, std::string_view suffix)
+        {
+            return text.size() >= suffix.size() &&
+                   text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+        }
+
+        // Only LDR formats stb_image decodes are cooked; the rest stay source-only.
+        bool is_cookable_extension(std::string_view extension)
+        {
+            return extension == ".png" || extension == ".jpg" || extension == ".jpeg";
+        }
+
+        bool decode_source(const std::vector<uint8_t>& sourceBytes, DecodedTexture& outTexture)
+        {
+            if (sourceBytes.empty() || sourceBytes.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+                return false;
+
+            int width = 0;
+            int height = 0;
+            int components = 0;
+            stbi_uc* pixels = stbi_load_from_memory(sourceBytes.data(), static_cast<int>(sourceBytes.size()),
+                                                    &width, &height, &components, 4);
+            if (!pixels)
+                return false;
+
+            outTexture.width = static_cast<uint32_t>(width);
+            outTexture.height = static_cast<uint32_t>(height);
+            outTexture.rgba.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+            stbi_image_free(pixels);
+
+            outTexture.hasAlpha = false;
+            for (size_t i = 3; i < outTexture.rgba.size(); i += 4)
+            {
+                if (outTexture.rgba[i] != 255)
+                {
+                    outTexture.hasAlpha = true;
+                    break;
+                }
+            }
+            return width > 0 && height > 0;
+        }
+
+        const std::array<float, 256>& srgb_to_linear_table()
+        {
+            static const std::array<float, 256> table = []
+            {
+                std::array<float, 256> values {};
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    const float c = float(i) / 255.0f;
+                    values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        uint8_t linear_to_srgb(float value)
+        {
+            static const std::array<uint8_t, 4096> table = []
+            {
+                std::array<uint8_t, 4096> values {};
+                for (uint32_t i = 0; i < values.size(); ++i)
+                {
+                    const float c = float(i) / float(values.size() - 1);
+                    const float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+                    values[i] = static_cast<uint8_t>(std::clamp(s * 255.0f + 0.5f, 0.0f, 255.0f));
+                }
+                return values;
+            }();
+            const float clamped = std::clamp(value, 0.0f, 1.0f);
+            return table[static_cast<size_t>(clamped * float(table.size() - 1) + 0.5f)];
+        }
+
+        // 2x2 box filter; sRGB colour is averaged in linear space and normals are renormalized.
+        void downsample(const std::vector<uint8_t>& fine, uint32_t fineWidth, uint32_t fineHeight,
+                        TextureUsage usage, bool isSRGB, std::vector<uint8_t>& outCoarse)
+        {
+            const uint32_t coarseWidth = std::max(1u, fineWidth / 2);
+            const uint32_t coarseHeight = std::max(1u, fineHeight / 2);
+            outCoarse.resize(static_cast<size_t>(coarseWidth) * coarseHeight * 4);
+            const auto& toLinear = srgb_to_linear_table();
+
+            for (uint32_t y = 0; y < coarseHeight; ++y)
+            {
+                const uint32_t y0 = std::min(y * 2, fineHeight - 1);
+                const uint32_t y1 = std::min(y * 2 + 1, fineHeight - 1);
+                for (uint32_t x = 0; x < coarseWidth; ++x)
+                {
+                    const uint32_t x0 = std::min(x * 2, fineWidth - 1);
+                    const uint32_t x1 = std::min(x * 2 + 1, fineWidth - 1);
+                    const uint8_t* taps[4] {
+                        &fine[(static_cast<size_t>(y0) * fineWidth + x0) * 4],
+                        &fine[(static_cast<size_t>(y0) * fineWidth + x1) * 4],
+                        &fine[(static_cast<size_t>(y1) * fineWidth + x0) * 4],
+                        &fine[(static_cast<size_t>(y1) * fineWidth + x1) * 4],
+                    };
+                    uint8_t* out = &outCoarse[(static_cast<size_t>(y) * coarseWidth + x) * 4];
+
+                    float sum[4] {};
+                    for (const uint8_t* tap : taps)
+                    {
+                        for (uint32_t c = 0; c < 4; ++c)
+                        {
+                            if (usage == TextureUsage::Normal && c < 3)
+                                sum[c] += float(tap[c]) / 127.5f - 1.0f;
+                            else if (isSRGB && c < 3)
+                                sum[c] += toLinear[tap[c]];
+                            else
+                                sum[c] += float(tap[c]);
+                        }
+                    }
+
+                    if (usage == TextureUsage::Normal)
+                    {
+                        const float length = std::sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+                        const float scale = length > 1e-6f ? 1.0f / length : 0.0f;
+                        for (uint32_t c = 0; c < 3; ++c)
+                            out[c] = static_cast<uint8_t>(std::clamp((sum[c] * scale + 1.0f) * 127.5f + 0.5f, 0.0f, 255.0f));
+                    }
+                    else if (isSRGB)
+                    {
+                        for (uint32_t c = 0; c < 3; ++c)
+                            out[c] = linear_to_srgb(sum[c] * 0.25f);
+                    }
+                    else
+                    {
+                        for (uint32_t c = 0; c < 3; ++c)
+                            out[c] = static_cast<uint8_t>(sum[c] * 0.25f + 0.5f);
+                    }
+                    out[3] = static_cast<uint8_t>(sum[3] * 0.25f + 0.5f);
+                }
+            }
+        }
+
+        bool cook_texture(const DecodedTexture& decoded, TextureUsage usage, uint32_t threadCount,
+                          CookedTexture& outCooked)
+        {
+            outCooked = {};
+            outCooked.usage = usage;
+            outCooked.format = TextureImporter::SelectCookFormat(usage, decoded.hasAlpha);
+
+            const bool isSRGB = TextureCompression::IsSRGB(outCooked.format);
+            std::vector<uint8_t> level = decoded.rgba;
+            std::vector<uint8_t> nextLevel;
+            uint32_t width = decoded.width;
+            uint32_t height = decoded.height;
+            for (;;)
+            {
+                std::vector<uint8_t> encoded;
+                if (!TextureCompression::Encode(outCooked.format, level.data(), width, height, encoded,
+                                                threadCount))
+                    return false;
+
+                TextureAssetMipRecord record;
+                record.width = width;
+                record.height = height;
+                record.rowPitch = TextureCompression::RowPitch(outCooked.format, width);
+                record.rowCount = TextureCompression::RowCount(outCooked.format, height);
+                record.dataSize = encoded.size();
+                outCooked.mips.push_back(record);
+                outCooked.mipData.push_back(std::move(encoded));
+
+                if (width == 1 && height == 1)
+                    break;
+                downsample(level, width, height, usage, isSRGB, nextLevel);
+                level.swap(nextLevel);
+                width = std::max(1u, width / 2);
+                height = std::max(1u, height / 2);
+            }
+            return true;
+        }
+
+        DerivedDataKey mip_chain_key(AssetGuid assetGuid, uint64_t contentHash, TextureUsage usage)
+        {
+            DerivedDataKey key;
+            key.kind = kDerivedTextureMipChain;
+            key.platformTag = kAnyAssetPlatform;
+            key.assetGuid = assetGuid;
+            key.contentHash = contentHash;
+            key.settingsHash = static_cast<uint64_t>(usage);
+            key.cookerVersion = kTextureImporterVersion;
+            return key;
+        }
+
+        void serialize_mip_chain(const CookedTexture& cooked, DerivedDataWriter& writer)
+        {
+            writer.Write(cooked.format);
+            writer.WriteArray(std::span<const TextureAssetMipRecord>(cooked.mips));
+            for (const auto& data : cooked.mipData)
+                writer.WriteArray(std::span<const uint8_t>(data));
+        }
+
+        bool deserialize_mip_chain(std::span<const uint8_t> bytes, TextureUsage usage, CookedTexture& outCooked)
+        {
+            outCooked = {};
+            outCooked.usage = usage;
+            DerivedDataReader reader(bytes);
+            if (!reader.Read(outCooked.format) || !reader.ReadArray(outCooked.mips) || outCooked.mips.empty() ||
+                outCooked.format == TextureCookFormat::Unknown)
+                return false;
+            outCooked.mipData.resize(outCooked.mips.size());
+            for (size_t i = 0; i < outCooked.mips.size(); ++i)
+            {
+                if (!reader.ReadArray(outCooked.mipData[i]) || outCooked.mipData[i].size() != outCooked.mips[i].dataSize)
+                    return false;
+            }
+            return reader.AtEnd();
+        }
+
+        // Decodes and cooks the mip chain unless the DDC already holds it for this key
+        bool derive_mip_chain(const AssetImportRequest& request, const std::vector<uint8_t>& sourceBytes,
+                              const DerivedDataKey& key, TextureUsage usage, CookedTexture& outCooked,
+                              std::string& outError)
+        {
+            std::vector<uint8_t> derived;
+            if (request.derivedDataCache && request.derivedDataCache->Get(key, derived) &&
+                deserialize_mip_chain(derived, usage, outCooked))
+                return true;
+
+            DecodedTexture decoded;
+            if (!decode_source(sourceBytes, decoded))
+            {
+                outError = "Failed to decode texture source file.";
+                return false;
+            }
+            if (!cook_texture(decoded, usage, request.threadCount, outCooked))
+            {
+                outError = "Failed to cook texture mip chain.";
+                return false;
+            }
+            if (request.derivedDataCache)
+            {
+                DerivedDataWriter writer;
+                serialize_mip_chain(outCooked, writer);
+                (void)request.derivedDataCache->Put(key, writer.Bytes());
+            }
+            return true;
+        }
+
+        void write_padding(std::ofstream& file, uint64_t size)
+        {
+            static constexpr std::array<char, kCookedDataAlignment> kZeros {};
+            file.write(kZeros.data(), static_cast<std::streamsize>(size));
+        }
+
         bool write_texture_editor_asset(const AssetImportRequest& request,
                                         const std::vector<uint8_t>& sourceBytes,
+                                        uint32_t width,
+                                        uint32_t height,
+                                        CookedTexture& cooked,
+                                        uint64_t contentHash,
+                                        uint64_t dependencyHash,
                                         AssetGuid assetGuid,
                                         AssetFileHeader& outHeader)
         {
@@ -30,21 +341,44 @@ namespace Cyber
                 return false;
 
             TextureAssetPayloadHeader payloadHeader;
-            payloadHeader.width = request.width;
-            payloadHeader.height = request.height;
+            payloadHeader.width = width;
+            payloadHeader.height = height;
             payloadHeader.sourceExtensionSize = static_cast<uint32_t>(sourceExtension.size());
             payloadHeader.sourceDataOffset = sizeof(TextureAssetPayloadHeader) + sourceExtension.size();
             payloadHeader.sourceDataSize = sourceBytes.size();
+            payloadHeader.cookedFormat = cooked.format;
+            payloadHeader.usage = cooked.usage;
+            payloadHeader.mipCount = static_cast<uint32_t>(cooked.mips.size());
+
+            uint64_t payloadSize = payloadHeader.sourceDataOffset + payloadHeader.sourceDataSize;
+            if (!cooked.mips.empty())
+            {
+                payloadHeader.mipsOffset = align_up(payloadSize, kCookedDataAlignment);
+                payloadHeader.cookedDataOffset = align_up(
+                    payloadHeader.mipsOffset + cooked.mips.size() * sizeof(TextureAssetMipRecord), kCookedDataAlignment);
+                // Mip tail first: the smallest mips sit right after the mip table, so a streamer can
+                // read the table and the always-resident tail in one short contiguous range
+                uint64_t offset = payloadHeader.cookedDataOffset;
+                for (auto mip = cooked.mips.rbegin(); mip != cooked.mips.rend(); ++mip)
+                {
+                    mip->dataOffset = offset;
+                    offset = align_up(offset + mip->dataSize, kCookedDataAlignment);
+                }
+                const TextureAssetMipRecord& last = cooked.mips.front();
+                payloadSize = last.dataOffset + last.dataSize;
+                payloadHeader.cookedDataSize = payloadSize - payloadHeader.cookedDataOffset;
+            }
 
             AssetFileHeader fileHeader;
             fileHeader.assetType = AssetType::Texture;
             fileHeader.assetGuid = assetGuid.IsValid() ? assetGuid : AssetGuid::Create();
-            fileHeader.contentHash = AssetHash::HashBytes(sourceBytes.data(), sourceBytes.size());
-            fileHeader.dependencyHash = AssetHash::HashString(request.sourcePath.generic_string());
+            fileHeader.contentHash = contentHash;
+            fileHeader.contentHashAlgorithm = kDefaultContentHashAlgorithm;
+            fileHeader.dependencyHash = dependencyHash;
             fileHeader.cookerVersion = kTextureImporterVersion;
             fileHeader.platformTag = kAnyAssetPlatform;
             fileHeader.payloadOffset = sizeof(AssetFileHeader);
-            fileHeader.payloadSize = payloadHeader.sourceDataOffset + payloadHeader.sourceDataSize;
+            fileHeader.payloadSize = payloadSize;
 
             std::error_code ec;
             const std::filesystem::path parent = request.destinationPath.parent_path();
@@ -66,6 +400,22 @@ namespace Cyber
                            static_cast<std::streamsize>(sourceBytes.size()));
             }
 
+            uint64_t written = payloadHeader.sourceDataOffset + payloadHeader.sourceDataSize;
+            if (!cooked.mips.empty())
+            {
+                write_padding(file, payloadHeader.mipsOffset - written);
+                file.write(reinterpret_cast<const char*>(cooked.mips.data()),
+                           static_cast<std::streamsize>(cooked.mips.size() * sizeof(TextureAssetMipRecord)));
+                written = payloadHeader.mipsOffset + cooked.mips.size() * sizeof(TextureAssetMipRecord);
+                for (size_t i = cooked.mips.size(); i-- > 0;)
+                {
+                    write_padding(file, cooked.mips[i].dataOffset - written);
+                    file.write(reinterpret_cast<const char*>(cooked.mipData[i].data()),
+                               static_cast<std::streamsize>(cooked.mipData[i].size()));
+                    written = cooked.mips[i].dataOffset + cooked.mips[i].dataSize;
+                }
+            }
+
             if (!file.good())
                 return false;
 
@@ -98,8 +448,25 @@ namespace Cyber
             return false;
         }
 
+        // The GUID is settled before cooking because it keys the derived data
+        const AssetGuid assetGuid = request.existingGuid.IsValid() ? request.existingGuid : AssetGuid::Create();
+        const uint64_t contentHash = AssetHash::HashContent(sourceBytes.data(), sourceBytes.size());
+        CookedTexture cooked;
+        uint32_t width = request.width;
+        uint32_t height = request.height;
+        if (is_cookable_extension(lowercase(request.sourcePath.extension().string())))
+        {
+            const TextureUsage usage = ResolveUsage(request.textureUsage, request.sourcePath);
+            if (!derive_mip_chain(request, sourceBytes, mip_chain_key(assetGuid, contentHash, usage), usage,
+                                  cooked, outResult.error))
+                return false;
+            width = cooked.mips.front().width;
+            height = cooked.mips.front().height;
+        }
+
         AssetFileHeader fileHeader;
-        if (!write_texture_editor_asset(request, sourceBytes, request.existingGuid, fileHeader))
+        if (!write_texture_editor_asset(request, sourceBytes, width, height, cooked, contentHash,
+                                        DependencyHash(request), assetGuid, fileHeader))
         {
             outResult.error = "Failed to write texture editor asset.";
             return false;
@@ -120,6 +487,13 @@ namespace Cyber
         return true;
     }
 
+    uint64_t TextureImporter::DependencyHash(const AssetImportRequest& request) const
+    {
+        // The cooked format follows from the usage and the source's alpha, so usage is enough
+        const TextureUsage usage = ResolveUsage(request.textureUsage, request.sourcePath);
+        return AssetHash::Combine(IAssetImporter::DependencyHash(request), static_cast<uint64_t>(usage));
+    }
+
     bool TextureImporter::IsSupportedSourceExtension(std::string_view extension)
     {
         const std::string ext = lowercase(extension);
@@ -145,25 +519,42 @@ namespace Cyber
         if (!file || !fileHeader.IsCompatible(AssetType::Texture, kAssetFileFormatVersion))
             return false;
 
-        if (fileHeader.payloadOffset < sizeof(AssetFileHeader) ||
-            fileHeader.payloadSize < sizeof(TextureAssetPayloadHeader))
+        if (fileHeader.payloadOffset < fileHeader.headerSize ||
+            fileHeader.payloadSize < sizeof(LegacyTextureAssetPayloadHeader))
         {
             return false;
         }
 
+        // v2 extends the v1 header in place, so a v1 header is read into the v2 prefix.
         file.seekg(static_cast<std::streamoff>(fileHeader.payloadOffset), std::ios::beg);
         TextureAssetPayloadHeader payloadHeader;
-        file.read(reinterpret_cast<char*>(&payloadHeader), sizeof(payloadHeader));
+        file.read(reinterpret_cast<char*>(&payloadHeader), sizeof(LegacyTextureAssetPayloadHeader));
         if (!file ||
             payloadHeader.magic != kTextureAssetPayloadMagic ||
-            payloadHeader.version != kTextureAssetPayloadVersion ||
+            payloadHeader.version == 0 ||
+            payloadHeader.version > kTextureAssetPayloadVersion ||
             payloadHeader.sourceExtensionSize > 64)
         {
             return false;
         }
 
-        const uint64_t minSourceOffset =
-            sizeof(TextureAssetPayloadHeader) + payloadHeader.sourceExtensionSize;
+        uint64_t headerSize = sizeof(LegacyTextureAssetPayloadHeader);
+        if (payloadHeader.version == 1)
+        {
+            payloadHeader.cookedFormat = TextureCookFormat::Unknown;
+        }
+        else
+        {
+            headerSize = sizeof(TextureAssetPayloadHeader);
+            if (fileHeader.payloadSize < headerSize)
+                return false;
+            file.read(reinterpret_cast<char*>(&payloadHeader) + sizeof(LegacyTextureAssetPayloadHeader),
+                      sizeof(TextureAssetPayloadHeader) - sizeof(LegacyTextureAssetPayloadHeader));
+            if (!file)
+                return false;
+        }
+
+        const uint64_t minSourceOffset = headerSize + payloadHeader.sourceExtensionSize;
         if (payloadHeader.sourceDataOffset < minSourceOffset ||
             payloadHeader.sourceDataOffset > fileHeader.payloadSize)
         {
@@ -180,9 +571,173 @@ namespace Cyber
         outInfo.fileHeader = fileHeader;
         outInfo.payloadHeader = payloadHeader;
         outInfo.sourceExtension = std::move(sourceExtension);
+        outInfo.isCooked = payloadHeader.version >= 2 &&
+                           payloadHeader.cookedFormat != TextureCookFormat::Unknown &&
+                           payloadHeader.mipCount > 0;
         return true;
     }
 
+    bool TextureImporter::ReadCookedData(const std::filesystem::path& path,
+                                         CookedTextureData& outData, std::string* outError)
+    {
+        return ReadCookedMips(path, 0, outData, outError);
+    }
+
+    bool TextureImporter::ReadCookedMips(const std::filesystem::path& path, uint32_t firstMip,
+                                         CookedTextureData& outData, std::string* outError)
+    {
+        outData = {};
+        if (outError)
+            outError->clear();
+
+        TextureEditorAssetInfo info;
+        if (!ReadInfo(path, info))
+        {
+            set_error(outError, "Invalid texture asset.");
+            return false;
+        }
+        if (!info.isCooked)
+        {
+            set_error(outError, "Texture asset has no cooked data and must be reimported.");
+            return false;
+        }
+
+        const auto& p = info.payloadHeader;
+        const uint64_t size = info.fileHeader.payloadSize;
+        if (TextureCompression::BytesPerBlock(p.cookedFormat) == 0 || p.mipCount > 32 ||
+            !section_inside(p.mipsOffset, p.mipCount, sizeof(TextureAssetMipRecord), size) ||
+            !section_inside(p.cookedDataOffset, p.cookedDataSize, 1, size))
+        {
+            set_error(outError, "Cooked texture asset contains an invalid section range.");
+            return false;
+        }
+        if (firstMip >= p.mipCount)
+        {
+            set_error(outError, "Requested mip is outside the cooked texture's mip chain.");
+            return false;
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        std::vector<TextureAssetMipRecord> records(p.mipCount);
+        file.seekg(static_cast<std::streamoff>(info.fileHeader.payloadOffset + p.mipsOffset), std::ios::beg);
+        file.read(reinterpret_cast<char*>(records.data()),
+                  static_cast<std::streamsize>(records.size() * sizeof(TextureAssetMipRecord)));
+        if (!file)
+        {
+            set_error(outError, "Failed to read cooked texture mip table.");
+            return false;
+        }
+
+        uint64_t rangeBegin = std::numeric_limits<uint64_t>::max();
+        uint64_t rangeEnd = 0;
+        uint64_t rangeBytes = 0;
+        for (uint32_t i = firstMip; i < p.mipCount; ++i)
+        {
+            const TextureAssetMipRecord& record = records[i];
+            if (record.dataOffset < p.cookedDataOffset ||
+                !section_inside(record.dataOffset, record.dataSize, 1, p.cookedDataOffset + p.cookedDataSize) ||
+                record.dataSize != TextureCompression::MipDataSize(p.cookedFormat, record.width, record.height))
+            {
+                set_error(outError, "Cooked texture mip range is invalid.");
+                return false;
+            }
+            rangeBegin = std::min(rangeBegin, record.dataOffset);
+            rangeEnd = std::max(rangeEnd, record.dataOffset + record.dataSize);
+            rangeBytes += record.dataSize;
+        }
+
+        outData.format = p.cookedFormat;
+        outData.width = p.width;
+        outData.height = p.height;
+        outData.firstMip = firstMip;
+        outData.mips.resize(p.mipCount - firstMip);
+        for (uint32_t i = firstMip; i < p.mipCount; ++i)
+        {
+            outData.mips[i - firstMip].record = records[i];
+            outData.mips[i - firstMip].bytes.resize(static_cast<size_t>(records[i].dataSize));
+        }
+
+        // Any suffix of the chain is one padded range in both the tail-first and the older
+        // full-resolution-first layout, so it costs a single read
+        const uint64_t maxPadding = static_cast<uint64_t>(outData.mips.size()) * kCookedDataAlignment;
+        if (rangeEnd - rangeBegin <= rangeBytes + maxPadding)
+        {
+            std::vector<uint8_t> range(static_cast<size_t>(rangeEnd - rangeBegin));
+            file.seekg(static_cast<std::streamoff>(info.fileHeader.payloadOffset + rangeBegin), std::ios::beg);
+            file.read(reinterpret_cast<char*>(range.data()), static_cast<std::streamsize>(range.size()));
+            if (!file)
+            {
+                set_error(outError, "Failed to read cooked texture mip data.");
+                return false;
+            }
+            for (auto& mip : outData.mips)
+            {
+                if (!mip.bytes.empty())
+                    std::memcpy(mip.bytes.data(), range.data() + (mip.record.dataOffset - rangeBegin), mip.bytes.size());
+            }
+            return true;
+        }
+
+        for (auto& mip : outData.mips)
+        {
+            file.seekg(static_cast<std::streamoff>(info.fileHeader.payloadOffset + mip.record.dataOffset), std::ios::beg);
+            file.read(reinterpret_cast<char*>(mip.bytes.data()), static_cast<std::streamsize>(mip.bytes.size()));
+            if (!file)
+            {
+                set_error(outError, "Failed to read cooked texture mip data.");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    TextureUsage TextureImporter::ResolveUsage(TextureUsage requested, const std::filesystem::path& sourcePath)
+    {
+        if (requested != TextureUsage::Auto)
+            return requested;
+
+        const std::string stem = lowercase(sourcePath.stem().string());
+        static constexpr std::array<std::string_view, 4> kNormalSuffixes {{ "_n", "_nrm", "_normal", "_normals" }};
+        static constexpr std::array<std::string_view, 7> kMaskSuffixes {{
+            "_mask", "_orm", "_arm", "_rough", "_roughness", "_metal", "_metallic"
+        }};
+        static constexpr std::array<std::string_view, 5> kGrayscaleSuffixes {{
+            "_ao", "_height", "_disp", "_displacement", "_gray"
+        }};
+
+        const auto matches = [&stem](const auto& suffixes)
+        {
+            return std::any_of(suffixes.begin(), suffixes.end(),
+                [&stem](std::string_view suffix) { return ends_with(stem, suffix); });
+        };
+        if (matches(kNormalSuffixes))
+            return TextureUsage::Normal;
+        if (matches(kMaskSuffixes))
+            return TextureUsage::Mask;
+        if (matches(kGrayscaleSuffixes))
+            return TextureUsage::Grayscale;
+        return TextureUsage::Albedo;
+    }
+
+    TextureCookFormat TextureImporter::SelectCookFormat(TextureUsage usage, bool hasAlpha)
+    {
+        switch (usage)
+        {
+        case TextureUsage::Normal:
+            return TextureCookFormat::BC5;
+        case TextureUsage::Mask:
+            return TextureCookFormat::BC7;
+        case TextureUsage::Grayscale:
+            return TextureCookFormat::BC4;
+        case TextureUsage::Uncompressed:
+            return TextureCookFormat::RGBA8_SRGB;
+        case TextureUsage::Auto:
+        case TextureUsage::Albedo:
+        default:
+            return hasAlpha ? TextureCookFormat::BC3_SRGB : TextureCookFormat::BC1_SRGB;
+        }
+    }
+
     bool TextureImporter::ReadSourceBytes(const std::filesystem::path& path,
                                           std::vector<uint8_t>& outBytes)
     {
@@ -2050,7 +2050,9 @@ namespace Cyber
                         edited_mesh->vertex_buffer = nullptr;
                         edited_mesh->index_buffer = nullptr;
                         edited_mesh->vertex_stride = 0;
+                        edited_mesh->vertex_layout = {};
                         edited_mesh->draw_primitives.clear();
+                        edited_mesh->primitive_decode = nullptr;
                         edited_mesh->runtime_vertex_count = 0;
                         edited_mesh->runtime_index_count = 0;
                         edited_mesh->runtime_bounds_valid = false;
@@ -2193,6 +2195,8 @@ namespace Cyber
                         m_texture_info_guid.clear();
                         m_texture_info_content_hash = 0;
                         m_texture_info_payload_size = 0;
+                        m_texture_info_cooked_format.clear();
+                        m_texture_info_mip_count = 0;
 
                         if (ext == ".textureasset")
                         {
@@ -2207,6 +2211,12 @@ namespace Cyber
                                 m_texture_info_guid = texture_asset_info.fileHeader.assetGuid.ToString();
                                 m_texture_info_content_hash = texture_asset_info.fileHeader.contentHash;
                                 m_texture_info_payload_size = texture_asset_info.fileHeader.payloadSize;
+                                if (texture_asset_info.isCooked)
+                                {
+                                    m_texture_info_cooked_format =
+                                        TextureCompression::ToString(texture_asset_info.payloadHeader.cookedFormat);
+                                    m_texture_info_mip_count = texture_asset_info.payloadHeader.mipCount;
+                                }
                             }
                         }
                         else
@@ -2227,6 +2237,11 @@ namespace Cyber
                         ImGui::Text("Content Hash: 0x%016llx", (unsigned long long)m_texture_info_content_hash);
                         ImGui::Text("Source Format: %s",
                                     m_texture_info_source_format.empty() ? "(unknown)" : m_texture_info_source_format.c_str());
+                        if (m_texture_info_cooked_format.empty())
+                            ImGui::TextDisabled("Cooked Format: (source only)");
+                        else
+                            ImGui::Text("Cooked Format: %s, %u mips",
+                                        m_texture_info_cooked_format.c_str(), m_texture_info_mip_count);
                     }
 
                     if (m_texture_info_valid)
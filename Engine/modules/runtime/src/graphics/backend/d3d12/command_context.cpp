@@ -200,20 +200,27 @@ void CommandContext::transition_resource(Texture_D3D12_Impl& texture, const Text
 {
     DECLARE_ZERO(D3D12_RESOURCE_BARRIER, d3d_barrier);
 
+    cyber_assert(!transition_barrier.record_only || transition_barrier.src_state != GRAPHICS_RESOURCE_STATE_UNKNOWN,
+                 "D3D12 ERROR: Record-only texture barrier needs an explicit source state!");
     GRAPHICS_RESOURCE_STATE current_state = transition_barrier.src_state != GRAPHICS_RESOURCE_STATE_UNKNOWN ?
                                             transition_barrier.src_state : texture.get_new_state();
     GRAPHICS_RESOURCE_STATE expected_state = transition_barrier.dst_state;
 
-    if(current_state == transition_barrier.dst_state)
+    // UAV -> UAV keeps the state but still orders unordered writes, so it must not take the early-out
+    const bool uav_barrier = current_state == GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS &&
+                             transition_barrier.dst_state == GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS;
+    if(!uav_barrier && current_state == transition_barrier.dst_state)
     {
         return;
     }
 
-    texture.set_old_state(current_state);
-    texture.set_new_state(expected_state);
+    if(!transition_barrier.record_only)
+    {
+        texture.set_old_state(current_state);
+        texture.set_new_state(expected_state);
+    }
 
-    if(transition_barrier.src_state == GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS &&
-        transition_barrier.dst_state == GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS)
+    if(uav_barrier)
     {
         d3d_barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
         d3d_barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
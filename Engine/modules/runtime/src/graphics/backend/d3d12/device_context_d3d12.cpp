@@ -465,8 +465,9 @@ void DeviceContext_D3D12_Impl::set_unordered_access_view(SHADER_STAGE stage, uin
     state_cache.unordered_access_view_cache.bind_slot_mask[stage] |= ((uint64_t)1 << binding);
 }
 
-void DeviceContext_D3D12_Impl::set_root_constant_buffer_view(SHADER_STAGE stage, uint32_t binding, IBuffer* buffer)
+void DeviceContext_D3D12_Impl::set_root_constant_buffer_view(SHADER_STAGE stage, uint32_t binding, IBuffer* buffer, uint64_t offset)
 {
+    cyber_check_msg((offset % D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT) == 0, "Root constant buffer offsets must be 256-byte aligned");
     auto& cache = state_cache.constant_buffer_cache;
     auto& current_cbv_cache = cache.current_gpu_virtual_address[stage];
     Buffer_D3D12_Impl* cbv_buffer = static_cast<Buffer_D3D12_Impl*>(buffer);
@@ -474,7 +475,7 @@ void DeviceContext_D3D12_Impl::set_root_constant_buffer_view(SHADER_STAGE stage,
     if(cbv_buffer && cbv_buffer->get_gpu_address(0) != D3D12_GPU_VIRTUAL_ADDRESS_UNKONWN)
     {
         state_cache.constant_buffer_cache.bind_slot_mask[stage] |= ((uint64_t)1 << binding);
-        current_cbv_cache[binding] = cbv_buffer->get_gpu_address(0);
+        current_cbv_cache[binding] = cbv_buffer->get_gpu_address(0) + offset;
     }
     else
     {
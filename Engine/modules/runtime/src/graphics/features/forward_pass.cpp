@@ -10,23 +10,15 @@
 #include "graphics/interface/render_device.hpp"
 #include "graphics/interface/texture.hpp"
 #include "graphics/interface/texture_view.h"
+#include "graphics/interface/vertex_input.h"
 #include "renderer/renderer.h"
 
-#include <cstddef>
+#include <cmath>
 #include <cstring>
+#include <limits>
 
 namespace Cyber::Renderer
 {
-    namespace
-    {
-        struct ForwardVertex
-        {
-            float3 position;
-            float3 normal;
-            float2 uv;
-        };
-    }
-
     void ForwardPassPipelineCache::initialize(RenderObject::IRenderDevice* render_device)
     {
         if (device == render_device)
@@ -36,20 +28,19 @@ namespace Cyber::Renderer
         device = render_device;
     }
 
-    RenderObject::IRenderPipeline* ForwardPassPipelineCache::get_depth_only(TEXTURE_FORMAT depth_format)
+    RenderObject::IRenderPipeline* ForwardPassPipelineCache::get_depth_only(TEXTURE_FORMAT depth_format,
+        const CookedVertexLayout& layout)
     {
         if (!device)
             return nullptr;
 
-        const auto existing = depth_pipelines.find(depth_format);
+        const auto key = eastl::make_pair(depth_format, layout.Key());
+        const auto existing = depth_pipelines.find(key);
         if (existing != depth_pipelines.end())
             return existing->second;
 
-        RenderObject::VertexAttribute vertex_attributes[] = {
-            {"ATTRIB", 0, 0, 3, VALUE_TYPE_FLOAT32, false, offsetof(ForwardVertex, position)},
-            {"ATTRIB", 1, 0, 3, VALUE_TYPE_FLOAT32, false, offsetof(ForwardVertex, normal)},
-            {"ATTRIB", 2, 0, 2, VALUE_TYPE_FLOAT32, false, offsetof(ForwardVertex, uv)},
-        };
+        RenderObject::VertexAttribute vertex_attributes[3];
+        make_cooked_input_layout(layout, vertex_attributes);
 
         RefCntAutoPtr<RenderObject::IRenderPipeline> pipeline = PipelineBuilder(device)
             .vertex_shader(CYBER_UTF8("shaders/DX12/forward_depth_vs.hlsl"))
@@ -60,10 +51,107 @@ namespace Cyber::Renderer
             .depth_format(depth_format)
             .build();
 
-        depth_pipelines[depth_format] = pipeline;
+        depth_pipelines[key] = pipeline;
         return pipeline;
     }
 
+    void make_cooked_input_layout(const CookedVertexLayout& layout, RenderObject::VertexAttribute (&out_attributes)[3])
+    {
+        const auto to_attribute = [&layout](uint32_t input_index, const CookedVertexAttribute& attribute)
+        {
+            RenderObject::VertexAttribute result;
+            result.input_index = input_index;
+            result.buffer_slot = 0;
+            result.relative_offset = attribute.offset;
+            result.stride = layout.stride;
+            switch (attribute.format)
+            {
+            case CookedVertexFormat::Float32x2:
+                result.num_components = 2;
+                result.value_type = VALUE_TYPE_FLOAT32;
+                break;
+            case CookedVertexFormat::Float32x3:
+                result.num_components = 3;
+                result.value_type = VALUE_TYPE_FLOAT32;
+                break;
+            case CookedVertexFormat::Float16x2:
+                result.num_components = 2;
+                result.value_type = VALUE_TYPE_FLOAT16;
+                break;
+            case CookedVertexFormat::Unorm16x2:
+                result.num_components = 2;
+                result.value_type = VALUE_TYPE_UINT16;
+                result.is_normalized = true;
+                break;
+            case CookedVertexFormat::Unorm16x4:
+                result.num_components = 4;
+                result.value_type = VALUE_TYPE_UINT16;
+                result.is_normalized = true;
+                break;
+            case CookedVertexFormat::OctahedralSnorm16x2:
+                result.num_components = 2;
+                result.value_type = VALUE_TYPE_INT16;
+                result.is_normalized = true;
+                break;
+            }
+            return result;
+        };
+
+        out_attributes[0] = to_attribute(0, layout.position);
+        out_attributes[1] = to_attribute(1, layout.normal);
+        out_attributes[2] = to_attribute(2, layout.uv0);
+    }
+
+    ForwardPrimitiveDecode make_forward_primitive_decode(const CookedVertexLayout& layout,
+                                                         const CookedMeshPrimitiveDecode& decode)
+    {
+        ForwardPrimitiveDecode result;
+        if (layout.position.format == CookedVertexFormat::Unorm16x4)
+        {
+            result.position_offset = float4(decode.positionOffset[0], decode.positionOffset[1], decode.positionOffset[2], 0.0f);
+            result.position_scale = float4(decode.positionScale[0], decode.positionScale[1], decode.positionScale[2], 1.0f);
+        }
+        if (layout.uv0.format == CookedVertexFormat::Unorm16x2)
+            result.uv_offset_scale = float4(decode.uvOffset[0], decode.uvOffset[1], decode.uvScale[0], decode.uvScale[1]);
+        result.octahedral_normal = layout.normal.format == CookedVertexFormat::OctahedralSnorm16x2 ? 1u : 0u;
+        return result;
+    }
+
+    bool is_forward_drawable(const Component::MeshComponent& mesh)
+    {
+        return mesh.enabled && mesh.is_render_ready();
+    }
+
+    float lod_pixels_per_unit(const float3& center, const float3& extent, const float3& eye,
+                              float proj_y_scale, float viewport_height, float world_scale)
+    {
+        const float dx = center.x - eye.x;
+        const float dy = center.y - eye.y;
+        const float dz = center.z - eye.z;
+        const float radius = std::sqrt(extent.x * extent.x + extent.y * extent.y + extent.z * extent.z);
+        const float distance = std::sqrt(dx * dx + dy * dy + dz * dz) - radius;
+        if (!(distance > 0.0f))
+            return std::numeric_limits<float>::infinity();
+        // Clip space spans 2 units over the viewport height
+        return world_scale * proj_y_scale * viewport_height * 0.5f / distance;
+    }
+
+    uint32_t select_mesh_lod(const Component::MeshDrawPrimitive& primitive, float pixels_per_unit, float max_pixel_error)
+    {
+        if (!(max_pixel_error > 0.0f))
+            return 0;
+
+        // Errors never decrease along the chain, so the first level over the limit ends it
+        uint32_t level = 0;
+        for (const Component::MeshDrawLod& lod : primitive.lods)
+        {
+            if (lod.error > 0.0f && !(lod.error * pixels_per_unit <= max_pixel_error))
+                break;
+            ++level;
+        }
+        return level;
+    }
+
     ForwardRenderPass::ForwardRenderPass(ForwardPassContext* context)
         : pass_context(context)
     {
@@ -87,103 +175,177 @@ namespace Cyber::Renderer
         pass_context->command_context->render_encoder_set_scissor(1, &scissor);
     }
 
-    void ForwardRenderPass::update_scene_constants(const ForwardSceneConstants& constants) const
+    void ForwardRenderPass::update_pass_constants(const ForwardPassConstants& constants) const
     {
-        if (!pass_context || !pass_context->device || !pass_context->scene_constants)
+        if (!pass_context || !pass_context->device || !pass_context->pass_constants)
             return;
 
-        void* mapped = pass_context->device->map_buffer(pass_context->scene_constants, MAP_WRITE, MAP_FLAG_DISCARD);
+        void* mapped = pass_context->device->map_buffer(pass_context->pass_constants, MAP_WRITE, MAP_FLAG_DISCARD);
         if (!mapped)
             return;
 
         std::memcpy(mapped, &constants, sizeof(constants));
-        pass_context->device->unmap_buffer(pass_context->scene_constants, MAP_WRITE);
-        pass_context->scene_constants->set_buffer_size(sizeof(constants));
+        pass_context->device->unmap_buffer(pass_context->pass_constants, MAP_WRITE);
+        pass_context->pass_constants->set_buffer_size(sizeof(constants));
     }
 
-    void ForwardRenderPass::draw_depth_only(const float4x4& view_proj, RenderObject::IRenderPipeline* pipeline) const
+    void ForwardRenderPass::bind_object_constants(uint32_t object_index) const
     {
-        if (!pass_context || !pass_context->frame.world || !pass_context->command_context || !pipeline)
+        pass_context->command_context->set_root_constant_buffer_view(SHADER_STAGE_VERT, 1, pass_context->object_constants,
+            static_cast<uint64_t>(object_index) * kForwardObjectConstantsStride);
+    }
+
+    void ForwardRenderPass::bind_mesh_decode(const Component::MeshComponent& mesh) const
+    {
+        // Meshes with per-primitive constants bind their slot in draw_primitive instead
+        if (!mesh.primitive_decode)
+            pass_context->command_context->set_root_constant_buffer_view(SHADER_STAGE_VERT, 2, pass_context->identity_decode);
+    }
+
+    void ForwardRenderPass::draw_primitive(uint32_t object_index, const Component::MeshComponent& mesh,
+        uint32_t primitive_index) const
+    {
+        if (mesh.primitive_decode)
+        {
+            pass_context->command_context->set_root_constant_buffer_view(SHADER_STAGE_VERT, 2, mesh.primitive_decode,
+                static_cast<uint64_t>(primitive_index) * kForwardPrimitiveDecodeStride);
+        }
+
+        const Component::MeshDrawPrimitive& primitive = mesh.draw_primitives[primitive_index];
+        uint32_t first_index = primitive.first_index;
+        uint32_t index_count = primitive.index_count;
+        if (!primitive.lods.empty() && object_index < pass_context->lod_pixels_per_unit.size())
+        {
+            const uint32_t level = select_mesh_lod(primitive, pass_context->lod_pixels_per_unit[object_index],
+                pass_context->lod_max_pixel_error);
+            if (level > 0)
+            {
+                first_index = primitive.lods[level - 1].first_index;
+                index_count = primitive.lods[level - 1].index_count;
+            }
+        }
+
+        pass_context->command_context->prepare_for_rendering();
+        pass_context->command_context->render_encoder_draw_indexed(index_count, first_index, 0);
+    }
+
+    uint32_t ForwardRenderPass::cull_draw_list(const float4x4& view_proj, bool shadow_casters) const
+    {
+        pass_context->visible_objects.resize(pass_context->draw_bounds.padded_size());
+        if (pass_context->visible_objects.empty())
+            return 0;
+
+        const CullingFrustum frustum = CullingFrustum::from_view_projection(view_proj, !shadow_casters);
+        return cull_boxes(frustum, pass_context->draw_bounds, pass_context->visible_objects.data());
+    }
+
+    void ForwardRenderPass::draw_depth_only(const float4x4& view_proj, bool shadow_casters)
+    {
+        if (!pass_context || !pass_context->command_context || !pass_context->object_constants ||
+            !pass_context->identity_decode)
+            return;
+
+        const uint32_t visible_count = cull_draw_list(view_proj, shadow_casters);
+        if (visible_count == 0)
             return;
 
+        ForwardPassConstants constants = {};
+        constants.view_proj_matrix = view_proj.transpose();
+        constants.camera_pos = float4(0.0f, 0.0f, 0.0f, 1.0f);
+        constants.light_direction = float4(0.0f, -1.0f, 0.0f, 0.0f);
+        constants.light_color = float4(1.0f, 1.0f, 1.0f, 1.0f);
+        update_pass_constants(constants);
+
         auto* command_context = pass_context->command_context;
-        command_context->render_encoder_bind_pipeline(pipeline);
-        pass_context->frame.world->for_each_component_of<Component::MeshComponent>(
-            [&](SceneNode&, Component::MeshComponent& mesh, uint32_t)
+        RenderObject::IRenderPipeline* bound_pipeline = nullptr;
+
+        for (uint32_t i = 0; i < visible_count; ++i)
+        {
+            const uint32_t object_index = pass_context->visible_objects[i];
+            const Component::MeshComponent& mesh = *pass_context->draw_list[object_index];
+            RenderObject::IRenderPipeline* pipeline = get_pipeline(mesh.vertex_layout);
+            if (!pipeline)
+                continue;
+            // Draw lists mostly share one layout, so this binds once per pass
+            if (pipeline != bound_pipeline)
             {
-                if (!mesh.enabled || !mesh.is_render_ready())
-                    return;
-
-                ForwardSceneConstants constants = {};
-                constants.view_proj_matrix = view_proj.transpose();
-                constants.model_matrix = mesh.local_matrix().transpose();
-                constants.camera_pos = float4(0.0f, 0.0f, 0.0f, 1.0f);
-                constants.light_direction = float4(0.0f, -1.0f, 0.0f, 0.0f);
-                constants.light_color = float4(1.0f, 1.0f, 1.0f, 1.0f);
-                update_scene_constants(constants);
-
-                RenderObject::IBuffer* vertex_buffers[] = { mesh.vertex_buffer };
-                uint32_t strides[] = { mesh.vertex_stride };
-                command_context->render_encoder_bind_vertex_buffer(1, vertex_buffers, strides, nullptr);
-                command_context->render_encoder_bind_index_buffer(mesh.index_buffer, sizeof(uint32_t), 0);
-                command_context->set_root_constant_buffer_view(SHADER_STAGE_VERT, 0, pass_context->scene_constants);
-
-                for (const auto& primitive : mesh.draw_primitives)
-                {
-                    command_context->prepare_for_rendering();
-                    command_context->render_encoder_draw_indexed(primitive.index_count, primitive.first_index, 0);
-                }
-            });
+                command_context->render_encoder_bind_pipeline(pipeline);
+                command_context->set_root_constant_buffer_view(SHADER_STAGE_VERT, 0, pass_context->pass_constants);
+                bound_pipeline = pipeline;
+            }
+            bind_object_constants(object_index);
+            bind_mesh_decode(mesh);
+
+            RenderObject::IBuffer* vertex_buffers[] = { mesh.vertex_buffer };
+            uint32_t strides[] = { mesh.vertex_stride };
+            command_context->render_encoder_bind_vertex_buffer(1, vertex_buffers, strides, nullptr);
+            command_context->render_encoder_bind_index_buffer(mesh.index_buffer, sizeof(uint32_t), 0);
+
+            for (uint32_t primitive_index = 0; primitive_index < mesh.draw_primitives.size(); ++primitive_index)
+                draw_primitive(object_index, mesh, primitive_index);
+        }
     }
 
     void ForwardRenderPass::draw_color(const float4x4& view_proj, const float3& eye,
         const float3& light_dir, const float3& light_color, float light_intensity,
-        RenderObject::IRenderPipeline* pipeline, RenderObject::ITexture* fallback_texture) const
+        RenderObject::ITexture* fallback_texture)
     {
-        if (!pass_context || !pass_context->frame.world || !pass_context->command_context ||
-            !pipeline)
+        if (!pass_context || !pass_context->command_context || !pass_context->object_constants ||
+            !pass_context->identity_decode)
+            return;
+
+        const uint32_t visible_count = cull_draw_list(view_proj, false);
+        if (visible_count == 0)
             return;
 
+        ForwardPassConstants constants = {};
+        constants.view_proj_matrix = view_proj.transpose();
+        constants.camera_pos = float4(eye, 1.0f);
+        constants.light_direction = float4(light_dir, 0.0f);
+        constants.light_color = float4(light_color * light_intensity, 1.0f);
+        update_pass_constants(constants);
+
         auto* command_context = pass_context->command_context;
-        command_context->render_encoder_bind_pipeline(pipeline);
-        pass_context->frame.world->for_each_component_of<Component::MeshComponent>(
-            [&](SceneNode&, Component::MeshComponent& mesh, uint32_t)
+        RenderObject::IRenderPipeline* bound_pipeline = nullptr;
+
+        RenderObject::ITexture_View* fallback_base_color = fallback_texture
+            ? fallback_texture->get_default_texture_view(TEXTURE_VIEW_SHADER_RESOURCE)
+            : nullptr;
+
+        for (uint32_t i = 0; i < visible_count; ++i)
+        {
+            const uint32_t object_index = pass_context->visible_objects[i];
+            const Component::MeshComponent& mesh = *pass_context->draw_list[object_index];
+            RenderObject::IRenderPipeline* pipeline = get_pipeline(mesh.vertex_layout);
+            if (!pipeline)
+                continue;
+            if (pipeline != bound_pipeline)
             {
-                if (!mesh.enabled || !mesh.is_render_ready())
-                    return;
-
-                ForwardSceneConstants constants = {};
-                constants.view_proj_matrix = view_proj.transpose();
-                constants.model_matrix = mesh.local_matrix().transpose();
-                constants.camera_pos = float4(eye, 1.0f);
-                constants.light_direction = float4(light_dir, 0.0f);
-                constants.light_color = float4(light_color * light_intensity, 1.0f);
-                update_scene_constants(constants);
-
-                RenderObject::IBuffer* vertex_buffers[] = { mesh.vertex_buffer };
-                uint32_t strides[] = { mesh.vertex_stride };
-                command_context->render_encoder_bind_vertex_buffer(1, vertex_buffers, strides, nullptr);
-                command_context->render_encoder_bind_index_buffer(mesh.index_buffer, sizeof(uint32_t), 0);
-                command_context->set_root_constant_buffer_view(SHADER_STAGE_VERT, 0, pass_context->scene_constants);
-                command_context->set_root_constant_buffer_view(SHADER_STAGE_FRAG, 0, pass_context->scene_constants);
-
-                RenderObject::ITexture_View* fallback_base_color = fallback_texture
-                    ? fallback_texture->get_default_texture_view(TEXTURE_VIEW_SHADER_RESOURCE)
-                    : nullptr;
-
-                for (const auto& primitive : mesh.draw_primitives)
-                {
-                    RenderObject::ITexture_View* base_color_view = primitive.base_color_view;
-                    if (!base_color_view)
-                        base_color_view = fallback_base_color;
-                    if (!base_color_view)
-                        continue;
-
-                    command_context->set_shader_resource_view(SHADER_STAGE_FRAG, 0, base_color_view);
-                    command_context->prepare_for_rendering();
-                    command_context->render_encoder_draw_indexed(primitive.index_count, primitive.first_index, 0);
-                }
-            });
+                command_context->render_encoder_bind_pipeline(pipeline);
+                command_context->set_root_constant_buffer_view(SHADER_STAGE_VERT, 0, pass_context->pass_constants);
+                command_context->set_root_constant_buffer_view(SHADER_STAGE_FRAG, 0, pass_context->pass_constants);
+                bound_pipeline = pipeline;
+            }
+            bind_object_constants(object_index);
+            bind_mesh_decode(mesh);
+
+            RenderObject::IBuffer* vertex_buffers[] = { mesh.vertex_buffer };
+            uint32_t strides[] = { mesh.vertex_stride };
+            command_context->render_encoder_bind_vertex_buffer(1, vertex_buffers, strides, nullptr);
+            command_context->render_encoder_bind_index_buffer(mesh.index_buffer, sizeof(uint32_t), 0);
+
+            for (uint32_t primitive_index = 0; primitive_index < mesh.draw_primitives.size(); ++primitive_index)
+            {
+                RenderObject::ITexture_View* base_color_view = mesh.draw_primitives[primitive_index].base_color_view;
+                if (!base_color_view)
+                    base_color_view = fallback_base_color;
+                if (!base_color_view)
+                    continue;
+
+                command_context->set_shader_resource_view(SHADER_STAGE_FRAG, 0, base_color_view);
+                draw_primitive(object_index, mesh, primitive_index);
+            }
+        }
     }
 
     bool ForwardRenderPass::find_scene_view(float4x4& view_proj, float3& eye) const
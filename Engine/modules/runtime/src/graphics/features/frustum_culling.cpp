@@ -0,0 +1,259 @@
+#include "graphics/features/frustum_culling.h"
+
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define CYBER_CULLING_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CYBER_CULLING_SSE2 1
+#endif
+
+namespace Cyber::Renderer
+{
+    namespace
+    {
+        // No plane rejects a box this large, and |n| * extent stays finite
+        constexpr float kUnboundedExtent = 1.0e30f;
+
+        float4 combine_columns(const float4x4& m, uint32_t column, uint32_t other, float sign)
+        {
+            return float4(m[0][column] + sign * m[0][other], m[1][column] + sign * m[1][other],
+                          m[2][column] + sign * m[2][other], m[3][column] + sign * m[3][other]);
+        }
+
+        // Same operation order as the SIMD paths, so both agree on boxes touching a plane
+        bool box_visible(const CullingFrustum& frustum, float cx, float cy, float cz, float ex, float ey, float ez)
+        {
+            for (uint32_t p = 0; p < frustum.plane_count; ++p)
+            {
+                const float4& plane = frustum.planes[p];
+                float distance = cx * plane.x;
+                distance += cy * plane.y;
+                distance += cz * plane.z;
+                distance += plane.w;
+                distance += ex * std::fabs(plane.x);
+                distance += ey * std::fabs(plane.y);
+                distance += ez * std::fabs(plane.z);
+                if (!(distance >= 0.0f))
+                    return false;
+            }
+            return true;
+        }
+
+#if CYBER_CULLING_AVX
+        uint32_t cull_boxes_avx(const CullingFrustum& frustum, const CullingBoxes& boxes, uint32_t* visible)
+        {
+            __m256 nx[6], ny[6], nz[6], nw[6], ax[6], ay[6], az[6];
+            for (uint32_t p = 0; p < frustum.plane_count; ++p)
+            {
+                const float4& plane = frustum.planes[p];
+                nx[p] = _mm256_set1_ps(plane.x);
+                ny[p] = _mm256_set1_ps(plane.y);
+                nz[p] = _mm256_set1_ps(plane.z);
+                nw[p] = _mm256_set1_ps(plane.w);
+                ax[p] = _mm256_set1_ps(std::fabs(plane.x));
+                ay[p] = _mm256_set1_ps(std::fabs(plane.y));
+                az[p] = _mm256_set1_ps(std::fabs(plane.z));
+            }
+
+            const uint32_t count = boxes.size();
+            const __m256 zero = _mm256_setzero_ps();
+            uint32_t visible_count = 0;
+            for (uint32_t base = 0; base < count; base += 8)
+            {
+                const __m256 cx = _mm256_loadu_ps(boxes.center_x.data() + base);
+                const __m256 cy = _mm256_loadu_ps(boxes.center_y.data() + base);
+                const __m256 cz = _mm256_loadu_ps(boxes.center_z.data() + base);
+                const __m256 ex = _mm256_loadu_ps(boxes.extent_x.data() + base);
+                const __m256 ey = _mm256_loadu_ps(boxes.extent_y.data() + base);
+                const __m256 ez = _mm256_loadu_ps(boxes.extent_z.data() + base);
+
+                __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for (uint32_t p = 0; p < frustum.plane_count; ++p)
+                {
+                    __m256 distance = _mm256_mul_ps(cx, nx[p]);
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(cy, ny[p]));
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(cz, nz[p]));
+                    distance = _mm256_add_ps(distance, nw[p]);
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(ex, ax[p]));
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(ey, ay[p]));
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(ez, az[p]));
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+                }
+
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(inside));
+                if (count - base < 8)
+                    mask &= (1u << (count - base)) - 1u;
+                // Branchless compaction; the padded buffer absorbs writes past the last visible box
+                for (uint32_t lane = 0; lane < 8; ++lane)
+                {
+                    visible[visible_count] = base + lane;
+                    visible_count += (mask >> lane) & 1u;
+                }
+            }
+            return visible_count;
+        }
+#elif CYBER_CULLING_SSE2
+        uint32_t cull_boxes_sse2(const CullingFrustum& frustum, const CullingBoxes& boxes, uint32_t* visible)
+        {
+            __m128 nx[6], ny[6], nz[6], nw[6], ax[6], ay[6], az[6];
+            for (uint32_t p = 0; p < frustum.plane_count; ++p)
+            {
+                const float4& plane = frustum.planes[p];
+                nx[p] = _mm_set1_ps(plane.x);
+                ny[p] = _mm_set1_ps(plane.y);
+                nz[p] = _mm_set1_ps(plane.z);
+                nw[p] = _mm_set1_ps(plane.w);
+                ax[p] = _mm_set1_ps(std::fabs(plane.x));
+                ay[p] = _mm_set1_ps(std::fabs(plane.y));
+                az[p] = _mm_set1_ps(std::fabs(plane.z));
+            }
+
+            const uint32_t count = boxes.size();
+            const __m128 zero = _mm_setzero_ps();
+            uint32_t visible_count = 0;
+            for (uint32_t base = 0; base < count; base += 4)
+            {
+                const __m128 cx = _mm_loadu_ps(boxes.center_x.data() + base);
+                const __m128 cy = _mm_loadu_ps(boxes.center_y.data() + base);
+                const __m128 cz = _mm_loadu_ps(boxes.center_z.data() + base);
+                const __m128 ex = _mm_loadu_ps(boxes.extent_x.data() + base);
+                const __m128 ey = _mm_loadu_ps(boxes.extent_y.data() + base);
+                const __m128 ez = _mm_loadu_ps(boxes.extent_z.data() + base);
+
+                __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                for (uint32_t p = 0; p < frustum.plane_count; ++p)
+                {
+                    __m128 distance = _mm_mul_ps(cx, nx[p]);
+                    distance = _mm_add_ps(distance, _mm_mul_ps(cy, ny[p]));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(cz, nz[p]));
+                    distance = _mm_add_ps(distance, nw[p]);
+                    distance = _mm_add_ps(distance, _mm_mul_ps(ex, ax[p]));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(ey, ay[p]));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(ez, az[p]));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, zero));
+                }
+
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(inside));
+                if (count - base < 4)
+                    mask &= (1u << (count - base)) - 1u;
+                // Branchless compaction; the padded buffer absorbs writes past the last visible box
+                for (uint32_t lane = 0; lane < 4; ++lane)
+                {
+                    visible[visible_count] = base + lane;
+                    visible_count += (mask >> lane) & 1u;
+                }
+            }
+            return visible_count;
+        }
+#endif
+    }
+
+    CullingFrustum CullingFrustum::from_view_projection(const float4x4& view_proj, bool test_depth_range)
+    {
+        // Gribb-Hartmann: clip = p * view_proj, so each plane combines columns of the matrix
+        CullingFrustum frustum;
+        frustum.planes[0] = combine_columns(view_proj, 3, 0, 1.0f);
+        frustum.planes[1] = combine_columns(view_proj, 3, 0, -1.0f);
+        frustum.planes[2] = combine_columns(view_proj, 3, 1, 1.0f);
+        frustum.planes[3] = combine_columns(view_proj, 3, 1, -1.0f);
+        frustum.plane_count = 4;
+        if (test_depth_range)
+        {
+            // D3D clip depth runs from 0 to w
+            frustum.planes[4] = combine_columns(view_proj, 2, 2, 0.0f);
+            frustum.planes[5] = combine_columns(view_proj, 3, 2, -1.0f);
+            frustum.plane_count = 6;
+        }
+        return frustum;
+    }
+
+    void CullingBoxes::clear()
+    {
+        center_x.clear();
+        center_y.clear();
+        center_z.clear();
+        extent_x.clear();
+        extent_y.clear();
+        extent_z.clear();
+        count = 0;
+    }
+
+    void CullingBoxes::reserve(uint32_t box_count)
+    {
+        const uint32_t padded = (box_count + kBatchWidth - 1) / kBatchWidth * kBatchWidth;
+        center_x.reserve(padded);
+        center_y.reserve(padded);
+        center_z.reserve(padded);
+        extent_x.reserve(padded);
+        extent_y.reserve(padded);
+        extent_z.reserve(padded);
+    }
+
+    uint32_t CullingBoxes::add_local_box(const float3& local_min, const float3& local_max, const float4x4& world)
+    {
+        const float3 c = (local_min + local_max) * 0.5f;
+        const float3 e = (local_max - local_min) * 0.5f;
+        const float3 center(
+            c.x * world[0][0] + c.y * world[1][0] + c.z * world[2][0] + world[3][0],
+            c.x * world[0][1] + c.y * world[1][1] + c.z * world[2][1] + world[3][1],
+            c.x * world[0][2] + c.y * world[1][2] + c.z * world[2][2] + world[3][2]);
+        const float3 extent(
+            e.x * std::fabs(world[0][0]) + e.y * std::fabs(world[1][0]) + e.z * std::fabs(world[2][0]),
+            e.x * std::fabs(world[0][1]) + e.y * std::fabs(world[1][1]) + e.z * std::fabs(world[2][1]),
+            e.x * std::fabs(world[0][2]) + e.y * std::fabs(world[1][2]) + e.z * std::fabs(world[2][2]));
+        return add_world_box(center, extent);
+    }
+
+    uint32_t CullingBoxes::add_world_box(const float3& center, const float3& extent)
+    {
+        if (count == center_x.size())
+        {
+            const size_t padded = center_x.size() + kBatchWidth;
+            center_x.resize(padded, 0.0f);
+            center_y.resize(padded, 0.0f);
+            center_z.resize(padded, 0.0f);
+            extent_x.resize(padded, 0.0f);
+            extent_y.resize(padded, 0.0f);
+            extent_z.resize(padded, 0.0f);
+        }
+
+        center_x[count] = center.x;
+        center_y[count] = center.y;
+        center_z[count] = center.z;
+        extent_x[count] = extent.x;
+        extent_y[count] = extent.y;
+        extent_z[count] = extent.z;
+        return count++;
+    }
+
+    uint32_t CullingBoxes::add_unbounded()
+    {
+        return add_world_box(float3(0.0f, 0.0f, 0.0f), float3(kUnboundedExtent, kUnboundedExtent, kUnboundedExtent));
+    }
+
+    uint32_t cull_boxes(const CullingFrustum& frustum, const CullingBoxes& boxes, uint32_t* visible)
+    {
+#if CYBER_CULLING_AVX
+        return cull_boxes_avx(frustum, boxes, visible);
+#elif CYBER_CULLING_SSE2
+        return cull_boxes_sse2(frustum, boxes, visible);
+#else
+        return cull_boxes_scalar(frustum, boxes, visible);
+#endif
+    }
+
+    uint32_t cull_boxes_scalar(const CullingFrustum& frustum, const CullingBoxes& boxes, uint32_t* visible)
+    {
+        uint32_t visible_count = 0;
+        for (uint32_t i = 0; i < boxes.size(); ++i)
+        {
+            if (box_visible(frustum, boxes.center_x[i], boxes.center_y[i], boxes.center_z[i],
+                            boxes.extent_x[i], boxes.extent_y[i], boxes.extent_z[i]))
+                visible[visible_count++] = i;
+        }
+        return visible_count;
+    }
+}
@@ -14,7 +14,6 @@ namespace Cyber::Renderer
         : ForwardRenderPass(context)
         , resources(pass_resources)
     {
-        create_pipeline();
         create_render_pass();
     }
 
@@ -23,13 +22,12 @@ namespace Cyber::Renderer
         set_depthstencil(resources.depth, LOAD_ACTION_CLEAR, STORE_ACTION_STORE);
     }
 
-    void PreDepthPass::create_pipeline()
+    RenderObject::IRenderPipeline* PreDepthPass::get_pipeline(const CookedVertexLayout& layout)
     {
         if (!pass_context || !pass_context->pipeline_cache || !resources.depth || !resources.depth->texture)
-            return;
+            return nullptr;
 
-        pipeline = pass_context->pipeline_cache->get_depth_only(
-            resources.depth->texture->get_create_desc().m_format);
+        return pass_context->pipeline_cache->get_depth_only(resources.depth->texture->get_create_desc().m_format, layout);
     }
 
     void PreDepthPass::create_render_pass()
@@ -83,7 +81,7 @@ namespace Cyber::Renderer
         float4x4 view_proj = float4x4::Identity();
         float3 eye = float3(0.0f, 0.0f, 0.0f);
         if (find_scene_view(view_proj, eye))
-            draw_depth_only(view_proj, pipeline);
+            draw_depth_only(view_proj);
 
         pass_context->command_context->cmd_end_render_pass();
     }
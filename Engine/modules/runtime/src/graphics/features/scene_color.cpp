@@ -8,29 +8,17 @@
 #include "graphics/interface/sampler.h"
 #include "graphics/interface/texture.hpp"
 #include "graphics/interface/texture_view.h"
+#include "graphics/interface/vertex_input.h"
 #include "graphics/rendergraph/render_graph.h"
 #include "graphics/rendergraph/render_graph_builder.h"
 
-#include <cstddef>
-
 namespace Cyber::Renderer
 {
-    namespace
-    {
-        struct ForwardVertex
-        {
-            float3 position;
-            float3 normal;
-            float2 uv;
-        };
-    }
-
     SceneColorPass::SceneColorPass(const Resources& pass_resources, ForwardPassContext* context)
         : ForwardRenderPass(context)
         , resources(pass_resources)
     {
         create_resources();
-        create_pipeline();
         create_render_pass();
     }
 
@@ -84,19 +72,20 @@ namespace Cyber::Renderer
         sampler = RefCntAutoPtr<RenderObject::ISampler>(pass_context->device->create_sampler(sampler_desc));
     }
 
-    void SceneColorPass::create_pipeline()
+    RenderObject::IRenderPipeline* SceneColorPass::get_pipeline(const CookedVertexLayout& layout)
     {
         if (!pass_context || !pass_context->device || !resources.color || !resources.color->texture ||
             !resources.depth || !resources.depth->texture || !sampler)
-            return;
+            return nullptr;
 
-        RenderObject::VertexAttribute vertex_attributes[] = {
-            {"ATTRIB", 0, 0, 3, VALUE_TYPE_FLOAT32, false, offsetof(ForwardVertex, position)},
-            {"ATTRIB", 1, 0, 3, VALUE_TYPE_FLOAT32, false, offsetof(ForwardVertex, normal)},
-            {"ATTRIB", 2, 0, 2, VALUE_TYPE_FLOAT32, false, offsetof(ForwardVertex, uv)},
-        };
+        const auto existing = pipelines.find(layout.Key());
+        if (existing != pipelines.end())
+            return existing->second;
 
-        pipeline = PipelineBuilder(pass_context->device)
+        RenderObject::VertexAttribute vertex_attributes[3];
+        make_cooked_input_layout(layout, vertex_attributes);
+
+        RefCntAutoPtr<RenderObject::IRenderPipeline> pipeline = PipelineBuilder(pass_context->device)
             .vertex_shader(CYBER_UTF8("shaders/DX12/forward_color_vs.hlsl"))
             .pixel_shader(CYBER_UTF8("shaders/DX12/forward_color_ps.hlsl"))
             .vertex_layout(vertex_attributes, 3)
@@ -106,6 +95,9 @@ namespace Cyber::Renderer
             .render_target_format(resources.color->texture->get_create_desc().m_format)
             .depth_format(resources.depth->texture->get_create_desc().m_format)
             .build();
+
+        pipelines[layout.Key()] = pipeline;
+        return pipeline;
     }
 
     void SceneColorPass::create_render_pass()
@@ -182,7 +174,7 @@ namespace Cyber::Renderer
         if (find_scene_view(view_proj, eye))
         {
             find_main_light(light_dir, light_color, light_intensity);
-            draw_color(view_proj, eye, light_dir, light_color, light_intensity, pipeline, white_texture);
+            draw_color(view_proj, eye, light_dir, light_color, light_intensity, white_texture);
         }
 
         pass_context->command_context->cmd_end_render_pass();
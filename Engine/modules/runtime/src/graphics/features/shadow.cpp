@@ -15,7 +15,6 @@ namespace Cyber::Renderer
         : ForwardRenderPass(context)
         , resources(pass_resources)
     {
-        create_pipeline();
         create_render_pass();
         create_frame_buffer();
     }
@@ -25,14 +24,14 @@ namespace Cyber::Renderer
         set_depthstencil(resources.shadow_map, LOAD_ACTION_CLEAR, STORE_ACTION_STORE);
     }
 
-    void ShadowPass::create_pipeline()
+    RenderObject::IRenderPipeline* ShadowPass::get_pipeline(const CookedVertexLayout& layout)
     {
         if (!pass_context || !pass_context->pipeline_cache ||
             !resources.shadow_map || !resources.shadow_map->texture)
-            return;
+            return nullptr;
 
-        pipeline = pass_context->pipeline_cache->get_depth_only(
-            resources.shadow_map->texture->get_create_desc().m_format);
+        return pass_context->pipeline_cache->get_depth_only(
+            resources.shadow_map->texture->get_create_desc().m_format, layout);
     }
 
     void ShadowPass::create_render_pass()
@@ -102,7 +101,7 @@ namespace Cyber::Renderer
         float3 light_color;
         float light_intensity;
         if (find_main_light(light_dir, light_color, light_intensity))
-            draw_depth_only(build_shadow_view_projection(light_dir), pipeline);
+            draw_depth_only(build_shadow_view_projection(light_dir), true);
 
         pass_context->command_context->cmd_end_render_pass();
     }
@@ -0,0 +1,304 @@
+#include "graphics/features/texture_streaming.h"
+
+#include "EASTL/sort.h"
+
+#include <cmath>
+
+namespace Cyber::Renderer
+{
+    namespace
+    {
+        // One mip a texture could hold beyond its tail. Residency is always a suffix of the chain,
+        // so a texture can only take mip m once it holds m + 1.
+        struct MipStep
+        {
+            StreamedTextureHandle texture = kInvalidStreamedTexture;
+            uint32_t mip = 0;
+            uint64_t bytes = 0;
+            // Requested and at or above the wanted mip; cached steps come after every wanted one
+            bool wanted = false;
+            // Wanted: mips still missing to reach the want; cached: frame the texture was last requested
+            uint64_t order = 0;
+            float screen_pixels = 0.0f;
+        };
+
+        bool step_before(const MipStep& lhs, const MipStep& rhs)
+        {
+            if (lhs.wanted != rhs.wanted)
+                return lhs.wanted;
+            if (lhs.order != rhs.order)
+                return lhs.order > rhs.order;
+            if (lhs.wanted && lhs.screen_pixels != rhs.screen_pixels)
+                return lhs.screen_pixels > rhs.screen_pixels;
+            if (lhs.mip != rhs.mip)
+                return lhs.mip > rhs.mip;
+            return lhs.texture < rhs.texture;
+        }
+    }
+
+    TextureStreamer::TextureStreamer(ITextureStreamingBackend& in_backend, TextureStreamingSettings in_settings)
+        : backend(in_backend)
+        , settings(in_settings)
+    {
+    }
+
+    uint64_t TextureStreamer::bytes_from(const StreamedTexture& texture, uint32_t first_mip)
+    {
+        uint64_t bytes = 0;
+        for (uint32_t mip = first_mip; mip < texture.mip_count; ++mip)
+            bytes += texture.desc.mip_bytes[mip];
+        return bytes;
+    }
+
+    StreamedTextureHandle TextureStreamer::register_texture(const StreamedTextureDesc& desc)
+    {
+        if (desc.mip_bytes.empty() || desc.width == 0 || desc.height == 0)
+            return kInvalidStreamedTexture;
+
+        StreamedTextureHandle handle;
+        if (!free_handles.empty())
+        {
+            handle = free_handles.back();
+            free_handles.pop_back();
+        }
+        else
+        {
+            handle = static_cast<StreamedTextureHandle>(textures.size());
+            textures.push_back();
+        }
+
+        StreamedTexture& texture = textures[handle];
+        texture = {};
+        texture.desc = desc;
+        texture.mip_count = static_cast<uint32_t>(desc.mip_bytes.size());
+        texture.tail_mip = texture.mip_count - 1;
+        for (uint32_t mip = 0; mip < texture.mip_count; ++mip)
+        {
+            if (eastl::max(desc.width >> mip, 1u) <= settings.tail_size && eastl::max(desc.height >> mip, 1u) <= settings.tail_size)
+            {
+                texture.tail_mip = mip;
+                break;
+            }
+        }
+        texture.resident_mip = texture.mip_count;
+        texture.wanted_mip = texture.tail_mip;
+        texture.live = true;
+
+        load_tail(handle);
+        return handle;
+    }
+
+    void TextureStreamer::unregister_texture(StreamedTextureHandle handle)
+    {
+        if (handle >= textures.size() || !textures[handle].live)
+            return;
+
+        StreamedTexture& texture = textures[handle];
+        backend.release(handle);
+        resident_bytes -= bytes_from(texture, texture.resident_mip);
+        texture = {};
+        free_handles.push_back(handle);
+    }
+
+    void TextureStreamer::load_tail(StreamedTextureHandle handle)
+    {
+        StreamedTexture& texture = textures[handle];
+        if (texture.resident_mip <= texture.tail_mip || !backend.set_resident_mips(handle, texture.tail_mip))
+            return;
+
+        const uint64_t bytes = bytes_from(texture, texture.tail_mip) - bytes_from(texture, texture.resident_mip);
+        resident_bytes += bytes;
+        stats.uploaded_bytes += bytes;
+        texture.resident_mip = texture.tail_mip;
+    }
+
+    void TextureStreamer::request(StreamedTextureHandle handle, float screen_pixels)
+    {
+        if (handle >= textures.size() || !textures[handle].live)
+            return;
+
+        StreamedTexture& texture = textures[handle];
+        texture.screen_pixels = texture.requested ? eastl::max(texture.screen_pixels, screen_pixels) : screen_pixels;
+        texture.requested = true;
+        texture.last_used_frame = frame_index;
+    }
+
+    void TextureStreamer::update()
+    {
+        stats = {};
+
+        // A tail that failed to load blocks everything finer, so retry those first
+        uint64_t tail_bytes = 0;
+        for (StreamedTextureHandle handle = 0; handle < textures.size(); ++handle)
+        {
+            if (!textures[handle].live)
+                continue;
+            load_tail(handle);
+            tail_bytes += bytes_from(textures[handle], textures[handle].tail_mip);
+        }
+
+        eastl::vector<MipStep> steps;
+        eastl::vector<uint32_t> target(textures.size(), 0);
+        for (StreamedTextureHandle handle = 0; handle < textures.size(); ++handle)
+        {
+            StreamedTexture& texture = textures[handle];
+            if (!texture.live)
+                continue;
+
+            ++stats.textures;
+            texture.wanted_mip = texture.tail_mip;
+            if (texture.requested)
+            {
+                ++stats.requested;
+                texture.wanted_mip = eastl::min(texture.tail_mip,
+                    compute_wanted_mip(texture.desc.width, texture.desc.height, texture.mip_count, texture.screen_pixels, settings.mip_bias));
+            }
+            stats.wanted_bytes += bytes_from(texture, texture.wanted_mip);
+            target[handle] = texture.tail_mip;
+
+            for (uint32_t mip = texture.tail_mip; mip-- > 0;)
+            {
+                MipStep step;
+                step.texture = handle;
+                step.mip = mip;
+                step.bytes = texture.desc.mip_bytes[mip];
+                step.wanted = texture.requested && mip >= texture.wanted_mip;
+                if (step.wanted)
+                {
+                    step.order = mip - texture.wanted_mip + 1;
+                    step.screen_pixels = texture.screen_pixels;
+                }
+                else if (mip >= texture.resident_mip)
+                {
+                    step.order = texture.last_used_frame;
+                }
+                else
+                {
+                    // Neither wanted nor held: nothing would load it
+                    continue;
+                }
+                steps.push_back(step);
+            }
+        }
+        eastl::sort(steps.begin(), steps.end(), step_before);
+
+        // Fill the budget in priority order; a step that does not fit ends its texture's chain,
+        // but smaller steps of other textures may still fit behind it
+        const uint64_t streaming_budget = settings.budget_bytes > tail_bytes ? settings.budget_bytes - tail_bytes : 0;
+        uint64_t planned_bytes = 0;
+        eastl::vector<MipStep> accepted;
+        accepted.reserve(steps.size());
+        for (const MipStep& step : steps)
+        {
+            if (step.mip + 1 != target[step.texture] || planned_bytes + step.bytes > streaming_budget)
+                continue;
+            planned_bytes += step.bytes;
+            target[step.texture] = step.mip;
+            accepted.push_back(step);
+        }
+
+        // Evict before loading so residency never exceeds the budget in between
+        for (StreamedTextureHandle handle = 0; handle < textures.size(); ++handle)
+        {
+            StreamedTexture& texture = textures[handle];
+            if (!texture.live)
+                continue;
+            if (texture.requested && target[handle] > texture.wanted_mip)
+                ++stats.over_budget;
+            if (texture.resident_mip >= target[handle])
+                continue;
+
+            backend.set_resident_mips(handle, target[handle]);
+            const uint64_t bytes = bytes_from(texture, texture.resident_mip) - bytes_from(texture, target[handle]);
+            resident_bytes -= bytes;
+            stats.evicted_bytes += bytes;
+            texture.resident_mip = target[handle];
+        }
+
+        // Only wanted steps can be missing, and they come in priority order
+        eastl::vector<uint32_t> upload_mip(textures.size(), 0);
+        eastl::vector<StreamedTextureHandle> upload_order;
+        for (StreamedTextureHandle handle = 0; handle < textures.size(); ++handle)
+            upload_mip[handle] = textures[handle].resident_mip;
+
+        uint64_t upload_bytes = 0;
+        for (const MipStep& step : accepted)
+        {
+            if (step.mip >= textures[step.texture].resident_mip)
+                continue;
+            const bool within_limit = settings.max_upload_bytes_per_update == 0 || upload_bytes == 0 ||
+                upload_bytes + step.bytes <= settings.max_upload_bytes_per_update;
+            if (step.mip + 1 != upload_mip[step.texture] || !within_limit)
+            {
+                ++stats.deferred_uploads;
+                continue;
+            }
+            if (upload_mip[step.texture] == textures[step.texture].resident_mip)
+                upload_order.push_back(step.texture);
+            upload_mip[step.texture] = step.mip;
+            upload_bytes += step.bytes;
+        }
+
+        for (StreamedTextureHandle handle : upload_order)
+        {
+            StreamedTexture& texture = textures[handle];
+            if (!backend.set_resident_mips(handle, upload_mip[handle]))
+                continue;
+            const uint64_t bytes = bytes_from(texture, upload_mip[handle]) - bytes_from(texture, texture.resident_mip);
+            resident_bytes += bytes;
+            stats.uploaded_bytes += bytes;
+            texture.resident_mip = upload_mip[handle];
+        }
+
+        for (StreamedTexture& texture : textures)
+        {
+            texture.requested = false;
+            texture.screen_pixels = 0.0f;
+        }
+        stats.resident_bytes = resident_bytes;
+        ++frame_index;
+    }
+
+    uint32_t TextureStreamer::get_resident_mip(StreamedTextureHandle handle) const
+    {
+        return handle < textures.size() && textures[handle].live ? textures[handle].resident_mip : 0;
+    }
+
+    uint32_t TextureStreamer::get_wanted_mip(StreamedTextureHandle handle) const
+    {
+        return handle < textures.size() && textures[handle].live ? textures[handle].wanted_mip : 0;
+    }
+
+    uint32_t TextureStreamer::get_tail_mip(StreamedTextureHandle handle) const
+    {
+        return handle < textures.size() && textures[handle].live ? textures[handle].tail_mip : 0;
+    }
+
+    uint32_t compute_wanted_mip(uint32_t width, uint32_t height, uint32_t mip_count, float screen_pixels, float mip_bias)
+    {
+        if (mip_count == 0)
+            return 0;
+        if (!(screen_pixels > 0.0f))
+            return mip_count - 1;
+
+        // The finest mip needed is the coarsest one still at least as large as the screen footprint
+        const float size = static_cast<float>(eastl::max(width, height));
+        const float mip = std::floor(std::log2(size / screen_pixels) + mip_bias);
+        if (!(mip > 0.0f))
+            return 0;
+        return mip >= static_cast<float>(mip_count - 1) ? mip_count - 1 : static_cast<uint32_t>(mip);
+    }
+
+    float projected_screen_pixels(const float3& center, const float3& extent, const float3& eye,
+                                  float proj_y_scale, float viewport_height)
+    {
+        const float dx = center.x - eye.x;
+        const float dy = center.y - eye.y;
+        const float dz = center.z - eye.z;
+        const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        const float radius = std::sqrt(extent.x * extent.x + extent.y * extent.y + extent.z * extent.z);
+        if (!(distance > radius))
+            return viewport_height;
+        return radius * proj_y_scale * viewport_height / distance;
+    }
+}
@@ -191,7 +191,19 @@ void MemoryPool::init()
 
 void MemoryPool::destroy()
 {
+    // Allocated blocks belong to the callers; only the pool's own bookkeeping is released here
+    for(PoolAllocationData* free_block : free_blocks)
+    {
+        free_block->remove_from_linked_list();
+        cyber_delete(free_block);
+    }
+    free_blocks.clear();
 
+    for(PoolAllocationData* allocation_data : allocated_pools)
+    {
+        cyber_delete(allocation_data);
+    }
+    allocated_pools.clear();
 }
 
 bool MemoryPool::try_allocate(uint32_t in_size_in_bytes, uint32_t in_allocation_alignment, PoolResourceType in_resource_type, PoolAllocationData& out_allocation)
@@ -231,6 +243,7 @@ bool MemoryPool::try_allocate(uint32_t in_size_in_bytes, uint32_t in_allocation_
         {
             add_to_free_blocks(free_block);
         }
+        return true;
     }
     else
     {
@@ -369,7 +382,7 @@ void MemoryPool::release_allocation_data(PoolAllocationData* in_allocation_data)
     in_allocation_data->reset();
     if(allocated_pools.size() >= desired_allocation_pool_size)
     {
-        delete in_allocation_data;
+        cyber_delete(in_allocation_data);
     }
     else  
     {
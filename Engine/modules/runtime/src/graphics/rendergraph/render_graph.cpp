@@ -2,6 +2,12 @@
 #include "platform/memory.h"
 #include "rendergraph/render_graph_builder.h"
 #include "rendergraph/render_graph_resource.h"
+#include "interface/command_queue.h"
+#include "interface/device_context.h"
+#include "tools/hash.h"
+#include "EASTL/algorithm.h"
+#include "EASTL/priority_queue.h"
+#include <thread>
 
 namespace Cyber
 {
@@ -22,6 +28,8 @@ namespace Cyber
 
         RenderGraph::~RenderGraph()
         {
+            stop_record_workers();
+
             for (uint32_t i = 0; i < RG_MAX_FRAME_IN_FLIGHT; ++i)
                 frame_executors[i].finalize();
 
@@ -33,6 +41,26 @@ namespace Cyber
 
             for (auto* resource_node : resources)
             {
+                RGRenderResource* resource = resource_node->resource;
+                if (resource)
+                {
+                    switch (resource->resource_type)
+                    {
+                    case ERGResourceType::Texture:
+                        cyber_delete(static_cast<RGTexture*>(resource));
+                        break;
+                    case ERGResourceType::Buffer:
+                        cyber_delete(static_cast<RGBuffer*>(resource));
+                        break;
+                    case ERGResourceType::DepthStencil:
+                        cyber_delete(static_cast<RGDepthStencil*>(resource));
+                        break;
+                    default:
+                        cyber_delete(resource);
+                        break;
+                    }
+                }
+
                 if (resource_node->object_type == RG_TEXTURE_NODE)
                     cyber_delete(static_cast<TextureNode*>(resource_node));
                 else if (resource_node->object_type == RG_BUFFER_NODE)
@@ -42,33 +70,55 @@ namespace Cyber
             }
             resources.clear();
             culled_resources.clear();
+            resource_table.clear();
 
-            for (auto& entry : resource_map)
+            cyber_delete(graphBuilder);
+            graphBuilder = nullptr;
+        }
+
+        RGRenderResource* RenderGraph::find_resource(RGResourceName name) const CYBER_NOEXCEPT
+        {
+            if (resource_table.empty())
+                return nullptr;
+
+            const uint32_t mask = static_cast<uint32_t>(resource_table.size()) - 1;
+            for (uint32_t slot = static_cast<uint32_t>(name.hash) & mask;; slot = (slot + 1) & mask)
             {
-                RGRenderResource* resource = entry.second;
-                if (!resource)
-                    continue;
+                const uint32_t resource_index = resource_table[slot];
+                if (resource_index == UINT32_MAX)
+                    return nullptr;
+                RGRenderResource* resource = resources[resource_index]->resource;
+                if (resource->name_hash == name.hash)
+                    return resource;
+            }
+        }
 
-                switch (resource->resource_type)
-                {
-                case ERGResourceType::Texture:
-                    cyber_delete(static_cast<RGTexture*>(resource));
-                    break;
-                case ERGResourceType::Buffer:
-                    cyber_delete(static_cast<RGBuffer*>(resource));
-                    break;
-                case ERGResourceType::DepthStencil:
-                    cyber_delete(static_cast<RGDepthStencil*>(resource));
-                    break;
-                default:
-                    cyber_delete(resource);
-                    break;
-                }
+        void RenderGraph::add_resource(ResourceNode* resource_node) CYBER_NOEXCEPT
+        {
+            resource_node->resource_index = static_cast<uint32_t>(resources.size());
+            resources.push_back(resource_node);
+
+            // Keep the table at most half full so probe chains stay short
+            if (resources.size() * 2 > resource_table.size())
+            {
+                resource_table.assign(eastl::max<size_t>(16, resource_table.size() * 2), UINT32_MAX);
+                for (auto* node : resources)
+                    insert_resource_slot(node);
+            }
+            else
+            {
+                insert_resource_slot(resource_node);
             }
-            resource_map.clear();
+            compiled = false;
+        }
 
-            cyber_delete(graphBuilder);
-            graphBuilder = nullptr;
+        void RenderGraph::insert_resource_slot(ResourceNode* resource_node) CYBER_NOEXCEPT
+        {
+            const uint32_t mask = static_cast<uint32_t>(resource_table.size()) - 1;
+            uint32_t slot = static_cast<uint32_t>(resource_node->resource->name_hash) & mask;
+            while (resource_table[slot] != UINT32_MAX)
+                slot = (slot + 1) & mask;
+            resource_table[slot] = resource_node->resource_index;
         }
 
         RenderGraph* RenderGraph::create(const RenderGraphSetupFunction& setup) CYBER_NOEXCEPT
@@ -80,6 +130,10 @@ namespace Cyber
                 setup(*graph->graphBuilder);
 
             graph->gfx_queue = graph->graphBuilder->gfx_queue;
+            graph->device_context = graph->graphBuilder->device_context;
+            graph->deferred_contexts = graph->graphBuilder->deferred_contexts;
+            graph->start_record_workers();
+            graph->async_compute = graph->graphBuilder->async_compute;
             graph->initialize();
             graph->compile();
             return graph;
@@ -126,83 +180,690 @@ namespace Cyber
             return access == ERGResourceAccess::Write || access == ERGResourceAccess::ReadWrite;
         }
 
-        static bool has_resource_hazard(const PassNode* previous, const PassNode* current)
+        static bool reads_resource(ERGResourceAccess access)
         {
-            for (const auto& previous_access : previous->resource_accesses)
+            return access == ERGResourceAccess::Read || access == ERGResourceAccess::ReadWrite;
+        }
+
+        static ERGQueue select_queue(const PassNode* pass, bool has_compute_queue)
+        {
+            if (!has_compute_queue || pass->pass_type != RG_COMPUTE_PASS)
+                return ERGQueue::Graphics;
+            const auto* compute_pass = dynamic_cast<const RGComputePass*>(pass->pass_handle);
+            return compute_pass && compute_pass->async_compute ? ERGQueue::AsyncCompute : ERGQueue::Graphics;
+        }
+
+        // States a compute queue cannot transition into or out of; D3D12 shader resource includes the pixel stage.
+        static constexpr GRAPHICS_RESOURCE_STATE kGraphicsOnlyStates = static_cast<GRAPHICS_RESOURCE_STATE>(
+            GRAPHICS_RESOURCE_STATE_VERTEX_BUFFER | GRAPHICS_RESOURCE_STATE_INDEX_BUFFER | GRAPHICS_RESOURCE_STATE_RENDER_TARGET |
+            GRAPHICS_RESOURCE_STATE_DEPTH_WRITE | GRAPHICS_RESOURCE_STATE_DEPTH_READ | GRAPHICS_RESOURCE_STATE_SHADER_RESOURCE |
+            GRAPHICS_RESOURCE_STATE_STREAM_OUT | GRAPHICS_RESOURCE_STATE_RESOLVE_DEST | GRAPHICS_RESOURCE_STATE_RESOLVE_SOURCE |
+            GRAPHICS_RESOURCE_STATE_INPUT_ATTACHMENT | GRAPHICS_RESOURCE_STATE_PRESENT | GRAPHICS_RESOURCE_STATE_SHADING_RATE);
+
+        // Adds the edge once however many resources the two passes share.
+        static void link_passes(PassNode* dependency, PassNode* pass)
+        {
+            if (dependency == pass || dependency->link_stamp == pass->pass_index)
+                return;
+
+            dependency->link_stamp = pass->pass_index;
+            pass->dependencies.push_back(dependency);
+            dependency->dependents.push_back(pass);
+            ++pass->pending_dependencies;
+        }
+
+        void RenderGraph::cull_passes()
+        {
+            for (auto* resource_node : resources)
+                resource_node->last_writer = nullptr;
+
+            // Walk in registration order so every read sees the write it consumes. A plain write
+            // replaces the previous contents, so only reads create producer edges.
+            for (auto* pass : passes)
             {
-                for (const auto& current_access : current->resource_accesses)
+                bool pinned = pass->pass_type == RG_PRESENT_PASS;
+                bool writes_any = false;
+                for (const auto& access : pass->resource_accesses)
                 {
-                    if (previous_access.resource == current_access.resource &&
-                        (writes_resource(previous_access.access) || writes_resource(current_access.access)))
-                        return true;
+                    ResourceNode* resource_node = get_resource_node(access.resource);
+                    if (!resource_node)
+                    {
+                        // Untracked resources cannot be reasoned about; keep the pass.
+                        pinned |= writes_resource(access.access);
+                        continue;
+                    }
+
+                    PassNode* producer = resource_node->last_writer;
+                    if (reads_resource(access.access) && producer && producer != pass &&
+                        producer->link_stamp != pass->pass_index)
+                    {
+                        producer->link_stamp = pass->pass_index;
+                        pass->producers.push_back(producer);
+                        ++producer->ref_count;
+                    }
+
+                    if (writes_resource(access.access))
+                    {
+                        resource_node->last_writer = pass;
+                        writes_any = true;
+                    }
                 }
+
+                // A pass that declares no writes works through side effects the graph cannot see.
+                if (pinned || !writes_any)
+                    ++pass->ref_count;
+            }
+
+            for (auto* resource_node : resources)
+            {
+                if (resource_node->output && resource_node->last_writer)
+                    ++resource_node->last_writer->ref_count;
+                resource_node->last_writer = nullptr;
+            }
+
+            eastl::vector<PassNode*> unreferenced;
+            for (auto* pass : passes)
+            {
+                if (pass->ref_count == 0)
+                {
+                    pass->culled = true;
+                    unreferenced.push_back(pass);
+                }
+            }
+
+            while (!unreferenced.empty())
+            {
+                PassNode* pass = unreferenced.back();
+                unreferenced.pop_back();
+                for (auto* producer : pass->producers)
+                {
+                    if (--producer->ref_count == 0)
+                    {
+                        producer->culled = true;
+                        unreferenced.push_back(producer);
+                    }
+                }
+            }
+
+            for (auto* pass : passes)
+            {
+                pass->link_stamp = UINT32_MAX;
+                if (pass->culled)
+                    culled_passes.push_back(pass);
             }
-            return false;
         }
 
-        void RenderGraph::compile()
+        void RenderGraph::build_dependencies()
         {
-            execution_order.clear();
-            culled_passes.clear();
+            // Registration order resolves WAW and WAR ambiguity. Each resource tracks its last writer
+            // and the readers since, so a read waits on the writer and a write waits on both; older
+            // hazards are already implied transitively. Read/read access stays freely reorderable.
+            for (auto* pass : passes)
+            {
+                if (pass->culled)
+                    continue;
+
+                for (const auto& access : pass->resource_accesses)
+                {
+                    ResourceNode* resource_node = get_resource_node(access.resource);
+                    if (!resource_node)
+                        continue;
+
+                    if (resource_node->last_writer)
+                        link_passes(resource_node->last_writer, pass);
 
+                    if (writes_resource(access.access))
+                    {
+                        for (auto* reader : resource_node->readers)
+                            link_passes(reader, pass);
+                        resource_node->readers.clear();
+                        resource_node->last_writer = pass;
+                    }
+                    else
+                    {
+                        resource_node->readers.push_back(pass);
+                    }
+                }
+            }
+
+            for (auto* resource_node : resources)
+            {
+                resource_node->last_writer = nullptr;
+                resource_node->readers.clear();
+            }
+        }
+
+        void RenderGraph::schedule_passes()
+        {
+            // Kahn's algorithm; the ready queue pops the lowest registration index so the order is
+            // deterministic and matches registration whenever the hazards allow it.
+            eastl::priority_queue<uint32_t, eastl::vector<uint32_t>, eastl::greater<uint32_t>> ready;
             for (auto* pass : passes)
             {
-                pass->dependencies.clear();
-                pass->order = UINT32_MAX;
+                if (!pass->culled && pass->pending_dependencies == 0)
+                    ready.push(pass->pass_index);
             }
 
-            // Registration order resolves WAW and WAR ambiguity. Resource hazards become
-            // explicit pass dependencies; read/read access remains freely reorderable.
-            for (size_t current_index = 0; current_index < passes.size(); ++current_index)
+            while (!ready.empty())
             {
-                PassNode* current = passes[current_index];
-                for (size_t previous_index = 0; previous_index < current_index; ++previous_index)
+                PassNode* pass = passes[ready.top()];
+                ready.pop();
+
+                pass->order = static_cast<uint32_t>(execution_order.size());
+                execution_order.push_back(pass);
+                for (auto* dependent : pass->dependents)
                 {
-                    PassNode* previous = passes[previous_index];
-                    if (has_resource_hazard(previous, current))
-                        current->dependencies.push_back(previous);
+                    if (--dependent->pending_dependencies == 0)
+                        ready.push(dependent->pass_index);
                 }
             }
 
-            eastl::vector<uint8_t> scheduled;
-            scheduled.resize(passes.size(), 0);
+            if (execution_order.size() != passes.size() - culled_passes.size())
+                cyber_assert(false, "RenderGraph contains a cyclic pass dependency");
+        }
+
+        void RenderGraph::compute_lifetimes()
+        {
+            for (auto* resource_node : resources)
+            {
+                resource_node->ref_count = 0;
+                resource_node->first_use = UINT32_MAX;
+                resource_node->last_use = UINT32_MAX;
+            }
 
-            while (execution_order.size() < passes.size())
+            for (auto* pass : execution_order)
             {
-                bool made_progress = false;
-                for (size_t pass_index = 0; pass_index < passes.size(); ++pass_index)
+                for (const auto& access : pass->resource_accesses)
                 {
-                    if (scheduled[pass_index])
+                    ResourceNode* resource_node = get_resource_node(access.resource);
+                    if (!resource_node)
                         continue;
 
-                    PassNode* candidate = passes[pass_index];
-                    bool ready = true;
-                    for (auto* dependency : candidate->dependencies)
+                    if (resource_node->first_use == UINT32_MAX)
+                        resource_node->first_use = pass->order;
+                    resource_node->last_use = pass->order;
+                    if (reads_resource(access.access))
+                        ++resource_node->ref_count;
+                }
+            }
+
+            compile_report.executed_passes.clear();
+            compile_report.culled_passes.clear();
+            compile_report.resources.clear();
+
+            for (auto* pass : execution_order)
+                compile_report.executed_passes.push_back(pass->pass_handle ? pass->pass_handle->pass_name : nullptr);
+            for (auto* pass : culled_passes)
+                compile_report.culled_passes.push_back(pass->pass_handle ? pass->pass_handle->pass_name : nullptr);
+
+            for (auto* resource_node : resources)
+            {
+                const bool culled = resource_node->first_use == UINT32_MAX && !resource_node->imported;
+                if (culled)
+                    culled_resources.push_back(resource_node);
+
+                RenderGraphResourceLifetime lifetime;
+                lifetime.name = resource_node->resource ? resource_node->resource->resource_name : nullptr;
+                lifetime.node = resource_node;
+                lifetime.first_pass = resource_node->first_use;
+                lifetime.last_pass = resource_node->last_use;
+                lifetime.reader_count = resource_node->ref_count;
+                lifetime.imported = resource_node->imported;
+                lifetime.output = resource_node->output;
+                lifetime.culled = culled;
+                compile_report.resources.push_back(lifetime);
+            }
+        }
+
+        void RenderGraph::compute_barriers()
+        {
+            barrier_batches.clear();
+            barrier_batches.resize(execution_order.size());
+            compile_report.barrier_count = 0;
+            compile_report.barrier_batch_count = 0;
+            compile_report.elided_transition_count = 0;
+            shared_read_sources.clear();
+            // Split halves would land on whichever queue runs the pass in between
+            const bool split = split_barriers && !async_compute_active;
+
+            struct ResourceUse
+            {
+                uint32_t pass_order;
+                const PassResourceAccess* access;
+            };
+
+            eastl::vector<eastl::vector<ResourceUse>> uses(resources.size());
+            for (auto* pass : execution_order)
+            {
+                for (const auto& access : pass->resource_accesses)
+                {
+                    ResourceNode* resource_node = get_resource_node(access.resource);
+                    if (resource_node && access.state != GRAPHICS_RESOURCE_STATE_UNKNOWN)
+                        uses[resource_node->resource_index].push_back({ pass->order, &access });
+                }
+            }
+
+            for (size_t resource_index = 0; resource_index < uses.size(); ++resource_index)
+            {
+                const auto& resource_uses = uses[resource_index];
+                // The first transition of a frame leaves the source state to the backend's tracking
+                GRAPHICS_RESOURCE_STATE state = GRAPHICS_RESOURCE_STATE_UNKNOWN;
+                uint32_t previous_pass = UINT32_MAX;
+                bool previous_wrote = false;
+
+                size_t use_index = 0;
+                while (use_index < resource_uses.size())
+                {
+                    const ResourceUse& use = resource_uses[use_index];
+                    const bool writes = use.access->access != ERGResourceAccess::Read;
+                    GRAPHICS_RESOURCE_STATE target = use.access->state;
+
+                    // Consecutive reads share one transition into the union of their read states
+                    size_t run_end = use_index + 1;
+                    if (!writes)
                     {
-                        if (dependency->order == UINT32_MAX)
+                        while (run_end < resource_uses.size() && resource_uses[run_end].access->access == ERGResourceAccess::Read)
                         {
-                            ready = false;
-                            break;
+                            // Later readers rely on the first reader's transition, possibly on another queue
+                            if (async_compute_active)
+                                shared_read_sources.push_back({ resource_uses[run_end].pass_order, use.pass_order });
+                            target = target | resource_uses[run_end++].access->state;
                         }
+                        compile_report.elided_transition_count += static_cast<uint32_t>(run_end - use_index - 1);
                     }
 
-                    if (!ready)
+                    RenderGraphBarrier barrier;
+                    barrier.resource = resources[resource_index]->resource;
+                    barrier.src_state = state;
+                    barrier.dst_state = target;
+                    barrier.previous_pass = previous_pass;
+                    if (target != state)
+                    {
+                        // Passes between the last access and this one overlap the transition
+                        if (split && previous_pass != UINT32_MAX && state != GRAPHICS_RESOURCE_STATE_UNKNOWN &&
+                            use.pass_order > previous_pass + 1)
+                        {
+                            RenderGraphBarrier begin = barrier;
+                            begin.begin_only = true;
+                            barrier_batches[previous_pass + 1].barriers.push_back(begin);
+                            barrier.end_only = true;
+                        }
+                        barrier_batches[use.pass_order].barriers.push_back(barrier);
+                    }
+                    else if (target == GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS && (writes || previous_wrote))
+                    {
+                        // Same state, but unordered writes still need a UAV barrier between passes
+                        barrier_batches[use.pass_order].barriers.push_back(barrier);
+                    }
+                    else if (previous_pass != UINT32_MAX)
+                    {
+                        ++compile_report.elided_transition_count;
+                    }
+
+                    state = target;
+                    previous_pass = resource_uses[run_end - 1].pass_order;
+                    previous_wrote = resource_uses[run_end - 1].access->access != ERGResourceAccess::Read;
+                    use_index = run_end;
+                }
+                resources[resource_index]->final_state = state;
+            }
+
+            for (const auto& batch : barrier_batches)
+            {
+                compile_report.barrier_count += static_cast<uint32_t>(batch.barriers.size());
+                if (!batch.barriers.empty())
+                    ++compile_report.barrier_batch_count;
+            }
+        }
+
+        void RenderGraph::compute_queue_syncs()
+        {
+            queue_syncs.clear();
+            final_graphics_wait = false;
+            compile_report.queue_wait_count = 0;
+            compile_report.async_compute_pass_count = 0;
+            if (!async_compute_active)
+                return;
+
+            queue_syncs.resize(execution_order.size());
+            eastl::vector<eastl::vector<uint32_t>> shared_sources(execution_order.size());
+            for (const auto& [reader, source] : shared_read_sources)
+                shared_sources[reader].push_back(source);
+
+            // A wait covers everything the other queue was given so far, since fences are signaled
+            // lazily right before the wait. covered[q] is the last execution index queue q has waited
+            // for on the other queue; later edges at or below it need nothing new.
+            int64_t covered[2] = { -1, -1 };
+            auto needs_wait = [&](ERGQueue queue, uint32_t source) {
+                return source != UINT32_MAX && execution_order[source]->queue != queue &&
+                    int64_t(source) > covered[static_cast<uint32_t>(queue)];
+            };
+
+            bool compute_started = false;
+            int64_t last_compute_pass = -1;
+            for (uint32_t order = 0; order < execution_order.size(); ++order)
+            {
+                PassNode* pass = execution_order[order];
+                RenderGraphQueueSync& sync = queue_syncs[order];
+                RenderGraphBarrierBatch& batch = barrier_batches[order];
+                const ERGQueue queue = pass->queue;
+                bool wait = false;
+
+                if (queue == ERGQueue::AsyncCompute)
+                {
+                    ++compile_report.async_compute_pass_count;
+                    last_compute_pass = order;
+                    // The compute queue has no view of last frame's graphics work, so its first pass waits
+                    wait = !compute_started;
+                    compute_started = true;
+
+                    // Graphics-only and untracked transitions move to the graphics queue, which must
+                    // first be done with whatever compute work last touched the resource
+                    auto keep = batch.barriers.begin();
+                    for (auto it = batch.barriers.begin(); it != batch.barriers.end(); ++it)
+                    {
+                        const bool graphics_only = it->src_state == GRAPHICS_RESOURCE_STATE_UNKNOWN ||
+                            ((it->src_state | it->dst_state) & kGraphicsOnlyStates) != 0;
+                        if (!graphics_only)
+                        {
+                            *keep++ = *it;
+                            continue;
+                        }
+                        if (needs_wait(ERGQueue::Graphics, it->previous_pass))
+                        {
+                            sync.graphics_waits_compute = true;
+                            covered[static_cast<uint32_t>(ERGQueue::Graphics)] = int64_t(order) - 1;
+                        }
+                        sync.graphics_barriers.barriers.push_back(*it);
+                    }
+                    batch.barriers.erase(keep, batch.barriers.end());
+                    wait |= !sync.graphics_barriers.barriers.empty();
+                }
+
+                for (const auto& barrier : batch.barriers)
+                    wait |= needs_wait(queue, barrier.previous_pass);
+                for (auto* dependency : pass->dependencies)
+                    wait |= needs_wait(queue, dependency->order);
+                for (uint32_t source : shared_sources[order])
+                    wait |= needs_wait(queue, source);
+
+                if (wait)
+                {
+                    sync.waits_other_queue = true;
+                    covered[static_cast<uint32_t>(queue)] = int64_t(order) - 1;
+                }
+                compile_report.queue_wait_count += (sync.graphics_waits_compute ? 1 : 0) + (sync.waits_other_queue ? 1 : 0);
+            }
+
+            // Whatever runs after the graph reads its outputs on the graphics queue
+            final_graphics_wait = last_compute_pass > covered[static_cast<uint32_t>(ERGQueue::Graphics)];
+            compile_report.queue_wait_count += final_graphics_wait ? 1 : 0;
+
+            compile_report.barrier_count = 0;
+            compile_report.barrier_batch_count = 0;
+            for (uint32_t order = 0; order < execution_order.size(); ++order)
+            {
+                const uint32_t count = static_cast<uint32_t>(barrier_batches[order].barriers.size() +
+                    queue_syncs[order].graphics_barriers.barriers.size());
+                compile_report.barrier_count += count;
+                compile_report.barrier_batch_count += (barrier_batches[order].barriers.empty() ? 0 : 1) +
+                    (queue_syncs[order].graphics_barriers.barriers.empty() ? 0 : 1);
+            }
+        }
+
+        void RenderGraph::compute_record_groups()
+        {
+            // Balanced contiguous ranges: recording cost is roughly per pass, and contiguity lets every
+            // deferred context be submitted in execution order with no extra synchronization.
+            record_groups.clear();
+            compile_report.record_group_count = 0;
+            const uint32_t pass_count = static_cast<uint32_t>(execution_order.size());
+            if (pass_count == 0)
+                return;
+
+            uint32_t group_count = pass_count / eastl::max(min_passes_per_record_group, 1u);
+            group_count = eastl::max(eastl::min(group_count, static_cast<uint32_t>(deferred_contexts.size())), 1u);
+            const uint32_t base_count = pass_count / group_count;
+            const uint32_t remainder = pass_count % group_count;
+            uint32_t first_pass = 0;
+            for (uint32_t group_index = 0; group_index < group_count; ++group_index)
+            {
+                RenderGraphRecordGroup group;
+                group.first_pass = first_pass;
+                group.pass_count = base_count + (group_index < remainder ? 1 : 0);
+                record_groups.push_back(group);
+                first_pass += group.pass_count;
+            }
+            compile_report.record_group_count = group_count;
+        }
+
+        void RenderGraph::record_barriers(const RenderGraphBarrierBatch& batch, RenderObject::IDeviceContext* context,
+            ResourceBarrierDesc& desc, bool deferred)
+        {
+            if (!context || batch.barriers.empty())
+                return;
+
+            desc.texture_barriers.clear();
+            desc.buffer_barriers.clear();
+            for (const auto& barrier : batch.barriers)
+            {
+                // Full texture transitions start from the backend's tracked state, which stays correct
+                // when a pass's render pass moves its own attachments. Split halves and UAV barriers
+                // need the explicit source. Deferred contexts record out of order, so tracked state is
+                // meaningless there; first uses were already resolved by execute_parallel.
+                const bool explicit_source = deferred || barrier.begin_only || barrier.end_only || barrier.src_state == barrier.dst_state;
+                if (deferred && barrier.src_state == GRAPHICS_RESOURCE_STATE_UNKNOWN)
+                    continue;
+
+                // Resources without an RHI object yet (unbacked transients) have nothing to transition
+                if (barrier.resource->resource_type == ERGResourceType::Texture)
+                {
+                    const GRAPHICS_RESOURCE_STATE src_state = explicit_source ? barrier.src_state : GRAPHICS_RESOURCE_STATE_UNKNOWN;
+                    RenderObject::ITexture* texture = static_cast<RGTexture*>(barrier.resource)->texture;
+                    if (!texture)
+                        continue;
+                    TextureBarrier texture_barrier(texture, src_state, barrier.dst_state);
+                    // Worker threads must not touch tracked state; execute_parallel writes it back
+                    texture_barrier.record_only = deferred;
+                    texture_barrier.d3d12.begin_only = barrier.begin_only;
+                    texture_barrier.d3d12.end_only = barrier.end_only;
+                    desc.texture_barriers.push_back(texture_barrier);
+                }
+                else if (barrier.resource->resource_type == ERGResourceType::Buffer)
+                {
+                    // Buffers have no backend-tracked state: every transition carries its compile-time
+                    // source, and a first use starts from the state the previous frame left
+                    const RGBuffer* rg_buffer = static_cast<RGBuffer*>(barrier.resource);
+                    RenderObject::IBuffer* buffer = rg_buffer->buffer;
+                    if (!buffer)
+                        continue;
+                    const GRAPHICS_RESOURCE_STATE src_state =
+                        barrier.src_state != GRAPHICS_RESOURCE_STATE_UNKNOWN ? barrier.src_state : rg_buffer->state;
+                    if (src_state == barrier.dst_state && src_state != GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS)
                         continue;
+                    BufferBarrier buffer_barrier(buffer, src_state, barrier.dst_state);
+                    buffer_barrier.d3d12.begin_only = barrier.begin_only;
+                    buffer_barrier.d3d12.end_only = barrier.end_only;
+                    desc.buffer_barriers.push_back(buffer_barrier);
+                }
+            }
 
-                    candidate->order = static_cast<uint32_t>(execution_order.size());
-                    execution_order.push_back(candidate);
-                    scheduled[pass_index] = 1;
-                    made_progress = true;
+            if (!desc.texture_barriers.empty() || !desc.buffer_barriers.empty())
+                context->cmd_resource_barrier(desc);
+        }
+
+        void RenderGraph::build_structure_key()
+        {
+            // Everything the compiled plan depends on: pass order and types, accesses with their states,
+            // resource flags and the descriptors that size transient placements. Imported descriptors and
+            // RHI objects only feed barriers at record time, so swapping them keeps the plan.
+            structure_key.clear();
+            structure_key.push_back(passes.size());
+            structure_key.push_back(resources.size());
+            structure_key.push_back(split_barriers ? 1 : 0);
+            structure_key.push_back(uint64_t(deferred_contexts.size()) | uint64_t(min_passes_per_record_group) << 32);
+            const bool has_compute_queue = async_compute.compute_context != nullptr;
+
+            for (auto* resource_node : resources)
+            {
+                structure_key.push_back(uint64_t(resource_node->object_type) | uint64_t(resource_node->imported) << 8 |
+                    uint64_t(resource_node->output) << 9);
+                if (resource_node->imported || !resource_node->resource)
+                    continue;
+
+                if (resource_node->object_type == RG_TEXTURE_NODE)
+                {
+                    const RGTextureCreateDesc& desc = static_cast<RGTexture*>(resource_node->resource)->create_desc;
+                    structure_key.push_back(uint64_t(desc.m_width) | uint64_t(desc.m_height) << 32);
+                    structure_key.push_back(uint64_t(desc.m_depth) | uint64_t(desc.m_arraySize) << 32);
+                    structure_key.push_back(uint64_t(desc.m_mipLevels) | uint64_t(desc.m_bindFlags) << 32);
+                    structure_key.push_back(uint64_t(desc.m_dimension) | uint64_t(desc.m_sampleCount) << 16 |
+                        uint64_t(desc.m_format) << 32);
+                }
+                else
+                {
+                    structure_key.push_back(static_cast<RGBuffer*>(resource_node->resource)->create_desc.size);
                 }
+            }
 
-                if (!made_progress)
+            for (auto* pass : passes)
+            {
+                structure_key.push_back(uint64_t(pass->pass_type) | uint64_t(select_queue(pass, has_compute_queue)) << 8 |
+                    uint64_t(pass->resource_accesses.size()) << 32);
+                for (const auto& access : pass->resource_accesses)
                 {
-                    cyber_assert(false, "RenderGraph contains a cyclic pass dependency");
-                    break;
+                    const ResourceNode* resource_node = get_resource_node(access.resource);
+                    const uint64_t resource_index = resource_node ? resource_node->resource_index : UINT32_MAX;
+                    structure_key.push_back(resource_index | uint64_t(access.access) << 32);
+                    structure_key.push_back(uint64_t(access.state));
                 }
             }
 
-            compiled = execution_order.size() == passes.size();
+            structure_hash = cyber_hash64(structure_key.data(), structure_key.size() * sizeof(uint64_t), 0);
+        }
+
+        bool RenderGraph::reuse_cached_plan()
+        {
+            // Hashes decide the common case; the full key comparison guards against collisions.
+            if (!has_cached_plan || structure_hash != cached_structure_hash ||
+                structure_key.size() != cached_structure_key.size() ||
+                memcmp(structure_key.data(), cached_structure_key.data(), structure_key.size() * sizeof(uint64_t)) != 0)
+                return false;
+
+            // Resource lifetimes, placements and barrier batches live on persistent resource nodes and
+            // members; only the recreated pass nodes need to be linked back into the schedule.
+            execution_order.clear();
+            culled_passes.clear();
+            for (uint32_t pass_index = 0; pass_index < passes.size(); ++pass_index)
+            {
+                PassNode* pass = passes[pass_index];
+                pass->dependencies.clear();
+                pass->dependents.clear();
+                pass->producers.clear();
+                pass->pass_index = pass_index;
+                pass->order = UINT32_MAX;
+                pass->culled = false;
+                pass->queue = select_queue(pass, async_compute.compute_context != nullptr);
+            }
+
+            compile_report.executed_passes.clear();
+            for (uint32_t pass_index : cached_execution_order)
+            {
+                PassNode* pass = passes[pass_index];
+                pass->order = static_cast<uint32_t>(execution_order.size());
+                execution_order.push_back(pass);
+                compile_report.executed_passes.push_back(pass->pass_handle ? pass->pass_handle->pass_name : nullptr);
+            }
+
+            compile_report.culled_passes.clear();
+            for (uint32_t pass_index : cached_culled_passes)
+            {
+                PassNode* pass = passes[pass_index];
+                pass->culled = true;
+                culled_passes.push_back(pass);
+                compile_report.culled_passes.push_back(pass->pass_handle ? pass->pass_handle->pass_name : nullptr);
+            }
+
+            compile_report.reused_cached_plan = true;
+            compiled = true;
+            return true;
+        }
+
+        void RenderGraph::store_cached_plan()
+        {
+            cached_structure_key = structure_key;
+            cached_structure_hash = structure_hash;
+            cached_execution_order.clear();
+            for (auto* pass : execution_order)
+                cached_execution_order.push_back(pass->pass_index);
+            cached_culled_passes.clear();
+            for (auto* pass : culled_passes)
+                cached_culled_passes.push_back(pass->pass_index);
+            has_cached_plan = true;
+        }
+
+        void RenderGraph::compile()
+        {
+            build_structure_key();
+            if (reuse_cached_plan())
+                return;
+
+            compile_report.reused_cached_plan = false;
+            execution_order.clear();
+            culled_passes.clear();
+            culled_resources.clear();
+            async_compute_active = false;
+
+            for (uint32_t pass_index = 0; pass_index < passes.size(); ++pass_index)
+            {
+                PassNode* pass = passes[pass_index];
+                pass->dependencies.clear();
+                pass->dependents.clear();
+                pass->producers.clear();
+                pass->order = UINT32_MAX;
+                pass->ref_count = 0;
+                pass->culled = false;
+                pass->pass_index = pass_index;
+                pass->link_stamp = UINT32_MAX;
+                pass->pending_dependencies = 0;
+                pass->queue = select_queue(pass, async_compute.compute_context != nullptr);
+            }
+
+            cull_passes();
+            for (auto* pass : passes)
+                async_compute_active |= !pass->culled && pass->queue == ERGQueue::AsyncCompute;
+            build_dependencies();
+            schedule_passes();
+
+            const size_t live_pass_count = passes.size() - culled_passes.size();
+            compute_lifetimes();
+            compiled = execution_order.size() == live_pass_count;
+            transient_allocator.plan(resources, compiled ? static_cast<uint32_t>(execution_order.size()) : 0);
+
+            for (auto& lifetime : compile_report.resources)
+            {
+                lifetime.heap_index = lifetime.node->heap_index;
+                lifetime.heap_offset = lifetime.node->heap_offset;
+                lifetime.size = lifetime.node->allocation_size;
+            }
+            compile_report.transient_heaps = transient_allocator.get_heaps();
+            compile_report.aliased_transient_size = transient_allocator.get_aliased_size();
+            compile_report.unaliased_transient_size = transient_allocator.get_unaliased_size();
+
+            if (compiled)
+            {
+                compute_barriers();
+                compute_queue_syncs();
+                compute_record_groups();
+                store_cached_plan();
+            }
+            else
+            {
+                barrier_batches.clear();
+                queue_syncs.clear();
+                record_groups.clear();
+                has_cached_plan = false;
+            }
         }
 
         void RenderGraph::execute()
@@ -213,11 +874,205 @@ namespace Cyber
             if (!compiled)
                 return;
 
-            for (auto* pass_node : execution_order)
-                execute_pass(pass_node->pass_handle, 0);
+            // Async compute interleaves two queues in execution order, so it records serially
+            if (async_compute_active)
+            {
+                execute_async();
+            }
+            else if (record_groups.size() > 1 && record_groups.size() <= deferred_contexts.size())
+            {
+                execute_parallel();
+            }
+            else
+            {
+                for (size_t order = 0; order < execution_order.size(); ++order)
+                {
+                    record_barriers(barrier_batches[order], device_context, barrier_desc, false);
+                    execute_pass(execution_order[order]->pass_handle, 0, device_context);
+                }
+            }
+            store_final_states();
+        }
+
+        void RenderGraph::store_final_states()
+        {
+            for (auto* resource_node : resources)
+            {
+                if (resource_node->final_state == GRAPHICS_RESOURCE_STATE_UNKNOWN || !resource_node->resource)
+                    continue;
+                if (resource_node->resource->resource_type == ERGResourceType::Buffer)
+                    static_cast<RGBuffer*>(resource_node->resource)->state = resource_node->final_state;
+            }
+        }
+
+        void RenderGraph::record_group(uint32_t group_index)
+        {
+            const RenderGraphRecordGroup& group = record_groups[group_index];
+            RenderObject::IDeviceContext* context = deferred_contexts[group_index];
+            ResourceBarrierDesc& desc = group_barrier_descs[group_index];
+
+            context->cmd_begin();
+            for (uint32_t order = group.first_pass; order < group.first_pass + group.pass_count; ++order)
+            {
+                record_barriers(barrier_batches[order], context, desc, true);
+                execute_pass(execution_order[order]->pass_handle, 0, context);
+            }
+            context->cmd_end();
+            // Closes the command list and parks it until the immediate context submits it
+            context->flush();
+        }
+
+        void RenderGraph::execute_parallel()
+        {
+            // First uses have no compile-time source state. Resolve them up front on the immediate
+            // context from the backend's tracked state; nothing earlier in the graph touches them.
+            barrier_desc.texture_barriers.clear();
+            barrier_desc.buffer_barriers.clear();
+            RenderGraphBarrierBatch first_uses;
+            for (const auto& batch : barrier_batches)
+            {
+                for (const auto& barrier : batch.barriers)
+                {
+                    if (barrier.src_state == GRAPHICS_RESOURCE_STATE_UNKNOWN)
+                        first_uses.barriers.push_back(barrier);
+                }
+            }
+            record_barriers(first_uses, device_context, barrier_desc, false);
+
+            const uint32_t group_count = static_cast<uint32_t>(record_groups.size());
+            group_barrier_descs.resize(group_count);
+
+            // The calling thread records the first group while the pool takes the rest
+            {
+                std::lock_guard<std::mutex> lock(record_mutex);
+                record_group_count = group_count;
+                record_pending = group_count - 1;
+                ++record_generation;
+            }
+            record_start.notify_all();
+            record_group(0);
+            {
+                std::unique_lock<std::mutex> lock(record_mutex);
+                record_done.wait(lock, [this]() { return record_pending == 0; });
+            }
+
+            if (device_context)
+            {
+                for (uint32_t group_index = 0; group_index < group_count; ++group_index)
+                    device_context->execute_deferred_context(deferred_contexts[group_index]);
+            }
+
+            // The groups recorded their barriers without tracked state; leave every texture where the
+            // frame's last barrier puts it so the next frame's first uses start from the right state
+            for (auto* resource_node : resources)
+            {
+                if (resource_node->object_type != RG_TEXTURE_NODE || resource_node->final_state == GRAPHICS_RESOURCE_STATE_UNKNOWN ||
+                    !resource_node->resource)
+                    continue;
+                if (RenderObject::ITexture* texture = static_cast<RGTexture*>(resource_node->resource)->texture)
+                    texture->set_new_state(resource_node->final_state);
+            }
+        }
+
+        void RenderGraph::start_record_workers()
+        {
+            // Group 0 records on the calling thread, so one context needs no worker
+            for (uint32_t group_index = 1; group_index < deferred_contexts.size(); ++group_index)
+                record_workers.push_back(std::thread([this, group_index]() { record_worker_main(group_index); }));
+        }
+
+        void RenderGraph::stop_record_workers()
+        {
+            {
+                std::lock_guard<std::mutex> lock(record_mutex);
+                record_shutdown = true;
+            }
+            record_start.notify_all();
+            for (auto& worker : record_workers)
+                worker.join();
+            record_workers.clear();
+        }
+
+        void RenderGraph::record_worker_main(uint32_t group_index)
+        {
+            uint64_t seen_generation = 0;
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(record_mutex);
+                    record_start.wait(lock, [&]() { return record_shutdown || record_generation != seen_generation; });
+                    if (record_shutdown)
+                        return;
+                    seen_generation = record_generation;
+                    // Frames with fewer groups than contexts leave the trailing workers idle
+                    if (group_index >= record_group_count)
+                        continue;
+                }
+
+                record_group(group_index);
+
+                bool last = false;
+                {
+                    std::lock_guard<std::mutex> lock(record_mutex);
+                    last = --record_pending == 0;
+                }
+                if (last)
+                    record_done.notify_one();
+            }
+        }
+
+        RenderObject::IDeviceContext* RenderGraph::get_queue_context(ERGQueue queue) const CYBER_NOEXCEPT
+        {
+            return queue == ERGQueue::AsyncCompute ? async_compute.compute_context : device_context;
+        }
+
+        void RenderGraph::wait_for_queue(ERGQueue waiting_queue)
+        {
+            const ERGQueue signaling_queue = waiting_queue == ERGQueue::Graphics ? ERGQueue::AsyncCompute : ERGQueue::Graphics;
+            const bool graphics_signals = signaling_queue == ERGQueue::Graphics;
+            RenderObject::ICommandQueue* signal_queue = graphics_signals ? async_compute.graphics_queue : async_compute.compute_queue;
+            RenderObject::ICommandQueue* wait_queue = graphics_signals ? async_compute.compute_queue : async_compute.graphics_queue;
+            RenderObject::IFence* fence = graphics_signals ? async_compute.graphics_fence : async_compute.compute_fence;
+
+            // Submit what the signaling queue has recorded so the signal lands after it
+            if (auto* signal_context = get_queue_context(signaling_queue))
+                signal_context->flush();
+            const uint64_t value = ++queue_fence_values[static_cast<uint32_t>(signaling_queue)];
+            if (signal_queue && fence)
+                signal_queue->signal_fence(fence, value);
+
+            // Work already recorded on the waiting queue does not depend on the signal
+            if (auto* wait_context = get_queue_context(waiting_queue))
+                wait_context->flush();
+            if (wait_queue && fence)
+                wait_queue->wait_fence(fence, value);
+        }
+
+        void RenderGraph::execute_async()
+        {
+            for (size_t order = 0; order < execution_order.size(); ++order)
+            {
+                const RenderGraphQueueSync& sync = queue_syncs[order];
+                PassNode* pass = execution_order[order];
+                RenderObject::IDeviceContext* context = get_queue_context(pass->queue);
+
+                if (sync.graphics_waits_compute)
+                    wait_for_queue(ERGQueue::Graphics);
+                record_barriers(sync.graphics_barriers, device_context, barrier_desc, false);
+                if (sync.waits_other_queue)
+                    wait_for_queue(pass->queue);
+
+                record_barriers(barrier_batches[order], context, barrier_desc, false);
+                execute_pass(pass->pass_handle, 0, context);
+            }
+
+            if (final_graphics_wait)
+                wait_for_queue(ERGQueue::Graphics);
+            else if (async_compute.compute_context)
+                async_compute.compute_context->flush();
         }
 
-        void RenderGraph::execute_pass(RGPass* pass, uint32_t frame_index)
+        void RenderGraph::execute_pass(RGPass* pass, uint32_t frame_index, RenderObject::IDeviceContext* context)
         {
             if (!pass || frame_index >= RG_MAX_FRAME_IN_FLIGHT)
                 return;
@@ -227,6 +1082,7 @@ namespace Cyber
             pass_context.pass = pass;
             pass_context.frame_index = frame_index;
             pass_context.encoder = frame_executors[frame_index].gfx_cmd_buffer;
+            pass_context.device_context = context ? context : device_context;
 
             pass->execute(*this, pass_context);
         }
@@ -0,0 +1,210 @@
+#include "rendergraph/render_graph_allocator.h"
+#include "common/graphics_utils.hpp"
+#include "core/common.h"
+#include "platform/memory.h"
+#include "EASTL/sort.h"
+
+namespace Cyber
+{
+    namespace render_graph
+    {
+        namespace
+        {
+            struct TransientRequest
+            {
+                ResourceNode* node = nullptr;
+                uint32_t heap_index = 0;
+                uint32_t allocation_index = 0;
+            };
+        }
+
+        uint64_t RenderGraphTransientAllocator::estimate_size(const RGTextureCreateDesc& desc, uint32_t& out_alignment)
+        {
+            const TextureFormatAttribs& attribs = get_texture_format_attribs(desc.m_format);
+            const uint32_t block_width = attribs.block_width > 0 ? attribs.block_width : 1;
+            const uint32_t block_height = attribs.block_height > 0 ? attribs.block_height : 1;
+            // Compressed formats store the block size in component_size
+            const uint64_t block_bytes = attribs.component_type == COMPONENT_TYPE_COMPRESSED ?
+                attribs.component_size : uint64_t(attribs.component_size) * attribs.num_components;
+
+            const uint32_t mip_levels = desc.m_mipLevels > 0 ? desc.m_mipLevels : 1;
+            const uint32_t array_size = desc.m_arraySize > 0 ? desc.m_arraySize : 1;
+            const uint32_t sample_count = desc.m_sampleCount > 0 ? static_cast<uint32_t>(desc.m_sampleCount) : 1;
+
+            uint64_t size = 0;
+            for (uint32_t mip = 0; mip < mip_levels; ++mip)
+            {
+                const uint64_t width = eastl::max(desc.m_width >> mip, 1u);
+                const uint64_t height = eastl::max(desc.m_height >> mip, 1u);
+                const uint64_t depth = desc.m_dimension == TEX_DIMENSION_3D ? eastl::max(desc.m_depth >> mip, 1u) : 1u;
+                size += ((width + block_width - 1) / block_width) * ((height + block_height - 1) / block_height) *
+                    depth * block_bytes;
+            }
+            size *= uint64_t(array_size) * sample_count;
+
+            out_alignment = sample_count > 1 ? kMSAAPlacementAlignment : kPlacementAlignment;
+            return align_up(size, out_alignment);
+        }
+
+        uint64_t RenderGraphTransientAllocator::estimate_size(const RGBufferCreateDesc& desc, uint32_t& out_alignment)
+        {
+            out_alignment = kPlacementAlignment;
+            return align_up(desc.size > 0 ? desc.size : 1, out_alignment);
+        }
+
+        RenderObject::PoolResourceType RenderGraphTransientAllocator::get_heap_type(const ResourceNode* resource_node)
+        {
+            if (resource_node->object_type == RG_BUFFER_NODE)
+                return RenderObject::PoolResourceType::Buffers;
+
+            const auto* texture = static_cast<const RGTexture*>(resource_node->resource);
+            const uint32_t target_flags = GRAPHICS_RESOURCE_BIND_RENDER_TARGET | GRAPHICS_RESOURCE_BIND_DEPTH_STENCIL;
+            if (texture && (texture->create_desc.m_bindFlags & target_flags) != 0)
+                return RenderObject::PoolResourceType::RTDSTextures;
+            return RenderObject::PoolResourceType::NonRTDSTextures;
+        }
+
+        void RenderGraphTransientAllocator::reset()
+        {
+            heaps.clear();
+            aliased_size = 0;
+            unaliased_size = 0;
+        }
+
+        void RenderGraphTransientAllocator::plan(const eastl::vector<ResourceNode*>& resources, uint32_t pass_count)
+        {
+            reset();
+
+            // One heap per resource type and placement alignment, so every block in a pool shares
+            // the pool's alignment and freed blocks merge without padding.
+            eastl::vector<TransientRequest> requests;
+            for (auto* resource_node : resources)
+            {
+                resource_node->heap_index = UINT32_MAX;
+                resource_node->heap_offset = 0;
+                resource_node->allocation_size = 0;
+                // Outputs hand their contents to whoever runs after the graph and cannot share memory
+                if (resource_node->imported || resource_node->output || !resource_node->resource ||
+                    resource_node->first_use >= pass_count)
+                    continue;
+
+                uint32_t alignment = kPlacementAlignment;
+                if (resource_node->object_type == RG_TEXTURE_NODE)
+                    resource_node->allocation_size = estimate_size(static_cast<RGTexture*>(resource_node->resource)->create_desc, alignment);
+                else
+                    resource_node->allocation_size = estimate_size(static_cast<RGBuffer*>(resource_node->resource)->create_desc, alignment);
+
+                const RenderObject::PoolResourceType heap_type = get_heap_type(resource_node);
+                uint32_t heap_index = 0;
+                while (heap_index < heaps.size() &&
+                       (heaps[heap_index].resource_type != heap_type || heaps[heap_index].alignment != alignment))
+                    ++heap_index;
+                if (heap_index == heaps.size())
+                {
+                    RenderGraphTransientHeap heap;
+                    heap.resource_type = heap_type;
+                    heap.alignment = alignment;
+                    heaps.push_back(heap);
+                }
+
+                ++heaps[heap_index].resource_count;
+                // Pool capacity starts at the unaliased total, which packing can never exceed
+                heaps[heap_index].size += resource_node->allocation_size;
+                unaliased_size += resource_node->allocation_size;
+
+                TransientRequest request;
+                request.node = resource_node;
+                request.heap_index = heap_index;
+                request.allocation_index = static_cast<uint32_t>(requests.size());
+                requests.push_back(request);
+            }
+
+            if (requests.empty())
+                return;
+
+            eastl::vector<RenderObject::MemoryPool*> pools;
+            for (uint32_t heap_index = 0; heap_index < heaps.size(); ++heap_index)
+            {
+                RenderGraphTransientHeap& heap = heaps[heap_index];
+                cyber_assert(heap.size <= UINT32_MAX, "Transient heap exceeds the 4GB pool offset range");
+                auto* pool = cyber_new<RenderObject::MemoryPool>(static_cast<int16_t>(heap_index), heap.size,
+                    heap.alignment, heap.resource_type, RenderObject::MemoryPool::FreeListOrder::SortBySize);
+                pool->init();
+                pools.push_back(pool);
+                heap.size = 0;
+            }
+
+            // Bucket requests by the pass that opens and closes them: O(passes + resources)
+            eastl::vector<uint32_t> begin_offsets(pass_count + 1, 0);
+            eastl::vector<uint32_t> end_offsets(pass_count + 1, 0);
+            for (const auto& request : requests)
+            {
+                ++begin_offsets[request.node->first_use + 1];
+                ++end_offsets[request.node->last_use + 1];
+            }
+            for (uint32_t pass = 0; pass < pass_count; ++pass)
+            {
+                begin_offsets[pass + 1] += begin_offsets[pass];
+                end_offsets[pass + 1] += end_offsets[pass];
+            }
+            eastl::vector<TransientRequest*> begins(requests.size(), nullptr);
+            eastl::vector<TransientRequest*> ends(requests.size(), nullptr);
+            {
+                eastl::vector<uint32_t> begin_cursor(begin_offsets.begin(), begin_offsets.end() - 1);
+                eastl::vector<uint32_t> end_cursor(end_offsets.begin(), end_offsets.end() - 1);
+                for (auto& request : requests)
+                {
+                    begins[begin_cursor[request.node->first_use]++] = &request;
+                    ends[end_cursor[request.node->last_use]++] = &request;
+                }
+            }
+
+            // Allocation records are linked into the pool's block list, so they must not move
+            eastl::vector<RenderObject::PoolAllocationData> allocations(requests.size());
+            for (auto& allocation : allocations)
+                allocation.reset();
+
+            for (uint32_t pass = 0; pass < pass_count; ++pass)
+            {
+                // Larger resources first leaves the smaller holes for the smaller ones
+                eastl::sort(begins.begin() + begin_offsets[pass], begins.begin() + begin_offsets[pass + 1],
+                    [](const TransientRequest* lhs, const TransientRequest* rhs) {
+                        if (lhs->node->allocation_size != rhs->node->allocation_size)
+                            return lhs->node->allocation_size > rhs->node->allocation_size;
+                        return lhs->allocation_index < rhs->allocation_index;
+                    });
+
+                for (uint32_t i = begin_offsets[pass]; i < begin_offsets[pass + 1]; ++i)
+                {
+                    TransientRequest* request = begins[i];
+                    ResourceNode* resource_node = request->node;
+                    RenderGraphTransientHeap& heap = heaps[request->heap_index];
+                    RenderObject::PoolAllocationData& allocation = allocations[request->allocation_index];
+                    const bool allocated = pools[request->heap_index]->try_allocate(
+                        static_cast<uint32_t>(resource_node->allocation_size), heap.alignment, heap.resource_type, allocation);
+                    cyber_assert(allocated, "Transient heap could not place a graph resource");
+                    if (!allocated)
+                        continue;
+
+                    resource_node->heap_index = request->heap_index;
+                    resource_node->heap_offset = allocation.get_offset();
+                    heap.size = eastl::max(heap.size, resource_node->heap_offset + resource_node->allocation_size);
+                }
+
+                // Resources read for the last time in this pass free their block for the next one
+                for (uint32_t i = end_offsets[pass]; i < end_offsets[pass + 1]; ++i)
+                {
+                    TransientRequest* request = ends[i];
+                    if (request->node->heap_index != UINT32_MAX)
+                        pools[request->heap_index]->deallocate(allocations[request->allocation_index]);
+                }
+            }
+
+            for (auto* pool : pools)
+                cyber_delete(pool);
+
+            for (const auto& heap : heaps)
+                aliased_size += heap.size;
+        }
+    }
+}
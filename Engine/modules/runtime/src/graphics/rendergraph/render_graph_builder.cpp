@@ -1,7 +1,6 @@
 #include "rendergraph/render_graph_builder.h"
 #include "platform/memory.h"
 #include "rendergraph/render_graph.h"
-#include "interface/command_queue.h"
 
 namespace Cyber
 {
@@ -34,56 +33,72 @@ namespace Cyber
             return *this;
         }
 
-        RGTextureRef RenderGraphBuilder::create_texture(RGTextureCreateDesc desc, const char8_t* name)
+        RenderGraphBuilder& RenderGraphBuilder::with_context(RenderObject::IDeviceContext* context) CYBER_NOEXCEPT
         {
-            if (!graph || !name)
+            this->device_context = context;
+            return *this;
+        }
+
+        RenderGraphBuilder& RenderGraphBuilder::with_deferred_contexts(RenderObject::IDeviceContext* const* contexts, uint32_t count) CYBER_NOEXCEPT
+        {
+            deferred_contexts.assign(contexts, contexts + count);
+            return *this;
+        }
+
+        RenderGraphBuilder& RenderGraphBuilder::with_async_compute(const RenderGraphAsyncComputeDesc& desc) CYBER_NOEXCEPT
+        {
+            async_compute = desc;
+            return *this;
+        }
+
+        RGTextureRef RenderGraphBuilder::create_texture(RGTextureCreateDesc desc, RGResourceName name)
+        {
+            if (!graph || !name.name)
             {
                 cyber_assert(false, "RenderGraph and resource name must be valid");
                 return nullptr;
             }
 
-            if(graph->resource_map.find(name) != graph->resource_map.end())
-            {
-                cyber_assert(false, "Resource name already exists")
+            if (!check_unique_name(name))
                 return nullptr;
-            }
 
             RGTexture* texture = cyber_new<RGTexture>();
             texture->create_desc = desc;
-            texture->resource_name = name;
+            texture->resource_name = name.name;
+            texture->name_hash = name.hash;
             texture->device = device;
 
             TextureNode* texture_node = cyber_new<TextureNode>();
             texture_node->texture = nullptr;
+            texture_node->resource = texture;
             texture->texture_node = texture_node;
 
-            graph->resource_map[name] = texture;
-            graph->resources.push_back(texture_node);
-            graph->invalidate();
+            graph->add_resource(texture_node);
             return texture;
         }
 
-        RGTextureRef RenderGraphBuilder::get_texture(const char8_t* name)
+        RGTextureRef RenderGraphBuilder::get_texture(RGResourceName name)
         {
-            if (!graph || !name)
+            if (!graph || !name.name)
                 return nullptr;
 
-            if(graph->resource_map.find(name) == graph->resource_map.end())
+            RGRenderResource* resource = graph->find_resource(name);
+            if (!resource)
             {
                 cyber_assert(false, "Resource name not found")
                 return nullptr;
             }
 
-            if(graph->resource_map[name]->resource_type != ERGResourceType::Texture)
+            if (resource->resource_type != ERGResourceType::Texture)
             {
                 cyber_assert(false, "Resource type is not texture")
                 return nullptr;
             }
 
-            return (RGTexture*)graph->resource_map[name];   
+            return static_cast<RGTexture*>(resource);
         }
 
-        RGTextureRef RenderGraphBuilder::import_texture(RenderObject::ITexture* texture, const char8_t* name)
+        RGTextureRef RenderGraphBuilder::import_texture(RenderObject::ITexture* texture, RGResourceName name)
         {
             if (!texture)
             {
@@ -92,10 +107,31 @@ namespace Cyber
             }
 
             RGTextureRef imported_texture = create_texture(texture->get_create_desc(), name);
+            if (!imported_texture)
+                return nullptr;
+
+            imported_texture->texture_node->imported = true;
+            imported_texture->texture_node->output = true;
             update_imported_texture(imported_texture, texture);
             return imported_texture;
         }
 
+        void RenderGraphBuilder::set_output(RGRenderResource* resource, bool output)
+        {
+            ResourceNode* resource_node = get_resource_node(resource);
+            if (!resource_node)
+            {
+                cyber_assert(false, "Only graph textures and buffers can be marked as outputs");
+                return;
+            }
+
+            if (resource_node->output != output)
+            {
+                resource_node->output = output;
+                graph->invalidate();
+            }
+        }
+
         void RenderGraphBuilder::update_imported_texture(RGTextureRef texture, RenderObject::ITexture* imported_texture)
         {
             if (!texture || !imported_texture)
@@ -110,58 +146,82 @@ namespace Cyber
                 texture->texture_node->texture = imported_texture;
         }
 
-        RenderObject::ITexture* RenderGraphBuilder::GetRHITexture(const char8_t* name)
+        RenderObject::ITexture* RenderGraphBuilder::GetRHITexture(RGResourceName name)
         {
             RGTextureRef texture = get_texture(name);
             return texture ? texture->GetTexture() : nullptr;
         }
 
-        RGBufferRef RenderGraphBuilder::create_buffer(RGBufferCreateDesc desc, const char8_t* name)
+        RGBufferRef RenderGraphBuilder::create_buffer(RGBufferCreateDesc desc, RGResourceName name)
         {
-            if (!graph || !name)
+            if (!graph || !name.name)
             {
                 cyber_assert(false, "RenderGraph and resource name must be valid");
                 return nullptr;
             }
 
-            if(graph->resource_map.find(name) != graph->resource_map.end())
-            {
-                cyber_assert(false, "Resource name already exists")
+            if (!check_unique_name(name))
                 return nullptr;
-            }
 
             RGBuffer* buffer = cyber_new<RGBuffer>();
             buffer->create_desc = desc;
-            buffer->resource_name = name;
+            buffer->resource_name = name.name;
+            buffer->name_hash = name.hash;
             buffer->device = device;
 
             BufferNode* buffer_node = cyber_new<BufferNode>();
             buffer_node->buffer = nullptr;
+            buffer_node->resource = buffer;
             buffer->buffer_node = buffer_node;
-            graph->resource_map[name] = buffer;
-            graph->resources.push_back(buffer_node);
-            graph->invalidate();
+
+            graph->add_resource(buffer_node);
             return buffer;
         }
 
-        RGBufferRef RenderGraphBuilder::get_buffer(const char8_t* name)
+        RGBufferRef RenderGraphBuilder::get_buffer(RGResourceName name)
         {
-            if (!graph || !name)
+            if (!graph || !name.name)
                 return nullptr;
 
-            if(graph->resource_map.find(name) == graph->resource_map.end())
+            RGRenderResource* resource = graph->find_resource(name);
+            if (!resource)
             {
                 cyber_assert(false, "Resource name not found")
                 return nullptr;
             }
 
-            if(graph->resource_map[name]->resource_type != ERGResourceType::Buffer)
+            if (resource->resource_type != ERGResourceType::Buffer)
             {
                 cyber_assert(false, "Resource type is not buffer")
                 return nullptr;
             }
 
-            return (RGBuffer*)graph->resource_map[name];
+            return static_cast<RGBuffer*>(resource);
+        }
+
+        bool RenderGraphBuilder::check_unique_name(RGResourceName name) const
+        {
+            RGRenderResource* existing = graph->find_resource(name);
+            if (!existing)
+                return true;
+
+            // Equal hashes from different strings would make one of the two unreachable
+            const char8_t* lhs = existing->resource_name;
+            const char8_t* rhs = name.name;
+            while (*lhs != 0 && *lhs == *rhs)
+            {
+                ++lhs;
+                ++rhs;
+            }
+            if (*lhs == *rhs)
+            {
+                cyber_assert(false, "Resource name already exists");
+            }
+            else
+            {
+                cyber_assert(false, "Resource name hash collides with another resource");
+            }
+            return false;
         }
 
         RGTextureViewRef RenderGraphBuilder::CreateTextureView(RGTextureViewCreateDesc desc)
@@ -54,7 +54,8 @@ namespace Cyber
         {
         }
 
-        void RGPass::register_resource_access(RGRenderResource* resource, ERGResourceAccess access) CYBER_NOEXCEPT
+        void RGPass::register_resource_access(RGRenderResource* resource, ERGResourceAccess access,
+            GRAPHICS_RESOURCE_STATE state) CYBER_NOEXCEPT
         {
             if (!resource || !pass_node)
             {
@@ -66,6 +67,12 @@ namespace Cyber
             {
                 if (existing.resource == resource)
                 {
+                    // Read states combine; once the pass writes, the write state wins
+                    if (existing.access == ERGResourceAccess::Read && access == ERGResourceAccess::Read)
+                        existing.state = existing.state | state;
+                    else if (access != ERGResourceAccess::Read)
+                        existing.state = state;
+
                     const uint8_t merged = static_cast<uint8_t>(existing.access) |
                         static_cast<uint8_t>(access);
                     existing.access = static_cast<ERGResourceAccess>(merged);
@@ -73,42 +80,42 @@ namespace Cyber
                 }
             }
 
-            pass_node->resource_accesses.push_back({ resource, access });
+            pass_node->resource_accesses.push_back({ resource, access, state });
         }
 
-        RGPass& RGPass::read(RGTextureRef texture) CYBER_NOEXCEPT
+        RGPass& RGPass::read(RGTextureRef texture, GRAPHICS_RESOURCE_STATE state) CYBER_NOEXCEPT
         {
-            register_resource_access(texture, ERGResourceAccess::Read);
+            register_resource_access(texture, ERGResourceAccess::Read, state);
             return *this;
         }
 
-        RGPass& RGPass::read(RGBufferRef buffer) CYBER_NOEXCEPT
+        RGPass& RGPass::read(RGBufferRef buffer, GRAPHICS_RESOURCE_STATE state) CYBER_NOEXCEPT
         {
-            register_resource_access(buffer, ERGResourceAccess::Read);
+            register_resource_access(buffer, ERGResourceAccess::Read, state);
             return *this;
         }
 
-        RGPass& RGPass::write(RGTextureRef texture) CYBER_NOEXCEPT
+        RGPass& RGPass::write(RGTextureRef texture, GRAPHICS_RESOURCE_STATE state) CYBER_NOEXCEPT
         {
-            register_resource_access(texture, ERGResourceAccess::Write);
+            register_resource_access(texture, ERGResourceAccess::Write, state);
             return *this;
         }
 
-        RGPass& RGPass::write(RGBufferRef buffer) CYBER_NOEXCEPT
+        RGPass& RGPass::write(RGBufferRef buffer, GRAPHICS_RESOURCE_STATE state) CYBER_NOEXCEPT
         {
-            register_resource_access(buffer, ERGResourceAccess::Write);
+            register_resource_access(buffer, ERGResourceAccess::Write, state);
             return *this;
         }
 
-        RGPass& RGPass::read_write(RGTextureRef texture) CYBER_NOEXCEPT
+        RGPass& RGPass::read_write(RGTextureRef texture, GRAPHICS_RESOURCE_STATE state) CYBER_NOEXCEPT
         {
-            register_resource_access(texture, ERGResourceAccess::ReadWrite);
+            register_resource_access(texture, ERGResourceAccess::ReadWrite, state);
             return *this;
         }
 
-        RGPass& RGPass::read_write(RGBufferRef buffer) CYBER_NOEXCEPT
+        RGPass& RGPass::read_write(RGBufferRef buffer, GRAPHICS_RESOURCE_STATE state) CYBER_NOEXCEPT
         {
-            register_resource_access(buffer, ERGResourceAccess::ReadWrite);
+            register_resource_access(buffer, ERGResourceAccess::ReadWrite, state);
             return *this;
         }
 
@@ -157,7 +164,7 @@ namespace Cyber
             mrt_load_actions[mrt_index] = load_action;
             mrt_store_actions[mrt_index] = store_action;
             mrt_clear_values[mrt_index] = clear_color;
-            write(texture);
+            write(texture, GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
 
             return *this;
         }
@@ -174,7 +181,7 @@ namespace Cyber
             this->sload_action = stencil_load_action;
             this->sstore_action = stencil_store_action;
 
-            register_resource_access(depthstencil, ERGResourceAccess::Write);
+            register_resource_access(depthstencil, ERGResourceAccess::Write, GRAPHICS_RESOURCE_STATE_DEPTH_WRITE);
 
             return *this;
         }
@@ -191,7 +198,7 @@ namespace Cyber
             this->sload_action = stencil_load_action;
             this->sstore_action = stencil_store_action;
 
-            write(depthstencil);
+            write(depthstencil, GRAPHICS_RESOURCE_STATE_DEPTH_WRITE);
 
             return *this;
         }
@@ -202,10 +209,35 @@ namespace Cyber
             return *this;
         }
 
-        RGRenderPass& RGRenderPass::add_input(const char8_t* name, RGTextureRef texture) CYBER_NOEXCEPT
+        template<typename ResourceRef>
+        static void set_pass_input(eastl::vector<RGPassInput<ResourceRef>>& inputs, RGResourceName name, ResourceRef resource)
+        {
+            for (auto& input : inputs)
+            {
+                if (input.name == name)
+                {
+                    input.resource = resource;
+                    return;
+                }
+            }
+            inputs.push_back({ name, resource });
+        }
+
+        template<typename ResourceRef>
+        static ResourceRef find_pass_input(const eastl::vector<RGPassInput<ResourceRef>>& inputs, RGResourceName name)
+        {
+            for (const auto& input : inputs)
+            {
+                if (input.name == name)
+                    return input.resource;
+            }
+            return nullptr;
+        }
+
+        RGRenderPass& RGRenderPass::add_input(RGResourceName name, RGTextureRef texture) CYBER_NOEXCEPT
         {
-            if (name)
-                input_textures[name] = texture;
+            if (name.name)
+                set_pass_input(input_textures, name, texture);
             read(texture);
 
             return *this;
@@ -223,19 +255,29 @@ namespace Cyber
             this->sload_action = stencil_load_action;
             this->sstore_action = stencil_store_action;
 
-            read(depthstencil);
+            read(depthstencil, GRAPHICS_RESOURCE_STATE_DEPTH_READ);
 
             return *this;
         }
 
-        RGRenderPass& RGRenderPass::add_input(const char8_t* name, RGBufferRef buffer) CYBER_NOEXCEPT
+        RGRenderPass& RGRenderPass::add_input(RGResourceName name, RGBufferRef buffer) CYBER_NOEXCEPT
         {
-            if (name)
-                input_buffers[name] = buffer;
+            if (name.name)
+                set_pass_input(input_buffers, name, buffer);
             read(buffer);
             return *this;
         }
 
+        RGTextureRef RGRenderPass::get_input_texture(RGResourceName name) const CYBER_NOEXCEPT
+        {
+            return find_pass_input(input_textures, name);
+        }
+
+        RGBufferRef RGRenderPass::get_input_buffer(RGResourceName name) const CYBER_NOEXCEPT
+        {
+            return find_pass_input(input_buffers, name);
+        }
+
         RGComputePass::RGComputePass()
             : RGPass(ERGPassType::RG_COMPUTE_PASS)
         {
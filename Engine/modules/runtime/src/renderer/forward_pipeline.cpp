@@ -1,8 +1,12 @@
 #include "renderer/forward_pipeline.h"
 
+#include "component/camera_component.h"
+#include "component/mesh_component.h"
+#include "gameruntime/world.h"
 #include "graphics/features/pre_depth.h"
 #include "graphics/features/scene_color.h"
 #include "graphics/features/shadow.h"
+#include "graphics/features/texture_streaming.h"
 #include "graphics/interface/buffer.h"
 #include "graphics/interface/device_context.h"
 #include "graphics/interface/render_device.hpp"
@@ -12,6 +16,11 @@
 #include "graphics/rendergraph/render_graph.h"
 #include "graphics/rendergraph/render_graph_builder.h"
 #include "renderer/renderer.h"
+#include "EASTL/algorithm.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
 
 namespace Cyber::Renderer
 {
@@ -27,6 +36,26 @@ namespace Cyber::Renderer
             desc.cpu_access_flags = CPU_ACCESS_WRITE;
             device->create_buffer(desc, nullptr, &out_buffer);
         }
+
+        Component::CameraComponent* find_enabled_camera(World* world)
+        {
+            Component::CameraComponent* camera = nullptr;
+            if (world)
+            {
+                world->for_each_component_of<Component::CameraComponent>(
+                    [&](SceneNode&, Component::CameraComponent& candidate, uint32_t)
+                    {
+                        if (!camera && candidate.enabled)
+                            camera = &candidate;
+                    });
+            }
+            return camera;
+        }
+
+        float projection_y_scale(const Component::CameraComponent& camera)
+        {
+            return 1.0f / std::tan(camera.fov_deg * (3.14159265f / 180.0f) * 0.5f);
+        }
     }
 
     ForwardPipeline::ForwardPipeline(Renderer* renderer)
@@ -66,6 +95,9 @@ namespace Cyber::Renderer
         ForwardFrameContext frame_context = begin_frame();
         frame_context.world = world;
         update_pass_context(frame_context);
+        build_draw_list(world);
+        select_mesh_lods(world);
+        request_texture_mips(world);
         update_render_graph_resources(frame_context);
 
         m_render_graph->reset_passes();
@@ -79,7 +111,18 @@ namespace Cyber::Renderer
 
     void ForwardPipeline::create_resources()
     {
-        create_constant_buffer(m_device, sizeof(ForwardSceneConstants), m_scene_constants);
+        create_constant_buffer(m_device, sizeof(ForwardPassConstants), m_pass_constants);
+
+        // Never rewritten, so it lives in GPU memory
+        const ForwardPrimitiveDecode identity_decode = {};
+        RenderObject::BufferCreateDesc decode_desc = {};
+        decode_desc.bind_flags = GRAPHICS_RESOURCE_BIND_UNIFORM_BUFFER;
+        decode_desc.size = kForwardPrimitiveDecodeStride;
+        decode_desc.usage = GRAPHICS_RESOURCE_USAGE_DEFAULT;
+        RenderObject::BufferData decode_data = {};
+        decode_data.data = &identity_decode;
+        decode_data.data_size = sizeof(identity_decode);
+        m_device->create_buffer(decode_desc, &decode_data, &m_identity_decode);
 
         RenderObject::TextureCreateDesc shadow_desc = {};
         shadow_desc.m_name = u8"Forward_ShadowMap";
@@ -110,10 +153,15 @@ namespace Cyber::Renderer
             [&](render_graph::RenderGraphBuilder& builder)
             {
                 builder.with_device(m_device);
+                // No deferred contexts: every forward pass begins a render pass, which transitions its
+                // attachments through the textures' tracked state and so must stay on one thread.
+                builder.with_context(m_context);
 
                 m_rg_scene_color = builder.import_texture(scene_target.color_buffer, u8"Forward.SceneColor");
                 m_rg_scene_depth = builder.import_texture(scene_target.depth_buffer, u8"Forward.SceneDepth");
                 m_rg_shadow_map = builder.import_texture(m_shadow_map, u8"Forward.ShadowMap");
+                // The shadow map only feeds SceneColor; without a reader the shadow pass is culled.
+                builder.set_output(m_rg_shadow_map, false);
 
                 m_pre_depth_pass = cyber_new<PreDepthPass>(
                     PreDepthPass::Resources{ m_rg_scene_depth }, &m_pass_context);
@@ -173,12 +221,138 @@ namespace Cyber::Renderer
         m_pass_context.renderer = m_renderer;
         m_pass_context.device = m_device;
         m_pass_context.command_context = m_context;
-        m_pass_context.scene_constants = m_scene_constants;
+        m_pass_context.pass_constants = m_pass_constants;
+        m_pass_context.identity_decode = m_identity_decode;
         m_pass_context.pipeline_cache = &m_pipeline_cache;
         m_pass_context.shadow_resolution = m_shadow_resolution;
         m_pass_context.frame = frame_context;
     }
 
+    void ForwardPipeline::build_draw_list(World* world)
+    {
+        m_pass_context.draw_list.clear();
+        m_pass_context.draw_bounds.clear();
+        if (!world)
+            return;
+
+        world->for_each_component_of<Component::MeshComponent>(
+            [&](SceneNode&, Component::MeshComponent& mesh, uint32_t)
+            {
+                if (is_forward_drawable(mesh))
+                    m_pass_context.draw_list.push_back(&mesh);
+            });
+        const uint32_t object_count = static_cast<uint32_t>(m_pass_context.draw_list.size());
+        if (object_count == 0)
+            return;
+
+        // Grow geometrically; each discard map suballocates the whole buffer from the context's
+        // dynamic heap, so the size only bounds the per-frame upload
+        if (object_count > m_object_capacity)
+        {
+            m_object_capacity = eastl::max(object_count, eastl::max(m_object_capacity * 2, 256u));
+            m_object_constants.reset();
+            create_constant_buffer(m_device, m_object_capacity * kForwardObjectConstantsStride, m_object_constants);
+            m_pass_context.object_constants = m_object_constants;
+        }
+
+        auto* mapped = m_object_constants
+            ? static_cast<uint8_t*>(m_device->map_buffer(m_object_constants, MAP_WRITE, MAP_FLAG_DISCARD))
+            : nullptr;
+        if (!mapped)
+        {
+            m_pass_context.draw_list.clear();
+            return;
+        }
+
+        // Culling works per mesh: draw primitives carry no bounds of their own
+        m_pass_context.draw_bounds.reserve(object_count);
+        for (uint32_t object_index = 0; object_index < object_count; ++object_index)
+        {
+            const Component::MeshComponent& mesh = *m_pass_context.draw_list[object_index];
+            const float4x4 model_matrix = mesh.local_matrix();
+            if (mesh.runtime_bounds_valid)
+                m_pass_context.draw_bounds.add_local_box(mesh.runtime_bounds_min, mesh.runtime_bounds_max, model_matrix);
+            else
+                m_pass_context.draw_bounds.add_unbounded();
+
+            ForwardObjectConstants constants = {};
+            constants.model_matrix = model_matrix.transpose();
+            std::memcpy(mapped + static_cast<size_t>(object_index) * kForwardObjectConstantsStride, &constants, sizeof(constants));
+        }
+        m_device->unmap_buffer(m_object_constants, MAP_WRITE);
+    }
+
+    void ForwardPipeline::select_mesh_lods(World* world)
+    {
+        // Without a camera every primitive keeps full detail
+        const uint32_t object_count = m_pass_context.draw_bounds.size();
+        m_pass_context.lod_pixels_per_unit.assign(object_count, std::numeric_limits<float>::infinity());
+
+        Component::CameraComponent* camera = find_enabled_camera(world);
+        const RenderObject::ITexture* color_buffer = m_pass_context.frame.color_buffer;
+        if (!camera || !color_buffer || !(m_pass_context.lod_max_pixel_error > 0.0f))
+            return;
+
+        const float3 eye = camera->get_camera_position();
+        const float y_scale = projection_y_scale(*camera);
+        const float viewport_height = static_cast<float>(color_buffer->get_create_desc().m_height);
+        const CullingBoxes& bounds = m_pass_context.draw_bounds;
+        for (uint32_t object_index = 0; object_index < object_count; ++object_index)
+        {
+            const Component::MeshComponent& mesh = *m_pass_context.draw_list[object_index];
+            bool has_lods = false;
+            for (const auto& primitive : mesh.draw_primitives)
+                has_lods |= !primitive.lods.empty();
+            if (!has_lods)
+                continue;
+
+            // LOD errors are in mesh units; scale them by the model matrix's largest axis
+            const float4x4 model_matrix = mesh.local_matrix();
+            float world_scale = 0.0f;
+            for (int row = 0; row < 3; ++row)
+            {
+                world_scale = eastl::max(world_scale, std::sqrt(model_matrix[row][0] * model_matrix[row][0] +
+                    model_matrix[row][1] * model_matrix[row][1] + model_matrix[row][2] * model_matrix[row][2]));
+            }
+            m_pass_context.lod_pixels_per_unit[object_index] = lod_pixels_per_unit(
+                float3(bounds.center_x[object_index], bounds.center_y[object_index], bounds.center_z[object_index]),
+                float3(bounds.extent_x[object_index], bounds.extent_y[object_index], bounds.extent_z[object_index]),
+                eye, y_scale, viewport_height, world_scale);
+        }
+    }
+
+    void ForwardPipeline::request_texture_mips(World* world)
+    {
+        if (!m_texture_streamer)
+            return;
+
+        Component::CameraComponent* camera = find_enabled_camera(world);
+
+        // Without a camera nothing is requested and every texture falls back to its tail
+        const RenderObject::ITexture* color_buffer = m_pass_context.frame.color_buffer;
+        if (camera && color_buffer)
+        {
+            const float3 eye = camera->get_camera_position();
+            const float y_scale = projection_y_scale(*camera);
+            const float viewport_height = static_cast<float>(color_buffer->get_create_desc().m_height);
+            const CullingBoxes& bounds = m_pass_context.draw_bounds;
+            for (uint32_t object_index = 0; object_index < bounds.size(); ++object_index)
+            {
+                // Assumes a texture spans its mesh once; tiling UVs would want a finer mip
+                const float screen_pixels = projected_screen_pixels(
+                    float3(bounds.center_x[object_index], bounds.center_y[object_index], bounds.center_z[object_index]),
+                    float3(bounds.extent_x[object_index], bounds.extent_y[object_index], bounds.extent_z[object_index]),
+                    eye, y_scale, viewport_height);
+                for (const auto& primitive : m_pass_context.draw_list[object_index]->draw_primitives)
+                {
+                    if (primitive.streamed_texture != kInvalidStreamedTexture)
+                        m_texture_streamer->request(primitive.streamed_texture, screen_pixels);
+                }
+            }
+        }
+        m_texture_streamer->update();
+    }
+
     ForwardFrameContext ForwardPipeline::begin_frame()
     {
         ForwardFrameContext frame_context = {};
@@ -0,0 +1,275 @@
+#include "asset/asset_cook_scheduler.h"
+#include "asset/mesh_importer.h"
+#include "asset/texture_importer.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    void write_file(const fs::path& path, const void* data, size_t size)
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        assert(file.good());
+    }
+
+    // Stands in for an expensive importer and records how many of its jobs overlap
+    class SleepyImporter final : public IAssetImporter
+    {
+    public:
+        [[nodiscard]] AssetType Type() const override { return AssetType::Material; }
+        [[nodiscard]] uint32_t Version() const override { return 1; }
+        [[nodiscard]] bool Import(const AssetImportRequest& request, AssetImportResult& outResult) const override
+        {
+            const uint32_t active = ++m_active;
+            uint32_t peak = m_peak.load();
+            while (active > peak && !m_peak.compare_exchange_weak(peak, active))
+            {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            --m_active;
+
+            outResult = {};
+            outResult.registryRecord.guid = request.existingGuid.IsValid() ? request.existingGuid : AssetGuid::Create();
+            outResult.registryRecord.type = AssetType::Material;
+            outResult.registryRecord.assetPath = AssetRegistry::MakeStoredPath(request.destinationPath, request.contentRoot);
+            outResult.registryRecord.importerVersion = Version();
+            return true;
+        }
+
+        uint32_t Peak() const { return m_peak.load(); }
+        void ResetPeak() { m_peak = 0; }
+
+    private:
+        mutable std::atomic<uint32_t> m_active { 0 };
+        mutable std::atomic<uint32_t> m_peak { 0 };
+    };
+
+    double cook_sleepy(AssetCookScheduler& scheduler, SleepyImporter& importer, uint32_t workerCount,
+                       const fs::path& root)
+    {
+        std::vector<AssetCookRequest> requests;
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            AssetCookRequest request;
+            request.importerType = AssetType::Material;
+            request.import.sourcePath = root / ("missing_" + std::to_string(i) + ".mat");
+            request.import.destinationPath = root / ("material_" + std::to_string(i) + ".asset");
+            request.import.contentRoot = root;
+            requests.push_back(request);
+        }
+        AssetRegistry registry;
+        AssetCookSettings settings;
+        settings.workerCount = workerCount;
+        AssetCookStats stats;
+        importer.ResetPeak();
+        const auto begin = Clock::now();
+        const std::vector<AssetCookResult> results = scheduler.Cook(requests, registry, settings, &stats);
+        const double ms = elapsed_ms(begin);
+        assert(stats.cooked == requests.size());
+        assert(registry.Records().size() == requests.size());
+        for (size_t i = 0; i < results.size(); ++i)
+            assert(results[i].importResult.registryRecord.displayName.empty() &&
+                   results[i].importResult.registryRecord.assetPath == "material_" + std::to_string(i) + ".asset");
+        return ms;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t textureCount = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 256;
+    assert(textureCount >= 4);
+
+    const fs::path testRoot =
+        fs::current_path() / "Saved" / "AssetCookSchedulerTests" / AssetGuid::Create().ToString();
+    const fs::path contentRoot = testRoot / "Content";
+    const fs::path cachePath = contentRoot / "Registry" / "SourceHashCache.bin";
+
+    // 4x4 opaque RGBA8 checker
+    const std::vector<uint8_t> pngBytes {
+        0x89u, 0x50u, 0x4eu, 0x47u, 0x0du, 0x0au, 0x1au, 0x0au,
+        0x00u, 0x00u, 0x00u, 0x0du, 0x49u, 0x48u, 0x44u, 0x52u,
+        0x00u, 0x00u, 0x00u, 0x04u, 0x00u, 0x00u, 0x00u, 0x04u,
+        0x08u, 0x06u, 0x00u, 0x00u, 0x00u, 0xa9u, 0xf1u, 0x9eu,
+        0x7eu, 0x00u, 0x00u, 0x00u, 0x30u, 0x49u, 0x44u, 0x41u,
+        0x54u, 0x78u, 0xdau, 0x15u, 0xc8u, 0x41u, 0x11u, 0x00u,
+        0x30u, 0x10u, 0xc2u, 0x40u, 0xa4u, 0x9cu, 0x14u, 0xa4u,
+        0x21u, 0x0du, 0x67u, 0x29u, 0x9du, 0x4cu, 0x3eu, 0x2bu,
+        0x24u, 0xb0u, 0xb8u, 0xecu, 0x8au, 0xe5u, 0x81u, 0x07u,
+        0xbbu, 0x46u, 0xa7u, 0x70u, 0x0eu, 0x64u, 0x37u, 0x1fu,
+        0x3au, 0xe8u, 0x60u, 0xb7u, 0x3cu, 0x73u, 0xdcu, 0x24u,
+        0xe9u, 0x25u, 0x54u, 0x60u, 0xfau, 0x00u, 0x00u, 0x00u,
+        0x00u, 0x49u, 0x45u, 0x4eu, 0x44u, 0xaeu, 0x42u, 0x60u,
+        0x82u
+    };
+    const std::string triangleGltf = R"({
+        "asset":{"version":"2.0"},
+        "buffers":[{"byteLength":42,"uri":"data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAABAAIA"}],
+        "bufferViews":[
+            {"buffer":0,"byteOffset":0,"byteLength":36,"target":34962},
+            {"buffer":0,"byteOffset":36,"byteLength":6,"target":34963}
+        ],
+        "accessors":[
+            {"bufferView":0,"componentType":5126,"count":3,"type":"VEC3","min":[0,0,0],"max":[1,1,0]},
+            {"bufferView":1,"componentType":5123,"count":3,"type":"SCALAR"}
+        ],
+        "meshes":[{"primitives":[{"attributes":{"POSITION":0},"indices":1}]}],
+        "nodes":[{"mesh":0}],
+        "scenes":[{"nodes":[0]}],
+        "scene":0
+    })";
+
+    std::vector<AssetCookRequest> requests;
+    for (uint32_t i = 0; i < textureCount; ++i)
+    {
+        const bool isMesh = i % 8 == 7;
+        const std::string name = (isMesh ? "mesh_" : "texture_") + std::to_string(i);
+        AssetCookRequest request;
+        request.importerType = isMesh ? AssetType::Mesh : AssetType::Texture;
+        request.import.sourcePath = testRoot / "Source" / (name + (isMesh ? ".gltf" : ".png"));
+        request.import.destinationPath = contentRoot / "Assets" / (name + (isMesh ? ".meshasset" : ".textureasset"));
+        request.import.contentRoot = contentRoot;
+        if (isMesh)
+            write_file(request.import.sourcePath, triangleGltf.data(), triangleGltf.size());
+        else
+            write_file(request.import.sourcePath, pngBytes.data(), pngBytes.size());
+        requests.push_back(request);
+    }
+
+    TextureImporter textureImporter;
+    MeshImporter meshImporter;
+    const auto register_importers = [&](AssetCookScheduler& scheduler)
+    {
+        scheduler.RegisterImporter(textureImporter);
+        scheduler.RegisterImporter(meshImporter, 2);
+    };
+
+    AssetCookSettings settings;
+    settings.sourceHashCachePath = cachePath;
+    AssetRegistry registry;
+    AssetCookStats stats;
+
+    // Full cook
+    AssetCookScheduler scheduler;
+    register_importers(scheduler);
+    auto begin = Clock::now();
+    std::vector<AssetCookResult> firstResults = scheduler.Cook(requests, registry, settings, &stats);
+    const double fullMs = elapsed_ms(begin);
+    assert(stats.cooked == textureCount && stats.upToDate == 0 && stats.failed == 0);
+    assert(registry.Records().size() == textureCount);
+    assert(fs::exists(cachePath));
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        assert(firstResults[i].status == AssetCookStatus::Cooked);
+        assert(firstResults[i].importResult.registryRecord.assetPath ==
+               AssetRegistry::MakeStoredPath(requests[i].import.destinationPath, contentRoot));
+    }
+
+    // No-op reimport from a fresh scheduler, as on the next editor start: sources are only stat'ed
+    AssetCookScheduler restarted;
+    register_importers(restarted);
+    begin = Clock::now();
+    std::vector<AssetCookResult> noopResults = restarted.Cook(requests, registry, settings, &stats);
+    const double noopMs = elapsed_ms(begin);
+    assert(stats.cooked == 0 && stats.upToDate == textureCount && stats.failed == 0);
+    for (size_t i = 0; i < requests.size(); ++i)
+        assert(noopResults[i].importResult.registryRecord.guid == firstResults[i].importResult.registryRecord.guid);
+
+    // Only the changed source, the asset whose usage changed and the deleted output are recooked
+    {
+        std::ofstream append(requests[0].import.sourcePath, std::ios::binary | std::ios::app);
+        append.put('\0');
+    }
+    requests[1].import.textureUsage = TextureUsage::Normal;
+    fs::remove(requests[7].import.destinationPath);
+    std::vector<AssetCookResult> partialResults = restarted.Cook(requests, registry, settings, &stats);
+    assert(stats.cooked == 3 && stats.upToDate == textureCount - 3);
+    assert(partialResults[0].status == AssetCookStatus::Cooked);
+    assert(partialResults[1].status == AssetCookStatus::Cooked);
+    assert(partialResults[7].status == AssetCookStatus::Cooked);
+    for (size_t i : { 0u, 1u, 7u })
+        assert(partialResults[i].importResult.registryRecord.guid == firstResults[i].importResult.registryRecord.guid);
+    assert(registry.Records().size() == textureCount);
+
+    // Assets whose header still names FNV-1a validate against an FNV hash of the source
+    {
+        const AssetImportRequest& legacy = requests[2].import;
+        uint64_t fnvHash = 0;
+        assert(AssetHash::HashFile(legacy.sourcePath, fnvHash, AssetHashAlgorithm::Fnv1a64));
+        AssetFileHeader header;
+        std::fstream file(legacy.destinationPath, std::ios::binary | std::ios::in | std::ios::out);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.contentHash = fnvHash;
+        header.contentHashAlgorithm = AssetHashAlgorithm::Fnv1a64;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        assert(file.good());
+        file.close();
+
+        AssetRegistryRecord record = *registry.FindByAssetPath(
+            AssetRegistry::MakeStoredPath(legacy.destinationPath, contentRoot));
+        record.sourceHash = fnvHash;
+        record.editorAssetHash = AssetHash::Combine(fnvHash, textureImporter.DependencyHash(legacy));
+        registry.Upsert(record);
+
+        std::vector<AssetCookResult> legacyResults = restarted.Cook(requests, registry, settings, &stats);
+        assert(stats.cooked == 0);
+        assert(legacyResults[2].status == AssetCookStatus::UpToDate);
+        assert(legacyResults[2].importResult.registryRecord.sourceHash == fnvHash);
+    }
+
+    settings.force = true;
+    (void)restarted.Cook(requests, registry, settings, &stats);
+    assert(stats.cooked == textureCount);
+    settings.force = false;
+
+    // Bad requests fail individually without stopping the batch
+    std::vector<AssetCookRequest> badRequests { requests[2], requests[2], {} };
+    badRequests[2].importerType = AssetType::Scene;
+    std::vector<AssetCookResult> badResults = restarted.Cook(badRequests, registry, settings, &stats);
+    assert(badResults[0].status == AssetCookStatus::UpToDate);
+    assert(badResults[1].status == AssetCookStatus::Failed && !badResults[1].importResult.error.empty());
+    assert(badResults[2].status == AssetCookStatus::Failed);
+    assert(stats.failed == 2);
+
+    // Concurrency limits hold and unlimited importers scale with the worker count
+    SleepyImporter sleepy;
+    AssetCookScheduler sleepyScheduler;
+    sleepyScheduler.RegisterImporter(sleepy, 3);
+    (void)cook_sleepy(sleepyScheduler, sleepy, 8, testRoot);
+    assert(sleepy.Peak() <= 3);
+    sleepyScheduler.RegisterImporter(sleepy);
+    const double serialMs = cook_sleepy(sleepyScheduler, sleepy, 1, testRoot);
+    assert(sleepy.Peak() == 1);
+    const double parallelMs = cook_sleepy(sleepyScheduler, sleepy, 8, testRoot);
+    assert(sleepy.Peak() > 1);
+    assert(parallelMs < serialMs);
+
+    std::printf("%u assets on %u hardware threads\n", textureCount, std::thread::hardware_concurrency());
+    std::printf("  full cook      %9.2f ms\n", fullMs);
+    std::printf("  no-op reimport %9.2f ms\n", noopMs);
+    std::printf("  16 x 10 ms jobs: 1 worker %7.2f ms, 8 workers %7.2f ms\n", serialMs, parallelMs);
+
+    std::error_code ec;
+    fs::remove_all(testRoot, ec);
+    std::cout << "Asset cook scheduler tests passed" << std::endl;
+    return 0;
+}
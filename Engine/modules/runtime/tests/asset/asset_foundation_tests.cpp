@@ -1,6 +1,8 @@
 #include "asset/asset.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
@@ -67,14 +69,27 @@ int main()
     fs::create_directories(assetPath.parent_path());
     fs::create_directories(meshAssetPath.parent_path());
 
-    const std::vector<uint8_t> fakePngBytes {
+    // 4x4 opaque RGBA8 checker
+    const std::vector<uint8_t> pngBytes {
         0x89u, 0x50u, 0x4eu, 0x47u, 0x0du, 0x0au, 0x1au, 0x0au,
-        0x43u, 0x59u, 0x42u, 0x45u, 0x52u
+        0x00u, 0x00u, 0x00u, 0x0du, 0x49u, 0x48u, 0x44u, 0x52u,
+        0x00u, 0x00u, 0x00u, 0x04u, 0x00u, 0x00u, 0x00u, 0x04u,
+        0x08u, 0x06u, 0x00u, 0x00u, 0x00u, 0xa9u, 0xf1u, 0x9eu,
+        0x7eu, 0x00u, 0x00u, 0x00u, 0x30u, 0x49u, 0x44u, 0x41u,
+        0x54u, 0x78u, 0xdau, 0x15u, 0xc8u, 0x41u, 0x11u, 0x00u,
+        0x30u, 0x10u, 0xc2u, 0x40u, 0xa4u, 0x9cu, 0x14u, 0xa4u,
+        0x21u, 0x0du, 0x67u, 0x29u, 0x9du, 0x4cu, 0x3eu, 0x2bu,
+        0x24u, 0xb0u, 0xb8u, 0xecu, 0x8au, 0xe5u, 0x81u, 0x07u,
+        0xbbu, 0x46u, 0xa7u, 0x70u, 0x0eu, 0x64u, 0x37u, 0x1fu,
+        0x3au, 0xe8u, 0x60u, 0xb7u, 0x3cu, 0x73u, 0xdcu, 0x24u,
+        0xe9u, 0x25u, 0x54u, 0x60u, 0xfau, 0x00u, 0x00u, 0x00u,
+        0x00u, 0x49u, 0x45u, 0x4eu, 0x44u, 0xaeu, 0x42u, 0x60u,
+        0x82u
     };
     {
         std::ofstream sourceFile(sourcePath, std::ios::binary | std::ios::trunc);
-        sourceFile.write(reinterpret_cast<const char*>(fakePngBytes.data()),
-                         static_cast<std::streamsize>(fakePngBytes.size()));
+        sourceFile.write(reinterpret_cast<const char*>(pngBytes.data()),
+                         static_cast<std::streamsize>(pngBytes.size()));
         assert(sourceFile.good());
     }
 
@@ -116,10 +131,46 @@ int main()
     TextureEditorAssetInfo textureInfo;
     assert(TextureImporter::ReadInfo(assetPath, textureInfo));
     assert(textureInfo.fileHeader.assetGuid == importResult.registryRecord.guid);
+    assert(textureInfo.fileHeader.ContentHashAlgorithm() == kDefaultContentHashAlgorithm);
+    assert(textureInfo.fileHeader.contentHash == AssetHash::HashContent(pngBytes.data(), pngBytes.size()));
     assert(textureInfo.payloadHeader.width == 4);
     assert(textureInfo.payloadHeader.height == 4);
-    assert(textureInfo.payloadHeader.sourceDataSize == fakePngBytes.size());
+    assert(textureInfo.payloadHeader.sourceDataSize == pngBytes.size());
     assert(textureInfo.sourceExtension == ".png");
+    assert(textureInfo.isCooked);
+    assert(textureInfo.payloadHeader.cookedFormat == TextureCookFormat::BC1_SRGB);
+    assert(textureInfo.payloadHeader.mipCount == 3);
+
+    CookedTextureData cookedTexture;
+    std::string cookedTextureError;
+    assert(TextureImporter::ReadCookedData(assetPath, cookedTexture, &cookedTextureError));
+    assert(cookedTexture.mips.size() == 3);
+    assert(cookedTexture.mips[0].record.width == 4 && cookedTexture.mips[2].record.width == 1);
+    for (const CookedTextureMip& mip : cookedTexture.mips)
+    {
+        assert(mip.bytes.size() == 8);
+        assert(mip.record.dataOffset % 16 == 0);
+    }
+    // Mip tail first, so the smallest mip follows the mip table
+    assert(cookedTexture.mips[2].record.dataOffset < cookedTexture.mips[1].record.dataOffset);
+    assert(cookedTexture.mips[1].record.dataOffset < cookedTexture.mips[0].record.dataOffset);
+    assert(cookedTexture.mips[2].record.dataOffset == textureInfo.payloadHeader.cookedDataOffset);
+
+    CookedTextureData cookedTail;
+    assert(TextureImporter::ReadCookedMips(assetPath, 1, cookedTail));
+    assert(cookedTail.firstMip == 1 && cookedTail.mips.size() == 2);
+    assert(cookedTail.width == 4 && cookedTail.mips[0].record.width == 2);
+    assert(cookedTail.mips[1].bytes == cookedTexture.mips[2].bytes);
+    assert(!TextureImporter::ReadCookedMips(assetPath, 3, cookedTail));
+
+    std::vector<uint8_t> decodedMip;
+    assert(TextureCompression::Decode(cookedTexture.format, cookedTexture.mips[0].bytes.data(), 4, 4, decodedMip));
+    assert(decodedMip[0] > 200 && decodedMip[2 * 4] < 64);
+
+    assert(TextureImporter::ResolveUsage(TextureUsage::Auto, "rock_normal.png") == TextureUsage::Normal);
+    assert(TextureImporter::ResolveUsage(TextureUsage::Auto, "rock_ORM.png") == TextureUsage::Mask);
+    assert(TextureImporter::ResolveUsage(TextureUsage::Mask, "rock_normal.png") == TextureUsage::Mask);
+    assert(TextureImporter::SelectCookFormat(TextureUsage::Albedo, true) == TextureCookFormat::BC3_SRGB);
 
     AssetDatabase database(contentRoot);
     assert(database.Load());
@@ -151,6 +202,214 @@ int main()
     assert(cookedMesh.meshes.size() == 1);
     assert(cookedMesh.primitives.size() == 1);
 
+    {
+        CookedMeshView meshView;
+        std::string meshViewError;
+        assert(meshView.Open(meshAssetPath, &meshViewError));
+        assert(meshView.Vertices().size() == cookedMesh.vertices.size());
+        assert(std::memcmp(meshView.Vertices().data(), cookedMesh.vertices.data(),
+                           cookedMesh.vertices.size() * sizeof(CookedMeshVertex)) == 0);
+        assert(std::equal(meshView.Indices().begin(), meshView.Indices().end(), cookedMesh.indices.begin()));
+        assert(reinterpret_cast<uintptr_t>(meshView.Vertices().data()) % kCookedMeshSectionAlignment == 0);
+        assert(reinterpret_cast<uintptr_t>(meshView.Indices().data()) % kCookedMeshSectionAlignment == 0);
+        assert(meshView.Primitives()[0].indexCount == 3);
+        assert(meshView.TextureBytes(0).empty());
+    }
+
+    // The original source is only kept with the asset on request, embedded or as a side-car
+    {
+        std::vector<uint8_t> keptSource;
+        MeshEditorAssetInfo keptInfo;
+        const fs::path sideCarPath = MeshImporter::SideCarSourcePath(meshAssetPath, ".gltf");
+        assert(!fs::exists(sideCarPath));
+        assert(!MeshImporter::ReadEmbeddedSource(meshAssetPath, keptInfo, keptSource));
+
+        AssetImportRequest storageRequest = meshImportRequest;
+        storageRequest.existingGuid = meshImportResult.registryRecord.guid;
+        storageRequest.sourceStorage = AssetSourceStorage::Embedded;
+        AssetImportResult storageResult;
+        assert(meshImporter.Import(storageRequest, storageResult));
+        assert(meshImporter.DependencyHash(storageRequest) != meshImporter.DependencyHash(meshImportRequest));
+        assert(MeshImporter::ReadEmbeddedSource(meshAssetPath, keptInfo, keptSource));
+        assert(keptInfo.payloadHeader.sourceDataSize == triangleGltf.size());
+        assert(std::equal(keptSource.begin(), keptSource.end(), triangleGltf.begin(), triangleGltf.end()));
+        CookedMeshView embeddedView;
+        assert(embeddedView.Open(meshAssetPath));
+        assert(embeddedView.Vertices().size() == 3);
+        embeddedView.Close();
+
+        storageRequest.sourceStorage = AssetSourceStorage::SideCar;
+        assert(meshImporter.Import(storageRequest, storageResult));
+        assert(fs::exists(sideCarPath));
+        assert(MeshImporter::ReadEmbeddedSource(meshAssetPath, keptInfo, keptSource));
+        assert(keptInfo.payloadHeader.sourceDataSize == 0);
+        assert(std::equal(keptSource.begin(), keptSource.end(), triangleGltf.begin(), triangleGltf.end()));
+
+        assert(meshImporter.Import(meshImportRequest, storageResult));
+        assert(!fs::exists(sideCarPath));
+        assert(!fs::exists(fs::path(meshAssetPath) += ".tmp"));
+        assert(storageResult.registryRecord.editorAssetHash == meshImportResult.registryRecord.editorAssetHash);
+    }
+
+    // Compact vertices: 16-bit bounds-relative positions, octahedral directions, half UVs
+    {
+        const CookedVertexLayout compact = MakeCookedVertexLayout(CookedVertexEncoding::Compact());
+        assert(compact.stride == 20 && compact.IsPrimitiveRelative() && IsValidCookedVertexLayout(compact));
+
+        CookedMeshData grid;
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            CookedMeshVertex vertex {};
+            const float angle = float(i) * 0.37f;
+            vertex.position[0] = float(i % 8) * 1.25f - 3.0f;
+            vertex.position[1] = float(i / 8) * 0.5f + 10.0f;
+            vertex.position[2] = std::sin(angle);
+            vertex.normal[0] = std::cos(angle) * 0.6f;
+            vertex.normal[1] = std::sin(angle) * 0.6f;
+            vertex.normal[2] = i % 2 ? 0.8f : -0.8f;
+            vertex.uv0[0] = float(i % 8) / 7.0f;
+            vertex.uv0[1] = float(i / 8) / 7.0f;
+            vertex.tangent[i % 3] = 1.0f;
+            grid.vertices.push_back(vertex);
+        }
+        for (uint32_t i = 0; i + 2 < 64; ++i)
+            grid.indices.insert(grid.indices.end(), { i, i + 1, i + 2 });
+        // Both primitives use vertices 32 and 33, which must be split between them
+        grid.primitives.push_back(CookedMeshPrimitive { 0, 96, 0, 0 });
+        grid.primitives.push_back(CookedMeshPrimitive { 96, uint32_t(grid.indices.size()) - 96, 0, 0 });
+
+        const CookedMeshData original = grid;
+        std::vector<uint8_t> bytes;
+        std::vector<CookedMeshPrimitiveDecode> decode;
+        EncodeCookedVertices(grid, compact, bytes, decode);
+        assert(decode.size() == 2);
+        assert(grid.vertices.size() > original.vertices.size());
+        assert(bytes.size() == grid.vertices.size() * compact.stride);
+
+        std::vector<CookedMeshVertex> decoded;
+        assert(DecodeCookedVertices(compact, bytes, grid.indices, grid.primitives, decode, decoded));
+        for (size_t i = 0; i < grid.indices.size(); ++i)
+        {
+            const CookedMeshVertex& expected = original.vertices[original.indices[i]];
+            const CookedMeshVertex& actual = decoded[grid.indices[i]];
+            float normalDot = 0.0f;
+            for (int c = 0; c < 3; ++c)
+            {
+                assert(std::fabs(actual.position[c] - expected.position[c]) < 1e-3f);
+                normalDot += actual.normal[c] * expected.normal[c];
+                assert(std::fabs(actual.tangent[c] - expected.tangent[c]) < 1e-3f);
+            }
+            assert(normalDot > 0.9999f);
+            assert(std::fabs(actual.uv0[0] - expected.uv0[0]) < 1e-3f && std::fabs(actual.uv0[1] - expected.uv0[1]) < 1e-3f);
+        }
+
+        AssetImportRequest compactRequest = meshImportRequest;
+        compactRequest.existingGuid = meshImportResult.registryRecord.guid;
+        compactRequest.vertexEncoding = CookedVertexEncoding::Compact();
+        assert(meshImporter.DependencyHash(compactRequest) != meshImporter.DependencyHash(meshImportRequest));
+        AssetImportResult compactResult;
+        assert(meshImporter.Import(compactRequest, compactResult));
+
+        CookedMeshView compactView;
+        assert(compactView.Open(meshAssetPath));
+        assert(compactView.Vertices().empty());
+        assert(compactView.VertexLayout().stride == 20);
+        assert(compactView.VertexBytes().size() == 3 * 20);
+        assert(compactView.PrimitiveDecode().size() == 1);
+        compactView.Close();
+
+        CookedMeshData compactMesh;
+        assert(MeshImporter::ReadCookedData(meshAssetPath, compactMesh));
+        assert(compactMesh.vertices.size() == cookedMesh.vertices.size());
+        for (size_t i = 0; i < compactMesh.vertices.size(); ++i)
+        {
+            for (int c = 0; c < 3; ++c)
+                assert(std::fabs(compactMesh.vertices[i].position[c] - cookedMesh.vertices[i].position[c]) < 1e-3f);
+        }
+
+        assert(meshImporter.Import(meshImportRequest, compactResult));
+    }
+
+    // LOD chains: a gently curved 32x32 grid simplifies well inside the error limit
+    {
+        const fs::path terrainSourcePath = testRoot / "Source" / "terrain.gltf";
+        const fs::path terrainAssetPath = contentRoot / "Assets" / "Meshes" / "terrain.meshasset";
+        std::vector<float> terrainPositions;
+        std::vector<uint32_t> terrainIndices;
+        for (uint32_t y = 0; y <= 32; ++y)
+        {
+            for (uint32_t x = 0; x <= 32; ++x)
+                terrainPositions.insert(terrainPositions.end(), { float(x), float(y), std::sin(float(x) * 0.2f) * std::cos(float(y) * 0.2f) });
+        }
+        for (uint32_t y = 0; y < 32; ++y)
+        {
+            for (uint32_t x = 0; x < 32; ++x)
+            {
+                const uint32_t corner = y * 33 + x;
+                terrainIndices.insert(terrainIndices.end(), { corner, corner + 1, corner + 34, corner, corner + 34, corner + 33 });
+            }
+        }
+        const size_t positionBytes = terrainPositions.size() * sizeof(float);
+        const size_t indexBytes = terrainIndices.size() * sizeof(uint32_t);
+        {
+            std::ofstream binFile(testRoot / "Source" / "terrain.bin", std::ios::binary | std::ios::trunc);
+            binFile.write(reinterpret_cast<const char*>(terrainPositions.data()), static_cast<std::streamsize>(positionBytes));
+            binFile.write(reinterpret_cast<const char*>(terrainIndices.data()), static_cast<std::streamsize>(indexBytes));
+            std::ofstream gltfFile(terrainSourcePath, std::ios::binary | std::ios::trunc);
+            gltfFile << R"({"asset":{"version":"2.0"},"buffers":[{"byteLength":)" << positionBytes + indexBytes
+                     << R"(,"uri":"terrain.bin"}],"bufferViews":[{"buffer":0,"byteOffset":0,"byteLength":)" << positionBytes
+                     << R"(},{"buffer":0,"byteOffset":)" << positionBytes << R"(,"byteLength":)" << indexBytes
+                     << R"(}],"accessors":[{"bufferView":0,"componentType":5126,"count":)" << terrainPositions.size() / 3
+                     << R"(,"type":"VEC3","min":[0,0,-1],"max":[32,32,1]},{"bufferView":1,"componentType":5125,"count":)"
+                     << terrainIndices.size()
+                     << R"(,"type":"SCALAR"}],"meshes":[{"primitives":[{"attributes":{"POSITION":0},"indices":1}]}],)"
+                     << R"("nodes":[{"mesh":0}],"scenes":[{"nodes":[0]}],"scene":0})";
+            assert(binFile.good() && gltfFile.good());
+        }
+
+        AssetImportRequest lodRequest;
+        lodRequest.sourcePath = terrainSourcePath;
+        lodRequest.destinationPath = terrainAssetPath;
+        lodRequest.contentRoot = contentRoot;
+        lodRequest.vertexEncoding = CookedVertexEncoding::Compact();
+        AssetImportResult lodResult;
+        assert(meshImporter.Import(lodRequest, lodResult));
+
+        CookedMeshView lodView;
+        assert(lodView.Open(terrainAssetPath));
+        assert(lodView.Primitives().size() == 1);
+        assert(lodView.PrimitiveLods().size() == 1);
+        const CookedMeshPrimitive& terrainPrimitive = lodView.Primitives()[0];
+        const CookedMeshPrimitiveLods& terrainLods = lodView.PrimitiveLods()[0];
+        assert(terrainPrimitive.indexCount == 32 * 32 * 6);
+        assert(terrainLods.lodCount >= 2 && terrainLods.firstLod == 0);
+        uint32_t previousCount = terrainPrimitive.indexCount;
+        for (uint32_t l = 0; l < terrainLods.lodCount; ++l)
+        {
+            const CookedMeshLod& lod = lodView.Lods()[l];
+            assert(lod.indexCount < previousCount && lod.error > 0.0f);
+            assert(lod.firstIndex + lod.indexCount <= lodView.Indices().size());
+            for (uint32_t i = lod.firstIndex; i < lod.firstIndex + lod.indexCount; ++i)
+                assert(lodView.Indices()[i] < lodView.VertexBytes().size() / lodView.VertexLayout().stride);
+            previousCount = lod.indexCount;
+        }
+        const uint32_t lodCount = terrainLods.lodCount;
+        lodView.Close();
+
+        CookedMeshData terrainMesh;
+        assert(MeshImporter::ReadCookedData(terrainAssetPath, terrainMesh));
+        assert(terrainMesh.lods.size() == lodCount && terrainMesh.primitiveLods.size() == 1);
+
+        AssetImportRequest noLodRequest = lodRequest;
+        noLodRequest.existingGuid = lodResult.registryRecord.guid;
+        noLodRequest.meshLods.lodCount = 0;
+        assert(meshImporter.DependencyHash(noLodRequest) != meshImporter.DependencyHash(lodRequest));
+        assert(meshImporter.Import(noLodRequest, lodResult));
+        assert(lodView.Open(terrainAssetPath));
+        assert(lodView.Lods().empty());
+        assert(lodView.Indices().size() == 32 * 32 * 6);
+    }
+
     database.Registry().Upsert(meshImportResult.registryRecord);
     assert(database.Save());
 
@@ -0,0 +1,125 @@
+#include "asset/asset_types.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    using Clock = std::chrono::steady_clock;
+
+    template <typename Fn>
+    double gigabytes_per_second(size_t bytes, uint32_t repeats, Fn&& fn)
+    {
+        const auto begin = Clock::now();
+        for (uint32_t i = 0; i < repeats; ++i)
+            fn();
+        const double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+        return double(bytes) * repeats / seconds / 1.0e9;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Cyber;
+    namespace fs = std::filesystem;
+
+    const size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 256;
+    assert(megabytes >= 1);
+    const size_t size = megabytes << 20;
+
+    std::vector<uint8_t> data(size);
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (uint8_t& byte : data)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        byte = static_cast<uint8_t>(state);
+    }
+
+    // Streaming matches one-shot hashing for any chunking, including empty updates
+    for (AssetHashAlgorithm algorithm : { AssetHashAlgorithm::Fnv1a64, AssetHashAlgorithm::XXH3_64 })
+    {
+        const size_t sample = std::min<size_t>(size, 1u << 20);
+        const uint64_t oneShot = AssetHash::HashContent(data.data(), sample, algorithm);
+        for (size_t chunk : { size_t(1), size_t(7), size_t(240), size_t(4096), size_t(65537), sample })
+        {
+            AssetHasher hasher(algorithm);
+            for (size_t offset = 0; offset < sample; offset += chunk)
+            {
+                hasher.Update(data.data() + offset, std::min(chunk, sample - offset));
+                hasher.Update(nullptr, 0);
+            }
+            assert(hasher.Digest64() == oneShot);
+            if (algorithm == AssetHashAlgorithm::XXH3_64)
+                assert(hasher.Digest128() == AssetHash::HashContent128(data.data(), sample));
+            hasher.Reset();
+            hasher.Update(data.data(), sample);
+            assert(hasher.Digest64() == oneShot);
+        }
+    }
+    assert(AssetHash::HashContent(data.data(), 4096, AssetHashAlgorithm::Fnv1a64) ==
+           AssetHash::HashBytes(data.data(), 4096));
+    assert(AssetHash::HashContent(data.data(), 4096) != AssetHash::HashContent(data.data() + 1, 4096));
+
+    // v1 headers end at the hash algorithm field and always mean FNV-1a
+    AssetFileHeader legacyHeader;
+    legacyHeader.formatVersion = 1;
+    legacyHeader.headerSize = kAssetFileHeaderV1Size;
+    legacyHeader.assetType = AssetType::Texture;
+    legacyHeader.assetGuid = AssetGuid::Create();
+    legacyHeader.contentHashAlgorithm = static_cast<AssetHashAlgorithm>(0xcdcdcdcdu);
+    assert(legacyHeader.IsValid());
+    assert(legacyHeader.ContentHashAlgorithm() == AssetHashAlgorithm::Fnv1a64);
+    AssetFileHeader currentHeader = legacyHeader;
+    currentHeader.formatVersion = kAssetFileFormatVersion;
+    assert(!currentHeader.IsValid());
+    currentHeader.headerSize = sizeof(AssetFileHeader);
+    currentHeader.contentHashAlgorithm = AssetHashAlgorithm::XXH3_64;
+    assert(currentHeader.IsValid());
+    assert(currentHeader.ContentHashAlgorithm() == AssetHashAlgorithm::XXH3_64);
+
+    const fs::path filePath = fs::current_path() / "Saved" / "AssetHashBenchmark" / (AssetGuid::Create().ToString() + ".bin");
+    fs::create_directories(filePath.parent_path());
+    {
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        assert(file.good());
+    }
+
+    const uint32_t repeats = 4;
+    uint64_t sink = 0;
+    const double fnvGBs = gigabytes_per_second(size, 1, [&] { sink ^= AssetHash::HashBytes(data.data(), size); });
+    const double xxh64GBs = gigabytes_per_second(size, repeats, [&] { sink ^= AssetHash::HashContent(data.data(), size); });
+    const double xxh128GBs = gigabytes_per_second(size, repeats, [&] { sink ^= AssetHash::HashContent128(data.data(), size).high; });
+    const double streamGBs = gigabytes_per_second(size, repeats, [&]
+    {
+        AssetHasher hasher;
+        for (size_t offset = 0; offset < size; offset += 64u << 10)
+            hasher.Update(data.data() + offset, std::min<size_t>(64u << 10, size - offset));
+        sink ^= hasher.Digest64();
+    });
+    uint64_t fileHash = 0;
+    const double fileGBs = gigabytes_per_second(size, 1, [&] { assert(AssetHash::HashFile(filePath, fileHash)); });
+    assert(fileHash == AssetHash::HashContent(data.data(), size));
+
+    std::printf("%zu MB buffer\n", megabytes);
+    std::printf("  fnv1a-64 one-shot    %7.2f GB/s\n", fnvGBs);
+    std::printf("  xxh3-64 one-shot     %7.2f GB/s\n", xxh64GBs);
+    std::printf("  xxh3-128 one-shot    %7.2f GB/s\n", xxh128GBs);
+    std::printf("  xxh3-64 64KB chunks  %7.2f GB/s\n", streamGBs);
+    std::printf("  xxh3-64 file (warm)  %7.2f GB/s\n", fileGBs);
+    std::printf("  (sink %016llx)\n", static_cast<unsigned long long>(sink));
+
+    std::error_code ec;
+    fs::remove(filePath, ec);
+    std::cout << "Asset hash benchmark passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,346 @@
+#include "asset/asset_manager.h"
+#include "asset/asset_package.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    void write_file(const fs::path& path, const std::vector<uint8_t>& bytes)
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        assert(file.good());
+    }
+
+    std::vector<uint8_t> make_bytes(size_t size, uint32_t seed)
+    {
+        std::vector<uint8_t> bytes(size);
+        for (size_t i = 0; i < size; ++i)
+            bytes[i] = static_cast<uint8_t>(seed * 13 + i / 8);
+        return bytes;
+    }
+
+    AssetGuid add_asset(AssetRegistry& registry, const fs::path& contentRoot, AssetType type, size_t size,
+                        std::vector<AssetGuid> dependencies = {})
+    {
+        AssetRegistryRecord record;
+        record.guid = AssetGuid::Create();
+        record.type = type;
+        record.assetPath = "Assets/" + record.guid.ToString() + ".asset";
+        record.dependencies = std::move(dependencies);
+        write_file(contentRoot / record.assetPath, make_bytes(size, static_cast<uint32_t>(record.guid.low)));
+        registry.Upsert(record);
+        return record.guid;
+    }
+
+    // Returns the cooked bytes and checks every dependency finished first. A gate lets a test
+    // hold the workers; a simulated latency stands in for slow storage.
+    class BytesLoader final : public IAssetLoader
+    {
+    public:
+        explicit BytesLoader(AssetType type)
+            : m_type(type)
+        {
+        }
+
+        AssetType Type() const override { return m_type; }
+
+        bool Load(const AssetLoadContext& context, std::shared_ptr<void>& outObject, std::string* outError) const override
+        {
+            {
+                std::unique_lock lock(m_mutex);
+                m_gateChanged.wait(lock, [this] { return m_open; });
+                m_order.push_back(context.Record().guid);
+            }
+            const int running = ++m_running;
+            int peak = m_peak.load();
+            while (running > peak && !m_peak.compare_exchange_weak(peak, running))
+            {
+            }
+
+            for (const AssetGuid& dependency : context.Record().dependencies)
+                assert(context.Manager().Find(AssetId(dependency)).IsLoaded());
+            if (m_latency.count() > 0)
+                std::this_thread::sleep_for(m_latency);
+
+            auto bytes = std::make_shared<std::vector<uint8_t>>();
+            const bool read = context.Record().guid != m_failing && context.ReadBytes(*bytes, outError);
+            if (context.Record().guid == m_failing && outError)
+                *outError = "Decode failed.";
+            ++m_loads;
+            --m_running;
+            outObject = bytes;
+            return read;
+        }
+
+        void SetGate(bool open)
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_open = open;
+            }
+            m_gateChanged.notify_all();
+        }
+
+        std::vector<AssetGuid> Order() const
+        {
+            std::lock_guard lock(m_mutex);
+            return m_order;
+        }
+
+        AssetGuid m_failing {};
+        std::chrono::microseconds m_latency { 0 };
+        mutable std::atomic<int> m_loads { 0 };
+        mutable std::atomic<int> m_peak { 0 };
+
+    private:
+        AssetType m_type;
+        mutable std::mutex m_mutex;
+        mutable std::condition_variable m_gateChanged;
+        mutable std::vector<AssetGuid> m_order;
+        mutable std::atomic<int> m_running { 0 };
+        bool m_open = true;
+    };
+
+    void test_dependencies_and_deduplication(const fs::path& root)
+    {
+        AssetRegistry registry;
+        const fs::path contentRoot = root / "Content";
+        const AssetGuid texture = add_asset(registry, contentRoot, AssetType::Texture, 4096);
+        const AssetGuid material = add_asset(registry, contentRoot, AssetType::Material, 64, { texture });
+        const AssetGuid mesh = add_asset(registry, contentRoot, AssetType::Mesh, 8192, { material, texture });
+
+        BytesLoader textures(AssetType::Texture);
+        BytesLoader materials(AssetType::Material);
+        BytesLoader meshes(AssetType::Mesh);
+        AssetManagerSettings settings;
+        settings.contentRoot = contentRoot;
+        settings.workerCount = 4;
+        AssetManager manager(registry, settings);
+        manager.RegisterLoader(textures);
+        manager.RegisterLoader(materials);
+        manager.RegisterLoader(meshes);
+
+        AssetHandle meshHandle = manager.Load(SoftAssetRef(AssetId(mesh), AssetType::Mesh));
+        AssetHandle again = manager.Load(AssetId(mesh));
+        assert(again == meshHandle);
+        manager.Wait(meshHandle);
+        assert(meshHandle.IsLoaded() && meshHandle.Id() == AssetId(mesh));
+        assert(*meshHandle.Get<std::vector<uint8_t>>() == make_bytes(8192, static_cast<uint32_t>(mesh.low)));
+        assert(manager.Find(AssetId(texture)).IsLoaded() && manager.Find(AssetId(material)).IsLoaded());
+        assert(textures.m_loads == 1 && materials.m_loads == 1 && meshes.m_loads == 1);
+
+        // A later request is served from the loaded entry
+        AssetHandle textureHandle = manager.Load(AssetId(texture));
+        assert(textureHandle.IsLoaded() && textures.m_loads == 1);
+        const AssetManagerStats stats = manager.Stats();
+        assert(stats.loaded == 3 && stats.failed == 0 && stats.bytesRead == 4096 + 64 + 8192);
+
+        // The wrong expected type fails the reference without poisoning the asset
+        AssetHandle wrongType = manager.Load(SoftAssetRef(AssetId(texture), AssetType::Mesh));
+        assert(wrongType.State() == AssetLoadState::Failed && !wrongType.Error().empty());
+        assert(manager.Load(AssetId(texture)).IsLoaded());
+
+        // Releasing every handle unloads the mesh and the material only it held; the texture
+        // still has a handle and stays
+        const std::weak_ptr<void> object = meshHandle.Object();
+        meshHandle.Reset();
+        again.Reset();
+        assert(object.expired());
+        assert(!manager.Find(AssetId(mesh)).IsValid() && !manager.Find(AssetId(material)).IsValid());
+        AssetHandle reloaded = manager.Load(AssetId(mesh));
+        manager.Wait(reloaded);
+        assert(reloaded.IsLoaded() && meshes.m_loads == 2 && materials.m_loads == 2 && textures.m_loads == 1);
+    }
+
+    void test_failures(const fs::path& root)
+    {
+        AssetRegistry registry;
+        const fs::path contentRoot = root / "Content";
+        const AssetGuid broken = add_asset(registry, contentRoot, AssetType::Texture, 16);
+        const AssetGuid dependent = add_asset(registry, contentRoot, AssetType::Mesh, 16, { broken });
+        const AssetGuid missingFile = add_asset(registry, contentRoot, AssetType::Texture, 16);
+        fs::remove(contentRoot / registry.Find(missingFile)->assetPath);
+        const AssetGuid noLoader = add_asset(registry, contentRoot, AssetType::Audio, 16);
+
+        // a -> b -> a
+        AssetRegistryRecord a;
+        a.guid = AssetGuid::Create();
+        a.type = AssetType::Mesh;
+        a.assetPath = "Assets/a.asset";
+        AssetRegistryRecord b = a;
+        b.guid = AssetGuid::Create();
+        b.assetPath = "Assets/b.asset";
+        a.dependencies = { b.guid };
+        b.dependencies = { a.guid };
+        registry.Upsert(a);
+        registry.Upsert(b);
+
+        BytesLoader textures(AssetType::Texture);
+        BytesLoader meshes(AssetType::Mesh);
+        textures.m_failing = broken;
+        AssetManagerSettings settings;
+        settings.contentRoot = contentRoot;
+        settings.workerCount = 2;
+        AssetManager manager(registry, settings);
+        manager.RegisterLoader(textures);
+        manager.RegisterLoader(meshes);
+
+        AssetHandle dependentHandle = manager.Load(AssetId(dependent));
+        manager.Wait(dependentHandle);
+        assert(dependentHandle.State() == AssetLoadState::Failed);
+        assert(dependentHandle.Error().find("Decode failed.") != std::string::npos);
+        assert(meshes.m_loads == 0);
+
+        AssetHandle missing = manager.Load(AssetId(missingFile));
+        manager.Wait(missing);
+        assert(missing.State() == AssetLoadState::Failed && missing.Error().find("Failed to open") == 0);
+        assert(manager.Load(AssetId(AssetGuid::Create())).State() == AssetLoadState::Failed);
+        assert(manager.Load(AssetId(noLoader)).State() == AssetLoadState::Failed);
+        AssetHandle cycle = manager.Load(AssetId(a.guid));
+        assert(cycle.State() == AssetLoadState::Failed && cycle.Error().find("cycle") != std::string::npos);
+        manager.WaitIdle();
+        assert(manager.Stats().loaded == 0);
+    }
+
+    void test_priority_and_cancellation(const fs::path& root)
+    {
+        AssetRegistry registry;
+        const fs::path contentRoot = root / "Content";
+        std::vector<AssetGuid> guids;
+        for (uint32_t i = 0; i < 6; ++i)
+            guids.push_back(add_asset(registry, contentRoot, AssetType::Texture, 32));
+
+        BytesLoader textures(AssetType::Texture);
+        AssetManagerSettings settings;
+        settings.contentRoot = contentRoot;
+        settings.workerCount = 1;
+        AssetManager manager(registry, settings);
+        manager.RegisterLoader(textures);
+
+        // Hold the only worker on the first asset while the rest queue up
+        textures.SetGate(false);
+        AssetHandle blocker = manager.Load(AssetId(guids[0]));
+        while (blocker.State() != AssetLoadState::Loading)
+            std::this_thread::yield();
+        AssetHandle low = manager.Load(AssetId(guids[1]), AssetLoadPriority::Low);
+        AssetHandle normal = manager.Load(AssetId(guids[2]));
+        AssetHandle high = manager.Load(AssetId(guids[3]), AssetLoadPriority::High);
+        AssetHandle cancelled = manager.Load(AssetId(guids[4]), AssetLoadPriority::Critical);
+        AssetHandle raised = manager.Load(AssetId(guids[5]), AssetLoadPriority::Low);
+        raised = manager.Load(AssetId(guids[5]), AssetLoadPriority::Critical);
+        cancelled.Reset();
+        textures.SetGate(true);
+        manager.WaitIdle();
+
+        const std::vector<AssetGuid> order = textures.Order();
+        assert((order == std::vector<AssetGuid> { guids[0], guids[5], guids[3], guids[2], guids[1] }));
+        assert(manager.Stats().cancelled == 1 && manager.Stats().loaded == 5);
+        assert(low.IsLoaded() && normal.IsLoaded() && high.IsLoaded() && raised.IsLoaded());
+    }
+
+    void test_packaged_assets(const fs::path& root)
+    {
+        AssetRegistry registry;
+        const fs::path contentRoot = root / "Content";
+        std::vector<AssetGuid> guids;
+        for (uint32_t i = 0; i < 16; ++i)
+            guids.push_back(add_asset(registry, contentRoot, AssetType::Texture, 1000 + i * 5000,
+                                      i > 0 ? std::vector<AssetGuid> { guids.back() } : std::vector<AssetGuid> {}));
+        std::string error;
+        assert(AssetPackager::PackRegistry(registry, contentRoot, root / "Packages", {}, nullptr, &error));
+        fs::remove_all(contentRoot);
+
+        BytesLoader textures(AssetType::Texture);
+        AssetManagerSettings settings;
+        settings.packageDirectory = root / "Packages";
+        AssetManager manager(registry, settings);
+        manager.RegisterLoader(textures);
+        AssetHandle last = manager.Load(AssetId(guids.back()));
+        manager.Wait(last);
+        assert(last.IsLoaded());
+        for (uint32_t i = 0; i < guids.size(); ++i)
+            assert(*manager.Find(AssetId(guids[i])).Get<std::vector<uint8_t>>() ==
+                   make_bytes(1000 + i * 5000, static_cast<uint32_t>(guids[i].low)));
+    }
+
+    // A scene opening hundreds of meshes that each wait on storage, loaded serially and on the pool
+    void benchmark_scene_open(const fs::path& root)
+    {
+        AssetRegistry registry;
+        const fs::path contentRoot = root / "Content";
+        std::vector<AssetGuid> meshes;
+        const AssetGuid sharedTexture = add_asset(registry, contentRoot, AssetType::Texture, 64 << 10);
+        for (uint32_t i = 0; i < 300; ++i)
+            meshes.push_back(add_asset(registry, contentRoot, AssetType::Mesh, 32 << 10, { sharedTexture }));
+
+        const auto open_scene = [&](uint32_t workerCount)
+        {
+            BytesLoader textures(AssetType::Texture);
+            BytesLoader meshLoader(AssetType::Mesh);
+            meshLoader.m_latency = std::chrono::microseconds(500);
+            AssetManagerSettings settings;
+            settings.contentRoot = contentRoot;
+            settings.workerCount = workerCount;
+            AssetManager manager(registry, settings);
+            manager.RegisterLoader(textures);
+            manager.RegisterLoader(meshLoader);
+
+            const auto begin = Clock::now();
+            std::vector<AssetHandle> handles;
+            for (const AssetGuid& mesh : meshes)
+                handles.push_back(manager.Load(AssetId(mesh)));
+            manager.WaitIdle();
+            const double ms = elapsed_ms(begin);
+            for (const AssetHandle& handle : handles)
+                assert(handle.IsLoaded());
+            assert(textures.m_loads == 1 && manager.Stats().deduplicated == meshes.size() - 1);
+            return std::make_pair(ms, meshLoader.m_peak.load());
+        };
+        const auto [serialMs, serialPeak] = open_scene(1);
+        const auto [poolMs, poolPeak] = open_scene(8);
+        assert(serialPeak == 1 && poolPeak > 1);
+        std::printf("%zu meshes with 0.5 ms storage latency: 1 worker %.2f ms, 8 workers %.2f ms (%d loads in flight)\n",
+                    meshes.size(), serialMs, poolMs, poolPeak);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    const fs::path root =
+        fs::current_path() / "Saved" / "AssetManagerTests" / AssetGuid::Create().ToString();
+    fs::create_directories(root);
+
+    test_dependencies_and_deduplication(root / "Dependencies");
+    test_failures(root / "Failures");
+    test_priority_and_cancellation(root / "Priority");
+    test_packaged_assets(root / "Packages");
+    benchmark_scene_open(root / "Benchmark");
+
+    fs::remove_all(root);
+    std::cout << "Asset manager tests passed" << std::endl;
+    return 0;
+}
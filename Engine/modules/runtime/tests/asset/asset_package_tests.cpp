@@ -0,0 +1,296 @@
+#include "asset/asset_cook_scheduler.h"
+#include "asset/asset_package.h"
+#include "asset/cooked_mesh.h"
+#include "asset/mesh_importer.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    void write_file(const fs::path& path, const void* data, size_t size)
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        assert(file.good());
+    }
+
+    // Sized single read, the way loose cooked assets are loaded today
+    std::vector<uint8_t> read_file(const fs::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::vector<uint8_t> bytes(static_cast<size_t>(fs::file_size(path)));
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        assert(file.good() || bytes.empty());
+        return bytes;
+    }
+
+    // Half structured, half noise, so some blocks compress and some are stored
+    std::vector<uint8_t> make_asset_bytes(size_t size, uint32_t seed)
+    {
+        std::vector<uint8_t> bytes(size);
+        uint32_t state = seed * 2654435761u + 1;
+        for (size_t i = 0; i < size; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            bytes[i] = seed % 2 == 0 ? static_cast<uint8_t>(i / 64 + seed) : static_cast<uint8_t>(state >> 24);
+        }
+        return bytes;
+    }
+
+    void write_triangle_gltf(const fs::path& gltfPath)
+    {
+        const float positions[] = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+        const uint32_t indices[] = { 0, 1, 2 };
+        std::vector<uint8_t> buffer(sizeof(positions) + sizeof(indices));
+        std::memcpy(buffer.data(), positions, sizeof(positions));
+        std::memcpy(buffer.data() + sizeof(positions), indices, sizeof(indices));
+        write_file(gltfPath.parent_path() / (gltfPath.stem().string() + ".bin"), buffer.data(), buffer.size());
+
+        const std::string gltf =
+            R"({"asset":{"version":"2.0"},"buffers":[{"byteLength":48,"uri":")" + gltfPath.stem().string() +
+            R"(.bin"}],"bufferViews":[{"buffer":0,"byteOffset":0,"byteLength":36,"target":34962},)"
+            R"({"buffer":0,"byteOffset":36,"byteLength":12,"target":34963}],"accessors":[)"
+            R"({"bufferView":0,"componentType":5126,"count":3,"type":"VEC3","min":[0,0,0],"max":[1,1,0]},)"
+            R"({"bufferView":1,"componentType":5125,"count":3,"type":"SCALAR"}],)"
+            R"("meshes":[{"primitives":[{"attributes":{"POSITION":0},"indices":1}]}],"nodes":[{"mesh":0}],"scenes":[{"nodes":[0]}],"scene":0})";
+        write_file(gltfPath, gltf.data(), gltf.size());
+    }
+
+    struct PackagedProject
+    {
+        fs::path contentRoot;
+        AssetRegistry registry;
+        std::vector<AssetGuid> guids;
+        AssetGuid meshGuid {};
+    };
+
+    void make_project(const fs::path& root, size_t assetCount, PackagedProject& project)
+    {
+        project.contentRoot = root / "Content";
+        for (size_t i = 0; i < assetCount; ++i)
+        {
+            // Sizes from a few bytes to several blocks, in two chunks
+            const size_t size = i % 7 == 0 ? 300u << 10 : 1 + (i * 7919) % (40u << 10);
+            AssetRegistryRecord record;
+            record.guid = AssetGuid::Create();
+            record.type = AssetType::Texture;
+            record.assetPath = "Assets/blob_" + std::to_string(i) + ".textureasset";
+            record.chunkId = static_cast<uint32_t>(i % 2);
+            if (i > 0)
+                record.dependencies.push_back(project.guids.back());
+            const std::vector<uint8_t> bytes = make_asset_bytes(size, static_cast<uint32_t>(i));
+            write_file(project.contentRoot / record.assetPath, bytes.data(), bytes.size());
+            project.guids.push_back(record.guid);
+            project.registry.Upsert(std::move(record));
+        }
+
+        MeshImporter meshImporter;
+        AssetCookScheduler scheduler;
+        scheduler.RegisterImporter(meshImporter);
+        AssetCookRequest request;
+        request.importerType = AssetType::Mesh;
+        request.import.sourcePath = root / "Source" / "triangle.gltf";
+        request.import.destinationPath = project.contentRoot / "Assets" / "triangle.meshasset";
+        request.import.contentRoot = project.contentRoot;
+        write_triangle_gltf(request.import.sourcePath);
+        const std::vector<AssetCookResult> results = scheduler.Cook({ request }, project.registry);
+        assert(results.size() == 1 && results[0].status == AssetCookStatus::Cooked);
+        project.meshGuid = results[0].importResult.registryRecord.guid;
+        project.guids.push_back(project.meshGuid);
+    }
+
+    void test_pack_and_read(const fs::path& root, PackagedProject& project, std::vector<fs::path>& packages)
+    {
+        std::string error;
+        AssetPackageSettings settings;
+        settings.blockSize = 64u << 10;
+        assert(AssetPackager::PackRegistry(project.registry, project.contentRoot, root / "Packages", settings, &packages,
+                                           &error));
+        assert(packages.size() == 2);
+        assert(packages[0].filename() == "chunk_0.assetpack" && packages[1].filename() == "chunk_1.assetpack");
+
+        std::vector<AssetPackage> opened(packages.size());
+        for (size_t i = 0; i < packages.size(); ++i)
+        {
+            assert(opened[i].Open(packages[i], &error));
+            assert(opened[i].Header().chunkId == i && opened[i].Header().blockSize == settings.blockSize);
+        }
+
+        // Every record names its package, and that package holds the loose bytes and dependencies
+        for (const AssetGuid& guid : project.guids)
+        {
+            const AssetRegistryRecord* record = project.registry.Find(guid);
+            assert(record && record->packageName == AssetPackager::PackageName(record->chunkId));
+            const AssetPackage& package = opened[record->chunkId];
+            const AssetPackageEntry* entry = package.Find(guid);
+            assert(entry && entry->type == record->type);
+            assert(entry->offset % 16 == 0);
+            const std::span<const AssetGuid> dependencies = package.Dependencies(*entry);
+            assert(std::vector<AssetGuid>(dependencies.begin(), dependencies.end()) == record->dependencies);
+
+            std::vector<uint8_t> bytes;
+            assert(package.Read(guid, bytes, &error));
+            assert(bytes == read_file(project.contentRoot / record->assetPath));
+            assert(!opened[1 - record->chunkId].Find(guid));
+        }
+        assert(!opened[0].Find(AssetGuid::Create()));
+        std::vector<uint8_t> bytes;
+        assert(!opened[0].Read(AssetGuid::Create(), bytes, &error) && !error.empty());
+
+        // A batch spanning shared blocks decodes each block once into every destination
+        const AssetPackage& chunk0 = opened[0];
+        std::vector<std::vector<uint8_t>> destinations(chunk0.Entries().size());
+        std::vector<AssetPackageReadRequest> requests;
+        for (size_t i = 0; i < destinations.size(); ++i)
+        {
+            destinations[i].resize(static_cast<size_t>(chunk0.Entries()[i].size));
+            requests.push_back({ chunk0.Entries()[i].guid, destinations[i] });
+        }
+        assert(chunk0.Read(requests, 4, &error));
+        for (size_t i = 0; i < destinations.size(); ++i)
+            assert(destinations[i] == read_file(project.contentRoot / project.registry.Find(requests[i].guid)->assetPath));
+        destinations[0].push_back(0);
+        requests[0].destination = destinations[0];
+        assert(!chunk0.Read(requests, 1, &error));
+
+        // Packaged meshes can be viewed in place
+        const AssetRegistryRecord* meshRecord = project.registry.Find(project.meshGuid);
+        assert(opened[meshRecord->chunkId].Read(project.meshGuid, bytes, &error));
+        CookedMeshView view;
+        assert(view.Open(bytes, &error));
+        assert(view.Indices().size() == 3 && view.Meshes().size() == 1);
+    }
+
+    void test_corruption_is_rejected(const fs::path& root, const fs::path& packagePath)
+    {
+        std::vector<uint8_t> bytes = read_file(packagePath);
+        AssetPackageHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+
+        const fs::path corruptIndex = root / "corrupt_index.assetpack";
+        bytes[static_cast<size_t>(header.entriesOffset) + 3] ^= 0x10;
+        write_file(corruptIndex, bytes.data(), bytes.size());
+        AssetPackage package;
+        std::string error;
+        assert(!package.Open(corruptIndex, &error) && !error.empty());
+        assert(!package.IsOpen());
+
+        const fs::path truncated = root / "truncated.assetpack";
+        write_file(truncated, bytes.data(), static_cast<size_t>(header.entriesOffset));
+        assert(!package.Open(truncated, &error));
+
+        // Flipping a compressed byte fails decompression instead of returning damaged data
+        bytes = read_file(packagePath);
+        assert(package.Open(packagePath, &error));
+        const AssetPackageBlock* compressed = nullptr;
+        for (size_t i = 0; i < package.Header().blockCount && !compressed; ++i)
+        {
+            const AssetPackageBlock* blocks = reinterpret_cast<const AssetPackageBlock*>(bytes.data() + header.blocksOffset);
+            if (blocks[i].compressedSize < blocks[i].uncompressedSize)
+                compressed = &blocks[i];
+        }
+        assert(compressed);
+        std::memset(bytes.data() + compressed->fileOffset, 0xff, compressed->compressedSize / 2);
+        const fs::path corruptBlock = root / "corrupt_block.assetpack";
+        write_file(corruptBlock, bytes.data(), bytes.size());
+        assert(package.Open(corruptBlock, &error));
+        bool failed = false;
+        for (const AssetPackageEntry& entry : package.Entries())
+        {
+            std::vector<uint8_t> read;
+            failed |= !package.Read(entry.guid, read, &error);
+        }
+        assert(failed);
+    }
+
+    void benchmark_loose_vs_package(const PackagedProject& project, const std::vector<fs::path>& packages)
+    {
+        std::vector<const AssetRegistryRecord*> records;
+        uint64_t totalBytes = 0;
+        for (const AssetRegistryRecord& record : project.registry.Records())
+        {
+            records.push_back(&record);
+            totalBytes += fs::file_size(project.contentRoot / record.assetPath);
+        }
+
+        auto begin = Clock::now();
+        std::vector<std::vector<uint8_t>> loose;
+        for (const AssetRegistryRecord* record : records)
+            loose.push_back(read_file(project.contentRoot / record->assetPath));
+        const double looseMs = elapsed_ms(begin);
+
+        const auto read_packages = [&](uint32_t threadCount)
+        {
+            std::vector<AssetPackage> opened(packages.size());
+            std::vector<std::vector<uint8_t>> destinations(records.size());
+            std::vector<std::vector<AssetPackageReadRequest>> requests(packages.size());
+            for (size_t i = 0; i < packages.size(); ++i)
+                assert(opened[i].Open(packages[i]));
+            for (size_t i = 0; i < records.size(); ++i)
+            {
+                const AssetPackageEntry* entry = opened[records[i]->chunkId].Find(records[i]->guid);
+                destinations[i].resize(static_cast<size_t>(entry->size));
+                requests[records[i]->chunkId].push_back({ records[i]->guid, destinations[i] });
+            }
+            for (size_t i = 0; i < packages.size(); ++i)
+                assert(opened[i].Read(requests[i], threadCount));
+            return destinations;
+        };
+        begin = Clock::now();
+        const std::vector<std::vector<uint8_t>> packaged = read_packages(1);
+        const double packageMs = elapsed_ms(begin);
+        assert(packaged == loose);
+        const uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+        begin = Clock::now();
+        const std::vector<std::vector<uint8_t>> threaded = read_packages(threads);
+        const double threadedMs = elapsed_ms(begin);
+        assert(threaded == loose);
+
+        uint64_t packagedBytes = 0;
+        for (const fs::path& package : packages)
+            packagedBytes += fs::file_size(package);
+        std::printf("%zu assets, %.2f MiB loose, %.2f MiB packaged: loose reads %.2f ms, package 1 thread %.2f ms, "
+                    "%u threads %.2f ms\n",
+                    records.size(), double(totalBytes) / (1 << 20), double(packagedBytes) / (1 << 20), looseMs,
+                    packageMs, threads, threadedMs);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    const fs::path root =
+        fs::current_path() / "Saved" / "AssetPackageTests" / AssetGuid::Create().ToString();
+    fs::create_directories(root);
+
+    PackagedProject project;
+    make_project(root, 600, project);
+    std::vector<fs::path> packages;
+    test_pack_and_read(root, project, packages);
+    test_corruption_is_rejected(root, packages[0]);
+    benchmark_loose_vs_package(project, packages);
+
+    fs::remove_all(root);
+    std::cout << "Asset package tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "asset/asset_registry.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    AssetRegistryRecord make_record(uint32_t index)
+    {
+        AssetRegistryRecord record;
+        record.guid = AssetGuid(0x1000000000000000ull + index, 0xabcdef0000000000ull ^ index);
+        record.type = index % 3 == 0 ? AssetType::Mesh : AssetType::Texture;
+        record.assetPath = "Assets/Folder" + std::to_string(index % 97) + "/asset_" + std::to_string(index) + ".asset";
+        record.displayName = "asset_" + std::to_string(index);
+        record.sourcePath = "Source\\Folder" + std::to_string(index % 97) + "\\asset_" + std::to_string(index) + ".png";
+        record.sourceHash = index * 2654435761ull;
+        record.importerVersion = 1;
+        record.assetFormatVersion = 1;
+        return record;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Cyber;
+
+    const uint32_t recordCount = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 100000;
+    assert(recordCount >= 16);
+
+    std::vector<AssetRegistryRecord> records;
+    records.reserve(recordCount);
+    for (uint32_t i = 0; i < recordCount; ++i)
+        records.push_back(make_record(i));
+
+    AssetRegistry registry;
+    auto begin = Clock::now();
+    registry.UpsertBatch(records);
+    const double batchMs = elapsed_ms(begin);
+    assert(registry.Records().size() == recordCount);
+
+    // Re-importing every asset one at a time, as a full editor reimport does
+    begin = Clock::now();
+    for (const AssetRegistryRecord& record : records)
+        registry.Upsert(record);
+    const double upsertMs = elapsed_ms(begin);
+    assert(registry.Records().size() == recordCount);
+
+    begin = Clock::now();
+    for (const AssetRegistryRecord& record : records)
+        assert(registry.Find(record.guid) != nullptr);
+    const double guidMs = elapsed_ms(begin);
+
+    begin = Clock::now();
+    for (const AssetRegistryRecord& record : records)
+        assert(registry.FindByAssetPath(record.assetPath) != nullptr);
+    const double assetPathMs = elapsed_ms(begin);
+
+    // Source paths are stored with backslashes, so every query pays for normalization
+    begin = Clock::now();
+    for (const AssetRegistryRecord& record : records)
+        assert(registry.FindBySourcePath(record.sourcePath) != nullptr);
+    const double sourcePathMs = elapsed_ms(begin);
+
+    // Semantics: replace by path keeps one record per path, removal keeps indices consistent
+    AssetRegistryRecord moved = make_record(7);
+    moved.guid = AssetGuid(42, 42);
+    registry.Upsert(moved);
+    assert(registry.Records().size() == recordCount);
+    assert(registry.Find(records[7].guid) == nullptr);
+    assert(registry.FindByAssetPath(moved.assetPath)->guid == moved.guid);
+
+    assert(registry.Remove(records[0].guid));
+    assert(!registry.Remove(records[0].guid));
+    assert(registry.Find(records[0].guid) == nullptr);
+    assert(registry.FindBySourcePath("Source/Folder0/asset_0.png") == nullptr);
+    const AssetRegistryRecord* last = registry.Find(records[recordCount - 1].guid);
+    assert(last != nullptr && last->assetPath == AssetRegistry::NormalizePath(records[recordCount - 1].assetPath));
+    assert(registry.FindBySourcePath(records[recordCount - 1].sourcePath) == last);
+
+    const double perRecord = 1.0e6 / double(recordCount);
+    std::printf("%u records\n", recordCount);
+    std::printf("  batch upsert     %9.2f ms  (%7.3f us/record)\n", batchMs, batchMs * perRecord / 1000.0);
+    std::printf("  single upsert    %9.2f ms  (%7.3f us/record)\n", upsertMs, upsertMs * perRecord / 1000.0);
+    std::printf("  find guid        %9.2f ms  (%7.3f us/query)\n", guidMs, guidMs * perRecord / 1000.0);
+    std::printf("  find asset path  %9.2f ms  (%7.3f us/query)\n", assetPathMs, assetPathMs * perRecord / 1000.0);
+    std::printf("  find source path %9.2f ms  (%7.3f us/query)\n", sourcePathMs, sourcePathMs * perRecord / 1000.0);
+
+    std::cout << "Asset registry benchmark passed" << std::endl;
+    return 0;
+}
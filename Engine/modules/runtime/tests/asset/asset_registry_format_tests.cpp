@@ -0,0 +1,150 @@
+#include "asset/asset_database.h"
+#include "asset/asset_registry_binary.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    AssetRegistryRecord make_record(uint32_t index)
+    {
+        AssetRegistryRecord record;
+        record.guid = AssetGuid(0x2000000000000000ull + index, 0x5eed000000000000ull ^ (index * 7919ull));
+        record.type = index % 4 == 0 ? AssetType::Mesh : AssetType::Texture;
+        record.assetPath = "Assets/Folder" + std::to_string(index % 211) + "/asset_" + std::to_string(index) + ".asset";
+        record.displayName = "asset_" + std::to_string(index);
+        record.sourcePath = "Source/Folder" + std::to_string(index % 211) + "/asset_" + std::to_string(index) + ".png";
+        record.sourceHash = index * 2654435761ull;
+        record.editorAssetHash = record.sourceHash ^ 0xffull;
+        record.importerVersion = 2;
+        record.assetFormatVersion = 1;
+        record.packageName = index % 2 == 0 ? "Core" : "";
+        record.chunkId = index % 5;
+        if (index > 0)
+            record.dependencies.push_back(AssetGuid(0x2000000000000000ull + index - 1, 0x5eed000000000000ull ^ ((index - 1) * 7919ull)));
+        return record;
+    }
+
+    bool same_record(const AssetRegistryRecord& lhs, const AssetRegistryRecord& rhs)
+    {
+        return lhs.guid == rhs.guid && lhs.type == rhs.type && lhs.assetPath == rhs.assetPath &&
+               lhs.displayName == rhs.displayName && lhs.sourcePath == rhs.sourcePath &&
+               lhs.sourceHash == rhs.sourceHash && lhs.editorAssetHash == rhs.editorAssetHash &&
+               lhs.cookedAssetHash == rhs.cookedAssetHash && lhs.importerVersion == rhs.importerVersion &&
+               lhs.assetFormatVersion == rhs.assetFormatVersion && lhs.dependencies == rhs.dependencies &&
+               lhs.thumbnailPath == rhs.thumbnailPath && lhs.packageName == rhs.packageName &&
+               lhs.chunkId == rhs.chunkId;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Cyber;
+    namespace fs = std::filesystem;
+
+    const uint32_t recordCount = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 50000;
+    assert(recordCount >= 16);
+
+    const fs::path contentRoot =
+        fs::current_path() / "Saved" / "AssetRegistryFormatTests" / AssetGuid::Create().ToString();
+
+    AssetDatabase database(contentRoot);
+    std::vector<AssetRegistryRecord> records;
+    records.reserve(recordCount);
+    for (uint32_t i = 0; i < recordCount; ++i)
+        records.push_back(make_record(i));
+    database.Registry().UpsertBatch(records);
+
+    auto begin = Clock::now();
+    assert(database.Registry().Save(database.RegistryPath()));
+    const double jsonSaveMs = elapsed_ms(begin);
+
+    begin = Clock::now();
+    assert(database.Registry().SaveBinary(database.BinaryRegistryPath()));
+    const double binarySaveMs = elapsed_ms(begin);
+
+    AssetRegistry fromJson;
+    begin = Clock::now();
+    assert(fromJson.Load(database.RegistryPath()));
+    const double jsonLoadMs = elapsed_ms(begin);
+
+    AssetRegistry fromBinary;
+    begin = Clock::now();
+    assert(fromBinary.LoadBinary(database.BinaryRegistryPath()));
+    const double binaryLoadMs = elapsed_ms(begin);
+
+    AssetRegistryBinaryView view;
+    begin = Clock::now();
+    assert(view.Open(database.BinaryRegistryPath()));
+    const double viewOpenMs = elapsed_ms(begin);
+
+    assert(fromJson.Records().size() == recordCount);
+    assert(fromBinary.Records().size() == recordCount);
+    assert(view.Records().size() == recordCount);
+    for (const AssetRegistryRecord& record : records)
+    {
+        const AssetRegistryRecord* loaded = fromBinary.Find(record.guid);
+        assert(loaded != nullptr && same_record(*loaded, record));
+        assert(same_record(*fromJson.Find(record.guid), record));
+    }
+
+    begin = Clock::now();
+    for (const AssetRegistryRecord& record : records)
+    {
+        const AssetRegistryBinaryRecord* byGuid = view.Find(record.guid);
+        const AssetRegistryBinaryRecord* byPath = view.FindByAssetPath(record.assetPath);
+        assert(byGuid != nullptr && byGuid == byPath);
+    }
+    const double viewQueryMs = elapsed_ms(begin);
+    assert(same_record(view.ToRecord(*view.Find(records[3].guid)), records[3]));
+    assert(view.FindByAssetPath("Assets\\Folder3\\asset_3.asset") == view.Find(records[3].guid));
+    assert(view.FindByAssetPath("Assets/missing.asset") == nullptr);
+    view.Close();
+
+    // AssetDatabase migrates a JSON-only registry and falls back to JSON when the binary is unusable
+    std::error_code ec;
+    fs::remove(database.BinaryRegistryPath(), ec);
+    AssetDatabase migrated(contentRoot);
+    assert(migrated.Load());
+    assert(migrated.Registry().Records().size() == recordCount);
+    assert(fs::exists(migrated.BinaryRegistryPath()));
+
+    {
+        std::ofstream corrupt(database.BinaryRegistryPath(), std::ios::binary | std::ios::trunc);
+        corrupt << "not a registry";
+    }
+    fs::last_write_time(database.RegistryPath(), fs::file_time_type::clock::now() - std::chrono::hours(1));
+    AssetDatabase recovered(contentRoot);
+    assert(recovered.Load());
+    assert(recovered.Registry().Records().size() == recordCount);
+
+    recovered.Registry().Upsert(make_record(recordCount));
+    assert(recovered.Save());
+    AssetDatabase reloaded(contentRoot);
+    assert(reloaded.Load());
+    assert(reloaded.Registry().Records().size() == recordCount + 1);
+
+    std::printf("%u records\n", recordCount);
+    std::printf("  json   save %9.2f ms  load %9.2f ms\n", jsonSaveMs, jsonLoadMs);
+    std::printf("  binary save %9.2f ms  load %9.2f ms\n", binarySaveMs, binaryLoadMs);
+    std::printf("  mapped open %9.2f ms  %u guid+path queries %9.2f ms\n", viewOpenMs, recordCount, viewQueryMs);
+
+    fs::remove_all(contentRoot, ec);
+    std::cout << "Asset registry format tests passed" << std::endl;
+    return 0;
+}
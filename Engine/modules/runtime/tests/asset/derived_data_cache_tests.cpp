@@ -0,0 +1,344 @@
+#include "asset/asset_cook_scheduler.h"
+#include "asset/derived_data_cache.h"
+#include "asset/mesh_importer.h"
+#include "asset/texture_importer.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    void write_file(const fs::path& path, const void* data, size_t size)
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        assert(file.good());
+    }
+
+    std::vector<uint8_t> read_file(const fs::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    size_t count_files(const fs::path& root, const char* extension)
+    {
+        size_t count = 0;
+        for (const auto& entry : fs::recursive_directory_iterator(root))
+            count += entry.path().extension() == extension ? 1 : 0;
+        return count;
+    }
+
+    DerivedDataKey make_key(uint64_t contentHash)
+    {
+        DerivedDataKey key;
+        key.kind = kDerivedTextureMipChain;
+        key.assetGuid = AssetGuid(1, 2);
+        key.contentHash = contentHash;
+        key.cookerVersion = 1;
+        return key;
+    }
+
+    std::vector<uint8_t> make_payload(size_t size, uint8_t seed)
+    {
+        std::vector<uint8_t> payload(size);
+        for (size_t i = 0; i < size; ++i)
+            payload[i] = static_cast<uint8_t>(seed + i * 31);
+        return payload;
+    }
+
+    void test_keys_cover_every_field()
+    {
+        const DerivedDataKey base = make_key(7);
+        std::vector<DerivedDataKey> variants(7, base);
+        variants[0].kind = kDerivedOptimizedMesh;
+        variants[1].platformTag = kWindowsD3D12AssetPlatform;
+        variants[2].assetGuid = AssetGuid(1, 3);
+        variants[3].contentHash = 8;
+        variants[4].settingsHash = 1;
+        variants[5].dependencyHash = 1;
+        variants[6].cookerVersion = 2;
+        for (const DerivedDataKey& variant : variants)
+            assert(variant.Digest() != base.Digest());
+        assert(make_key(7).Digest() == base.Digest());
+    }
+
+    void test_round_trip_and_integrity(const fs::path& root)
+    {
+        DerivedDataCache cache;
+        DerivedDataCacheSettings settings;
+        settings.localPath = root;
+        assert(cache.Open(settings));
+
+        const std::vector<uint8_t> payload = make_payload(4096, 1);
+        std::vector<uint8_t> read;
+        assert(!cache.Get(make_key(1), read));
+        assert(cache.Put(make_key(1), payload));
+        assert(cache.Get(make_key(1), read) && read == payload);
+        assert(cache.Put(make_key(2), {}));
+        assert(cache.Get(make_key(2), read) && read.empty());
+        assert(count_files(root, ".tmp") == 0);
+
+        // A flipped payload byte fails the hash check; the entry is dropped and reads as a miss
+        const fs::path path = DerivedDataCache::EntryPath(root, make_key(1).Digest());
+        std::vector<uint8_t> bytes = read_file(path);
+        bytes[bytes.size() / 2] ^= 0x40;
+        write_file(path, bytes.data(), bytes.size());
+        assert(!cache.Get(make_key(1), read));
+        assert(!fs::exists(path));
+
+        // An entry copied under another key's name does not satisfy that key
+        assert(cache.Put(make_key(3), payload));
+        const fs::path otherPath = DerivedDataCache::EntryPath(root, make_key(4).Digest());
+        fs::create_directories(otherPath.parent_path());
+        fs::copy_file(DerivedDataCache::EntryPath(root, make_key(3).Digest()), otherPath);
+        assert(!cache.Get(make_key(4), read));
+
+        const DerivedDataCacheStats stats = cache.Stats();
+        assert(stats.localHits == 2 && stats.misses == 3 && stats.corrupt == 2 && stats.puts == 3);
+    }
+
+    void test_lru_eviction(const fs::path& root)
+    {
+        constexpr size_t kPayloadSize = 1000;
+        DerivedDataCache cache;
+        DerivedDataCacheSettings settings;
+        settings.localPath = root;
+        settings.maxLocalBytes = 0;
+        assert(cache.Open(settings));
+        assert(cache.Put(make_key(1), make_payload(kPayloadSize, 1)));
+        const uint64_t entrySize = cache.LocalSize();
+        assert(entrySize > kPayloadSize);
+
+        // Room for three and a half entries; trimming stops a tenth below the cap
+        settings.maxLocalBytes = entrySize * 7 / 2;
+        assert(cache.Open(settings));
+        for (uint64_t key : { 2u, 3u })
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            assert(cache.Put(make_key(key), make_payload(kPayloadSize, static_cast<uint8_t>(key))));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        std::vector<uint8_t> read;
+        assert(cache.Get(make_key(1), read));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        assert(cache.Put(make_key(4), make_payload(kPayloadSize, 4)));
+
+        // Key 2 was used least recently
+        assert(cache.Stats().evicted == 1);
+        assert(cache.LocalSize() == entrySize * 3);
+        assert(!fs::exists(DerivedDataCache::EntryPath(root, make_key(2).Digest())));
+        for (uint64_t key : { 1u, 3u, 4u })
+            assert(fs::exists(DerivedDataCache::EntryPath(root, make_key(key).Digest())));
+
+        // Recency survives a reopen: key 3 is now the oldest
+        DerivedDataCache reopened;
+        assert(reopened.Open(settings));
+        assert(reopened.LocalSize() == entrySize * 3);
+        assert(reopened.Get(make_key(4), read) && reopened.Get(make_key(1), read));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        assert(reopened.Put(make_key(5), make_payload(kPayloadSize, 5)));
+        assert(!fs::exists(DerivedDataCache::EntryPath(root, make_key(3).Digest())));
+        assert(reopened.LocalSize() <= settings.maxLocalBytes);
+    }
+
+    void test_shared_store(const fs::path& root)
+    {
+        DerivedDataCacheSettings agentA;
+        agentA.localPath = root / "AgentA";
+        agentA.sharedPath = root / "Shared";
+        DerivedDataCacheSettings agentB = agentA;
+        agentB.localPath = root / "AgentB";
+        DerivedDataCacheSettings readOnly = agentA;
+        readOnly.localPath = root / "ReadOnly";
+        readOnly.writeShared = false;
+
+        DerivedDataCache first;
+        DerivedDataCache second;
+        DerivedDataCache third;
+        assert(first.Open(agentA) && second.Open(agentB) && third.Open(readOnly));
+
+        const std::vector<uint8_t> payload = make_payload(512, 9);
+        assert(first.Put(make_key(1), payload));
+        std::vector<uint8_t> read;
+        assert(second.Get(make_key(1), read) && read == payload);
+        assert(second.Get(make_key(1), read) && read == payload);
+        assert(second.Stats().sharedHits == 1 && second.Stats().localHits == 1);
+        assert(fs::exists(DerivedDataCache::EntryPath(agentB.localPath, make_key(1).Digest())));
+
+        assert(third.Put(make_key(2), payload));
+        assert(!fs::exists(DerivedDataCache::EntryPath(agentA.sharedPath, make_key(2).Digest())));
+        assert(!first.Get(make_key(2), read));
+    }
+
+    // size x size quads, positions in an external buffer so the DDC key must follow its contents
+    void write_grid_gltf(const fs::path& gltfPath, uint32_t size, float height)
+    {
+        std::vector<float> positions;
+        for (uint32_t y = 0; y <= size; ++y)
+            for (uint32_t x = 0; x <= size; ++x)
+                positions.insert(positions.end(), { float(x), height, float(y) });
+        std::vector<uint32_t> indices;
+        for (uint32_t y = 0; y < size; ++y)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                const uint32_t v = y * (size + 1) + x;
+                indices.insert(indices.end(), { v, v + size + 1, v + 1, v + 1, v + size + 1, v + size + 2 });
+            }
+        }
+
+        std::vector<uint8_t> buffer(positions.size() * sizeof(float) + indices.size() * sizeof(uint32_t));
+        std::memcpy(buffer.data(), positions.data(), positions.size() * sizeof(float));
+        std::memcpy(buffer.data() + positions.size() * sizeof(float), indices.data(), indices.size() * sizeof(uint32_t));
+        write_file(gltfPath.parent_path() / (gltfPath.stem().string() + ".bin"), buffer.data(), buffer.size());
+
+        const size_t positionBytes = positions.size() * sizeof(float);
+        const std::string gltf =
+            R"({"asset":{"version":"2.0"},"buffers":[{"byteLength":)" + std::to_string(buffer.size()) +
+            R"(,"uri":")" + gltfPath.stem().string() + R"(.bin"}],"bufferViews":[{"buffer":0,"byteOffset":0,"byteLength":)" +
+            std::to_string(positionBytes) + R"(,"target":34962},{"buffer":0,"byteOffset":)" + std::to_string(positionBytes) +
+            R"(,"byteLength":)" + std::to_string(indices.size() * sizeof(uint32_t)) +
+            R"(,"target":34963}],"accessors":[{"bufferView":0,"componentType":5126,"count":)" +
+            std::to_string(positions.size() / 3) + R"(,"type":"VEC3","min":[0,)" + std::to_string(height) + R"(,0],"max":[)" +
+            std::to_string(size) + "," + std::to_string(height) + "," + std::to_string(size) +
+            R"(]},{"bufferView":1,"componentType":5125,"count":)" + std::to_string(indices.size()) +
+            R"(,"type":"SCALAR"}],"meshes":[{"primitives":[{"attributes":{"POSITION":0},"indices":1}]}],"nodes":[{"mesh":0}],"scenes":[{"nodes":[0]}],"scene":0})";
+        write_file(gltfPath, gltf.data(), gltf.size());
+    }
+
+    // A forced recook of an unchanged project is served entirely from the DDC and writes the same assets
+    void test_cook_through_ddc(const fs::path& root, uint32_t gridSize)
+    {
+        // 4x4 opaque RGBA8 checker
+        const std::vector<uint8_t> pngBytes {
+            0x89u, 0x50u, 0x4eu, 0x47u, 0x0du, 0x0au, 0x1au, 0x0au,
+            0x00u, 0x00u, 0x00u, 0x0du, 0x49u, 0x48u, 0x44u, 0x52u,
+            0x00u, 0x00u, 0x00u, 0x04u, 0x00u, 0x00u, 0x00u, 0x04u,
+            0x08u, 0x06u, 0x00u, 0x00u, 0x00u, 0xa9u, 0xf1u, 0x9eu,
+            0x7eu, 0x00u, 0x00u, 0x00u, 0x30u, 0x49u, 0x44u, 0x41u,
+            0x54u, 0x78u, 0xdau, 0x15u, 0xc8u, 0x41u, 0x11u, 0x00u,
+            0x30u, 0x10u, 0xc2u, 0x40u, 0xa4u, 0x9cu, 0x14u, 0xa4u,
+            0x21u, 0x0du, 0x67u, 0x29u, 0x9du, 0x4cu, 0x3eu, 0x2bu,
+            0x24u, 0xb0u, 0xb8u, 0xecu, 0x8au, 0xe5u, 0x81u, 0x07u,
+            0xbbu, 0x46u, 0xa7u, 0x70u, 0x0eu, 0x64u, 0x37u, 0x1fu,
+            0x3au, 0xe8u, 0x60u, 0xb7u, 0x3cu, 0x73u, 0xdcu, 0x24u,
+            0xe9u, 0x25u, 0x54u, 0x60u, 0xfau, 0x00u, 0x00u, 0x00u,
+            0x00u, 0x49u, 0x45u, 0x4eu, 0x44u, 0xaeu, 0x42u, 0x60u,
+            0x82u
+        };
+        const fs::path contentRoot = root / "Content";
+        std::vector<AssetCookRequest> requests;
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            const bool isMesh = i % 4 == 3;
+            const std::string name = (isMesh ? "grid_" : "texture_") + std::to_string(i);
+            AssetCookRequest request;
+            request.importerType = isMesh ? AssetType::Mesh : AssetType::Texture;
+            request.import.sourcePath = root / "Source" / (name + (isMesh ? ".gltf" : ".png"));
+            request.import.destinationPath = contentRoot / "Assets" / (name + (isMesh ? ".meshasset" : ".textureasset"));
+            request.import.contentRoot = contentRoot;
+            if (isMesh)
+                write_grid_gltf(request.import.sourcePath, gridSize, float(i));
+            else
+                write_file(request.import.sourcePath, pngBytes.data(), pngBytes.size());
+            requests.push_back(request);
+        }
+
+        TextureImporter textureImporter;
+        MeshImporter meshImporter;
+        AssetCookScheduler scheduler;
+        scheduler.RegisterImporter(textureImporter);
+        scheduler.RegisterImporter(meshImporter);
+
+        DerivedDataCacheSettings ddcSettings;
+        ddcSettings.localPath = root / "DerivedDataCache";
+        ddcSettings.sharedPath = root / "SharedDerivedDataCache";
+        DerivedDataCache ddc;
+        assert(ddc.Open(ddcSettings));
+
+        AssetCookSettings settings;
+        settings.force = true;
+        settings.derivedDataCache = &ddc;
+        AssetRegistry registry;
+        AssetCookStats stats;
+
+        auto begin = Clock::now();
+        const std::vector<AssetCookResult> firstResults = scheduler.Cook(requests, registry, settings, &stats);
+        const double coldMs = elapsed_ms(begin);
+        assert(stats.cooked == requests.size());
+        assert(ddc.Stats().misses == requests.size() && ddc.Stats().puts == requests.size());
+        std::vector<std::vector<uint8_t>> firstAssets;
+        for (const AssetCookRequest& request : requests)
+            firstAssets.push_back(read_file(request.import.destinationPath));
+
+        begin = Clock::now();
+        const std::vector<AssetCookResult> secondResults = scheduler.Cook(requests, registry, settings, &stats);
+        const double warmMs = elapsed_ms(begin);
+        assert(stats.cooked == requests.size());
+        assert(ddc.Stats().misses == requests.size() && ddc.Stats().localHits == requests.size());
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            assert(read_file(requests[i].import.destinationPath) == firstAssets[i]);
+            assert(secondResults[i].importResult.meshOptimization.acmrAfter ==
+                   firstResults[i].importResult.meshOptimization.acmrAfter);
+        }
+
+        // Another agent with an empty local store is warmed by the shared one
+        DerivedDataCacheSettings agentSettings = ddcSettings;
+        agentSettings.localPath = root / "AgentDerivedDataCache";
+        DerivedDataCache agent;
+        assert(agent.Open(agentSettings));
+        settings.derivedDataCache = &agent;
+        (void)scheduler.Cook(requests, registry, settings, &stats);
+        assert(agent.Stats().sharedHits == requests.size() && agent.Stats().misses == 0);
+
+        // Changing an external glTF buffer invalidates that mesh only
+        std::vector<uint8_t> buffer = read_file(root / "Source" / "grid_3.bin");
+        buffer[0] ^= 0x01;
+        write_file(root / "Source" / "grid_3.bin", buffer.data(), buffer.size());
+        (void)scheduler.Cook(requests, registry, settings, &stats);
+        assert(stats.cooked == requests.size());
+        assert(agent.Stats().misses == 1);
+
+        std::printf("%zu assets (%ux%u grids): cold cook %.2f ms, DDC cook %.2f ms\n",
+                    requests.size(), gridSize, gridSize, coldMs, warmMs);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t gridSize = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 128;
+    assert(gridSize > 0);
+
+    const fs::path testRoot =
+        fs::current_path() / "Saved" / "DerivedDataCacheTests" / AssetGuid::Create().ToString();
+    test_keys_cover_every_field();
+    test_round_trip_and_integrity(testRoot / "Integrity");
+    test_lru_eviction(testRoot / "Eviction");
+    test_shared_store(testRoot / "Shared");
+    test_cook_through_ddc(testRoot / "Cook", gridSize);
+
+    std::error_code ec;
+    fs::remove_all(testRoot, ec);
+    std::cout << "Derived data cache tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,370 @@
+#include "asset/mesh_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    using Triangle = std::array<float, 9>;
+
+    CookedMeshVertex grid_vertex(uint32_t x, uint32_t y)
+    {
+        CookedMeshVertex vertex {};
+        vertex.position[0] = float(x);
+        vertex.position[1] = float(y);
+        vertex.normal[2] = 1.0f;
+        vertex.uv0[0] = float(x);
+        vertex.uv0[1] = float(y);
+        return vertex;
+    }
+
+    // Unindexed grid with shuffled triangles, as a DCC exporter that splits every corner would write it
+    CookedMeshData make_shuffled_grid(uint32_t size, uint32_t seed)
+    {
+        std::vector<std::array<CookedMeshVertex, 3>> triangles;
+        for (uint32_t y = 0; y < size; ++y)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                triangles.push_back({ grid_vertex(x, y), grid_vertex(x + 1, y), grid_vertex(x + 1, y + 1) });
+                triangles.push_back({ grid_vertex(x, y), grid_vertex(x + 1, y + 1), grid_vertex(x, y + 1) });
+            }
+        }
+        std::mt19937 random(seed);
+        std::shuffle(triangles.begin(), triangles.end(), random);
+
+        CookedMeshData data;
+        for (const auto& triangle : triangles)
+        {
+            for (const CookedMeshVertex& vertex : triangle)
+            {
+                data.indices.push_back(static_cast<uint32_t>(data.vertices.size()));
+                data.vertices.push_back(vertex);
+            }
+        }
+        CookedMeshPrimitive primitive {};
+        primitive.indexCount = static_cast<uint32_t>(data.indices.size());
+        primitive.vertexCount = static_cast<uint32_t>(data.vertices.size());
+        data.primitives.push_back(primitive);
+        return data;
+    }
+
+    // Triangles by position, rotated so the smallest corner leads; winding is preserved
+    std::vector<Triangle> triangle_set(const CookedMeshData& data, const CookedMeshPrimitive& primitive)
+    {
+        std::vector<Triangle> result;
+        for (uint32_t i = primitive.firstIndex; i < primitive.firstIndex + primitive.indexCount; i += 3)
+        {
+            std::array<std::array<float, 3>, 3> corners;
+            for (uint32_t k = 0; k < 3; ++k)
+            {
+                const CookedMeshVertex& vertex = data.vertices[data.indices[i + k]];
+                corners[k] = { vertex.position[0], vertex.position[1], vertex.position[2] };
+            }
+            const auto lead = std::min_element(corners.begin(), corners.end()) - corners.begin();
+            std::rotate(corners.begin(), corners.begin() + lead, corners.end());
+            Triangle triangle;
+            for (uint32_t k = 0; k < 3; ++k)
+                std::copy(corners[k].begin(), corners[k].end(), triangle.begin() + k * 3);
+            result.push_back(triangle);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    // Closed unit sphere with one vertex per position, so every vertex may collapse
+    CookedMeshData make_icosphere(uint32_t subdivisions)
+    {
+        const float t = (1.0f + std::sqrt(5.0f)) * 0.5f;
+        std::vector<std::array<float, 3>> positions = {
+            { -1, t, 0 }, { 1, t, 0 }, { -1, -t, 0 }, { 1, -t, 0 },
+            { 0, -1, t }, { 0, 1, t }, { 0, -1, -t }, { 0, 1, -t },
+            { t, 0, -1 }, { t, 0, 1 }, { -t, 0, -1 }, { -t, 0, 1 } };
+        std::vector<uint32_t> indices = {
+            0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11, 1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+            3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9, 4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1 };
+        for (uint32_t s = 0; s < subdivisions; ++s)
+        {
+            std::map<std::pair<uint32_t, uint32_t>, uint32_t> midpoints;
+            const auto midpoint = [&](uint32_t a, uint32_t b)
+            {
+                const auto key = std::minmax(a, b);
+                auto it = midpoints.find(key);
+                if (it != midpoints.end())
+                    return it->second;
+                const uint32_t index = static_cast<uint32_t>(positions.size());
+                positions.push_back({ (positions[a][0] + positions[b][0]) * 0.5f, (positions[a][1] + positions[b][1]) * 0.5f,
+                                      (positions[a][2] + positions[b][2]) * 0.5f });
+                midpoints.emplace(key, index);
+                return index;
+            };
+            std::vector<uint32_t> next;
+            for (size_t i = 0; i < indices.size(); i += 3)
+            {
+                const uint32_t a = indices[i], b = indices[i + 1], c = indices[i + 2];
+                const uint32_t ab = midpoint(a, b), bc = midpoint(b, c), ca = midpoint(c, a);
+                next.insert(next.end(), { a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca });
+            }
+            indices = std::move(next);
+        }
+
+        CookedMeshData data;
+        for (const auto& position : positions)
+        {
+            const float length = std::sqrt(position[0] * position[0] + position[1] * position[1] + position[2] * position[2]);
+            CookedMeshVertex vertex {};
+            for (uint32_t k = 0; k < 3; ++k)
+            {
+                vertex.position[k] = position[k] / length;
+                vertex.normal[k] = position[k] / length;
+            }
+            data.vertices.push_back(vertex);
+        }
+        data.indices = indices;
+        CookedMeshPrimitive primitive {};
+        primitive.indexCount = static_cast<uint32_t>(indices.size());
+        primitive.vertexCount = static_cast<uint32_t>(positions.size());
+        primitive.boundsMin[0] = primitive.boundsMin[1] = primitive.boundsMin[2] = -1.0f;
+        primitive.boundsMax[0] = primitive.boundsMax[1] = primitive.boundsMax[2] = 1.0f;
+        data.primitives.push_back(primitive);
+        return data;
+    }
+
+    std::array<float, 3> triangle_cross(const CookedMeshData& data, const uint32_t* triangle)
+    {
+        const float* a = data.vertices[triangle[0]].position;
+        const float* b = data.vertices[triangle[1]].position;
+        const float* c = data.vertices[triangle[2]].position;
+        const float e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        const float e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+        return { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+    }
+
+    void test_weld()
+    {
+        CookedMeshData data = make_shuffled_grid(8, 1);
+        const std::vector<Triangle> before = triangle_set(data, data.primitives[0]);
+        assert(MeshOptimizer::WeldVertices(data) == 81);
+        assert(data.vertices.size() == 81);
+        assert(triangle_set(data, data.primitives[0]) == before);
+    }
+
+    void test_vertex_cache()
+    {
+        CookedMeshData data = make_shuffled_grid(32, 2);
+        MeshOptimizer::WeldVertices(data);
+        const float acmrBefore = MeshOptimizer::AnalyzeACMR(data.indices);
+        const std::vector<Triangle> before = triangle_set(data, data.primitives[0]);
+
+        MeshOptimizer::OptimizeVertexCache(data.indices, static_cast<uint32_t>(data.vertices.size()));
+        const float acmrAfter = MeshOptimizer::AnalyzeACMR(data.indices);
+        assert(acmrAfter < acmrBefore);
+        assert(acmrAfter < 1.0f);
+        assert(MeshOptimizer::AnalyzeATVR(data.indices) < 2.0f);
+        assert(triangle_set(data, data.primitives[0]) == before);
+
+        MeshOptimizer::OptimizeOverdraw(data.indices, data.vertices);
+        assert(triangle_set(data, data.primitives[0]) == before);
+        assert(MeshOptimizer::AnalyzeACMR(data.indices) <= acmrAfter * 1.05f + 0.01f);
+    }
+
+    void test_optimize_primitives()
+    {
+        // Two triangle primitives plus a trailing line list the optimizer must leave alone
+        CookedMeshData data = make_shuffled_grid(16, 3);
+        CookedMeshData second = make_shuffled_grid(4, 4);
+        for (CookedMeshVertex& vertex : second.vertices)
+            vertex.position[2] = 1.0f;
+        const uint32_t vertexBase = static_cast<uint32_t>(data.vertices.size());
+        CookedMeshPrimitive secondPrimitive = second.primitives[0];
+        secondPrimitive.firstIndex = static_cast<uint32_t>(data.indices.size());
+        secondPrimitive.materialIndex = 1;
+        for (uint32_t index : second.indices)
+            data.indices.push_back(index + vertexBase);
+        data.vertices.insert(data.vertices.end(), second.vertices.begin(), second.vertices.end());
+        data.primitives.push_back(secondPrimitive);
+
+        CookedMeshPrimitive lines {};
+        lines.firstIndex = static_cast<uint32_t>(data.indices.size());
+        lines.indexCount = 4;
+        lines.materialIndex = 2;
+        for (uint32_t i = 0; i < 4; ++i)
+            data.indices.push_back(vertexBase + i);
+        data.primitives.push_back(lines);
+
+        const std::vector<Triangle> firstBefore = triangle_set(data, data.primitives[0]);
+        const std::vector<Triangle> secondBefore = triangle_set(data, data.primitives[1]);
+        const uint32_t sourceVertexCount = static_cast<uint32_t>(data.vertices.size());
+
+        const MeshOptimizationStats stats = MeshOptimizer::Optimize(data);
+        assert(stats.sourceVertexCount == sourceVertexCount);
+        assert(stats.vertexCount == data.vertices.size());
+        assert(stats.vertexCount == 17 * 17 + 5 * 5);
+        assert(stats.triangleCount == 16 * 16 * 2 + 4 * 4 * 2);
+        assert(stats.acmrBefore == 3.0f);
+        assert(stats.acmrAfter < 1.0f);
+        // Unwelded input loads every index once (ATVR 1) but that is all misses; compare per vertex after welding
+        assert(stats.atvrBefore == 1.0f);
+        assert(stats.atvrAfter < 1.5f);
+
+        assert(data.primitives.size() == 3);
+        assert(data.primitives[0].vertexCount == 17 * 17);
+        assert(data.primitives[1].vertexCount == 5 * 5);
+        assert(data.primitives[2].indexCount == 4);
+        assert(triangle_set(data, data.primitives[0]) == firstBefore);
+        assert(triangle_set(data, data.primitives[1]) == secondBefore);
+        for (uint32_t index : data.indices)
+            assert(index < data.vertices.size());
+
+        // Fetch order: the first primitive's vertices come first, in first-use order
+        uint32_t nextNew = 0;
+        for (uint32_t i = 0; i < data.primitives[0].indexCount; ++i)
+        {
+            assert(data.indices[i] <= nextNew);
+            if (data.indices[i] == nextNew)
+                ++nextNew;
+        }
+        assert(nextNew == 17 * 17);
+    }
+
+    void test_simplify_plane()
+    {
+        // Every interior vertex of a flat grid collapses for free; the border stays
+        CookedMeshData data = make_shuffled_grid(64, 6);
+        MeshOptimizer::Optimize(data);
+        std::vector<uint32_t> simplified;
+        const float error = MeshOptimizer::Simplify(data.indices, data.vertices, data.indices.size() / 4, simplified);
+        assert(error < 1e-3f);
+        assert(simplified.size() % 3 == 0);
+        assert(simplified.size() <= data.indices.size() / 4 + data.indices.size() / 20);
+
+        float area = 0.0f;
+        for (size_t i = 0; i < simplified.size(); i += 3)
+        {
+            assert(simplified[i] < data.vertices.size() && simplified[i + 1] < data.vertices.size() &&
+                   simplified[i + 2] < data.vertices.size());
+            const std::array<float, 3> cross = triangle_cross(data, &simplified[i]);
+            assert(cross[2] > 0.0f);
+            area += cross[2] * 0.5f;
+        }
+        assert(std::abs(area - 64.0f * 64.0f) < 0.5f);
+    }
+
+    void test_simplify_sphere()
+    {
+        CookedMeshData data = make_icosphere(4);
+        std::vector<uint32_t> simplified;
+        const float error = MeshOptimizer::Simplify(data.indices, data.vertices, data.indices.size() / 4, simplified);
+        assert(error > 0.0f && error < 0.05f);
+        assert(simplified.size() <= data.indices.size() / 4 + data.indices.size() / 20);
+
+        // Still closed and two-manifold, and still wound outward
+        std::map<std::pair<uint32_t, uint32_t>, int> edges;
+        for (size_t i = 0; i < simplified.size(); i += 3)
+        {
+            for (uint32_t k = 0; k < 3; ++k)
+                ++edges[std::minmax(simplified[i + k], simplified[i + (k + 1) % 3])];
+            const std::array<float, 3> cross = triangle_cross(data, &simplified[i]);
+            const float* a = data.vertices[simplified[i]].position;
+            assert(cross[0] * a[0] + cross[1] * a[1] + cross[2] * a[2] > 0.0f);
+        }
+        for (const auto& [edge, count] : edges)
+            assert(count == 2);
+    }
+
+    void test_generate_lods()
+    {
+        CookedMeshData data = make_icosphere(5);
+        MeshOptimizer::Optimize(data);
+        const uint32_t baseIndexCount = static_cast<uint32_t>(data.indices.size());
+        MeshLodSettings settings;
+        settings.lodCount = 4;
+        const uint32_t levels = MeshOptimizer::GenerateLods(data, settings);
+        assert(levels >= 2 && levels <= 4);
+        assert(data.primitiveLods.size() == data.primitives.size());
+        assert(data.primitiveLods[0].firstLod == 0 && data.primitiveLods[0].lodCount == levels);
+        assert(data.lods.size() == levels);
+
+        uint32_t previousCount = data.primitives[0].indexCount;
+        float previousError = 0.0f;
+        uint32_t expectedFirst = baseIndexCount;
+        for (const CookedMeshLod& lod : data.lods)
+        {
+            assert(lod.firstIndex == expectedFirst);
+            assert(lod.indexCount % 3 == 0 && lod.indexCount < previousCount);
+            assert(lod.indexCount >= settings.minTriangleCount * 3);
+            assert(lod.error >= previousError && lod.error < settings.maxRelativeError * std::sqrt(12.0f));
+            for (uint32_t i = lod.firstIndex; i < lod.firstIndex + lod.indexCount; ++i)
+                assert(data.indices[i] < data.primitives[0].vertexCount);
+            expectedFirst += lod.indexCount;
+            previousCount = lod.indexCount;
+            previousError = lod.error;
+        }
+        assert(data.indices.size() == expectedFirst);
+
+        // Regenerating replaces the chain instead of appending a second one
+        assert(MeshOptimizer::GenerateLods(data, settings) == levels);
+        assert(data.indices.size() == expectedFirst);
+
+        // A primitive-relative layout keeps the levels on the primitive's own vertices
+        std::vector<uint8_t> bytes;
+        std::vector<CookedMeshPrimitiveDecode> decode;
+        EncodeCookedVertices(data, MakeCookedVertexLayout(CookedVertexEncoding::Compact()), bytes, decode);
+        for (uint32_t index : data.indices)
+            assert(index < data.vertices.size());
+
+        // Too small to simplify
+        CookedMeshData small = make_icosphere(0);
+        assert(MeshOptimizer::GenerateLods(small) == 0);
+        assert(small.primitiveLods.empty() || small.primitiveLods[0].lodCount == 0);
+    }
+
+    void benchmark_lods()
+    {
+        CookedMeshData data = make_icosphere(7);
+        MeshOptimizer::Optimize(data);
+        MeshLodSettings settings;
+        settings.lodCount = 6;
+        const auto begin = std::chrono::steady_clock::now();
+        MeshOptimizer::GenerateLods(data, settings);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        std::printf("GenerateLods %u triangles: %.1f ms,", data.primitives[0].indexCount / 3, ms);
+        for (const CookedMeshLod& lod : data.lods)
+            std::printf(" %u (%.4f)", lod.indexCount / 3, lod.error);
+        std::printf("\n");
+    }
+
+    void benchmark_optimize()
+    {
+        CookedMeshData data = make_shuffled_grid(256, 5);
+        const auto begin = std::chrono::steady_clock::now();
+        const MeshOptimizationStats stats = MeshOptimizer::Optimize(data);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        std::printf("Optimize %u triangles: %.1f ms, vertices %u -> %u, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+                    stats.triangleCount, ms, stats.sourceVertexCount, stats.vertexCount,
+                    stats.acmrBefore, stats.acmrAfter, stats.atvrBefore, stats.atvrAfter);
+    }
+}
+
+int main()
+{
+    test_weld();
+    test_vertex_cache();
+    test_optimize_primitives();
+    test_simplify_plane();
+    test_simplify_sphere();
+    test_generate_lods();
+    benchmark_optimize();
+    benchmark_lods();
+    std::cout << "Mesh optimizer tests passed\n";
+    return 0;
+}
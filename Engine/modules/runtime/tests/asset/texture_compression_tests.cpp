@@ -0,0 +1,146 @@
+#include "asset/texture_compression.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+
+    // Smooth gradients with soft noise and a few hard edges, roughly photo-like content.
+    std::vector<uint8_t> make_test_image(uint32_t width, uint32_t height, bool withAlpha)
+    {
+        std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+        std::mt19937 rng(1234u);
+        std::uniform_int_distribution<int> noise(-6, 6);
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                const float u = float(x) / float(width);
+                const float v = float(y) / float(height);
+                const bool edge = ((x / 37) + (y / 53)) % 5 == 0;
+                const float base[4] {
+                    128.0f + 100.0f * std::sin(u * 6.28f),
+                    edge ? 40.0f : 200.0f * v,
+                    255.0f * u * v,
+                    withAlpha ? 255.0f * (0.5f + 0.5f * std::cos(v * 9.0f)) : 255.0f,
+                };
+                uint8_t* texel = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    const int jitter = (c == 3 && !withAlpha) ? 0 : noise(rng);
+                    texel[c] = static_cast<uint8_t>(std::clamp(int(base[c]) + jitter, 0, 255));
+                }
+            }
+        }
+        return rgba;
+    }
+
+    double psnr(const std::vector<uint8_t>& lhs, const std::vector<uint8_t>& rhs, uint32_t firstChannel,
+                uint32_t channelCount)
+    {
+        double squaredError = 0.0;
+        size_t samples = 0;
+        for (size_t i = 0; i < lhs.size(); i += 4)
+        {
+            for (uint32_t c = firstChannel; c < firstChannel + channelCount; ++c)
+            {
+                const double d = double(lhs[i + c]) - double(rhs[i + c]);
+                squaredError += d * d;
+                ++samples;
+            }
+        }
+        const double mse = squaredError / double(samples);
+        return mse <= 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+
+    struct FormatCase
+    {
+        TextureCookFormat format;
+        uint32_t firstChannel;
+        uint32_t channelCount;
+        bool withAlpha;
+        double minPsnr;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Cyber;
+
+    // Pass a size to benchmark a larger image, e.g. "TextureCompressionTests 4096".
+    const uint32_t size = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 512;
+    assert(size >= 4);
+
+    assert(TextureCompression::MipDataSize(TextureCookFormat::BC1, 1, 1) == 8);
+    assert(TextureCompression::MipDataSize(TextureCookFormat::BC7, 5, 9) == 2 * 3 * 16);
+    assert(TextureCompression::RowPitch(TextureCookFormat::RGBA8, 7) == 28);
+    assert(TextureCompression::IsSRGB(TextureCookFormat::BC3_SRGB));
+    assert(!TextureCompression::IsBlockCompressed(TextureCookFormat::RGBA8_SRGB));
+
+    const FormatCase cases[] {
+        { TextureCookFormat::BC1, 0, 3, false, 30.0 },
+        { TextureCookFormat::BC3, 0, 4, true, 30.0 },
+        { TextureCookFormat::BC4, 0, 1, false, 38.0 },
+        { TextureCookFormat::BC5, 0, 2, false, 38.0 },
+        { TextureCookFormat::BC7, 0, 4, true, 34.0 },
+    };
+
+    const uint32_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (const FormatCase& testCase : cases)
+    {
+        // Odd dimensions exercise the partial edge blocks
+        const std::vector<uint8_t> image = make_test_image(size + 3, size + 1, testCase.withAlpha);
+        const uint32_t width = size + 3;
+        const uint32_t height = size + 1;
+
+        std::vector<uint8_t> encoded;
+        const auto begin = std::chrono::steady_clock::now();
+        assert(TextureCompression::Encode(testCase.format, image.data(), width, height, encoded, threadCount));
+        const auto end = std::chrono::steady_clock::now();
+        assert(encoded.size() == TextureCompression::MipDataSize(testCase.format, width, height));
+
+        std::vector<uint8_t> singleThreaded;
+        assert(TextureCompression::Encode(testCase.format, image.data(), width, height, singleThreaded, 1));
+        assert(singleThreaded == encoded);
+
+        std::vector<uint8_t> decoded;
+        assert(TextureCompression::Decode(testCase.format, encoded.data(), width, height, decoded));
+        assert(decoded.size() == image.size());
+
+        const double quality = psnr(image, decoded, testCase.firstChannel, testCase.channelCount);
+        const double seconds = std::chrono::duration<double>(end - begin).count();
+        const double megapixels = double(width) * double(height) / 1.0e6;
+        std::printf("%-5s %ux%u  PSNR %6.2f dB  %8.2f MPix/s  (%u threads)\n",
+                    TextureCompression::ToString(testCase.format), width, height, quality,
+                    megapixels / std::max(seconds, 1e-9), threadCount);
+        assert(quality >= testCase.minPsnr);
+    }
+
+    // Flat blocks must round-trip exactly
+    std::vector<uint8_t> flat(16 * 4, 0);
+    for (size_t i = 0; i < flat.size(); i += 4)
+    {
+        flat[i + 0] = 10;
+        flat[i + 1] = 200;
+        flat[i + 2] = 90;
+        flat[i + 3] = 255;
+    }
+    std::vector<uint8_t> flatEncoded;
+    std::vector<uint8_t> flatDecoded;
+    assert(TextureCompression::Encode(TextureCookFormat::BC7, flat.data(), 4, 4, flatEncoded));
+    assert(TextureCompression::Decode(TextureCookFormat::BC7, flatEncoded.data(), 4, 4, flatDecoded));
+    assert(psnr(flat, flatDecoded, 0, 4) >= 45.0);
+
+    std::cout << "Texture compression tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "graphics/features/frustum_culling.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    using namespace Cyber::Renderer;
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    // Same layout as Renderer::get_adjusted_projection_matrix: left-handed, D3D depth
+    float4x4 perspective(float fov, float aspect_ratio, float near_plane, float far_plane)
+    {
+        const float y_scale = 1.0f / std::tan(fov * 0.5f);
+        const float x_scale = y_scale / aspect_ratio;
+        return float4x4(
+            x_scale, 0.0f, 0.0f, 0.0f,
+            0.0f, y_scale, 0.0f, 0.0f,
+            0.0f, 0.0f, far_plane / (far_plane - near_plane), 1.0f,
+            0.0f, 0.0f, -near_plane * far_plane / (far_plane - near_plane), 0.0f);
+    }
+
+    template<typename Cull>
+    double best_ms(uint32_t iterations, Cull&& cull)
+    {
+        double best = 0.0;
+        for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            const auto begin = Clock::now();
+            cull();
+            const double ms = elapsed_ms(begin);
+            best = iteration == 0 ? ms : std::min(best, ms);
+        }
+        return best;
+    }
+
+    void test_known_boxes()
+    {
+        const float4x4 view_proj = float4x4::look_at(float3(0.0f, 0.0f, 0.0f), float3(0.0f, 0.0f, 1.0f), float3(0.0f, 1.0f, 0.0f)) *
+            perspective(1.5707964f, 1.0f, 0.1f, 100.0f);
+        const CullingFrustum frustum = CullingFrustum::from_view_projection(view_proj);
+
+        CullingBoxes boxes;
+        boxes.add_world_box(float3(0.0f, 0.0f, 10.0f), float3(1.0f, 1.0f, 1.0f));     // ahead
+        boxes.add_world_box(float3(0.0f, 0.0f, -10.0f), float3(1.0f, 1.0f, 1.0f));    // behind
+        boxes.add_world_box(float3(0.0f, 0.0f, 200.0f), float3(1.0f, 1.0f, 1.0f));    // past far
+        boxes.add_world_box(float3(30.0f, 0.0f, 10.0f), float3(1.0f, 1.0f, 1.0f));    // right of the 90 degree fov
+        boxes.add_world_box(float3(10.5f, 0.0f, 10.0f), float3(1.0f, 1.0f, 1.0f));    // straddles the right plane
+        boxes.add_unbounded();
+        // Scaled and moved out of view by its world matrix
+        boxes.add_local_box(float3(-1.0f, -1.0f, -1.0f), float3(1.0f, 1.0f, 1.0f),
+                            float4x4::scale(float3(2.0f, 2.0f, 2.0f)) * float4x4::translation(float3(0.0f, 50.0f, 10.0f)));
+
+        std::vector<uint32_t> visible(boxes.padded_size());
+        const uint32_t visible_count = cull_boxes(frustum, boxes, visible.data());
+        assert(visible_count == 3);
+        assert(visible[0] == 0 && visible[1] == 4 && visible[2] == 5);
+
+        // Without the depth planes the box past the far plane survives; the side planes of a
+        // perspective frustum still reject what lies behind the eye
+        const CullingFrustum caster_frustum = CullingFrustum::from_view_projection(view_proj, false);
+        assert(cull_boxes(caster_frustum, boxes, visible.data()) == 4);
+        assert(visible[0] == 0 && visible[1] == 2 && visible[2] == 4 && visible[3] == 5);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t box_count = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 100000;
+    const uint32_t iterations = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 20;
+    assert(box_count > 0 && iterations > 0);
+
+    test_known_boxes();
+
+    // Objects scattered around the camera; roughly a tenth end up inside the view
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.25f, 4.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::vector<float3> half_extents;
+    std::vector<float4x4> worlds;
+    half_extents.reserve(box_count);
+    worlds.reserve(box_count);
+    for (uint32_t i = 0; i < box_count; ++i)
+    {
+        half_extents.push_back(float3(size(rng), size(rng), size(rng)));
+        worlds.push_back(quaternion_f::rotation_from_axis_angle(float3(0.0f, 1.0f, 0.0f), angle(rng)).to_matrix() *
+            float4x4::translation(float3(position(rng), position(rng), position(rng))));
+    }
+
+    CullingBoxes boxes;
+    const double transform_ms = best_ms(iterations, [&] {
+        boxes.clear();
+        boxes.reserve(box_count);
+        for (uint32_t i = 0; i < box_count; ++i)
+            boxes.add_local_box(float3(0.0f, 0.0f, 0.0f) - half_extents[i], half_extents[i], worlds[i]);
+    });
+
+    const float4x4 camera = float4x4::look_at(float3(0.0f, 10.0f, -50.0f), float3(0.0f, 0.0f, 100.0f), float3(0.0f, 1.0f, 0.0f)) *
+        perspective(1.0471976f, 16.0f / 9.0f, 0.1f, 600.0f);
+    const float4x4 light = float4x4::look_at(float3(-100.0f, 300.0f, -50.0f), float3(0.0f, 0.0f, 0.0f), float3(0.0f, 1.0f, 0.0f)) *
+        float4x4::ortho_off_center(-150.0f, 150.0f, -150.0f, 150.0f, 0.1f, 800.0f);
+
+    struct View { const char* name; CullingFrustum frustum; };
+    const View views[] = {
+        { "camera", CullingFrustum::from_view_projection(camera) },
+        { "shadow", CullingFrustum::from_view_projection(light, false) },
+    };
+
+    std::vector<uint32_t> simd_visible(boxes.padded_size());
+    std::vector<uint32_t> scalar_visible(boxes.padded_size());
+    std::printf("%u boxes, local-to-world transform %.3f ns/box\n", box_count, transform_ms * 1.0e6 / box_count);
+    for (const View& view : views)
+    {
+        uint32_t simd_count = 0;
+        uint32_t scalar_count = 0;
+        const double scalar_ms = best_ms(iterations, [&] { scalar_count = cull_boxes_scalar(view.frustum, boxes, scalar_visible.data()); });
+        const double simd_ms = best_ms(iterations, [&] { simd_count = cull_boxes(view.frustum, boxes, simd_visible.data()); });
+
+        assert(simd_count == scalar_count);
+        assert(std::equal(simd_visible.begin(), simd_visible.begin() + simd_count, scalar_visible.begin()));
+        assert(simd_count > 0 && simd_count < box_count);
+
+        std::printf("%-6s  %6u visible  scalar %6.3f ns/box  simd %6.3f ns/box  (%.1fx)\n", view.name, simd_count,
+                    scalar_ms * 1.0e6 / box_count, simd_ms * 1.0e6 / box_count, simd_ms > 0.0 ? scalar_ms / simd_ms : 0.0);
+    }
+
+    std::cout << "Frustum culling benchmark passed" << std::endl;
+    return 0;
+}
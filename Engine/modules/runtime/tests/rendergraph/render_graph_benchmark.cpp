@@ -0,0 +1,168 @@
+#include "graphics/rendergraph/render_graph.h"
+#include "graphics/rendergraph/render_graph_builder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    using namespace Cyber::render_graph;
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    class BenchmarkPass : public RGPass
+    {
+    public:
+        BenchmarkPass() : RGPass(RG_RENDER_PASS) {}
+
+        void setup(RenderGraphBuilder&) override {}
+        void execute(RenderGraph&, RenderPassContext&) override {}
+    };
+
+    RGTextureCreateDesc texture_desc(uint32_t size, uint32_t bind_flags)
+    {
+        RGTextureCreateDesc desc = {};
+        desc.m_width = size;
+        desc.m_height = size;
+        desc.m_depth = 1;
+        desc.m_arraySize = 1;
+        desc.m_mipLevels = 1;
+        desc.m_sampleCount = SAMPLE_COUNT_1;
+        desc.m_dimension = TEX_DIMENSION_2D;
+        desc.m_format = TEX_FORMAT_RGBA8_UNORM;
+        desc.m_bindFlags = bind_flags;
+        return desc;
+    }
+
+    // A procedurally generated frame: per-light shadow passes feeding tiled lighting passes that
+    // accumulate into one buffer, the shape that made the old quadratic compile show up in profiles.
+    // Every fourth pass lights the shadow maps rendered since the previous lighting pass.
+    struct ProceduralFrame
+    {
+        explicit ProceduralFrame(uint32_t pass_count)
+        {
+            names.reserve(pass_count + 4);
+            graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+                depth = builder.create_texture(texture_desc(1024, GRAPHICS_RESOURCE_BIND_DEPTH_STENCIL), u8"Depth");
+                output = builder.create_texture(texture_desc(1024, GRAPHICS_RESOURCE_BIND_RENDER_TARGET), u8"Output");
+                RGBufferCreateDesc lighting_desc = {};
+                lighting_desc.size = 4u * 1024u * 1024u;
+                lighting = builder.create_buffer(lighting_desc, u8"Lighting");
+                builder.set_output(output);
+
+                for (uint32_t i = 0; i + 1 < pass_count; ++i)
+                {
+                    if (is_lighting_pass(i, pass_count))
+                        continue;
+                    names.push_back("Shadow" + std::to_string(i));
+                    shadow_maps.push_back(builder.create_texture(texture_desc(128, GRAPHICS_RESOURCE_BIND_DEPTH_STENCIL),
+                        reinterpret_cast<const char8_t*>(names.back().c_str())));
+                }
+            });
+
+            RenderGraphBuilder* builder = graph->get_builder();
+            passes.reset(new BenchmarkPass[pass_count]);
+            uint32_t shadow_index = 0;
+            uint32_t lit_index = 0;
+            for (uint32_t i = 0; i + 1 < pass_count; ++i)
+            {
+                BenchmarkPass& pass = passes[i];
+                if (!is_lighting_pass(i, pass_count))
+                {
+                    builder->add_pass(u8"Shadow", &pass);
+                    pass.write(shadow_maps[shadow_index++], GRAPHICS_RESOURCE_STATE_DEPTH_WRITE);
+                    continue;
+                }
+
+                builder->add_pass(u8"Lighting", &pass);
+                pass.read(depth, GRAPHICS_RESOURCE_STATE_DEPTH_READ).read_write(lighting);
+                for (; lit_index < shadow_index; ++lit_index)
+                    pass.read(shadow_maps[lit_index]);
+            }
+
+            BenchmarkPass& resolve = passes[pass_count - 1];
+            builder->add_pass(u8"Resolve", &resolve);
+            resolve.read(lighting).write(output, GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+        }
+
+        // The pass before the resolve always lights, so no shadow map is left unread and culled
+        static bool is_lighting_pass(uint32_t index, uint32_t pass_count)
+        {
+            return index % 4 == 3 || index + 2 == pass_count;
+        }
+
+        ~ProceduralFrame()
+        {
+            graph->reset_passes();
+            RenderGraph::destroy(graph);
+        }
+
+        RenderGraph* graph = nullptr;
+        RGTextureRef depth = nullptr;
+        RGTextureRef output = nullptr;
+        RGBufferRef lighting = nullptr;
+        std::vector<RGTextureRef> shadow_maps;
+        std::vector<std::string> names;
+        std::unique_ptr<BenchmarkPass[]> passes;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 10;
+    assert(iterations > 0);
+
+    for (uint32_t pass_count : { 1000u, 2500u, 5000u, 10000u })
+    {
+        ProceduralFrame frame(pass_count);
+
+        double best_ms = 0.0;
+        for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            frame.graph->discard_cached_plan();
+            const auto begin = Clock::now();
+            frame.graph->compile();
+            const double ms = elapsed_ms(begin);
+            best_ms = iteration == 0 ? ms : std::min(best_ms, ms);
+        }
+        assert(!frame.graph->get_compile_report().reused_cached_plan);
+
+        // Steady state: nothing structural changed since the last compile
+        double cached_ms = 0.0;
+        for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            frame.graph->invalidate();
+            const auto begin = Clock::now();
+            frame.graph->compile();
+            const double ms = elapsed_ms(begin);
+            cached_ms = iteration == 0 ? ms : std::min(cached_ms, ms);
+        }
+        assert(frame.graph->get_compile_report().reused_cached_plan);
+
+        // Nothing is culled and the lighting chain serializes on the accumulation buffer
+        const RenderGraphCompileReport& report = frame.graph->get_compile_report();
+        assert(report.executed_passes.size() == pass_count);
+        assert(report.culled_passes.empty());
+        const auto& order = frame.graph->get_execution_order();
+        for (uint32_t i = 0; i < order.size(); ++i)
+            assert(order[i]->order == i);
+
+        std::printf("%5u passes  compile %8.3f ms  (%6.3f us/pass)  cached %8.3f ms  (%6.3f us/pass)\n", pass_count,
+                    best_ms, best_ms * 1000.0 / pass_count, cached_ms, cached_ms * 1000.0 / pass_count);
+    }
+
+    std::cout << "Render graph benchmark passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "graphics/rendergraph/render_graph.h"
+#include "graphics/rendergraph/render_graph_builder.h"
+#include "EASTL/map.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    using namespace Cyber::render_graph;
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    // The comparator the graph's name map used before names were interned
+    struct Utf8StringLess
+    {
+        bool operator()(const char8_t* lhs, const char8_t* rhs) const
+        {
+            while (*lhs != 0 && *lhs == *rhs)
+            {
+                ++lhs;
+                ++rhs;
+            }
+            return *lhs < *rhs;
+        }
+    };
+
+    RGTextureCreateDesc texture_desc()
+    {
+        RGTextureCreateDesc desc = {};
+        desc.m_width = 64;
+        desc.m_height = 64;
+        desc.m_depth = 1;
+        desc.m_arraySize = 1;
+        desc.m_mipLevels = 1;
+        desc.m_sampleCount = SAMPLE_COUNT_1;
+        desc.m_dimension = TEX_DIMENSION_2D;
+        desc.m_format = TEX_FORMAT_RGBA8_UNORM;
+        desc.m_bindFlags = GRAPHICS_RESOURCE_BIND_SHADER_RESOURCE;
+        return desc;
+    }
+
+    template<typename Lookup>
+    double best_frame_ms(uint32_t iterations, Lookup&& lookup)
+    {
+        double best_ms = 0.0;
+        for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            const auto begin = Clock::now();
+            lookup();
+            const double ms = elapsed_ms(begin);
+            best_ms = iteration == 0 ? ms : std::min(best_ms, ms);
+        }
+        return best_ms;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 20;
+    // Every resource is looked up this many times a frame, as passes bind their inputs and outputs
+    const uint32_t lookups_per_resource = 4;
+    assert(iterations > 0);
+
+    for (uint32_t resource_count : { 100u, 250u, 500u, 1000u })
+    {
+        // Shared prefixes, as pipelines namespace their resources
+        std::vector<std::string> names;
+        names.reserve(resource_count);
+        for (uint32_t i = 0; i < resource_count; ++i)
+            names.push_back("Forward.Lighting.Target" + std::to_string(i));
+
+        eastl::map<const char8_t*, RGRenderResource*, Utf8StringLess> string_map;
+        std::vector<RGResourceName> handles;
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            for (const std::string& name : names)
+            {
+                const RGResourceName handle = reinterpret_cast<const char8_t*>(name.c_str());
+                handles.push_back(handle);
+                string_map[handle.name] = builder.create_texture(texture_desc(), handle);
+            }
+        });
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        // Visit resources in a scattered order so neither structure benefits from sequential access
+        std::vector<uint32_t> order;
+        order.reserve(resource_count * lookups_per_resource);
+        for (uint32_t i = 0; i < resource_count * lookups_per_resource; ++i)
+            order.push_back((i * 7919u) % resource_count);
+        const uint32_t lookups = static_cast<uint32_t>(order.size());
+
+        uintptr_t sink = 0;
+        const double map_ms = best_frame_ms(iterations, [&] {
+            for (uint32_t index : order)
+                sink ^= reinterpret_cast<uintptr_t>(string_map.find(handles[index].name)->second);
+        });
+        const double string_ms = best_frame_ms(iterations, [&] {
+            for (uint32_t index : order)
+                sink ^= reinterpret_cast<uintptr_t>(builder->get_texture(handles[index].name));
+        });
+        const double handle_ms = best_frame_ms(iterations, [&] {
+            for (uint32_t index : order)
+                sink ^= reinterpret_cast<uintptr_t>(builder->get_texture(handles[index]));
+        });
+
+        for (uint32_t i = 0; i < resource_count; ++i)
+            assert(builder->get_texture(handles[i]) == string_map[handles[i].name]);
+
+        std::printf("%5u resources  %5u lookups/frame  string map %8.2f us  string wrapper %8.2f us  handle %8.2f us  (%5.1fx)  [%zx]\n",
+                    resource_count, lookups, map_ms * 1000.0, string_ms * 1000.0, handle_ms * 1000.0,
+                    handle_ms > 0.0 ? map_ms / handle_ms : 0.0, static_cast<size_t>(sink & 0xf));
+
+        RenderGraph::destroy(graph);
+    }
+
+    std::cout << "Render graph lookup benchmark passed" << std::endl;
+    return 0;
+}
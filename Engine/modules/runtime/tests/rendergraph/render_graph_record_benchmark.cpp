@@ -0,0 +1,223 @@
+#include "graphics/interface/device_context.h"
+#include "graphics/rendergraph/render_graph.h"
+#include "graphics/rendergraph/render_graph_builder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    using namespace Cyber::render_graph;
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    // Stand-in for a backend context: every command costs some CPU and appends to a command stream,
+    // roughly what validating state and writing a D3D12 command list does
+    class StandInDeviceContext : public RenderObject::IDeviceContext
+    {
+    public:
+        void transition_resource_state(const ResourceBarrierDesc&) override {}
+        void cmd_begin() override {}
+        void cmd_end() override {}
+        void cmd_resource_barrier(RenderObject::ITexture*, GRAPHICS_RESOURCE_STATE, GRAPHICS_RESOURCE_STATE) override { encode(1); }
+        void cmd_resource_barrier(RenderObject::IBuffer*, GRAPHICS_RESOURCE_STATE, GRAPHICS_RESOURCE_STATE) override { encode(1); }
+        void cmd_resource_barrier(const ResourceBarrierDesc& desc) override
+        {
+            encode(static_cast<uint32_t>(desc.texture_barriers.size() + desc.buffer_barriers.size()));
+        }
+        void flush() override { ++flush_count; }
+        void finish_frame() override {}
+        void set_frame_buffer(RenderObject::IFrameBuffer*) override {}
+        RenderObject::IFrameBuffer* get_frame_buffer() const override { return nullptr; }
+        void set_render_target(uint32_t, RenderObject::ITexture_View**, RenderObject::ITexture_View*) override {}
+        void cmd_begin_render_pass(const RenderObject::BeginRenderPassAttribs&) override {}
+        void cmd_next_sub_pass() override {}
+        void cmd_end_render_pass() override {}
+        void transition_subpass_attachments(uint32_t) override {}
+        void render_encoder_bind_descriptor_set(RenderObject::IDescriptorSet*) override {}
+        void render_encoder_set_viewport(uint32_t, const RenderObject::Viewport*) override {}
+        void render_encoder_set_scissor(uint32_t, const RenderObject::Rect*) override {}
+        void render_encoder_set_blend_factor(const float*) override {}
+        void render_encoder_bind_pipeline(RenderObject::IRenderPipeline*) override { encode(1); }
+        void render_encoder_bind_vertex_buffer(uint32_t, RenderObject::IBuffer**, const uint32_t*, const uint64_t*) override {}
+        void render_encoder_bind_index_buffer(RenderObject::IBuffer*, uint32_t, uint64_t) override {}
+        void render_encoder_push_constants(RenderObject::IRootSignature*, const char8_t*, const void*) override {}
+        void render_encoder_draw(uint32_t vertex_count, uint32_t) override { encode(vertex_count); }
+        void render_encoder_draw_instanced(uint32_t, uint32_t, uint32_t, uint32_t) override {}
+        void render_encoder_draw_indexed(uint32_t, uint32_t, uint32_t) override {}
+        void render_encoder_draw_indexed_instanced(uint32_t, uint32_t, uint32_t, uint32_t, uint32_t) override {}
+        void set_shader_resource_view(SHADER_STAGE, uint32_t, RenderObject::ITexture_View*) override {}
+        void set_constant_buffer_view(SHADER_STAGE, uint32_t, RenderObject::IBuffer*) override {}
+        void set_unordered_access_view(SHADER_STAGE, uint32_t, RenderObject::IBuffer*) override {}
+        void set_root_constant_buffer_view(SHADER_STAGE, uint32_t, RenderObject::IBuffer*, uint64_t) override {}
+        void prepare_for_rendering() override {}
+        void create_render_pass(const RenderObject::RenderPassDesc&, RenderObject::IRenderPass**) override {}
+        void execute_deferred_context(RenderObject::IDeviceContext*) override {}
+
+        void encode(uint32_t payload)
+        {
+            uint32_t word = payload;
+            for (uint32_t i = 0; i < kWorkPerCommand; ++i)
+                word = word * 1664525u + 1013904223u;
+            commands.push_back(word);
+        }
+
+        static constexpr uint32_t kWorkPerCommand = 512;
+        std::vector<uint32_t> commands;
+        uint32_t flush_count = 0;
+    };
+
+    // Parallel recording writes each texture's tracked state back after submission, so the targets
+    // need a real object rather than a placeholder address
+    class StandInTexture : public RenderObject::ITexture
+    {
+    public:
+        void free() override {}
+        const RenderObject::TextureCreateDesc& get_create_desc() const override { return desc; }
+        RenderObject::ITexture_View* get_default_texture_view(TEXTURE_VIEW_TYPE) override { return nullptr; }
+        GRAPHICS_RESOURCE_STATE get_old_state() const override { return old_state; }
+        void set_old_state(GRAPHICS_RESOURCE_STATE state) override { old_state = state; }
+        GRAPHICS_RESOURCE_STATE get_new_state() const override { return new_state; }
+        void set_new_state(GRAPHICS_RESOURCE_STATE state) override { new_state = state; }
+
+        RenderObject::TextureCreateDesc desc;
+        GRAPHICS_RESOURCE_STATE old_state = GRAPHICS_RESOURCE_STATE_COMMON;
+        GRAPHICS_RESOURCE_STATE new_state = GRAPHICS_RESOURCE_STATE_COMMON;
+    };
+
+    class DrawPass : public RGPass
+    {
+    public:
+        DrawPass() : RGPass(RG_RENDER_PASS) {}
+
+        void setup(RenderGraphBuilder&) override {}
+        void execute(RenderGraph&, RenderPassContext& context) override
+        {
+            context.device_context->render_encoder_bind_pipeline(nullptr);
+            for (uint32_t draw = 0; draw < kDrawsPerPass; ++draw)
+                context.device_context->render_encoder_draw(3, 0);
+        }
+
+        static constexpr uint32_t kDrawsPerPass = 64;
+    };
+
+    constexpr uint32_t kMinPassesPerGroup = 16;
+
+    RGTextureCreateDesc texture_desc(uint32_t size)
+    {
+        RGTextureCreateDesc desc = {};
+        desc.m_width = size;
+        desc.m_height = size;
+        desc.m_format = TEX_FORMAT_RGBA8_UNORM;
+        desc.m_bindFlags = GRAPHICS_RESOURCE_BIND_RENDER_TARGET | GRAPHICS_RESOURCE_BIND_SHADER_RESOURCE;
+        return desc;
+    }
+
+    // Per-view passes: each renders its own target and samples the previous view's, then a
+    // composite reads them all
+    double record_frame(uint32_t pass_count, uint32_t worker_count, uint32_t iterations)
+    {
+        StandInDeviceContext immediate;
+        std::vector<std::unique_ptr<StandInDeviceContext>> deferred;
+        std::vector<RenderObject::IDeviceContext*> deferred_contexts;
+        for (uint32_t i = 0; i < worker_count; ++i)
+        {
+            deferred.push_back(std::make_unique<StandInDeviceContext>());
+            deferred_contexts.push_back(deferred.back().get());
+        }
+
+        std::vector<RGTextureRef> targets;
+        std::vector<std::string> names;
+        names.reserve(pass_count);
+        std::unique_ptr<StandInTexture[]> textures(new StandInTexture[pass_count]);
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            builder.with_context(&immediate).with_deferred_contexts(deferred_contexts.data(), worker_count);
+            for (uint32_t i = 0; i < pass_count; ++i)
+            {
+                names.push_back("View" + std::to_string(i));
+                targets.push_back(builder.create_texture(texture_desc(256), reinterpret_cast<const char8_t*>(names.back().c_str())));
+                targets.back()->texture = &textures[i];
+                builder.set_output(targets.back());
+            }
+        });
+
+        graph->set_min_passes_per_record_group(kMinPassesPerGroup);
+
+        std::unique_ptr<DrawPass[]> passes(new DrawPass[pass_count]);
+        double best_ms = 0.0;
+        for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            graph->reset_passes();
+            RenderGraphBuilder* builder = graph->get_builder();
+            for (uint32_t i = 0; i < pass_count; ++i)
+            {
+                builder->add_pass(u8"View", &passes[i]);
+                if (i > 0)
+                    passes[i].read(targets[i - 1]);
+                passes[i].write(targets[i], GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+            }
+
+            immediate.commands.clear();
+            for (auto& context : deferred)
+                context->commands.clear();
+
+            const auto begin = Clock::now();
+            graph->execute();
+            const double ms = elapsed_ms(begin);
+            best_ms = iteration == 0 ? ms : std::min(best_ms, ms);
+        }
+
+        size_t command_count = immediate.commands.size();
+        for (auto& context : deferred)
+            command_count += context->commands.size();
+        assert(command_count >= size_t(pass_count) * (DrawPass::kDrawsPerPass + 1));
+        // Groups never drop below the minimum pass count, which caps them on wide machines
+        const uint32_t expected_groups = std::max(std::min(worker_count, pass_count / kMinPassesPerGroup), 1u);
+        assert(graph->get_record_groups().size() == expected_groups);
+        for (uint32_t i = 0; i < expected_groups && worker_count > 1; ++i)
+            assert(!deferred[i]->commands.empty());
+        assert(textures[pass_count - 1].new_state == GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+        return best_ms;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t pass_count = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 512;
+    const uint32_t iterations = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 5;
+    assert(pass_count >= 64 && iterations > 0);
+
+    const uint32_t hardware_threads = std::thread::hardware_concurrency();
+    std::printf("%u passes x %u draws, %u hardware threads\n", pass_count, DrawPass::kDrawsPerPass, hardware_threads);
+    const double serial_ms = record_frame(pass_count, 0, iterations);
+    std::printf("  serial      %8.3f ms\n", serial_ms);
+
+    // Fixed counts compare machines; the last run gives every hardware thread a context
+    std::vector<uint32_t> worker_counts = { 2u, 4u, 8u };
+    if (hardware_threads > 1 && std::find(worker_counts.begin(), worker_counts.end(), hardware_threads) == worker_counts.end())
+        worker_counts.push_back(hardware_threads);
+    for (uint32_t worker_count : worker_counts)
+    {
+        const double ms = record_frame(pass_count, worker_count, iterations);
+        std::printf("  %u contexts  %8.3f ms  (%.2fx)\n", worker_count, ms, serial_ms / ms);
+    }
+
+    std::cout << "Render graph record benchmark passed" << std::endl;
+    return 0;
+}
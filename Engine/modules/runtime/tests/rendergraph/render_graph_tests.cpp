@@ -0,0 +1,1237 @@
+#include "graphics/interface/command_queue.h"
+#include "graphics/interface/device_context.h"
+#include "graphics/rendergraph/render_graph.h"
+#include "graphics/rendergraph/render_graph_builder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    using namespace Cyber::render_graph;
+
+    // Declares its accesses from a callback so each test can describe a graph inline
+    class TestPass : public RGPass
+    {
+    public:
+        explicit TestPass(std::function<void(TestPass&)> declare)
+            : RGPass(RG_RENDER_PASS)
+            , declare_accesses(std::move(declare))
+        {
+        }
+
+        void setup(RenderGraphBuilder&) override
+        {
+            if (declare_accesses)
+                declare_accesses(*this);
+        }
+
+        void execute(RenderGraph&, RenderPassContext& context) override
+        {
+            ++execute_count;
+            recorded_context = context.device_context;
+            if (log)
+                log->push_back(label);
+        }
+
+        std::function<void(TestPass&)> declare_accesses;
+        uint32_t execute_count = 0;
+        RenderObject::IDeviceContext* recorded_context = nullptr;
+        std::vector<std::string>* log = nullptr;
+        std::string label;
+    };
+
+    class TestComputePass : public RGComputePass
+    {
+    public:
+        TestComputePass(std::function<void(TestComputePass&)> declare, std::vector<std::string>& event_log, const char* name)
+            : declare_accesses(std::move(declare))
+            , log(event_log)
+            , label(name)
+        {
+            set_async_compute();
+        }
+
+        void setup(RenderGraphBuilder&) override { declare_accesses(*this); }
+        void execute(RenderGraph&, RenderPassContext& context) override
+        {
+            recorded_context = context.device_context;
+            log.push_back(label);
+        }
+
+        std::function<void(TestComputePass&)> declare_accesses;
+        std::vector<std::string>& log;
+        std::string label;
+        RenderObject::IDeviceContext* recorded_context = nullptr;
+    };
+
+    // Logs GPU-side fence operations; fences are fake pointers, named by their id
+    class FakeCommandQueue : public RenderObject::ICommandQueue
+    {
+    public:
+        FakeCommandQueue(const char* queue_name, std::vector<std::string>& event_log) : name(queue_name), log(event_log) {}
+
+        void signal_fence(RenderObject::IFence* fence, uint64_t value) override
+        {
+            log.push_back(name + ":signal " + std::to_string(reinterpret_cast<uintptr_t>(fence) / 0x100) + "@" + std::to_string(value));
+        }
+        void wait_fence(RenderObject::IFence* fence, uint64_t value) override
+        {
+            log.push_back(name + ":wait " + std::to_string(reinterpret_cast<uintptr_t>(fence) / 0x100) + "@" + std::to_string(value));
+        }
+        COMMAND_QUEUE_TYPE get_type() const override { return COMMAND_QUEUE_TYPE_GRAPHICS; }
+        void set_type(COMMAND_QUEUE_TYPE) override {}
+        RenderObject::QueueIndex get_index() const override { return 0; }
+        void set_index(RenderObject::QueueIndex) override {}
+        uint64_t wait_for_idle() override { return 0; }
+        uint64_t get_completed_fence_value() override { return 0; }
+        void free() override {}
+
+        std::string name;
+        std::vector<std::string>& log;
+    };
+
+    // Records every barrier call; every other command is a no-op
+    class RecordingDeviceContext : public RenderObject::IDeviceContext
+    {
+    public:
+        void transition_resource_state(const ResourceBarrierDesc&) override {}
+        void cmd_begin() override {}
+        void cmd_end() override {}
+        void cmd_resource_barrier(RenderObject::ITexture*, GRAPHICS_RESOURCE_STATE, GRAPHICS_RESOURCE_STATE) override { ++single_barrier_calls; }
+        void cmd_resource_barrier(RenderObject::IBuffer*, GRAPHICS_RESOURCE_STATE, GRAPHICS_RESOURCE_STATE) override { ++single_barrier_calls; }
+        void cmd_resource_barrier(const ResourceBarrierDesc& desc) override
+        {
+            batches.push_back(desc);
+            batch_pass.push_back(current_pass);
+            if (log)
+                log->push_back(name + ":barrier " + std::to_string(desc.texture_barriers.size() + desc.buffer_barriers.size()));
+        }
+        void flush() override
+        {
+            ++flush_count;
+            if (log)
+                log->push_back(name + ":flush");
+        }
+        void finish_frame() override {}
+        void set_frame_buffer(RenderObject::IFrameBuffer*) override {}
+        RenderObject::IFrameBuffer* get_frame_buffer() const override { return nullptr; }
+        void set_render_target(uint32_t, RenderObject::ITexture_View**, RenderObject::ITexture_View*) override {}
+        void cmd_begin_render_pass(const RenderObject::BeginRenderPassAttribs&) override {}
+        void cmd_next_sub_pass() override {}
+        void cmd_end_render_pass() override {}
+        void transition_subpass_attachments(uint32_t) override {}
+        void render_encoder_bind_descriptor_set(RenderObject::IDescriptorSet*) override {}
+        void render_encoder_set_viewport(uint32_t, const RenderObject::Viewport*) override {}
+        void render_encoder_set_scissor(uint32_t, const RenderObject::Rect*) override {}
+        void render_encoder_set_blend_factor(const float*) override {}
+        void render_encoder_bind_pipeline(RenderObject::IRenderPipeline*) override {}
+        void render_encoder_bind_vertex_buffer(uint32_t, RenderObject::IBuffer**, const uint32_t*, const uint64_t*) override {}
+        void render_encoder_bind_index_buffer(RenderObject::IBuffer*, uint32_t, uint64_t) override {}
+        void render_encoder_push_constants(RenderObject::IRootSignature*, const char8_t*, const void*) override {}
+        void render_encoder_draw(uint32_t, uint32_t) override {}
+        void render_encoder_draw_instanced(uint32_t, uint32_t, uint32_t, uint32_t) override {}
+        void render_encoder_draw_indexed(uint32_t, uint32_t, uint32_t) override {}
+        void render_encoder_draw_indexed_instanced(uint32_t, uint32_t, uint32_t, uint32_t, uint32_t) override {}
+        void set_shader_resource_view(SHADER_STAGE, uint32_t, RenderObject::ITexture_View*) override {}
+        void set_constant_buffer_view(SHADER_STAGE, uint32_t, RenderObject::IBuffer*) override {}
+        void set_unordered_access_view(SHADER_STAGE, uint32_t, RenderObject::IBuffer*) override {}
+        void set_root_constant_buffer_view(SHADER_STAGE, uint32_t, RenderObject::IBuffer*, uint64_t) override {}
+        void prepare_for_rendering() override {}
+        void create_render_pass(const RenderObject::RenderPassDesc&, RenderObject::IRenderPass**) override {}
+        void execute_deferred_context(RenderObject::IDeviceContext* deferred_context) override
+        {
+            executed_deferred_contexts.push_back(deferred_context);
+        }
+
+        std::vector<ResourceBarrierDesc> batches;
+        // Passes bump this as they execute, so each batch knows which pass it preceded
+        std::vector<uint32_t> batch_pass;
+        uint32_t current_pass = 0;
+        uint32_t single_barrier_calls = 0;
+        uint32_t flush_count = 0;
+        std::vector<RenderObject::IDeviceContext*> executed_deferred_contexts;
+        std::vector<std::string>* log = nullptr;
+        std::string name;
+    };
+
+    // The graph only forwards RHI pointers into barriers, so distinct fake addresses suffice
+    template<typename T>
+    T* fake_rhi_object(uintptr_t id)
+    {
+        return reinterpret_cast<T*>(id * 0x100);
+    }
+
+    // Stands in for a backend texture where the graph itself reads or writes the tracked state
+    class StateTrackingTexture : public RenderObject::ITexture
+    {
+    public:
+        void free() override {}
+        const RenderObject::TextureCreateDesc& get_create_desc() const override { return desc; }
+        RenderObject::ITexture_View* get_default_texture_view(TEXTURE_VIEW_TYPE) override { return nullptr; }
+        GRAPHICS_RESOURCE_STATE get_old_state() const override { return old_state; }
+        void set_old_state(GRAPHICS_RESOURCE_STATE state) override { old_state = state; }
+        GRAPHICS_RESOURCE_STATE get_new_state() const override { return new_state; }
+        void set_new_state(GRAPHICS_RESOURCE_STATE state) override { new_state = state; }
+
+        RenderObject::TextureCreateDesc desc;
+        GRAPHICS_RESOURCE_STATE old_state = GRAPHICS_RESOURCE_STATE_COMMON;
+        GRAPHICS_RESOURCE_STATE new_state = GRAPHICS_RESOURCE_STATE_COMMON;
+    };
+
+    const TextureBarrier* find_barrier(const ResourceBarrierDesc& desc, RenderObject::ITexture* texture)
+    {
+        for (const TextureBarrier& barrier : desc.texture_barriers)
+        {
+            if (barrier.texture == texture)
+                return &barrier;
+        }
+        return nullptr;
+    }
+
+    RGTextureCreateDesc texture_desc(uint32_t width, uint32_t height,
+                                     uint32_t bind_flags = GRAPHICS_RESOURCE_BIND_SHADER_RESOURCE)
+    {
+        RGTextureCreateDesc desc = {};
+        desc.m_bindFlags = bind_flags;
+        desc.m_width = width;
+        desc.m_height = height;
+        desc.m_depth = 1;
+        desc.m_arraySize = 1;
+        desc.m_mipLevels = 1;
+        desc.m_format = TEX_FORMAT_RGBA8_UNORM;
+        desc.m_dimension = TEX_DIMENSION_2D;
+        return desc;
+    }
+
+    const RenderGraphResourceLifetime& lifetime_of(const RenderGraph& graph, const char* name)
+    {
+        for (const auto& lifetime : graph.get_compile_report().resources)
+        {
+            if (std::strcmp(reinterpret_cast<const char*>(lifetime.name), name) == 0)
+                return lifetime;
+        }
+        assert(false && "resource missing from compile report");
+        return graph.get_compile_report().resources.front();
+    }
+
+    bool was_culled(const RenderGraph& graph, const RGPass& pass)
+    {
+        for (const char8_t* name : graph.get_compile_report().culled_passes)
+        {
+            if (name == pass.pass_name)
+                return true;
+        }
+        return false;
+    }
+
+    struct ForwardGraph
+    {
+        RenderGraph* graph = nullptr;
+        RGTextureRef depth = nullptr;
+        RGTextureRef shadow = nullptr;
+        RGTextureRef color = nullptr;
+    };
+
+    ForwardGraph make_forward_graph()
+    {
+        ForwardGraph forward;
+        forward.graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            forward.depth = builder.create_texture(texture_desc(64, 64), u8"SceneDepth");
+            forward.shadow = builder.create_texture(texture_desc(128, 128), u8"ShadowMap");
+            forward.color = builder.create_texture(texture_desc(64, 64), u8"SceneColor");
+            builder.set_output(forward.color);
+        });
+        return forward;
+    }
+
+    void test_forward_graph_keeps_consumed_passes()
+    {
+        ForwardGraph forward = make_forward_graph();
+        RenderGraphBuilder* builder = forward.graph->get_builder();
+
+        TestPass pre_depth([&](TestPass& pass) { pass.write(forward.depth); });
+        TestPass shadow([&](TestPass& pass) { pass.write(forward.shadow); });
+        TestPass scene_color([&](TestPass& pass) {
+            pass.read(forward.shadow).read(forward.depth).write(forward.color);
+        });
+        builder->add_pass(u8"PreDepth", &pre_depth);
+        builder->add_pass(u8"Shadow", &shadow);
+        builder->add_pass(u8"SceneColor", &scene_color);
+        forward.graph->execute();
+
+        assert(pre_depth.execute_count == 1);
+        assert(shadow.execute_count == 1);
+        assert(scene_color.execute_count == 1);
+        assert(forward.graph->culled_passes.empty());
+        assert(forward.graph->culled_resources.empty());
+        assert(forward.graph->get_compile_report().executed_passes.size() == 3);
+
+        const RenderGraphResourceLifetime& shadow_lifetime = lifetime_of(*forward.graph, "ShadowMap");
+        assert(shadow_lifetime.first_pass == shadow.pass_node->order);
+        assert(shadow_lifetime.last_pass == scene_color.pass_node->order);
+        assert(shadow_lifetime.reader_count == 1);
+        assert(!shadow_lifetime.output);
+        const RenderGraphResourceLifetime& color_lifetime = lifetime_of(*forward.graph, "SceneColor");
+        assert(color_lifetime.first_pass == scene_color.pass_node->order);
+        assert(color_lifetime.last_pass == color_lifetime.first_pass);
+        assert(color_lifetime.output);
+
+        forward.graph->reset_passes();
+        RenderGraph::destroy(forward.graph);
+    }
+
+    void test_unread_shadow_pass_is_culled()
+    {
+        ForwardGraph forward = make_forward_graph();
+        RenderGraphBuilder* builder = forward.graph->get_builder();
+
+        // Shadows disabled: SceneColor no longer samples the shadow map
+        TestPass pre_depth([&](TestPass& pass) { pass.write(forward.depth); });
+        TestPass shadow([&](TestPass& pass) { pass.write(forward.shadow); });
+        TestPass scene_color([&](TestPass& pass) { pass.read(forward.depth).write(forward.color); });
+        builder->add_pass(u8"PreDepth", &pre_depth);
+        builder->add_pass(u8"Shadow", &shadow);
+        builder->add_pass(u8"SceneColor", &scene_color);
+        forward.graph->execute();
+
+        assert(shadow.execute_count == 0);
+        assert(pre_depth.execute_count == 1);
+        assert(scene_color.execute_count == 1);
+        assert(forward.graph->culled_passes.size() == 1);
+        assert(was_culled(*forward.graph, shadow));
+        assert(forward.graph->culled_resources.size() == 1);
+        assert(forward.graph->culled_resources[0] == forward.shadow->texture_node);
+        assert(lifetime_of(*forward.graph, "ShadowMap").culled);
+        assert(lifetime_of(*forward.graph, "ShadowMap").first_pass == UINT32_MAX);
+
+        forward.graph->reset_passes();
+        RenderGraph::destroy(forward.graph);
+    }
+
+    void test_culling_propagates_through_chains()
+    {
+        RGTextureRef half = nullptr;
+        RGTextureRef blurred = nullptr;
+        RGTextureRef color = nullptr;
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            half = builder.create_texture(texture_desc(32, 32), u8"Half");
+            blurred = builder.create_texture(texture_desc(32, 32), u8"Blurred");
+            color = builder.create_texture(texture_desc(64, 64), u8"Color");
+            builder.set_output(color);
+        });
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        TestPass downsample([&](TestPass& pass) { pass.write(half); });
+        TestPass blur([&](TestPass& pass) { pass.read(half).write(blurred); });
+        TestPass scene([&](TestPass& pass) { pass.write(color); });
+        TestPass overlay([&](TestPass& pass) { pass.read(color); });
+        builder->add_pass(u8"Downsample", &downsample);
+        builder->add_pass(u8"Blur", &blur);
+        builder->add_pass(u8"Scene", &scene);
+        builder->add_pass(u8"Overlay", &overlay);
+        graph->execute();
+
+        // Nothing reads Blurred, so Blur goes and takes Downsample with it. Overlay declares no
+        // writes and is kept for its side effects.
+        assert(downsample.execute_count == 0);
+        assert(blur.execute_count == 0);
+        assert(scene.execute_count == 1);
+        assert(overlay.execute_count == 1);
+        assert(graph->culled_passes.size() == 2);
+        assert(graph->culled_resources.size() == 2);
+
+        // Marking the chain's result as an output revives both passes
+        builder->set_output(blurred);
+        graph->execute();
+        assert(downsample.execute_count == 1);
+        assert(blur.execute_count == 1);
+        assert(graph->culled_passes.empty());
+        const RenderGraphResourceLifetime& half_lifetime = lifetime_of(*graph, "Half");
+        assert(half_lifetime.first_pass == downsample.pass_node->order);
+        assert(half_lifetime.last_pass == blur.pass_node->order);
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+    }
+
+    void test_overwritten_result_is_culled()
+    {
+        RGTextureRef target = nullptr;
+        RGTextureRef color = nullptr;
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            target = builder.create_texture(texture_desc(16, 16), u8"Target");
+            color = builder.create_texture(texture_desc(16, 16), u8"Color");
+            builder.set_output(color);
+        });
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        // First write is fully replaced before anyone reads it; the accumulate pass reads its
+        // predecessor through read_write
+        TestPass stale([&](TestPass& pass) { pass.write(target); });
+        TestPass fill([&](TestPass& pass) { pass.write(target); });
+        TestPass accumulate([&](TestPass& pass) { pass.read_write(target); });
+        TestPass resolve([&](TestPass& pass) { pass.read(target).write(color); });
+        builder->add_pass(u8"Stale", &stale);
+        builder->add_pass(u8"Fill", &fill);
+        builder->add_pass(u8"Accumulate", &accumulate);
+        builder->add_pass(u8"Resolve", &resolve);
+        graph->execute();
+
+        assert(stale.execute_count == 0);
+        assert(fill.execute_count == 1);
+        assert(accumulate.execute_count == 1);
+        assert(resolve.execute_count == 1);
+        assert(was_culled(*graph, stale));
+        assert(fill.pass_node->order < accumulate.pass_node->order);
+        assert(accumulate.pass_node->order < resolve.pass_node->order);
+        const RenderGraphResourceLifetime& target_lifetime = lifetime_of(*graph, "Target");
+        assert(target_lifetime.first_pass == fill.pass_node->order);
+        assert(target_lifetime.last_pass == resolve.pass_node->order);
+        assert(target_lifetime.reader_count == 2);
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+    }
+
+    // Every pair of placed resources that is live in the same pass must use disjoint heap bytes
+    void validate_aliasing(const RenderGraph& graph)
+    {
+        const RenderGraphCompileReport& report = graph.get_compile_report();
+        uint64_t unaliased = 0;
+        for (const auto& lifetime : report.resources)
+        {
+            if (lifetime.heap_index == UINT32_MAX)
+            {
+                assert(lifetime.imported || lifetime.output || lifetime.culled);
+                continue;
+            }
+            assert(!lifetime.imported && !lifetime.output && !lifetime.culled);
+            assert(lifetime.heap_offset + lifetime.size <= report.transient_heaps[lifetime.heap_index].size);
+            assert(lifetime.heap_offset % report.transient_heaps[lifetime.heap_index].alignment == 0);
+            unaliased += lifetime.size;
+        }
+        assert(unaliased == report.unaliased_transient_size);
+
+        for (size_t i = 0; i < report.resources.size(); ++i)
+        {
+            const RenderGraphResourceLifetime& a = report.resources[i];
+            if (a.heap_index == UINT32_MAX)
+                continue;
+            for (size_t j = i + 1; j < report.resources.size(); ++j)
+            {
+                const RenderGraphResourceLifetime& b = report.resources[j];
+                if (b.heap_index != a.heap_index)
+                    continue;
+                const bool live_together = a.first_pass <= b.last_pass && b.first_pass <= a.last_pass;
+                const bool share_bytes = a.heap_offset < b.heap_offset + b.size && b.heap_offset < a.heap_offset + a.size;
+                assert(!(live_together && share_bytes));
+            }
+        }
+
+        uint64_t aliased = 0;
+        for (const auto& heap : report.transient_heaps)
+            aliased += heap.size;
+        assert(aliased == report.aliased_transient_size);
+        assert(report.aliased_transient_size <= report.unaliased_transient_size);
+    }
+
+    void test_post_chain_aliases_ping_pong()
+    {
+        constexpr uint32_t kChainLength = 8;
+        const uint32_t target_flags = GRAPHICS_RESOURCE_BIND_RENDER_TARGET | GRAPHICS_RESOURCE_BIND_SHADER_RESOURCE;
+        std::vector<RGTextureRef> chain;
+        RGTextureRef color = nullptr;
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            static const char8_t* names[kChainLength] = { u8"Post0", u8"Post1", u8"Post2", u8"Post3",
+                                                          u8"Post4", u8"Post5", u8"Post6", u8"Post7" };
+            for (uint32_t i = 0; i < kChainLength; ++i)
+                chain.push_back(builder.create_texture(texture_desc(1920, 1080, target_flags), names[i]));
+            color = builder.create_texture(texture_desc(1920, 1080, target_flags), u8"Color");
+            builder.set_output(color);
+        });
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        std::vector<TestPass*> passes;
+        passes.push_back(new TestPass([&](TestPass& pass) { pass.write(chain[0]); }));
+        for (uint32_t i = 1; i < kChainLength; ++i)
+            passes.push_back(new TestPass([&, i](TestPass& pass) { pass.read(chain[i - 1]).write(chain[i]); }));
+        passes.push_back(new TestPass([&](TestPass& pass) { pass.read(chain.back()).write(color); }));
+        for (TestPass* pass : passes)
+            builder->add_pass(u8"Post", pass);
+        graph->compile();
+        validate_aliasing(*graph);
+
+        // Each link only overlaps its neighbours, so two targets' worth of memory suffices
+        const RenderGraphCompileReport& report = graph->get_compile_report();
+        const uint64_t target_size = lifetime_of(*graph, "Post0").size;
+        assert(report.transient_heaps.size() == 1);
+        assert(report.transient_heaps[0].resource_type == RenderObject::PoolResourceType::RTDSTextures);
+        assert(report.unaliased_transient_size == target_size * kChainLength);
+        assert(report.aliased_transient_size == target_size * 2);
+        assert(lifetime_of(*graph, "Color").heap_index == UINT32_MAX);
+        std::printf("Post chain: %u transients, peak %.1f MB vs %.1f MB unaliased\n", kChainLength,
+                    report.aliased_transient_size / (1024.0 * 1024.0), report.unaliased_transient_size / (1024.0 * 1024.0));
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+        for (TestPass* pass : passes)
+            delete pass;
+    }
+
+    void test_random_graph_aliasing()
+    {
+        constexpr uint32_t kResourceCount = 96;
+        constexpr uint32_t kPassCount = 160;
+        std::mt19937 random(7);
+        std::vector<RGTextureRef> textures;
+        std::vector<RGBufferRef> buffers;
+        std::vector<std::string> names;
+        names.reserve(kResourceCount + 1);
+        RGTextureRef color = nullptr;
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            for (uint32_t i = 0; i < kResourceCount; ++i)
+            {
+                names.push_back("Transient" + std::to_string(i));
+                const char8_t* name = reinterpret_cast<const char8_t*>(names.back().c_str());
+                if (i % 4 == 3)
+                {
+                    RGBufferCreateDesc desc = {};
+                    desc.size = 1024u * (1u + random() % 512u);
+                    buffers.push_back(builder.create_buffer(desc, name));
+                    continue;
+                }
+                const uint32_t size = 64u << (random() % 5u);
+                const uint32_t flags = i % 2 ? GRAPHICS_RESOURCE_BIND_RENDER_TARGET : GRAPHICS_RESOURCE_BIND_SHADER_RESOURCE;
+                RGTextureCreateDesc desc = texture_desc(size, size, flags);
+                if (i % 16 == 5)
+                    desc.m_sampleCount = SAMPLE_COUNT_4;
+                textures.push_back(builder.create_texture(desc, name));
+            }
+            color = builder.create_texture(texture_desc(256, 256), u8"Color");
+            builder.set_output(color);
+        });
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        std::vector<TestPass*> passes;
+        for (uint32_t i = 0; i < kPassCount; ++i)
+        {
+            const uint32_t read_texture = random() % textures.size();
+            const uint32_t write_texture = random() % textures.size();
+            const uint32_t buffer = random() % buffers.size();
+            const bool last = i + 1 == kPassCount;
+            passes.push_back(new TestPass([&, read_texture, write_texture, buffer, last](TestPass& pass) {
+                pass.read(textures[read_texture]).read_write(buffers[buffer]);
+                if (write_texture != read_texture)
+                    pass.write(textures[write_texture]);
+                if (last)
+                    pass.write(color);
+                else if (read_texture % 7 == 0)
+                    pass.write(color);
+            }));
+            builder->add_pass(u8"Random", passes.back());
+        }
+        graph->compile();
+        validate_aliasing(*graph);
+
+        const RenderGraphCompileReport& report = graph->get_compile_report();
+        assert(report.aliased_transient_size < report.unaliased_transient_size);
+        std::printf("Random graph: %zu passes kept, %zu heaps, peak %.1f MB vs %.1f MB unaliased\n",
+                    report.executed_passes.size(), report.transient_heaps.size(),
+                    report.aliased_transient_size / (1024.0 * 1024.0), report.unaliased_transient_size / (1024.0 * 1024.0));
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+        for (TestPass* pass : passes)
+            delete pass;
+    }
+
+    // Edges only link each access to the resource's last writer and open readers; every hazard
+    // between any two live passes must still be reachable through them, in registration order
+    void test_dependencies_cover_every_hazard()
+    {
+        constexpr uint32_t kResourceCount = 24;
+        constexpr uint32_t kPassCount = 200;
+        std::mt19937 random(11);
+        std::vector<RGTextureRef> textures;
+        std::vector<std::string> names;
+        names.reserve(kResourceCount);
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            for (uint32_t i = 0; i < kResourceCount; ++i)
+            {
+                names.push_back("Target" + std::to_string(i));
+                textures.push_back(builder.create_texture(texture_desc(64, 64),
+                    reinterpret_cast<const char8_t*>(names.back().c_str())));
+                builder.set_output(textures.back());
+            }
+        });
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        std::vector<TestPass*> passes;
+        for (uint32_t i = 0; i < kPassCount; ++i)
+        {
+            const uint32_t reads = random() % 4;
+            std::vector<std::pair<uint32_t, uint32_t>> accesses;
+            for (uint32_t access = 0; access < reads + 1; ++access)
+                accesses.emplace_back(random() % kResourceCount, access == 0 ? 1 + random() % 2 : 0);
+            passes.push_back(new TestPass([&, accesses](TestPass& pass) {
+                for (const auto& [resource, kind] : accesses)
+                {
+                    if (kind == 0)
+                        pass.read(textures[resource]);
+                    else if (kind == 1)
+                        pass.write(textures[resource]);
+                    else
+                        pass.read_write(textures[resource]);
+                }
+            }));
+            builder->add_pass(u8"Random", passes.back());
+        }
+        graph->compile();
+
+        const auto& order = graph->get_execution_order();
+        assert(order.size() == graph->passes.size() - graph->culled_passes.size());
+        std::vector<std::vector<uint8_t>> reachable(order.size(), std::vector<uint8_t>(order.size(), 0));
+        for (uint32_t i = 0; i < order.size(); ++i)
+        {
+            assert(i == 0 || order[i - 1]->pass_index < order[i]->pass_index);
+            for (const auto* dependency : order[i]->dependencies)
+            {
+                assert(dependency->order < i);
+                assert(std::count(order[i]->dependencies.begin(), order[i]->dependencies.end(), dependency) == 1);
+                reachable[i][dependency->order] = 1;
+                for (uint32_t j = 0; j < i; ++j)
+                    reachable[i][j] |= reachable[dependency->order][j];
+            }
+        }
+
+        for (uint32_t i = 0; i < order.size(); ++i)
+        {
+            for (uint32_t j = 0; j < i; ++j)
+            {
+                bool hazard = false;
+                for (const auto& later : order[i]->resource_accesses)
+                {
+                    for (const auto& earlier : order[j]->resource_accesses)
+                    {
+                        hazard |= later.resource == earlier.resource &&
+                            (later.access != ERGResourceAccess::Read || earlier.access != ERGResourceAccess::Read);
+                    }
+                }
+                assert(!hazard || reachable[i][j]);
+            }
+        }
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+        for (TestPass* pass : passes)
+            delete pass;
+    }
+
+    // Declares accesses like TestPass and stamps the recorder so batches map to passes
+    class RecordedPass : public TestPass
+    {
+    public:
+        RecordedPass(RecordingDeviceContext& context, uint32_t index, std::function<void(TestPass&)> declare)
+            : TestPass(std::move(declare))
+            , recorder(context)
+            , pass_index(index)
+        {
+        }
+
+        void execute(RenderGraph& graph, RenderPassContext& context) override
+        {
+            TestPass::execute(graph, context);
+            recorder.current_pass = pass_index + 1;
+        }
+
+        RecordingDeviceContext& recorder;
+        uint32_t pass_index;
+    };
+
+    void test_barriers_are_batched_per_pass()
+    {
+        RecordingDeviceContext recorder;
+        RGTextureRef depth = nullptr;
+        RGTextureRef shadow = nullptr;
+        RGTextureRef color = nullptr;
+        RGTextureRef output = nullptr;
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            builder.with_context(&recorder);
+            depth = builder.create_texture(texture_desc(64, 64), u8"Depth");
+            shadow = builder.create_texture(texture_desc(64, 64), u8"Shadow");
+            color = builder.create_texture(texture_desc(64, 64), u8"Color");
+            output = builder.create_texture(texture_desc(64, 64), u8"Output");
+            builder.set_output(output);
+        });
+        depth->texture = fake_rhi_object<RenderObject::ITexture>(1);
+        shadow->texture = fake_rhi_object<RenderObject::ITexture>(2);
+        color->texture = fake_rhi_object<RenderObject::ITexture>(3);
+        output->texture = fake_rhi_object<RenderObject::ITexture>(4);
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        RecordedPass pre_depth(recorder, 0, [&](TestPass& pass) { pass.write(depth, GRAPHICS_RESOURCE_STATE_DEPTH_WRITE); });
+        RecordedPass shadow_pass(recorder, 1, [&](TestPass& pass) { pass.write(shadow, GRAPHICS_RESOURCE_STATE_DEPTH_WRITE); });
+        RecordedPass scene_color(recorder, 2, [&](TestPass& pass) {
+            pass.read(shadow).read(depth, GRAPHICS_RESOURCE_STATE_DEPTH_READ).write(color, GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+        });
+        RecordedPass post(recorder, 3, [&](TestPass& pass) {
+            pass.read(color).read(depth).write(output, GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+        });
+        builder->add_pass(u8"PreDepth", &pre_depth);
+        builder->add_pass(u8"Shadow", &shadow_pass);
+        builder->add_pass(u8"SceneColor", &scene_color);
+        builder->add_pass(u8"Post", &post);
+        graph->execute();
+
+        // One batched call per pass boundary and nothing through the single-resource overloads
+        assert(recorder.single_barrier_calls == 0);
+        assert(recorder.batches.size() == 4);
+        for (uint32_t i = 0; i < 4; ++i)
+            assert(recorder.batch_pass[i] == i);
+
+        const ResourceBarrierDesc& before_pre_depth = recorder.batches[0];
+        assert(before_pre_depth.texture_barriers.size() == 1);
+        assert(before_pre_depth.texture_barriers[0].texture == depth->texture);
+        assert(before_pre_depth.texture_barriers[0].src_state == GRAPHICS_RESOURCE_STATE_UNKNOWN);
+        assert(before_pre_depth.texture_barriers[0].dst_state == GRAPHICS_RESOURCE_STATE_DEPTH_WRITE);
+
+        // Depth is read by SceneColor and Post; both reads share one transition to the combined state
+        const ResourceBarrierDesc& before_scene_color = recorder.batches[2];
+        assert(before_scene_color.texture_barriers.size() == 3);
+        assert(find_barrier(before_scene_color, shadow->texture)->dst_state == GRAPHICS_RESOURCE_STATE_SHADER_RESOURCE);
+        assert(find_barrier(before_scene_color, depth->texture)->dst_state ==
+               (GRAPHICS_RESOURCE_STATE_DEPTH_READ | GRAPHICS_RESOURCE_STATE_SHADER_RESOURCE));
+        assert(find_barrier(before_scene_color, color->texture)->dst_state == GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+
+        const ResourceBarrierDesc& before_post = recorder.batches[3];
+        assert(before_post.texture_barriers.size() == 2);
+        assert(find_barrier(before_post, depth->texture) == nullptr);
+        assert(find_barrier(before_post, color->texture)->dst_state == GRAPHICS_RESOURCE_STATE_SHADER_RESOURCE);
+        assert(find_barrier(before_post, output->texture)->dst_state == GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+
+        // Compile-time sources are explicit even though recorded full transitions defer to the backend
+        const RenderGraphBarrierBatch& compiled_batch = graph->get_barrier_batches()[2];
+        for (const RenderGraphBarrier& barrier : compiled_batch.barriers)
+        {
+            if (barrier.resource == depth)
+                assert(barrier.src_state == GRAPHICS_RESOURCE_STATE_DEPTH_WRITE);
+        }
+
+        const RenderGraphCompileReport& report = graph->get_compile_report();
+        assert(report.barrier_count == 7);
+        assert(report.barrier_batch_count == 4);
+        assert(report.elided_transition_count == 1);
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+    }
+
+    void test_split_and_uav_barriers()
+    {
+        RecordingDeviceContext recorder;
+        RGTextureRef history = nullptr;
+        RGTextureRef unrelated = nullptr;
+        RGTextureRef output = nullptr;
+        RGBufferRef counters = nullptr;
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            builder.with_context(&recorder);
+            history = builder.create_texture(texture_desc(64, 64), u8"History");
+            unrelated = builder.create_texture(texture_desc(64, 64), u8"Unrelated");
+            output = builder.create_texture(texture_desc(64, 64), u8"Output");
+            RGBufferCreateDesc buffer_desc = {};
+            buffer_desc.size = 256;
+            counters = builder.create_buffer(buffer_desc, u8"Counters");
+            builder.set_output(output);
+            builder.set_output(unrelated);
+        });
+        history->texture = fake_rhi_object<RenderObject::ITexture>(1);
+        unrelated->texture = fake_rhi_object<RenderObject::ITexture>(2);
+        output->texture = fake_rhi_object<RenderObject::ITexture>(3);
+        counters->buffer = fake_rhi_object<RenderObject::IBuffer>(4);
+        graph->set_split_barriers(true);
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        // History is written, then two independent passes run, then it is sampled: the transition
+        // to shader resource can begin after the write and end just before the read
+        RecordedPass produce(recorder, 0, [&](TestPass& pass) {
+            pass.write(history, GRAPHICS_RESOURCE_STATE_RENDER_TARGET).read_write(counters);
+        });
+        RecordedPass independent_a(recorder, 1, [&](TestPass& pass) { pass.read_write(counters).write(unrelated); });
+        RecordedPass independent_b(recorder, 2, [&](TestPass& pass) { pass.read_write(counters).write(unrelated); });
+        RecordedPass consume(recorder, 3, [&](TestPass& pass) {
+            pass.read(history).write(output, GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+        });
+        builder->add_pass(u8"Produce", &produce);
+        builder->add_pass(u8"IndependentA", &independent_a);
+        builder->add_pass(u8"IndependentB", &independent_b);
+        builder->add_pass(u8"Consume", &consume);
+        graph->execute();
+
+        assert(recorder.batches.size() == 4);
+        const TextureBarrier* begin = find_barrier(recorder.batches[1], history->texture);
+        assert(begin && begin->d3d12.begin_only && !begin->d3d12.end_only);
+        assert(begin->src_state == GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+        assert(begin->dst_state == GRAPHICS_RESOURCE_STATE_SHADER_RESOURCE);
+        assert(find_barrier(recorder.batches[2], history->texture) == nullptr);
+        const TextureBarrier* end = find_barrier(recorder.batches[3], history->texture);
+        assert(end && end->d3d12.end_only && !end->d3d12.begin_only);
+        assert(end->src_state == GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+
+        // Back-to-back unordered writes to the counters keep a UAV barrier between each pass
+        for (uint32_t i = 1; i < 3; ++i)
+        {
+            assert(recorder.batches[i].buffer_barriers.size() == 1);
+            const BufferBarrier& uav = recorder.batches[i].buffer_barriers[0];
+            assert(uav.buffer == counters->buffer);
+            assert(uav.src_state == GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS);
+            assert(uav.dst_state == GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS);
+        }
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+    }
+
+    // Buffers have no backend-tracked state, so every recorded transition names its source
+    void test_buffer_barriers_carry_source_across_frames()
+    {
+        RecordingDeviceContext recorder;
+        RGBufferRef lights = nullptr;
+        RGTextureRef output = nullptr;
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            builder.with_context(&recorder);
+            RGBufferCreateDesc buffer_desc = {};
+            buffer_desc.size = 4096;
+            lights = builder.create_buffer(buffer_desc, u8"Lights");
+            output = builder.create_texture(texture_desc(64, 64), u8"Output");
+            builder.set_output(output);
+        });
+        lights->buffer = fake_rhi_object<RenderObject::IBuffer>(1);
+        output->texture = fake_rhi_object<RenderObject::ITexture>(2);
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        RecordedPass cull(recorder, 0, [&](TestPass& pass) { pass.read_write(lights); });
+        RecordedPass shade(recorder, 1, [&](TestPass& pass) {
+            pass.read(lights).write(output, GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+        });
+        auto execute_frame = [&]() {
+            recorder.batches.clear();
+            recorder.current_pass = 0;
+            graph->reset_passes();
+            builder->add_pass(u8"LightCull", &cull);
+            builder->add_pass(u8"Shade", &shade);
+            graph->execute();
+            assert(recorder.batches.size() == 2);
+            for (const ResourceBarrierDesc& desc : recorder.batches)
+            {
+                assert(desc.buffer_barriers.size() == 1);
+                assert(desc.buffer_barriers[0].src_state != GRAPHICS_RESOURCE_STATE_UNKNOWN);
+            }
+        };
+
+        // The first frame starts from the state buffers are created in
+        execute_frame();
+        assert(recorder.batches[0].buffer_barriers[0].src_state == GRAPHICS_RESOURCE_STATE_COMMON);
+        assert(recorder.batches[0].buffer_barriers[0].dst_state == GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS);
+        assert(recorder.batches[1].buffer_barriers[0].src_state == GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS);
+        assert(recorder.batches[1].buffer_barriers[0].dst_state == GRAPHICS_RESOURCE_STATE_SHADER_RESOURCE);
+        assert(lights->state == GRAPHICS_RESOURCE_STATE_SHADER_RESOURCE);
+
+        // The next one starts where the last left it, through the cached plan as well
+        execute_frame();
+        assert(graph->get_compile_report().reused_cached_plan);
+        assert(recorder.batches[0].buffer_barriers[0].src_state == GRAPHICS_RESOURCE_STATE_SHADER_RESOURCE);
+        assert(recorder.batches[0].buffer_barriers[0].dst_state == GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS);
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+    }
+
+    // Rebuilding an identical graph each frame, as the forward pipeline does, reuses the plan
+    void test_unchanged_graph_reuses_compiled_plan()
+    {
+        RecordingDeviceContext recorder;
+        RGTextureRef depth = nullptr;
+        RGTextureRef color = nullptr;
+        RGTextureRef output = nullptr;
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            builder.with_context(&recorder);
+            depth = builder.create_texture(texture_desc(64, 64, GRAPHICS_RESOURCE_BIND_DEPTH_STENCIL), u8"Depth");
+            color = builder.create_texture(texture_desc(64, 64), u8"Color");
+            output = builder.create_texture(texture_desc(64, 64), u8"Output");
+            builder.set_output(output);
+        });
+        depth->texture = fake_rhi_object<RenderObject::ITexture>(1);
+        color->texture = fake_rhi_object<RenderObject::ITexture>(2);
+        output->texture = fake_rhi_object<RenderObject::ITexture>(3);
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        GRAPHICS_RESOURCE_STATE color_state = GRAPHICS_RESOURCE_STATE_RENDER_TARGET;
+        TestPass pre_depth([&](TestPass& pass) { pass.write(depth, GRAPHICS_RESOURCE_STATE_DEPTH_WRITE); });
+        TestPass unused([&](TestPass& pass) { pass.write(color); });
+        TestPass scene_color([&](TestPass& pass) { pass.read(depth, GRAPHICS_RESOURCE_STATE_DEPTH_READ).write(color, color_state); });
+        TestPass post([&](TestPass& pass) { pass.read(color).write(output, GRAPHICS_RESOURCE_STATE_RENDER_TARGET); });
+        auto build_frame = [&]() {
+            graph->reset_passes();
+            builder->add_pass(u8"PreDepth", &pre_depth);
+            builder->add_pass(u8"Unused", &unused);
+            builder->add_pass(u8"SceneColor", &scene_color);
+            builder->add_pass(u8"Post", &post);
+        };
+
+        build_frame();
+        graph->execute();
+        assert(!graph->get_compile_report().reused_cached_plan);
+        assert(graph->get_compile_report().culled_passes.size() == 1);
+        const uint64_t hash = graph->get_structure_hash();
+        const std::vector<ResourceBarrierDesc> first_frame = recorder.batches;
+        const uint64_t color_offset = color->texture_node->heap_offset;
+        const uint32_t color_heap = color->texture_node->heap_index;
+
+        // Swapping RHI objects is a parameter change: the cached barriers record the new pointers
+        for (uint32_t frame = 0; frame < 3; ++frame)
+        {
+            recorder.batches.clear();
+            output->texture = fake_rhi_object<RenderObject::ITexture>(10 + frame);
+            build_frame();
+            graph->execute();
+
+            const RenderGraphCompileReport& report = graph->get_compile_report();
+            assert(report.reused_cached_plan);
+            assert(graph->get_structure_hash() == hash);
+            assert(report.executed_passes.size() == 3 && report.culled_passes.size() == 1);
+            assert(std::strcmp(reinterpret_cast<const char*>(report.culled_passes[0]), "Unused") == 0);
+            assert(unused.pass_node->culled && unused.pass_node->order == UINT32_MAX);
+            assert(post.pass_node->order == 2);
+            assert(color->texture_node->heap_index == color_heap && color->texture_node->heap_offset == color_offset);
+            assert(recorder.batches.size() == first_frame.size());
+            for (size_t i = 0; i < first_frame.size(); ++i)
+                assert(recorder.batches[i].texture_barriers.size() == first_frame[i].texture_barriers.size());
+            assert(find_barrier(recorder.batches.back(), output->texture) != nullptr);
+        }
+        assert(unused.execute_count == 0 && post.execute_count == 4);
+
+        // A different required state changes the structure and recompiles
+        color_state = GRAPHICS_RESOURCE_STATE_UNORDERED_ACCESS;
+        build_frame();
+        graph->compile();
+        assert(!graph->get_compile_report().reused_cached_plan);
+        assert(graph->get_structure_hash() != hash);
+        assert(graph->get_execution_order()[1]->dependencies.size() == 1);
+
+        // So does resizing a transient, whose placement depends on its descriptor
+        color_state = GRAPHICS_RESOURCE_STATE_RENDER_TARGET;
+        build_frame();
+        graph->compile();
+        assert(!graph->get_compile_report().reused_cached_plan);
+        assert(graph->get_structure_hash() == hash);
+        color->create_desc.m_width = 128;
+        build_frame();
+        graph->compile();
+        assert(!graph->get_compile_report().reused_cached_plan);
+        assert(graph->get_structure_hash() != hash);
+
+        graph->discard_cached_plan();
+        graph->compile();
+        assert(!graph->get_compile_report().reused_cached_plan);
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+    }
+
+    // A chain recorded across three deferred contexts, each owned by its own thread
+    void test_parallel_recording_into_deferred_contexts()
+    {
+        constexpr uint32_t kPassCount = 12;
+        RecordingDeviceContext immediate;
+        RecordingDeviceContext deferred[3];
+        RenderObject::IDeviceContext* deferred_contexts[3] = { &deferred[0], &deferred[1], &deferred[2] };
+        std::vector<RGTextureRef> targets;
+        std::vector<std::string> names;
+        names.reserve(kPassCount);
+        StateTrackingTexture textures[kPassCount];
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            builder.with_context(&immediate).with_deferred_contexts(deferred_contexts, 3);
+            for (uint32_t i = 0; i < kPassCount; ++i)
+            {
+                names.push_back("Chain" + std::to_string(i));
+                targets.push_back(builder.create_texture(texture_desc(64, 64), reinterpret_cast<const char8_t*>(names.back().c_str())));
+                targets.back()->texture = &textures[i];
+            }
+            builder.set_output(targets.back());
+        });
+        graph->set_min_passes_per_record_group(4);
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        std::vector<TestPass*> passes;
+        for (uint32_t i = 0; i < kPassCount; ++i)
+        {
+            passes.push_back(new TestPass([&, i](TestPass& pass) {
+                if (i > 0)
+                    pass.read(targets[i - 1]);
+                pass.write(targets[i], GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+            }));
+            builder->add_pass(u8"Chain", passes.back());
+        }
+        graph->execute();
+
+        const auto& groups = graph->get_record_groups();
+        assert(groups.size() == 3 && graph->get_compile_report().record_group_count == 3);
+        for (uint32_t group_index = 0; group_index < 3; ++group_index)
+        {
+            assert(groups[group_index].first_pass == group_index * 4 && groups[group_index].pass_count == 4);
+            assert(deferred[group_index].flush_count == 1);
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                const TestPass* pass = passes[group_index * 4 + i];
+                assert(pass->execute_count == 1 && pass->recorded_context == deferred_contexts[group_index]);
+            }
+            // Sources are explicit since groups record before earlier groups have run
+            for (const ResourceBarrierDesc& desc : deferred[group_index].batches)
+            {
+                for (const TextureBarrier& barrier : desc.texture_barriers)
+                    assert(barrier.src_state == GRAPHICS_RESOURCE_STATE_RENDER_TARGET && barrier.record_only);
+            }
+        }
+
+        // First uses go to the immediate context once, then the groups are submitted in order
+        assert(immediate.batches.size() == 1);
+        assert(immediate.batches[0].texture_barriers.size() == kPassCount);
+        for (const TextureBarrier& barrier : immediate.batches[0].texture_barriers)
+        {
+            assert(barrier.src_state == GRAPHICS_RESOURCE_STATE_UNKNOWN && !barrier.record_only);
+            assert(barrier.dst_state == GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+        }
+        assert(immediate.executed_deferred_contexts.size() == 3);
+        for (uint32_t group_index = 0; group_index < 3; ++group_index)
+            assert(immediate.executed_deferred_contexts[group_index] == deferred_contexts[group_index]);
+        // Pass 0 has no transition left after the prologue; every later pass reads its predecessor
+        assert(deferred[0].batches.size() == 3 && deferred[1].batches.size() == 4 && deferred[2].batches.size() == 4);
+
+        // Tracked state is written back on the calling thread as the frame leaves each texture
+        for (uint32_t i = 0; i + 1 < kPassCount; ++i)
+            assert(textures[i].new_state == GRAPHICS_RESOURCE_STATE_SHADER_RESOURCE);
+        assert(textures[kPassCount - 1].new_state == GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+
+        // Too few passes for more than one group falls back to serial recording
+        graph->set_min_passes_per_record_group(kPassCount + 1);
+        immediate.batches.clear();
+        graph->execute();
+        assert(graph->get_record_groups().size() == 1);
+        assert(immediate.executed_deferred_contexts.size() == 3);
+        assert(immediate.batches.size() == kPassCount);
+        assert(passes.back()->recorded_context == &immediate);
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+        for (TestPass* pass : passes)
+            delete pass;
+    }
+
+    // Light culling on async compute overlaps shadow rendering; queues sync only where data crosses
+    void test_async_compute_syncs_only_crossing_dependencies()
+    {
+        std::vector<std::string> log;
+        RecordingDeviceContext graphics;
+        RecordingDeviceContext compute;
+        graphics.log = &log;
+        graphics.name = "gfx";
+        compute.log = &log;
+        compute.name = "compute";
+        FakeCommandQueue graphics_queue("gfx-queue", log);
+        FakeCommandQueue compute_queue("compute-queue", log);
+
+        RenderGraphAsyncComputeDesc async_desc;
+        async_desc.compute_context = &compute;
+        async_desc.graphics_queue = &graphics_queue;
+        async_desc.compute_queue = &compute_queue;
+        async_desc.graphics_fence = fake_rhi_object<RenderObject::IFence>(1);
+        async_desc.compute_fence = fake_rhi_object<RenderObject::IFence>(2);
+
+        RGTextureRef depth = nullptr;
+        RGTextureRef shadow = nullptr;
+        RGTextureRef color = nullptr;
+        RGBufferRef lights = nullptr;
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            builder.with_context(&graphics).with_async_compute(async_desc);
+            depth = builder.create_texture(texture_desc(64, 64, GRAPHICS_RESOURCE_BIND_DEPTH_STENCIL), u8"Depth");
+            shadow = builder.create_texture(texture_desc(64, 64, GRAPHICS_RESOURCE_BIND_DEPTH_STENCIL), u8"Shadow");
+            color = builder.create_texture(texture_desc(64, 64), u8"Color");
+            RGBufferCreateDesc buffer_desc = {};
+            buffer_desc.size = 4096;
+            lights = builder.create_buffer(buffer_desc, u8"Lights");
+            builder.set_output(color);
+        });
+        depth->texture = fake_rhi_object<RenderObject::ITexture>(1);
+        shadow->texture = fake_rhi_object<RenderObject::ITexture>(2);
+        color->texture = fake_rhi_object<RenderObject::ITexture>(3);
+        lights->buffer = fake_rhi_object<RenderObject::IBuffer>(4);
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        TestPass pre_depth([&](TestPass& pass) { pass.write(depth, GRAPHICS_RESOURCE_STATE_DEPTH_WRITE); });
+        TestComputePass light_cull([&](TestComputePass& pass) { pass.read(depth).write(lights); }, log, "LightCull");
+        TestPass shadow_pass([&](TestPass& pass) { pass.write(shadow, GRAPHICS_RESOURCE_STATE_DEPTH_WRITE); });
+        TestPass scene_color([&](TestPass& pass) {
+            pass.read(lights).read(shadow).write(color, GRAPHICS_RESOURCE_STATE_RENDER_TARGET);
+        });
+        pre_depth.log = shadow_pass.log = scene_color.log = &log;
+        pre_depth.label = "PreDepth";
+        shadow_pass.label = "Shadow";
+        scene_color.label = "SceneColor";
+        builder->add_pass(u8"PreDepth", &pre_depth);
+        builder->add_pass(u8"LightCull", &light_cull);
+        builder->add_pass(u8"Shadow", &shadow_pass);
+        builder->add_pass(u8"SceneColor", &scene_color);
+        graph->execute();
+
+        // Depth leaves DEPTH_WRITE and Lights has no tracked state, so the graphics queue transitions
+        // both for the compute queue before signaling it. Shadow needs no sync and overlaps LightCull.
+        const std::vector<std::string> expected = {
+            "gfx:barrier 1", "PreDepth",
+            "gfx:barrier 2", "gfx:flush", "gfx-queue:signal 1@1", "compute:flush", "compute-queue:wait 1@1", "LightCull",
+            "gfx:barrier 1", "Shadow",
+            "compute:flush", "compute-queue:signal 2@1", "gfx:flush", "gfx-queue:wait 2@1", "gfx:barrier 3", "SceneColor",
+            "compute:flush",
+        };
+        assert(log == expected);
+        assert(light_cull.recorded_context == &compute && shadow_pass.recorded_context == &graphics);
+
+        const RenderGraphCompileReport& report = graph->get_compile_report();
+        assert(report.async_compute_pass_count == 1);
+        assert(report.queue_wait_count == 2);
+        assert(graph->get_queue_syncs()[1].graphics_barriers.barriers.size() == 2);
+
+        // Rebuilding the same frame reuses the plan; the recreated pass nodes keep their queues
+        log.clear();
+        light_cull.recorded_context = nullptr;
+        graph->reset_passes();
+        builder->add_pass(u8"PreDepth", &pre_depth);
+        builder->add_pass(u8"LightCull", &light_cull);
+        builder->add_pass(u8"Shadow", &shadow_pass);
+        builder->add_pass(u8"SceneColor", &scene_color);
+        graph->execute();
+        assert(graph->get_compile_report().reused_cached_plan);
+        assert(light_cull.recorded_context == &compute && shadow_pass.recorded_context == &graphics);
+        assert(log.size() == expected.size());
+        assert(log[6] == "compute-queue:wait 1@2" && log[11] == "compute-queue:signal 2@2");
+
+        // A compute pass last in the frame is joined back into the graphics queue; fence values keep rising
+        log.clear();
+        TestComputePass histogram([&](TestComputePass& pass) { pass.read(color).write(lights); }, log, "Histogram");
+        builder->set_output(lights);
+        builder->add_pass(u8"Histogram", &histogram);
+        graph->execute();
+        assert(graph->get_compile_report().async_compute_pass_count == 2);
+        assert(graph->get_compile_report().queue_wait_count == 4);
+        assert(log[log.size() - 5] == "Histogram");
+        assert(log[log.size() - 3] == "compute-queue:signal 2@4");
+        assert(log.back() == "gfx-queue:wait 2@4");
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+    }
+
+    // Without a compute queue configured, async passes stay on graphics and no fences are used
+    void test_async_compute_falls_back_to_graphics()
+    {
+        std::vector<std::string> log;
+        RecordingDeviceContext graphics;
+        RGBufferRef data = nullptr;
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            builder.with_context(&graphics);
+            RGBufferCreateDesc buffer_desc = {};
+            buffer_desc.size = 256;
+            data = builder.create_buffer(buffer_desc, u8"Data");
+            builder.set_output(data);
+        });
+        TestComputePass compute([&](TestComputePass& pass) { pass.write(data); }, log, "Compute");
+        graph->get_builder()->add_pass(u8"Compute", &compute);
+        graph->execute();
+        assert(compute.recorded_context == &graphics);
+        assert(graph->get_queue_syncs().empty());
+        assert(graph->get_compile_report().async_compute_pass_count == 0);
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+    }
+
+    // Handles hash at compile time and resolve through the graph's flat table, string or not
+    void test_resources_resolve_by_interned_name()
+    {
+        static constexpr RGResourceName kSceneColor = u8"SceneColor";
+        static_assert(kSceneColor.hash == RGResourceName::hash_string(u8"SceneColor"), "handles hash at compile time");
+        static_assert(kSceneColor != RGResourceName(u8"SceneDepth"), "distinct names hash apart");
+
+        std::vector<std::string> names;
+        names.reserve(300);
+        RGTextureRef color = nullptr;
+        RGBufferRef lights = nullptr;
+        RenderGraph* graph = RenderGraph::create([&](RenderGraphBuilder& builder) {
+            // Enough resources to grow the table several times
+            for (uint32_t i = 0; i < 300; ++i)
+            {
+                names.push_back("Target" + std::to_string(i));
+                builder.create_texture(texture_desc(16, 16), reinterpret_cast<const char8_t*>(names.back().c_str()));
+            }
+            color = builder.create_texture(texture_desc(64, 64), kSceneColor);
+            RGBufferCreateDesc buffer_desc = {};
+            buffer_desc.size = 256;
+            lights = builder.create_buffer(buffer_desc, u8"Lights");
+            builder.set_output(color);
+        });
+        RenderGraphBuilder* builder = graph->get_builder();
+
+        assert(builder->get_texture(kSceneColor) == color);
+        assert(builder->get_texture(u8"SceneColor") == color);
+        assert(builder->get_buffer(u8"Lights") == lights);
+        assert(graph->find_resource(u8"Missing") == nullptr);
+        for (uint32_t i = 0; i < 300; ++i)
+        {
+            const std::string name = "Target" + std::to_string(i);
+            RGTextureRef texture = builder->get_texture(reinterpret_cast<const char8_t*>(name.c_str()));
+            assert(texture && texture->texture_node->resource_index == i);
+        }
+
+        // Inputs are keyed by hash; rebinding a name replaces the earlier resource
+        RGRenderPass pass;
+        builder->add_pass(u8"Composite", &pass);
+        pass.add_input(u8"Scene", builder->get_texture(u8"Target0"));
+        pass.add_input(u8"Scene", color).add_input(u8"Lights", lights);
+        assert(pass.input_textures.size() == 1);
+        assert(pass.get_input_texture(u8"Scene") == color);
+        assert(pass.get_input_buffer(u8"Lights") == lights);
+        assert(pass.get_input_texture(u8"Lights") == nullptr);
+
+        graph->reset_passes();
+        RenderGraph::destroy(graph);
+    }
+}
+
+int main()
+{
+    test_forward_graph_keeps_consumed_passes();
+    test_unread_shadow_pass_is_culled();
+    test_culling_propagates_through_chains();
+    test_overwritten_result_is_culled();
+    test_post_chain_aliases_ping_pong();
+    test_random_graph_aliasing();
+    test_dependencies_cover_every_hazard();
+    test_barriers_are_batched_per_pass();
+    test_split_and_uav_barriers();
+    test_buffer_barriers_carry_source_across_frames();
+    test_unchanged_graph_reuses_compiled_plan();
+    test_parallel_recording_into_deferred_contexts();
+    test_async_compute_syncs_only_crossing_dependencies();
+    test_async_compute_falls_back_to_graphics();
+    test_resources_resolve_by_interned_name();
+    std::cout << "Render graph tests passed\n";
+    return 0;
+}
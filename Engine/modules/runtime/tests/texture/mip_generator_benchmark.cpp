@@ -0,0 +1,133 @@
+#include "mip_generator.h"
+#include "common/graphics_utils.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    using namespace Cyber::TextureLoader;
+
+    struct BenchmarkCase
+    {
+        const char* name;
+        TEXTURE_FORMAT format;
+        MIP_FILTER_TYPE filter;
+        float alpha_cutoff;
+    };
+
+    // Deterministic gradient + hash noise so the corpus is reproducible without shipping 8K images
+    std::vector<uint8_t> make_source_image(uint32_t size, uint32_t pixel_size)
+    {
+        std::vector<uint8_t> pixels(size_t(size) * size * pixel_size);
+        uint32_t state = 0x9e3779b9u;
+        for(size_t i = 0; i < pixels.size(); ++i)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            pixels[i] = static_cast<uint8_t>((i / pixel_size) % size + (state & 0x3f));
+        }
+        if(pixel_size == 16)
+        {
+            auto* values = reinterpret_cast<float*>(pixels.data());
+            for(size_t i = 0; i < pixels.size() / sizeof(float); ++i)
+                values[i] = float(i % 977) / 977.0f;
+        }
+        return pixels;
+    }
+
+    // Returns the time to build the whole chain below mip 0
+    double generate_mip_chain(const BenchmarkCase& test, uint32_t size, const std::vector<uint8_t>& source)
+    {
+        const auto& fmt_attribs = get_texture_format_attribs(test.format);
+        const uint32_t pixel_size = uint32_t(fmt_attribs.component_size) * fmt_attribs.num_components;
+        const uint32_t mip_levels = compute_mip_levels_count(size, size);
+
+        std::vector<std::vector<uint8_t>> mips(mip_levels);
+        for(uint32_t mip = 1; mip < mip_levels; ++mip)
+        {
+            const uint32_t mip_size = std::max(1u, size >> mip);
+            mips[mip].resize(size_t(mip_size) * mip_size * pixel_size);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for(uint32_t mip = 1; mip < mip_levels; ++mip)
+        {
+            const uint32_t fine_size = std::max(1u, size >> (mip - 1));
+            ComputeMipLevelAttribs attribs;
+            attribs.format = test.format;
+            attribs.fine_mip_width = fine_size;
+            attribs.fine_mip_height = fine_size;
+            attribs.fine_mip_data = mip == 1 ? source.data() : mips[mip - 1].data();
+            attribs.fine_mip_stride = size_t(fine_size) * pixel_size;
+            attribs.coarse_mip_data = mips[mip].data();
+            attribs.coarse_mip_stride = size_t(std::max(1u, fine_size / 2)) * pixel_size;
+            attribs.filter_type = test.filter;
+            attribs.alpha_cutoff = test.alpha_cutoff;
+            compute_mip_level(attribs);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+
+    void check_box_filter()
+    {
+        // 2x2 RGBA8 -> 1x1 must be the rounded average
+        const uint8_t fine[16] = { 0, 10, 255, 255,  4, 20, 255, 0,  8, 30, 0, 255,  12, 41, 0, 0 };
+        uint8_t coarse[4] {};
+        ComputeMipLevelAttribs attribs;
+        attribs.format = TEX_FORMAT_RGBA8_UNORM;
+        attribs.fine_mip_width = 2;
+        attribs.fine_mip_height = 2;
+        attribs.fine_mip_data = fine;
+        attribs.fine_mip_stride = 8;
+        attribs.coarse_mip_data = coarse;
+        attribs.coarse_mip_stride = 4;
+        compute_mip_level(attribs);
+        assert(coarse[0] == 6 && coarse[1] == 25 && coarse[2] == 128 && coarse[3] == 128);
+
+        // Black/white in sRGB averages to ~0.5 linear, which is 188 in sRGB rather than 128
+        const uint8_t checker[16] = { 0, 0, 0, 255,  255, 255, 255, 255,  255, 255, 255, 255,  0, 0, 0, 255 };
+        attribs.format = TEX_FORMAT_RGBA8_UNORM_SRGB;
+        attribs.fine_mip_data = checker;
+        compute_mip_level(attribs);
+        assert(coarse[0] >= 187 && coarse[0] <= 189 && coarse[3] == 255);
+    }
+}
+
+int main()
+{
+    check_box_filter();
+
+    const BenchmarkCase cases[] = {
+        { "RGBA8 box", TEX_FORMAT_RGBA8_UNORM, MIP_FILTER_TYPE_BOX_AVERAGE, 0.0f },
+        { "RGBA8 sRGB box", TEX_FORMAT_RGBA8_UNORM_SRGB, MIP_FILTER_TYPE_BOX_AVERAGE, 0.0f },
+        { "RGBA8 box + alpha coverage", TEX_FORMAT_RGBA8_UNORM, MIP_FILTER_TYPE_BOX_AVERAGE, 0.5f },
+        { "RGBA8 kaiser", TEX_FORMAT_RGBA8_UNORM, MIP_FILTER_TYPE_KAISER, 0.0f },
+        { "RGBA32F box", TEX_FORMAT_RGBA32_FLOAT, MIP_FILTER_TYPE_BOX_AVERAGE, 0.0f },
+        { "RGBA32F kaiser", TEX_FORMAT_RGBA32_FLOAT, MIP_FILTER_TYPE_KAISER, 0.0f },
+    };
+    const uint32_t sizes[] = { 4096, 8192 };
+
+    std::cout << std::fixed << std::setprecision(1);
+    for(uint32_t size : sizes)
+    {
+        for(const BenchmarkCase& test : cases)
+        {
+            const auto& fmt_attribs = get_texture_format_attribs(test.format);
+            const std::vector<uint8_t> source = make_source_image(size, uint32_t(fmt_attribs.component_size) * fmt_attribs.num_components);
+            const double seconds = generate_mip_chain(test, size, source);
+            const double source_mpix = double(size) * double(size) / 1.0e6;
+            std::cout << size << "x" << size << " " << test.name << ": "
+                      << seconds * 1000.0 << " ms, " << source_mpix / seconds << " MPix/s\n";
+        }
+    }
+    return 0;
+}
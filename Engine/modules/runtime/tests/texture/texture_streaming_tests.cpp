@@ -0,0 +1,312 @@
+#include "graphics/features/texture_streaming.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+    using namespace Cyber;
+    using namespace Cyber::Renderer;
+
+    // Stands in for the GPU: holds each texture's resident mips and tracks allocated bytes
+    class FakeDevice final : public ITextureStreamingBackend
+    {
+    public:
+        bool set_resident_mips(StreamedTextureHandle texture, uint32_t first_mip) override
+        {
+            auto [it, inserted] = textures.try_emplace(texture);
+            if (inserted)
+            {
+                it->second.mip_bytes = pending_mip_bytes;
+                it->second.first_mip = static_cast<uint32_t>(pending_mip_bytes.size());
+            }
+            Texture& entry = it->second;
+            const bool loading = first_mip < entry.first_mip;
+            if (loading && failing.count(texture))
+                return false;
+
+            allocated_bytes -= bytes_from(entry, entry.first_mip);
+            entry.first_mip = first_mip;
+            allocated_bytes += bytes_from(entry, entry.first_mip);
+            peak_bytes = std::max(peak_bytes, allocated_bytes);
+            ++calls;
+            return true;
+        }
+
+        void release(StreamedTextureHandle texture) override
+        {
+            auto it = textures.find(texture);
+            assert(it != textures.end());
+            allocated_bytes -= bytes_from(it->second, it->second.first_mip);
+            textures.erase(it);
+        }
+
+        uint32_t first_mip(StreamedTextureHandle texture) const { return textures.at(texture).first_mip; }
+
+        std::vector<uint64_t> pending_mip_bytes;
+        std::unordered_set<StreamedTextureHandle> failing;
+        uint64_t allocated_bytes = 0;
+        uint64_t peak_bytes = 0;
+        uint32_t calls = 0;
+
+    private:
+        struct Texture
+        {
+            std::vector<uint64_t> mip_bytes;
+            uint32_t first_mip = 0;
+        };
+
+        static uint64_t bytes_from(const Texture& texture, uint32_t first_mip)
+        {
+            uint64_t bytes = 0;
+            for (uint32_t mip = first_mip; mip < texture.mip_bytes.size(); ++mip)
+                bytes += texture.mip_bytes[mip];
+            return bytes;
+        }
+
+        std::unordered_map<StreamedTextureHandle, Texture> textures;
+    };
+
+    // RGBA8 chain down to 1x1
+    StreamedTextureDesc make_desc(uint32_t size)
+    {
+        StreamedTextureDesc desc;
+        desc.width = size;
+        desc.height = size;
+        for (uint32_t mip_size = size;; mip_size /= 2)
+        {
+            desc.mip_bytes.push_back(static_cast<uint64_t>(mip_size) * mip_size * 4);
+            if (mip_size == 1)
+                break;
+        }
+        return desc;
+    }
+
+    uint64_t bytes_from(const StreamedTextureDesc& desc, uint32_t first_mip)
+    {
+        uint64_t bytes = 0;
+        for (uint32_t mip = first_mip; mip < desc.mip_bytes.size(); ++mip)
+            bytes += desc.mip_bytes[mip];
+        return bytes;
+    }
+
+    StreamedTextureHandle register_texture(TextureStreamer& streamer, FakeDevice& device, const StreamedTextureDesc& desc)
+    {
+        device.pending_mip_bytes.assign(desc.mip_bytes.begin(), desc.mip_bytes.end());
+        return streamer.register_texture(desc);
+    }
+
+    void test_wanted_mip()
+    {
+        assert(compute_wanted_mip(1024, 1024, 11, 1024.0f) == 0);
+        assert(compute_wanted_mip(1024, 1024, 11, 600.0f) == 0);
+        assert(compute_wanted_mip(1024, 1024, 11, 512.0f) == 1);
+        assert(compute_wanted_mip(1024, 256, 11, 200.0f) == 2);
+        assert(compute_wanted_mip(1024, 1024, 11, 4000.0f) == 0);
+        assert(compute_wanted_mip(1024, 1024, 11, 0.5f) == 10);
+        assert(compute_wanted_mip(1024, 1024, 11, 0.0f) == 10);
+        assert(compute_wanted_mip(1024, 1024, 11, 1024.0f, 1.0f) == 1);
+
+        const float3 eye(0.0f, 0.0f, 0.0f);
+        const float pixels = projected_screen_pixels(float3(0.0f, 0.0f, 10.0f), float3(1.0f, 0.0f, 0.0f), eye, 1.0f, 1000.0f);
+        assert(pixels > 99.0f && pixels < 101.0f);
+        assert(projected_screen_pixels(float3(0.0f, 0.0f, 1.0f), float3(2.0f, 2.0f, 2.0f), eye, 1.0f, 1000.0f) == 1000.0f);
+        assert(projected_screen_pixels(float3(0.0f, 0.0f, 0.0f), float3(1.0e30f, 1.0e30f, 1.0e30f), eye, 1.0f, 720.0f) == 720.0f);
+    }
+
+    void test_tail_resident_on_registration()
+    {
+        FakeDevice device;
+        TextureStreamer streamer(device);
+        const StreamedTextureDesc desc = make_desc(1024);
+        const StreamedTextureHandle texture = register_texture(streamer, device, desc);
+
+        // 1024 >> 4 is the first mip within the 64 texel tail
+        assert(streamer.get_tail_mip(texture) == 4);
+        assert(streamer.get_resident_mip(texture) == 4 && device.first_mip(texture) == 4);
+        assert(device.allocated_bytes == bytes_from(desc, 4));
+        assert(streamer.get_resident_bytes() == device.allocated_bytes);
+
+        // Not requested: stays at the tail, and the tail is never evicted even with no budget
+        streamer.set_budget(0);
+        streamer.update();
+        assert(streamer.get_resident_mip(texture) == 4);
+        assert(device.allocated_bytes == bytes_from(desc, 4));
+
+        const StreamedTextureHandle small = register_texture(streamer, device, make_desc(32));
+        assert(streamer.get_tail_mip(small) == 0 && streamer.get_resident_mip(small) == 0);
+
+        assert(streamer.register_texture({}) == kInvalidStreamedTexture);
+
+        streamer.unregister_texture(texture);
+        streamer.unregister_texture(small);
+        assert(device.allocated_bytes == 0 && streamer.get_resident_bytes() == 0);
+        // Handles are reused
+        assert(register_texture(streamer, device, desc) == small);
+    }
+
+    void test_budget_is_shared_fairly()
+    {
+        FakeDevice device;
+        const StreamedTextureDesc desc = make_desc(1024);
+        TextureStreamingSettings settings;
+        // Room for the tails plus roughly two full textures
+        settings.budget_bytes = 8 * bytes_from(desc, 4) + 2 * bytes_from(desc, 0);
+        settings.max_upload_bytes_per_update = 0;
+        TextureStreamer streamer(device, settings);
+
+        std::vector<StreamedTextureHandle> textures;
+        for (uint32_t i = 0; i < 8; ++i)
+            textures.push_back(register_texture(streamer, device, desc));
+
+        for (uint32_t frame = 0; frame < 4; ++frame)
+        {
+            for (StreamedTextureHandle texture : textures)
+                streamer.request(texture, 1024.0f);
+            streamer.update();
+            assert(device.peak_bytes <= settings.budget_bytes);
+            assert(device.allocated_bytes == streamer.get_resident_bytes());
+        }
+
+        // Nobody gets mip 0 while another texture is stuck two mips coarser
+        uint32_t finest = 32;
+        uint32_t coarsest = 0;
+        for (StreamedTextureHandle texture : textures)
+        {
+            assert(streamer.get_wanted_mip(texture) == 0);
+            finest = std::min(finest, streamer.get_resident_mip(texture));
+            coarsest = std::max(coarsest, streamer.get_resident_mip(texture));
+        }
+        assert(coarsest - finest <= 1);
+        assert(finest >= 1);
+        assert(streamer.get_stats().over_budget == 8);
+        assert(streamer.get_stats().wanted_bytes == 8 * bytes_from(desc, 0));
+
+        // A larger budget lets them all sharpen
+        streamer.set_budget(8 * bytes_from(desc, 0));
+        for (StreamedTextureHandle texture : textures)
+            streamer.request(texture, 1024.0f);
+        streamer.update();
+        for (StreamedTextureHandle texture : textures)
+            assert(streamer.get_resident_mip(texture) == 0);
+        assert(streamer.get_stats().over_budget == 0);
+        assert(device.allocated_bytes == 8 * bytes_from(desc, 0));
+
+        // Smaller on screen means coarser mips, and the freed memory goes back
+        for (StreamedTextureHandle texture : textures)
+            streamer.request(texture, 200.0f);
+        streamer.set_budget(8 * bytes_from(desc, 2));
+        streamer.update();
+        for (StreamedTextureHandle texture : textures)
+            assert(streamer.get_resident_mip(texture) == 2 && device.first_mip(texture) == 2);
+        assert(device.allocated_bytes == 8 * bytes_from(desc, 2));
+    }
+
+    void test_lru_eviction()
+    {
+        FakeDevice device;
+        const StreamedTextureDesc desc = make_desc(512);
+        TextureStreamingSettings settings;
+        settings.budget_bytes = 3 * bytes_from(desc, 3) + 2 * bytes_from(desc, 0) - bytes_from(desc, 3) * 2;
+        settings.max_upload_bytes_per_update = 0;
+        TextureStreamer streamer(device, settings);
+
+        const StreamedTextureHandle a = register_texture(streamer, device, desc);
+        const StreamedTextureHandle b = register_texture(streamer, device, desc);
+        const StreamedTextureHandle c = register_texture(streamer, device, desc);
+        assert(streamer.get_tail_mip(a) == 3);
+
+        streamer.request(a, 512.0f);
+        streamer.update();
+        assert(streamer.get_resident_mip(a) == 0);
+
+        // b is wanted, a is merely cached; both fit
+        streamer.request(b, 512.0f);
+        streamer.update();
+        assert(streamer.get_resident_mip(a) == 0 && streamer.get_resident_mip(b) == 0);
+
+        // c needs room: a was used least recently and gives its mips up, b keeps them
+        streamer.request(c, 512.0f);
+        streamer.update();
+        assert(streamer.get_resident_mip(c) == 0);
+        assert(streamer.get_resident_mip(b) == 0);
+        assert(streamer.get_resident_mip(a) > 0 && device.first_mip(a) == streamer.get_resident_mip(a));
+        assert(streamer.get_stats().evicted_bytes > 0);
+        assert(device.peak_bytes <= settings.budget_bytes);
+
+        // Touching a again makes b the oldest
+        streamer.request(a, 512.0f);
+        streamer.update();
+        assert(streamer.get_resident_mip(a) == 0 && streamer.get_resident_mip(c) == 0);
+        assert(streamer.get_resident_mip(b) > 0);
+        assert(device.peak_bytes <= settings.budget_bytes);
+    }
+
+    void test_upload_limit_and_retry()
+    {
+        FakeDevice device;
+        const StreamedTextureDesc desc = make_desc(1024);
+        TextureStreamingSettings settings;
+        settings.budget_bytes = 1ull << 30;
+        settings.max_upload_bytes_per_update = desc.mip_bytes[1];
+        TextureStreamer streamer(device, settings);
+
+        const StreamedTextureHandle texture = register_texture(streamer, device, desc);
+        uint32_t updates = 0;
+        while (streamer.get_resident_mip(texture) > 0)
+        {
+            streamer.request(texture, 1024.0f);
+            streamer.update();
+            ++updates;
+            // Coarse mips share an update; mip 0 exceeds the allowance but still goes alone
+            const TextureStreamingStats& stats = streamer.get_stats();
+            assert(stats.uploaded_bytes <= settings.max_upload_bytes_per_update || stats.uploaded_bytes == desc.mip_bytes[0]);
+            assert(updates < 8);
+        }
+        assert(updates == 3);
+        assert(device.allocated_bytes == bytes_from(desc, 0));
+
+        // A load that fails leaves residency alone and is tried again
+        const StreamedTextureHandle other = register_texture(streamer, device, desc);
+        device.failing.insert(other);
+        streamer.request(other, 256.0f);
+        streamer.update();
+        assert(streamer.get_resident_mip(other) == 4 && device.first_mip(other) == 4);
+        assert(streamer.get_resident_bytes() == device.allocated_bytes);
+
+        device.failing.clear();
+        for (uint32_t i = 0; i < 4 && streamer.get_resident_mip(other) > 2; ++i)
+        {
+            streamer.request(other, 256.0f);
+            streamer.request(texture, 1024.0f);
+            streamer.update();
+        }
+        assert(streamer.get_resident_mip(other) == 2);
+        assert(streamer.get_resident_bytes() == device.allocated_bytes);
+
+        // A tail that could not load on registration is retried by update
+        device.failing.insert(2);
+        const StreamedTextureHandle late = register_texture(streamer, device, desc);
+        assert(late == 2);
+        assert(streamer.get_resident_mip(late) == static_cast<uint32_t>(desc.mip_bytes.size()));
+        device.failing.clear();
+        streamer.update();
+        assert(streamer.get_resident_mip(late) == 4);
+        assert(streamer.get_resident_bytes() == device.allocated_bytes);
+    }
+}
+
+int main()
+{
+    test_wanted_mip();
+    test_tail_resident_on_registration();
+    test_budget_is_shared_fairly();
+    test_lru_eviction();
+    test_upload_limit_and_retry();
+    std::printf("Texture streaming tests passed\n");
+    return 0;
+}
@@ -7,6 +7,7 @@ target("CyberRuntime")
     add_includedirs("src/inputsystem", {public=true})
     add_defines("CYBER_API_EXPORT")
     add_defines("CYBER_COOKED_MESH_EXPORTS")
+    add_defines("CYBER_MAPPED_FILE_EXPORTS")
     add_files("src/graphics/interface/*.cpp")
     add_files("src/graphics/backend/d3d12/*.cpp")
     add_files("src/graphics/common/*.cpp")
@@ -37,6 +38,7 @@ target("CyberRuntime")
     add_deps("nlohmann_json")
     add_deps("GLTF", {public = true})
     add_deps("OpenFBX", {public = true})
+    add_deps("zlib")
     if (is_os("windows")) then
         add_links("windowscodecs", "ole32", "comdlg32", "shell32")
     end
@@ -53,6 +55,90 @@ target("AssetFoundationTests")
     add_files("tests/asset/asset_foundation_tests.cpp")
     add_deps("CyberRuntime", {public = true})
 
+target("AssetRegistryFormatTests")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/asset/asset_registry_format_tests.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("AssetRegistryBenchmark")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/asset/asset_registry_benchmark.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("AssetHashBenchmark")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/asset/asset_hash_benchmark.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("AssetCookSchedulerTests")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/asset/asset_cook_scheduler_tests.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("DerivedDataCacheTests")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/asset/derived_data_cache_tests.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("AssetPackageTests")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/asset/asset_package_tests.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("AssetManagerTests")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/asset/asset_manager_tests.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("MeshOptimizerTests")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/asset/mesh_optimizer_tests.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("RenderGraphTests")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/rendergraph/render_graph_tests.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("RenderGraphBenchmark")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/rendergraph/render_graph_benchmark.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("RenderGraphRecordBenchmark")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/rendergraph/render_graph_record_benchmark.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("RenderGraphLookupBenchmark")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/rendergraph/render_graph_lookup_benchmark.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("FrustumCullingBenchmark")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/culling/frustum_culling_benchmark.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("TextureCompressionTests")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/asset/texture_compression_tests.cpp")
+    add_deps("CyberRuntime", {public = true})
+
 target("ModelLoaderTests")
     set_kind("binary")
     set_default(false)
@@ -60,6 +146,18 @@ target("ModelLoaderTests")
     add_files("tests/asset/model_loader_tests.cpp")
     add_deps("ModelLoader", {public = true})
 
+target("TextureStreamingTests")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/texture/texture_streaming_tests.cpp")
+    add_deps("CyberRuntime", {public = true})
+
+target("MipGeneratorBenchmark")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/texture/mip_generator_benchmark.cpp")
+    add_deps("TextureLoader", {public = true})
+
 target("MeshAssetMigrationTool")
     set_kind("binary")
     set_default(false)
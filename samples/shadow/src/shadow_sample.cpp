@@ -451,12 +451,9 @@ namespace Cyber
                 cube_verts[i].normal = model_verts[i].normal;
                 cube_verts[i].uv = model_verts[i].uv0;
             }
-            uint32_t* cube_indices = cyber_new_n<uint32_t>(index_count);
-            for(size_t i = 0; i < index_count; ++i)
-                cube_indices[i] = model_indices[i];
 
             create_vertex_buffer(cube_verts, vertex_count * sizeof(CubeVertex), cube_item.vertex_buffer);
-            create_index_buffer(cube_indices, index_count * sizeof(uint32_t), cube_item.index_buffer);
+            create_index_buffer(model_indices.data(), index_count * sizeof(uint32_t), cube_item.index_buffer);
             cube_item.index_count = index_count;
 
             // Constant buffers
@@ -21,13 +21,6 @@ namespace Cyber
     {
         class CYBER_GAME_API SponzaApp : public SampleApp
         {
-            struct SponzaVertex
-            {
-                float3 position;
-                float3 normal;
-                float2 uv;
-            };
-
             struct SceneConstants
             {
                 float4x4 view_proj_matrix;
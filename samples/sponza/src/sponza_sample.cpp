@@ -6,6 +6,7 @@
 #include "gameruntime/project_settings.h"
 #include "gameruntime/world.h"
 #include "asset/mesh_importer.h"
+#include "graphics/features/forward_pass.h"
 #include "graphics/interface/device_context.h"
 #include "core/file_helper.hpp"
 #include "log/Log.h"
@@ -16,6 +17,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <filesystem>
 
 namespace Cyber
@@ -175,35 +177,13 @@ namespace Cyber
 
             const auto vertex_count = mc.model->get_vertex_count();
             const auto index_count  = mc.model->get_index_count();
-            const auto model_verts  = mc.model->get_vertex_data();
+            const auto model_bytes  = mc.model->get_vertex_bytes();
             const auto model_idx    = mc.model->get_index_data();
+            const auto& layout      = mc.model->get_vertex_layout();
 
-            eastl::vector<SponzaVertex> vertices(vertex_count);
-            float3 bounds_min{0.0f, 0.0f, 0.0f};
-            float3 bounds_max{0.0f, 0.0f, 0.0f};
-            for (size_t i = 0; i < vertex_count; ++i)
-            {
-                vertices[i].position = model_verts[i].pos;
-                vertices[i].normal   = model_verts[i].normal;
-                vertices[i].uv       = model_verts[i].uv0;
-                if (i == 0)
-                {
-                    bounds_min = model_verts[i].pos;
-                    bounds_max = model_verts[i].pos;
-                }
-                else
-                {
-                    bounds_min = Math::min(bounds_min, model_verts[i].pos);
-                    bounds_max = Math::max(bounds_max, model_verts[i].pos);
-                }
-            }
-
-            eastl::vector<uint32_t> indices(index_count);
-            for (size_t i = 0; i < index_count; ++i)
-                indices[i] = model_idx[i];
-
-            create_vertex_buffer(vertices.data(), vertex_count * sizeof(SponzaVertex), mc.vertex_buffer);
-            create_index_buffer(indices.data(), index_count * sizeof(uint32_t), mc.index_buffer);
+            // Vertices are uploaded as cooked; the forward passes bind them with the model's layout
+            create_vertex_buffer(model_bytes.data(), static_cast<uint32_t>(model_bytes.size()), mc.vertex_buffer);
+            create_index_buffer(model_idx.data(), index_count * sizeof(uint32_t), mc.index_buffer);
             if (!mc.vertex_buffer || !mc.index_buffer)
             {
                 CB_ERROR("MeshComponent GPU buffer creation failed: node='{}', vertices={}, indices={}",
@@ -213,8 +193,11 @@ namespace Cyber
                 return false;
             }
 
-            mc.vertex_stride = sizeof(SponzaVertex);
+            mc.vertex_stride = layout.stride;
+            mc.vertex_layout = layout;
             mc.draw_primitives.clear();
+            mc.primitive_decode = nullptr;
+            eastl::vector<Renderer::ForwardPrimitiveDecode> primitive_decode;
 
             const auto& meshes    = mc.model->get_meshes();
             const auto& materials = mc.model->get_materials();
@@ -241,7 +224,11 @@ namespace Cyber
                     engine_dp.first_index = prim.first_index;
                     engine_dp.index_count = prim.index_count;
                     engine_dp.base_color_view = base_color_view;
+                    for (const auto& lod : prim.lods)
+                        engine_dp.lods.push_back({ lod.first_index, lod.index_count, lod.error });
                     mc.draw_primitives.push_back(engine_dp);
+                    if (!layout.IsFloat())
+                        primitive_decode.push_back(Renderer::make_forward_primitive_decode(layout, prim.decode));
                 }
             }
 
@@ -253,10 +240,33 @@ namespace Cyber
                 return false;
             }
 
+            // One root constant buffer slot per draw primitive, in draw_primitives order
+            if (!primitive_decode.empty())
+            {
+                eastl::vector<uint8_t> decode_slots(primitive_decode.size() * Renderer::kForwardPrimitiveDecodeStride);
+                for (size_t i = 0; i < primitive_decode.size(); ++i)
+                {
+                    std::memcpy(decode_slots.data() + i * Renderer::kForwardPrimitiveDecodeStride,
+                                &primitive_decode[i], sizeof(Renderer::ForwardPrimitiveDecode));
+                }
+                create_buffer(GRAPHICS_RESOURCE_BIND_UNIFORM_BUFFER, static_cast<uint32_t>(decode_slots.size()),
+                              GRAPHICS_RESOURCE_USAGE_DEFAULT, CPU_ACCESS_NONE, decode_slots.data(), mc.primitive_decode);
+                if (!mc.primitive_decode)
+                {
+                    CB_ERROR("MeshComponent decode buffer creation failed: node='{}'", node.name.c_str());
+                    mc.vertex_buffer = nullptr;
+                    mc.index_buffer = nullptr;
+                    return false;
+                }
+            }
+
+            // Primitive bounds are cooked from the decoded positions, so compact layouts need no CPU decode
+            const BoundBox bounds = mc.model->compute_bounding_box(float4x4::Identity());
+
             mc.runtime_vertex_count = vertex_count;
             mc.runtime_index_count = index_count;
-            mc.runtime_bounds_min = bounds_min;
-            mc.runtime_bounds_max = bounds_max;
+            mc.runtime_bounds_min = bounds.Min;
+            mc.runtime_bounds_max = bounds.Max;
             mc.runtime_bounds_valid = vertex_count > 0;
             mc.gpu_ready = true;
             CB_INFO("MeshComponent GPU ready: node='{}', vertices={}, indices={}, primitives={}",
@@ -0,0 +1,42 @@
+// Decoding for cooked mesh vertex buffers bound with make_cooked_input_layout(). Normalized
+// formats arrive in [0,1] / [-1,1]; the offsets and scales are the primitive's
+// CookedMeshPrimitiveDecode, bound per draw. Float layouts bind the identity decode.
+
+cbuffer CookedPrimitiveDecode : register(b2)
+{
+    float4 decode_position_offset;
+    float4 decode_position_scale;
+    // xy offset, zw scale
+    float4 decode_uv_offset_scale;
+    uint decode_octahedral_normal;
+};
+
+// Unorm16x4 position relative to the primitive's bounds
+float3 cooked_decode_position(float3 encoded)
+{
+    return decode_position_offset.xyz + encoded * decode_position_scale.xyz;
+}
+
+// Unorm16x2 UV relative to the primitive's UV range; Float16x2 UVs decode with the identity
+float2 cooked_decode_uv(float2 encoded)
+{
+    return decode_uv_offset_scale.xy + encoded * decode_uv_offset_scale.zw;
+}
+
+// OctahedralSnorm16x2 unit vector
+float3 cooked_decode_octahedral(float2 encoded)
+{
+    float3 n = float3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    if (n.z < 0.0)
+    {
+        float2 sign_not_zero = float2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+        n.xy = (1.0 - abs(n.yx)) * sign_not_zero;
+    }
+    return normalize(n);
+}
+
+// A two component octahedral normal reads as float3 with z = 0
+float3 cooked_decode_normal(float3 encoded)
+{
+    return decode_octahedral_normal != 0 ? cooked_decode_octahedral(encoded.xy) : encoded;
+}
@@ -1,7 +1,6 @@
-cbuffer ForwardSceneConstants : register(b0)
+cbuffer ForwardPassConstants : register(b0)
 {
     float4x4 view_proj_matrix;
-    float4x4 model_matrix;
     float4 camera_pos;
     float4 light_direction;
     float4 light_color;
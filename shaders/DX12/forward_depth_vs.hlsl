@@ -1,12 +1,18 @@
-cbuffer ForwardSceneConstants : register(b0)
+#include "cooked_vertex.hlsli"
+
+cbuffer ForwardPassConstants : register(b0)
 {
     float4x4 view_proj_matrix;
-    float4x4 model_matrix;
     float4 camera_pos;
     float4 light_direction;
     float4 light_color;
 };
 
+cbuffer ForwardObjectConstants : register(b1)
+{
+    float4x4 model_matrix;
+};
+
 struct VSInput
 {
     float3 position : ATTRIB0;
@@ -22,7 +28,7 @@ struct VSOutput
 VSOutput VSMain(VSInput input)
 {
     VSOutput output;
-    float4 world_pos = mul(float4(input.position, 1.0), model_matrix);
+    float4 world_pos = mul(float4(cooked_decode_position(input.position), 1.0), model_matrix);
     output.position = mul(world_pos, view_proj_matrix);
     return output;
 }
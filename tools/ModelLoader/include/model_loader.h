@@ -5,6 +5,7 @@
 #include "math/advanced_math.hpp"
 #include "graphics/interface/render_device.hpp"
 #include "image.h"
+#include "asset/cooked_mesh.h"
 #include "GLFW/tiny_gltf.h"
 
 
@@ -134,6 +135,15 @@ struct Material
     std::array<int, num_texture_attributes> texture_ids = {};
  };
 
+// A simplified index range into the model's index data, drawn with the primitive's vertices
+struct PrimitiveLod
+{
+    uint32_t first_index = 0;
+    uint32_t index_count = 0;
+    // Distance in mesh units the level may deviate from the full-detail surface
+    float error = 0.0f;
+};
+
 struct Primitive
 {
     uint32_t first_index;
@@ -142,6 +152,10 @@ struct Primitive
     uint32_t material_id;
 
     BoundBox bound_box;
+    // Dequantization constants when the cooked vertex layout is primitive-relative
+    CookedMeshPrimitiveDecode decode = {};
+    // Cooked LOD levels, finest first; empty when the asset carries none
+    std::vector<PrimitiveLod> lods;
 
     Primitive(uint32_t _first_index, uint32_t _index_count, uint32_t _vertex_count, uint32_t _material_id, const float3& bb_min, const float3& bb_max)
         : first_index(_first_index), index_count(_index_count), vertex_count(_vertex_count), material_id(_material_id), bound_box(bb_min, bb_max) {}
@@ -198,7 +212,7 @@ public:
 
     bool is_valid() const
     {
-        return !meshes.empty() && !model_data.empty() && !indices_data.empty();
+        return !meshes.empty() && get_vertex_count() != 0 && get_index_count() != 0;
     }
 
     const std::vector<Mesh>& get_meshes() const
@@ -213,7 +227,7 @@ public:
     
     const uint32_t get_vertex_count() const
     {
-        return static_cast<uint32_t>(model_data.size());
+        return static_cast<uint32_t>(get_vertex_bytes().size() / get_vertex_layout().stride);
     }
     
     struct VertexBasicAttribs
@@ -223,19 +237,42 @@ public:
         float2 uv0;
         float3 tangent;
     };
+    static_assert(sizeof(VertexBasicAttribs) == 44, "VertexBasicAttribs must match the default CookedVertexLayout");
 
+    // Float vertices for CPU-side users; empty for assets cooked with a compact CookedVertexEncoding,
+    // which only expose get_vertex_bytes()
     const std::vector<VertexBasicAttribs>& get_vertex_data() const
     {
         return model_data;
     }
 
+    // The vertex buffer to upload, laid out as get_vertex_layout(). Points into the mapped
+    // .meshasset for cooked assets, with the same lifetime as get_index_data().
+    std::span<const uint8_t> get_vertex_bytes() const
+    {
+        if (m_cooked_view.IsOpen())
+            return m_cooked_view.VertexBytes();
+        return { reinterpret_cast<const uint8_t*>(model_data.data()), model_data.size() * sizeof(VertexBasicAttribs) };
+    }
+
+    // Compact layouts decode in the vertex shader with each Primitive::decode
+    const CookedVertexLayout& get_vertex_layout() const
+    {
+        static const CookedVertexLayout float_layout = {};
+        return m_cooked_view.IsOpen() ? m_cooked_view.VertexLayout() : float_layout;
+    }
+
     const uint32_t get_index_count() const
     {
-        return static_cast<uint32_t>(indices_data.size());
+        return static_cast<uint32_t>(get_index_data().size());
     }
 
-    const std::vector<uint32_t>& get_index_data() const
+    // Points into the mapped .meshasset for cooked assets, so upload straight from it instead of
+    // copying; valid until the next load_data() or destruction
+    std::span<const uint32_t> get_index_data() const
     {
+        if (m_cooked_view.IsOpen())
+            return m_cooked_view.Indices();
         return indices_data;
     }
 
@@ -272,6 +309,14 @@ public:
     }
 private:
     bool load_cooked_meshasset(const std::string& file_path);
+    // vertices is empty for compact layouts, which stay in the mapped view
+    void load_cooked_sections(std::span<const CookedMeshVertex> vertices,
+                              std::span<const CookedMeshRecord> cooked_meshes,
+                              std::span<const CookedMeshPrimitive> primitives,
+                              std::span<const CookedMeshPrimitiveDecode> primitive_decode,
+                              std::span<const CookedMeshPrimitiveLods> primitive_lods,
+                              std::span<const CookedMeshLod> lods,
+                              std::span<const CookedMeshMaterial> cooked_materials);
     void load_node(const tinygltf::Model& gltf_model, uint32_t node_index, const float4x4& parent_transform);
     void load_mesh(const tinygltf::Model& gltf_model, uint32_t mesh_index, const float4x4& world_transform);
     void load_materials(const tinygltf::Model& gltf_model);
@@ -287,6 +332,8 @@ private:
 
     std::vector<VertexBasicAttribs> model_data;
     std::vector<uint32_t> indices_data; // Indices for indexed drawing
+    // Kept open after load_data() so cooked indices and textures upload from the mapping
+    CookedMeshView m_cooked_view;
 
     float4x4 root_transform = float4x4::Identity();
     std::string m_base_dir; // Stored by load_data() for deferred create_gpu_textures()
@@ -299,9 +346,13 @@ private:
         uint32_t height = 0;
         uint32_t component_count = 0;
         uint32_t component_size = 0;
-        std::vector<uint8_t> bytes;
+        // Into m_cooked_view, or into owned_bytes for assets read through the stream fallback
+        std::span<const uint8_t> bytes;
+        std::vector<uint8_t> owned_bytes;
     };
     std::vector<PendingCookedTexture> m_cooked_textures;
+    static PendingCookedTexture make_pending_cooked_texture(const CookedMeshTextureRecord& record,
+                                                            std::span<const uint8_t> bytes);
     struct TextureInfo
     {
         RefCntAutoPtr<RenderObject::ITexture> texture = nullptr;
@@ -83,6 +83,7 @@ void Model::load_data(const ModelCreateInfo& create_info)
     materials.clear();
     model_data.clear();
     indices_data.clear();
+    m_cooked_view.Close();
     textures.clear();
     m_is_gltf_source = false;
     m_is_cooked_source = false;
@@ -154,28 +155,70 @@ void Model::load_data(const ModelCreateInfo& create_info)
 
 bool Model::load_cooked_meshasset(const std::string& file_path)
 {
-    CookedMeshData cooked;
+    // Map the asset and convert straight out of the page cache; only assets cooked before
+    // sections were aligned take the copying stream reader. The view stays open so indices and
+    // textures are uploaded from the mapping.
+    CookedMeshView& view = m_cooked_view;
     std::string error;
-    if (!ReadCookedMeshAsset(file_path, cooked, &error))
+    if (view.Open(file_path, &error))
     {
-        CB_ERROR("Failed to load cooked mesh asset {0}: {1}", file_path.c_str(), error.c_str());
-        return false;
+        // Compact layouts are uploaded as cooked and decoded by the forward vertex shaders, so only
+        // float assets fill the CPU-side vertex copy
+        load_cooked_sections(view.Vertices(), view.Meshes(), view.Primitives(), view.PrimitiveDecode(),
+                             view.PrimitiveLods(), view.Lods(), view.Materials());
+        m_cooked_textures.reserve(view.TextureRecords().size());
+        for (size_t i = 0; i < view.TextureRecords().size(); ++i)
+            m_cooked_textures.push_back(make_pending_cooked_texture(view.TextureRecords()[i], view.TextureBytes(i)));
     }
+    else
+    {
+        CookedMeshData cooked;
+        if (!ReadCookedMeshAsset(file_path, cooked, &error))
+        {
+            CB_ERROR("Failed to load cooked mesh asset {0}: {1}", file_path.c_str(), error.c_str());
+            return false;
+        }
 
-    model_data.resize(cooked.vertices.size());
-    for (size_t i = 0; i < cooked.vertices.size(); ++i)
+        load_cooked_sections(cooked.vertices, cooked.meshes, cooked.primitives, {},
+                             cooked.primitiveLods, cooked.lods, cooked.materials);
+        indices_data = std::move(cooked.indices);
+        m_cooked_textures.reserve(cooked.textures.size());
+        for (CookedMeshTexture& source : cooked.textures)
+        {
+            // Moving the vector keeps its heap block, so the span stays valid as the list grows
+            PendingCookedTexture& texture = m_cooked_textures.emplace_back(make_pending_cooked_texture(source.record, {}));
+            texture.owned_bytes = std::move(source.bytes);
+            texture.bytes = texture.owned_bytes;
+        }
+    }
+
+    m_is_cooked_source = true;
+    CB_INFO("Loaded cooked mesh asset: {0} ({1} meshes, {2} vertices, {3} indices)",
+            file_path.c_str(), meshes.size(), get_vertex_count(), get_index_count());
+    return true;
+}
+
+void Model::load_cooked_sections(std::span<const CookedMeshVertex> vertices,
+                                 std::span<const CookedMeshRecord> cooked_meshes,
+                                 std::span<const CookedMeshPrimitive> primitives,
+                                 std::span<const CookedMeshPrimitiveDecode> primitive_decode,
+                                 std::span<const CookedMeshPrimitiveLods> primitive_lods,
+                                 std::span<const CookedMeshLod> lods,
+                                 std::span<const CookedMeshMaterial> cooked_materials)
+{
+    model_data.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)
     {
-        const CookedMeshVertex& source = cooked.vertices[i];
+        const CookedMeshVertex& source = vertices[i];
         VertexBasicAttribs& destination = model_data[i];
         destination.pos = { source.position[0], source.position[1], source.position[2] };
         destination.normal = { source.normal[0], source.normal[1], source.normal[2] };
         destination.uv0 = { source.uv0[0], source.uv0[1] };
         destination.tangent = { source.tangent[0], source.tangent[1], source.tangent[2] };
     }
-    indices_data = std::move(cooked.indices);
 
-    materials.reserve(cooked.materials.size());
-    for (const CookedMeshMaterial& source : cooked.materials)
+    materials.reserve(cooked_materials.size());
+    for (const CookedMeshMaterial& source : cooked_materials)
     {
         Material material;
         material.attribs.base_color_factor = {
@@ -193,42 +236,46 @@ bool Model::load_cooked_meshasset(const std::string& file_path)
         materials.push_back(material);
     }
 
-    meshes.reserve(cooked.meshes.size());
-    for (const CookedMeshRecord& sourceMesh : cooked.meshes)
+    meshes.reserve(cooked_meshes.size());
+    for (const CookedMeshRecord& sourceMesh : cooked_meshes)
     {
         Mesh mesh;
         mesh.name = sourceMesh.name;
         mesh.primitives.reserve(sourceMesh.primitiveCount);
         for (uint32_t i = 0; i < sourceMesh.primitiveCount; ++i)
         {
-            const CookedMeshPrimitive& source =
-                cooked.primitives[sourceMesh.firstPrimitive + i];
-            mesh.primitives.emplace_back(
+            const uint32_t primitive_index = sourceMesh.firstPrimitive + i;
+            const CookedMeshPrimitive& source = primitives[primitive_index];
+            Primitive& primitive = mesh.primitives.emplace_back(
                 source.firstIndex, source.indexCount, source.vertexCount, source.materialIndex,
                 float3 { source.boundsMin[0], source.boundsMin[1], source.boundsMin[2] },
                 float3 { source.boundsMax[0], source.boundsMax[1], source.boundsMax[2] });
+            if (primitive_index < primitive_decode.size())
+                primitive.decode = primitive_decode[primitive_index];
+            if (primitive_index < primitive_lods.size())
+            {
+                const CookedMeshPrimitiveLods& range = primitive_lods[primitive_index];
+                primitive.lods.reserve(range.lodCount);
+                for (uint32_t l = range.firstLod; l < range.firstLod + range.lodCount; ++l)
+                    primitive.lods.push_back({ lods[l].firstIndex, lods[l].indexCount, lods[l].error });
+            }
         }
         mesh.update_bounding_box();
         meshes.push_back(std::move(mesh));
     }
+}
 
-    m_cooked_textures.reserve(cooked.textures.size());
-    for (CookedMeshTexture& source : cooked.textures)
-    {
-        PendingCookedTexture texture;
-        texture.name = source.record.name;
-        texture.width = source.record.width;
-        texture.height = source.record.height;
-        texture.component_count = source.record.componentCount;
-        texture.component_size = source.record.componentSize;
-        texture.bytes = std::move(source.bytes);
-        m_cooked_textures.push_back(std::move(texture));
-    }
-
-    m_is_cooked_source = true;
-    CB_INFO("Loaded cooked mesh asset: {0} ({1} meshes, {2} vertices, {3} indices)",
-            file_path.c_str(), meshes.size(), model_data.size(), indices_data.size());
-    return true;
+Model::PendingCookedTexture Model::make_pending_cooked_texture(const CookedMeshTextureRecord& record,
+                                                               std::span<const uint8_t> bytes)
+{
+    PendingCookedTexture texture;
+    texture.name = record.name;
+    texture.width = record.width;
+    texture.height = record.height;
+    texture.component_count = record.componentCount;
+    texture.component_size = record.componentSize;
+    texture.bytes = bytes;
+    return texture;
 }
 
 // Build the row-major local transform for a glTF node. Row-vector convention:
@@ -659,37 +706,77 @@ RenderObject::TextureData prepare_gltf_texture_data(const Model::ImageData& imag
     const auto tex_format = get_image_data_texture_format(image_data);
     const auto& fmt_attribs = get_texture_format_attribs(tex_format);
     const auto src_stride = image_data.width * image_data.component_size * image_data.num_components;
+    if(num_mip_levels == 0)
+    {
+        num_mip_levels = compute_mip_levels_count(image_data.width, image_data.height);
+    }
     RenderObject::TextureData texture_data;
-    texture_data.numSubResources = 1;
+    texture_data.numSubResources = num_mip_levels;
     texture_data.pSubResources = cyber_new_n<RenderObject::TextureSubResData>(texture_data.numSubResources);
     RenderObject::TextureSubResData& sub_res_data = texture_data.pSubResources[0];
     auto& stride = sub_res_data.stride;
-    stride = align_up(uint64_t(image_data.width) * fmt_attribs.component_size * image_data.num_components, 4);
-    uint8_t* data_buffer = cyber_new_n<uint8_t>(stride * image_data.height);
-    sub_res_data.pData = data_buffer;
-
-    TextureLoader::CopyPixelsAttribs copy_attribs;
-    copy_attribs.width = image_data.width;
-    copy_attribs.height = image_data.height;
-    copy_attribs.component_size = image_data.component_size;
-    copy_attribs.src_pixels = image_data.pData;
-    copy_attribs.src_stride = src_stride;
-    copy_attribs.src_comp_count = image_data.num_components;
-    copy_attribs.dst_pixels = data_buffer;
-    copy_attribs.dst_stride = stride;
-    copy_attribs.dst_comp_count = fmt_attribs.num_components;
-    TextureLoader::copy_pixels(copy_attribs);
+    if (image_data.num_components == fmt_attribs.num_components && image_data.component_size == fmt_attribs.component_size &&
+        src_stride % 4 == 0 && image_data.data_size >= size_t(src_stride) * image_data.height)
+    {
+        // Already in the texture layout: mip 0 uploads straight from the source pixels, which
+        // for cooked assets are the mapped file. free_gltf_texture_data() leaves it alone.
+        stride = src_stride;
+        sub_res_data.pData = image_data.pData;
+    }
+    else
+    {
+        // copy_pixels expands RGB sources to the RGBA format, so rows hold fmt_attribs.num_components per pixel
+        stride = align_up(uint64_t(image_data.width) * fmt_attribs.component_size * fmt_attribs.num_components, 4);
+        uint8_t* data_buffer = cyber_new_n<uint8_t>(stride * image_data.height);
+        sub_res_data.pData = data_buffer;
+
+        TextureLoader::CopyPixelsAttribs copy_attribs;
+        copy_attribs.width = image_data.width;
+        copy_attribs.height = image_data.height;
+        copy_attribs.component_size = image_data.component_size;
+        copy_attribs.src_pixels = image_data.pData;
+        copy_attribs.src_stride = src_stride;
+        copy_attribs.src_comp_count = image_data.num_components;
+        copy_attribs.dst_pixels = data_buffer;
+        copy_attribs.dst_stride = stride;
+        copy_attribs.dst_comp_count = fmt_attribs.num_components;
+        TextureLoader::copy_pixels(copy_attribs);
+    }
+
+    for(uint32_t mip = 1; mip < texture_data.numSubResources; ++mip)
+    {
+        const auto& fine_mip = texture_data.pSubResources[mip - 1];
+        auto& coarse_mip = texture_data.pSubResources[mip];
+        const uint32_t fine_mip_width = std::max(1u, uint32_t(image_data.width) >> (mip - 1));
+        const uint32_t fine_mip_height = std::max(1u, uint32_t(image_data.height) >> (mip - 1));
+        const uint32_t coarse_mip_width = std::max(1u, fine_mip_width >> 1);
+        const uint32_t coarse_mip_height = std::max(1u, fine_mip_height >> 1);
+        coarse_mip.stride = align_up(uint64_t(coarse_mip_width) * fmt_attribs.component_size * fmt_attribs.num_components, 4);
+        uint8_t* coarse_data = cyber_new_n<uint8_t>(coarse_mip.stride * coarse_mip_height);
+        coarse_mip.pData = coarse_data;
+
+        TextureLoader::ComputeMipLevelAttribs mip_attribs;
+        mip_attribs.format = tex_format;
+        mip_attribs.fine_mip_width = fine_mip_width;
+        mip_attribs.fine_mip_height = fine_mip_height;
+        mip_attribs.fine_mip_data = fine_mip.pData;
+        mip_attribs.fine_mip_stride = static_cast<size_t>(fine_mip.stride);
+        mip_attribs.coarse_mip_data = coarse_data;
+        mip_attribs.coarse_mip_stride = static_cast<size_t>(coarse_mip.stride);
+        mip_attribs.alpha_cutoff = alpha_cut_off;
+        TextureLoader::compute_mip_level(mip_attribs);
+    }
 
     return texture_data;
 }
 
-static void free_gltf_texture_data(RenderObject::TextureData& texture_data)
+static void free_gltf_texture_data(RenderObject::TextureData& texture_data, const void* source_pixels)
 {
     if (texture_data.pSubResources)
     {
         for (uint32_t i = 0; i < texture_data.numSubResources; ++i)
         {
-            if (texture_data.pSubResources[i].pData)
+            if (texture_data.pSubResources[i].pData && texture_data.pSubResources[i].pData != source_pixels)
             {
                 cyber_free(const_cast<void*>(texture_data.pSubResources[i].pData));
             }
@@ -709,7 +796,9 @@ uint32_t Model::add_texture(RenderObject::IRenderDevice* render_device, const Im
     {
         const auto tex_format = get_image_data_texture_format(image);
 
-        RenderObject::TextureData texture_data = prepare_gltf_texture_data(image, 0.0f, 1);
+        const uint32_t num_mip_levels = TextureLoader::is_mip_generation_supported(tex_format) ?
+            compute_mip_levels_count(image.width, image.height) : 1;
+        RenderObject::TextureData texture_data = prepare_gltf_texture_data(image, 0.0f, num_mip_levels);
 
         RenderObject::TextureCreateDesc texture_desc;
         texture_desc.m_name = image.name;
@@ -719,10 +808,10 @@ uint32_t Model::add_texture(RenderObject::IRenderDevice* render_device, const Im
         texture_desc.m_usage = GRAPHICS_RESOURCE_USAGE_DEFAULT;
         texture_desc.m_bindFlags = GRAPHICS_RESOURCE_BIND_SHADER_RESOURCE;
         texture_desc.m_format = tex_format;
-        texture_desc.m_mipLevels = 0;
+        texture_desc.m_mipLevels = num_mip_levels;
         render_device->create_texture(texture_desc, &texture_data, &texture_info.texture);
 
-        free_gltf_texture_data(texture_data);
+        free_gltf_texture_data(texture_data, image.pData);
     }
     textures.push_back(texture_info);
     return new_texture_index;
@@ -0,0 +1,48 @@
+#pragma once
+#include "graphics/interface/graphics_types.h"
+
+CYBER_BEGIN_NAMESPACE(Cyber)
+CYBER_BEGIN_NAMESPACE(TextureLoader)
+
+CYBER_TYPED_ENUM(MIP_FILTER_TYPE, uint8_t)
+{
+    // Box filter for 8/16-bit unorm formats, Kaiser for float formats
+    MIP_FILTER_TYPE_DEFAULT = 0,
+
+    // 2x2 average, cheapest and vectorized for RGBA8/RGBA32F
+    MIP_FILTER_TYPE_BOX_AVERAGE,
+
+    // 8x8 separable Kaiser-windowed sinc, sharper but ~16x the work of the box filter
+    MIP_FILTER_TYPE_KAISER,
+};
+
+struct ComputeMipLevelAttribs
+{
+    TEXTURE_FORMAT format = TEX_FORMAT_UNKNOWN;
+
+    uint32_t fine_mip_width = 0;
+    uint32_t fine_mip_height = 0;
+    const void* fine_mip_data = nullptr;
+    size_t fine_mip_stride = 0;
+
+    void* coarse_mip_data = nullptr;
+    size_t coarse_mip_stride = 0;
+
+    MIP_FILTER_TYPE filter_type = MIP_FILTER_TYPE_DEFAULT;
+
+    // When > 0 the alpha channel of the coarse mip is rescaled so that the fraction
+    // of texels passing the alpha test matches the fine mip.
+    float alpha_cutoff = 0.0f;
+
+    // Number of worker threads the coarse rows are split across, 0 uses all hardware threads
+    uint32_t num_threads = 0;
+};
+
+// Returns true if compute_mip_level() can filter textures of this format
+bool is_mip_generation_supported(TEXTURE_FORMAT format);
+
+// Coarse mip dimensions are max(1, fine / 2); sRGB formats are filtered in linear space
+void compute_mip_level(const ComputeMipLevelAttribs& attribs);
+
+CYBER_END_NAMESPACE
+CYBER_END_NAMESPACE
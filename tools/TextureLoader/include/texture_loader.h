@@ -2,6 +2,7 @@
 
 #include "graphics/interface/texture.hpp"
 #include "image.h"
+#include "mip_generator.h"
 
 CYBER_BEGIN_NAMESPACE(Cyber)
 CYBER_BEGIN_NAMESPACE(TextureLoader)
@@ -28,6 +29,8 @@ struct TextureLoadInfo
 
     FILTER_TYPE filter;
 
+    MIP_FILTER_TYPE mipFilter = MIP_FILTER_TYPE_DEFAULT;
+
     explicit TextureLoadInfo(const char8_t* name,
                              GRAPHICS_RESOURCE_USAGE usage, 
                              GRAPHICS_RESOURCE_BIND_FLAGS bindFlags, 
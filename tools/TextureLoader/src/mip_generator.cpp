@@ -0,0 +1,505 @@
+#include "mip_generator.h"
+#include "common/graphics_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+CYBER_BEGIN_NAMESPACE(Cyber)
+CYBER_BEGIN_NAMESPACE(TextureLoader)
+
+// Built with AVX2 in mip_generator_avx2.cpp; only called after cpu_supports_avx2()
+uint32_t box_filter_rgba8_avx2(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, uint32_t coarse_width);
+
+namespace
+{
+    // Rows below this are not worth a thread of their own
+    constexpr uint32_t kMinRowsPerBand = 16;
+
+    constexpr uint32_t kKaiserTaps = 8;
+    constexpr float kKaiserAlpha = 4.0f;
+
+    struct MipRowArgs
+    {
+        const uint8_t* fine_data;
+        size_t fine_stride;
+        uint32_t fine_width;
+        uint32_t fine_height;
+        uint8_t* coarse_data;
+        size_t coarse_stride;
+        uint32_t coarse_width;
+        uint32_t num_components;
+    };
+
+    struct SRGBTables
+    {
+        std::array<float, 256> to_linear;
+        std::array<uint8_t, 4096> from_linear;
+
+        SRGBTables()
+        {
+            for(uint32_t i = 0; i < 256; ++i)
+            {
+                const float c = float(i) / 255.0f;
+                to_linear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            for(uint32_t i = 0; i < 4096; ++i)
+            {
+                const float l = float(i) / 4095.0f;
+                const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+                from_linear[i] = static_cast<uint8_t>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+        }
+    };
+
+    // Namespace scope so the per-channel lookups do not pay for a function-local static guard
+    const SRGBTables g_srgb_tables;
+
+    const SRGBTables& srgb_tables()
+    {
+        return g_srgb_tables;
+    }
+
+    // Converts channels to normalized floats (linear for sRGB color channels) and back
+    template<typename ChannelType, bool IsSRGB>
+    struct ChannelCodec
+    {
+        static float decode(ChannelType value, uint32_t component)
+        {
+            if constexpr (std::is_floating_point_v<ChannelType>)
+            {
+                return value;
+            }
+            else if constexpr (IsSRGB)
+            {
+                return component < 3 ? srgb_tables().to_linear[value] : float(value) / 255.0f;
+            }
+            else
+            {
+                return float(value) / float(std::numeric_limits<ChannelType>::max());
+            }
+        }
+
+        static ChannelType encode(float value, uint32_t component)
+        {
+            if constexpr (std::is_floating_point_v<ChannelType>)
+            {
+                return value;
+            }
+            else
+            {
+                value = std::clamp(value, 0.0f, 1.0f);
+                if constexpr (IsSRGB)
+                {
+                    if(component < 3)
+                        return srgb_tables().from_linear[static_cast<uint32_t>(value * 4095.0f + 0.5f)];
+                }
+                return static_cast<ChannelType>(value * float(std::numeric_limits<ChannelType>::max()) + 0.5f);
+            }
+        }
+    };
+
+    template<typename ChannelType>
+    const ChannelType* fine_row(const MipRowArgs& args, uint32_t y)
+    {
+        y = std::min(y, args.fine_height - 1);
+        return reinterpret_cast<const ChannelType*>(args.fine_data + size_t(y) * args.fine_stride);
+    }
+
+    template<typename ChannelType>
+    ChannelType* coarse_row(const MipRowArgs& args, uint32_t y)
+    {
+        return reinterpret_cast<ChannelType*>(args.coarse_data + size_t(y) * args.coarse_stride);
+    }
+
+    // Scalar 2x2 average; integer channels are averaged exactly with rounding
+    template<typename ChannelType, bool IsSRGB>
+    void box_filter_pixels(const ChannelType* row0, const ChannelType* row1, ChannelType* dst,
+                           uint32_t x_begin, uint32_t x_end, const MipRowArgs& args)
+    {
+        using Codec = ChannelCodec<ChannelType, IsSRGB>;
+        const uint32_t comps = args.num_components;
+        for(uint32_t x = x_begin; x < x_end; ++x)
+        {
+            const uint32_t x0 = std::min(x * 2 + 0, args.fine_width - 1) * comps;
+            const uint32_t x1 = std::min(x * 2 + 1, args.fine_width - 1) * comps;
+            for(uint32_t c = 0; c < comps; ++c)
+            {
+                if constexpr (IsSRGB || std::is_floating_point_v<ChannelType>)
+                {
+                    const float sum = Codec::decode(row0[x0 + c], c) + Codec::decode(row0[x1 + c], c) +
+                                      Codec::decode(row1[x0 + c], c) + Codec::decode(row1[x1 + c], c);
+                    dst[x * comps + c] = Codec::encode(sum * 0.25f, c);
+                }
+                else
+                {
+                    const uint32_t sum = uint32_t(row0[x0 + c]) + uint32_t(row0[x1 + c]) +
+                                         uint32_t(row1[x0 + c]) + uint32_t(row1[x1 + c]);
+                    dst[x * comps + c] = static_cast<ChannelType>((sum + 2) >> 2);
+                }
+            }
+        }
+    }
+
+    bool detect_avx2()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if(info[0] < 7)
+            return false;
+        // The OS must save the YMM registers (OSXSAVE, XCR0 bits 1-2) as well as the CPU reporting AVX/AVX2
+        __cpuid(info, 1);
+        const bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6;
+        __cpuidex(info, 7, 0);
+        return os_avx && (info[1] & (1 << 5));
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    bool cpu_supports_avx2()
+    {
+        static const bool supported = detect_avx2();
+        return supported;
+    }
+
+    // RGBA8 unorm: 8 coarse pixels per AVX2 iteration when the CPU has it, then 4 per SSE2 iteration.
+    // Returns the first coarse pixel left for the scalar tail.
+    uint32_t box_filter_rgba8_simd(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, uint32_t coarse_width)
+    {
+        uint32_t x = 0;
+        if(cpu_supports_avx2())
+            x = box_filter_rgba8_avx2(row0, row1, dst, coarse_width);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i round4 = _mm_set1_epi16(2);
+        for(; x + 4 <= coarse_width; x += 4)
+        {
+            __m128i half[2];
+            for(uint32_t h = 0; h < 2; ++h)
+            {
+                const size_t offset = size_t(x) * 8 + h * 16;
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + offset));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + offset));
+                const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+                const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+                half[h] = _mm_srli_epi16(_mm_add_epi16(sum, round4), 2);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + size_t(x) * 4), _mm_packus_epi16(half[0], half[1]));
+        }
+        return x;
+    }
+
+    uint32_t box_filter_rgba32f_simd(const float* row0, const float* row1, float* dst, uint32_t coarse_width)
+    {
+        const __m128 quarter = _mm_set1_ps(0.25f);
+        for(uint32_t x = 0; x < coarse_width; ++x)
+        {
+            const size_t offset = size_t(x) * 8;
+            const __m128 top = _mm_add_ps(_mm_loadu_ps(row0 + offset), _mm_loadu_ps(row0 + offset + 4));
+            const __m128 bottom = _mm_add_ps(_mm_loadu_ps(row1 + offset), _mm_loadu_ps(row1 + offset + 4));
+            _mm_storeu_ps(dst + size_t(x) * 4, _mm_mul_ps(_mm_add_ps(top, bottom), quarter));
+        }
+        return coarse_width;
+    }
+
+    template<typename ChannelType, bool IsSRGB>
+    void box_filter_rows(const MipRowArgs& args, uint32_t y_begin, uint32_t y_end)
+    {
+        // The SIMD kernels read two full fine pixels per coarse pixel, which only holds when fine_width >= 2
+        constexpr bool is_rgba8 = std::is_same_v<ChannelType, uint8_t> && !IsSRGB;
+        constexpr bool is_rgba32f = std::is_same_v<ChannelType, float>;
+        const bool use_simd = args.num_components == 4 && args.fine_width >= 2;
+
+        for(uint32_t y = y_begin; y < y_end; ++y)
+        {
+            const ChannelType* row0 = fine_row<ChannelType>(args, y * 2 + 0);
+            const ChannelType* row1 = fine_row<ChannelType>(args, y * 2 + 1);
+            ChannelType* dst = coarse_row<ChannelType>(args, y);
+
+            uint32_t x = 0;
+            if constexpr (is_rgba8)
+            {
+                if(use_simd)
+                    x = box_filter_rgba8_simd(row0, row1, dst, args.coarse_width);
+            }
+            else if constexpr (is_rgba32f)
+            {
+                if(use_simd)
+                    x = box_filter_rgba32f_simd(row0, row1, dst, args.coarse_width);
+            }
+            box_filter_pixels<ChannelType, IsSRGB>(row0, row1, dst, x, args.coarse_width, args);
+        }
+    }
+
+    double bessel_i0(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        for(int k = 1; k < 32; ++k)
+        {
+            const double t = x / (2.0 * k);
+            term *= t * t;
+            sum += term;
+            if(term < sum * 1e-12)
+                break;
+        }
+        return sum;
+    }
+
+    // Weights for fine texels 2x-3 .. 2x+4 around the coarse texel center at fine coordinate 2x+1
+    const std::array<float, kKaiserTaps>& kaiser_weights()
+    {
+        static const std::array<float, kKaiserTaps> weights = [] {
+            std::array<float, kKaiserTaps> w {};
+            const double radius = kKaiserTaps * 0.5;
+            const double pi = 3.14159265358979323846;
+            double total = 0.0;
+            for(uint32_t i = 0; i < kKaiserTaps; ++i)
+            {
+                const double d = double(i) - radius + 0.5;
+                // Cutoff at half the fine Nyquist frequency for a 2x decimation
+                const double s = d * 0.5;
+                const double sinc = std::abs(s) < 1e-8 ? 1.0 : std::sin(pi * s) / (pi * s);
+                const double r = d / radius;
+                const double window = bessel_i0(kKaiserAlpha * std::sqrt(std::max(0.0, 1.0 - r * r))) / bessel_i0(kKaiserAlpha);
+                w[i] = float(sinc * window);
+                total += w[i];
+            }
+            for(auto& value : w)
+                value = float(value / total);
+            return w;
+        }();
+        return weights;
+    }
+
+    template<typename ChannelType, bool IsSRGB>
+    void kaiser_filter_rows(const MipRowArgs& args, uint32_t y_begin, uint32_t y_end)
+    {
+        using Codec = ChannelCodec<ChannelType, IsSRGB>;
+        const auto& weights = kaiser_weights();
+        const int32_t half_taps = int32_t(kKaiserTaps / 2);
+        const uint32_t comps = args.num_components;
+        const size_t row_floats = size_t(args.coarse_width) * comps;
+
+        // Horizontally filter every fine row this band touches once, then run the vertical pass
+        const int32_t first_fine = int32_t(y_begin) * 2 - (half_taps - 1);
+        const int32_t last_fine = int32_t(y_end - 1) * 2 + half_taps;
+        std::vector<float> horizontal(size_t(last_fine - first_fine + 1) * row_floats);
+        std::vector<float> decoded(size_t(args.fine_width) * comps);
+
+        for(int32_t fy = first_fine; fy <= last_fine; ++fy)
+        {
+            const uint32_t sy = uint32_t(std::clamp(fy, 0, int32_t(args.fine_height) - 1));
+            const ChannelType* src = fine_row<ChannelType>(args, sy);
+            for(uint32_t x = 0; x < args.fine_width; ++x)
+            {
+                for(uint32_t c = 0; c < comps; ++c)
+                    decoded[size_t(x) * comps + c] = Codec::decode(src[size_t(x) * comps + c], c);
+            }
+
+            float* out = horizontal.data() + size_t(fy - first_fine) * row_floats;
+            for(uint32_t x = 0; x < args.coarse_width; ++x)
+            {
+                float sum[4] = {};
+                const int32_t first_tap = int32_t(x) * 2 - (half_taps - 1);
+                const bool interior = first_tap >= 0 && first_tap + int32_t(kKaiserTaps) <= int32_t(args.fine_width);
+                for(int32_t t = 0; t < int32_t(kKaiserTaps); ++t)
+                {
+                    const int32_t fx = interior ? first_tap + t : std::clamp(first_tap + t, 0, int32_t(args.fine_width) - 1);
+                    const float* texel = decoded.data() + size_t(fx) * comps;
+                    for(uint32_t c = 0; c < comps; ++c)
+                        sum[c] += weights[t] * texel[c];
+                }
+                for(uint32_t c = 0; c < comps; ++c)
+                    out[size_t(x) * comps + c] = sum[c];
+            }
+        }
+
+        std::vector<float> vertical(row_floats);
+        for(uint32_t y = y_begin; y < y_end; ++y)
+        {
+            const int32_t base = int32_t(y) * 2 - (half_taps - 1) - first_fine;
+            std::fill(vertical.begin(), vertical.end(), 0.0f);
+            for(int32_t t = 0; t < int32_t(kKaiserTaps); ++t)
+            {
+                const float weight = weights[t];
+                const float* src = horizontal.data() + size_t(base + t) * row_floats;
+                for(size_t i = 0; i < row_floats; ++i)
+                    vertical[i] += weight * src[i];
+            }
+
+            ChannelType* dst = coarse_row<ChannelType>(args, y);
+            for(uint32_t x = 0; x < args.coarse_width; ++x)
+            {
+                for(uint32_t c = 0; c < comps; ++c)
+                    dst[size_t(x) * comps + c] = Codec::encode(vertical[size_t(x) * comps + c], c);
+            }
+        }
+    }
+
+    template<typename Fn>
+    void for_each_row_band(uint32_t row_count, uint32_t num_threads, Fn&& fn)
+    {
+        if(num_threads == 0)
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        const uint32_t band_count = std::clamp((row_count + kMinRowsPerBand - 1) / kMinRowsPerBand, 1u, num_threads);
+        if(band_count == 1)
+        {
+            fn(0u, row_count);
+            return;
+        }
+
+        const uint32_t rows_per_band = (row_count + band_count - 1) / band_count;
+        std::vector<std::thread> workers;
+        workers.reserve(band_count - 1);
+        for(uint32_t band = 1; band < band_count; ++band)
+        {
+            const uint32_t begin = band * rows_per_band;
+            const uint32_t end = std::min(row_count, begin + rows_per_band);
+            if(begin < end)
+                workers.emplace_back([&fn, begin, end] { fn(begin, end); });
+        }
+        fn(0u, std::min(row_count, rows_per_band));
+        for(auto& worker : workers)
+            worker.join();
+    }
+
+    template<typename ChannelType, bool IsSRGB>
+    float alpha_coverage(const uint8_t* data, size_t stride, uint32_t width, uint32_t height,
+                         uint32_t comps, float alpha_cutoff)
+    {
+        using Codec = ChannelCodec<ChannelType, IsSRGB>;
+        uint64_t passed = 0;
+        for(uint32_t y = 0; y < height; ++y)
+        {
+            const auto* row = reinterpret_cast<const ChannelType*>(data + size_t(y) * stride);
+            for(uint32_t x = 0; x < width; ++x)
+            {
+                if(Codec::decode(row[size_t(x) * comps + 3], 3) > alpha_cutoff)
+                    ++passed;
+            }
+        }
+        return float(double(passed) / (double(width) * double(height)));
+    }
+
+    // Alpha-tested foliage thins out with every mip because averaging pulls alpha below the cutoff.
+    // Scale the coarse alpha so that it passes the test as often as the fine mip does.
+    template<typename ChannelType, bool IsSRGB>
+    void preserve_alpha_coverage(const MipRowArgs& args, uint32_t coarse_height, float alpha_cutoff)
+    {
+        using Codec = ChannelCodec<ChannelType, IsSRGB>;
+        const uint32_t comps = args.num_components;
+        const float target = alpha_coverage<ChannelType, IsSRGB>(args.fine_data, args.fine_stride,
+            args.fine_width, args.fine_height, comps, alpha_cutoff);
+
+        std::vector<float> alphas;
+        alphas.reserve(size_t(args.coarse_width) * coarse_height);
+        for(uint32_t y = 0; y < coarse_height; ++y)
+        {
+            const ChannelType* row = coarse_row<ChannelType>(args, y);
+            for(uint32_t x = 0; x < args.coarse_width; ++x)
+                alphas.push_back(Codec::decode(row[size_t(x) * comps + 3], 3));
+        }
+
+        // The texel at rank N - passing must land just above the cutoff after scaling
+        const size_t passing = static_cast<size_t>(double(target) * double(alphas.size()) + 0.5);
+        if(passing == 0 || passing >= alphas.size())
+            return;
+        auto threshold = alphas.begin() + (alphas.size() - passing);
+        std::nth_element(alphas.begin(), threshold, alphas.end());
+        if(*threshold <= 0.0f)
+            return;
+        // Half an 8-bit step of headroom keeps the threshold texel above the cutoff after quantization
+        const float scale = (alpha_cutoff + 0.5f / 255.0f) / *threshold;
+
+        for(uint32_t y = 0; y < coarse_height; ++y)
+        {
+            ChannelType* row = coarse_row<ChannelType>(args, y);
+            for(uint32_t x = 0; x < args.coarse_width; ++x)
+            {
+                ChannelType& alpha = row[size_t(x) * comps + 3];
+                alpha = Codec::encode(Codec::decode(alpha, 3) * scale, 3);
+            }
+        }
+    }
+
+    template<typename ChannelType, bool IsSRGB>
+    void compute_mip_level_impl(const ComputeMipLevelAttribs& attribs, uint32_t num_components, MIP_FILTER_TYPE filter)
+    {
+        MipRowArgs args;
+        args.fine_data = static_cast<const uint8_t*>(attribs.fine_mip_data);
+        args.fine_stride = attribs.fine_mip_stride;
+        args.fine_width = attribs.fine_mip_width;
+        args.fine_height = attribs.fine_mip_height;
+        args.coarse_data = static_cast<uint8_t*>(attribs.coarse_mip_data);
+        args.coarse_stride = attribs.coarse_mip_stride;
+        args.coarse_width = std::max(1u, attribs.fine_mip_width / 2);
+        args.num_components = num_components;
+        const uint32_t coarse_height = std::max(1u, attribs.fine_mip_height / 2);
+
+        for_each_row_band(coarse_height, attribs.num_threads, [&args, filter](uint32_t begin, uint32_t end) {
+            if(filter == MIP_FILTER_TYPE_KAISER)
+                kaiser_filter_rows<ChannelType, IsSRGB>(args, begin, end);
+            else
+                box_filter_rows<ChannelType, IsSRGB>(args, begin, end);
+        });
+
+        if(attribs.alpha_cutoff > 0.0f && num_components == 4)
+            preserve_alpha_coverage<ChannelType, IsSRGB>(args, coarse_height, attribs.alpha_cutoff);
+    }
+}
+
+bool is_mip_generation_supported(TEXTURE_FORMAT format)
+{
+    const auto& fmt_attribs = get_texture_format_attribs(format);
+    if(fmt_attribs.num_components == 0 || fmt_attribs.num_components > 4)
+        return false;
+    switch(fmt_attribs.component_type)
+    {
+        case COMPONENT_TYPE_UNORM: return fmt_attribs.component_size == 1 || fmt_attribs.component_size == 2;
+        case COMPONENT_TYPE_UNORM_SRGB: return fmt_attribs.component_size == 1;
+        case COMPONENT_TYPE_FLOAT: return fmt_attribs.component_size == 4;
+        default: return false;
+    }
+}
+
+void compute_mip_level(const ComputeMipLevelAttribs& attribs)
+{
+    cyber_check(attribs.fine_mip_data != nullptr && attribs.coarse_mip_data != nullptr);
+    cyber_check(attribs.fine_mip_width > 0 && attribs.fine_mip_height > 0);
+
+    if(!is_mip_generation_supported(attribs.format))
+    {
+        cyber_assert(false, "Mip generation is not supported for format {0}", get_texture_format_attribs(attribs.format).name);
+        return;
+    }
+
+    const auto& fmt_attribs = get_texture_format_attribs(attribs.format);
+    const uint32_t num_components = fmt_attribs.num_components;
+
+    MIP_FILTER_TYPE filter = attribs.filter_type;
+    if(filter == MIP_FILTER_TYPE_DEFAULT)
+        filter = fmt_attribs.component_type == COMPONENT_TYPE_FLOAT ? MIP_FILTER_TYPE_KAISER : MIP_FILTER_TYPE_BOX_AVERAGE;
+
+    if(fmt_attribs.component_type == COMPONENT_TYPE_UNORM_SRGB)
+        compute_mip_level_impl<uint8_t, true>(attribs, num_components, filter);
+    else if(fmt_attribs.component_type == COMPONENT_TYPE_FLOAT)
+        compute_mip_level_impl<float, false>(attribs, num_components, filter);
+    else if(fmt_attribs.component_size == 2)
+        compute_mip_level_impl<uint16_t, false>(attribs, num_components, filter);
+    else
+        compute_mip_level_impl<uint8_t, false>(attribs, num_components, filter);
+}
+
+CYBER_END_NAMESPACE
+CYBER_END_NAMESPACE
@@ -0,0 +1,44 @@
+// Built with AVX2 enabled (see xmake/tools/texture_loader.lua) and only entered after the runtime
+// cpuid check in mip_generator.cpp. Keep engine headers out of this file: inline functions they
+// define would be compiled with AVX2 here and the linker may keep that copy for every caller.
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace Cyber
+{
+namespace TextureLoader
+{
+
+// RGBA8 unorm 2x2 box filter, 8 coarse pixels per iteration. Returns the first coarse pixel left
+// for the SSE2 and scalar paths.
+uint32_t box_filter_rgba8_avx2(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, uint32_t coarse_width)
+{
+    const __m256i round8 = _mm256_set1_epi16(2);
+    const __m256i unshuffle = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    uint32_t x = 0;
+    for(; x + 8 <= coarse_width; x += 8)
+    {
+        __m256i half[2];
+        for(uint32_t h = 0; h < 2; ++h)
+        {
+            const size_t offset = size_t(x) * 8 + h * 32;
+            // Each 256-bit register holds 4 fine pixels widened to u16: lanes [p0 p1 | p2 p3]
+            const __m256i a = _mm256_add_epi16(
+                _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + offset))),
+                _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + offset))));
+            const __m256i b = _mm256_add_epi16(
+                _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + offset + 16))),
+                _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + offset + 16))));
+            const __m256i sum = _mm256_add_epi16(_mm256_unpacklo_epi64(a, b), _mm256_unpackhi_epi64(a, b));
+            half[h] = _mm256_srli_epi16(_mm256_add_epi16(sum, round8), 2);
+        }
+        // packus interleaves per 128-bit lane, the permute restores pixel order
+        const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(half[0], half[1]), unshuffle);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + size_t(x) * 4), packed);
+    }
+    return x;
+}
+
+}
+}
@@ -143,6 +143,12 @@ void TextureLoaderImpl::load_from_image(const TextureLoadInfo& texLoadInfo)
         }
     }
 
+    if(m_textureCreateDesc.m_mipLevels > 1 && !is_mip_generation_supported(m_textureCreateDesc.m_format))
+    {
+        cyber_warn("Mip generation is not supported for texture format, only mip 0 is loaded");
+        m_textureCreateDesc.m_mipLevels = 1;
+    }
+
     m_textureSubResData.resize(m_textureCreateDesc.m_mipLevels);
     m_mips.resize(m_textureCreateDesc.m_mipLevels);
 
@@ -174,7 +180,27 @@ void TextureLoaderImpl::load_from_image(const TextureLoadInfo& texLoadInfo)
     // 处理mipmaps
     for(uint32_t m = 1; m < m_textureCreateDesc.m_mipLevels; ++m)
     {
-
+        const auto fine_mip_width = std::max(1u, imgDesc.width >> (m - 1));
+        const auto fine_mip_height = std::max(1u, imgDesc.height >> (m - 1));
+        const auto coarse_mip_width = std::max(1u, fine_mip_width >> 1);
+        const auto coarse_mip_height = std::max(1u, fine_mip_height >> 1);
+        const auto coarse_mip_stride = align_up(coarse_mip_width * num_components * (channelDepth / 8), (uint32_t)4);
+        m_mips[m].resize(size_t(coarse_mip_stride) * size_t(coarse_mip_height));
+
+        ComputeMipLevelAttribs mip_attribs;
+        mip_attribs.format = m_textureCreateDesc.m_format;
+        mip_attribs.fine_mip_width = fine_mip_width;
+        mip_attribs.fine_mip_height = fine_mip_height;
+        mip_attribs.fine_mip_data = m_textureSubResData[m - 1].pData;
+        mip_attribs.fine_mip_stride = static_cast<size_t>(m_textureSubResData[m - 1].stride);
+        mip_attribs.coarse_mip_data = m_mips[m].data();
+        mip_attribs.coarse_mip_stride = coarse_mip_stride;
+        mip_attribs.filter_type = texLoadInfo.mipFilter;
+        mip_attribs.alpha_cutoff = texLoadInfo.alphaCutoff;
+        compute_mip_level(mip_attribs);
+
+        m_textureSubResData[m].pData = m_mips[m].data();
+        m_textureSubResData[m].stride = coarse_mip_stride;
     }
 }
 
@@ -4,9 +4,12 @@ texture_loader_include_dir = "$(projectdir)/tools/TextureLoader/include"
 
 target("TextureLoader")
     set_kind("static")
-    add_files("$(projectdir)/tools/TextureLoader/src/*.cpp")
+    add_files("$(projectdir)/tools/TextureLoader/src/*.cpp|mip_generator_avx2.cpp")
+    -- Only the AVX2 kernel is built for AVX2; mip_generator.cpp picks it with a cpuid check
+    add_files("$(projectdir)/tools/TextureLoader/src/mip_generator_avx2.cpp", {cxflags = "/arch:AVX2"})
     add_files("$(projectdir)/tools/TextureLoader/src/texture_utils.cpp")
     add_includedirs(texture_loader_include_dir, {public=true})
+    add_vectorexts("sse2")
     add_deps("CyberCore", {public = true})
     add_deps("CyberRuntime", {public = true})
     add_deps("mozjpeg", {public=true})